@@ -4,6 +4,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <cassert>
 #include <Reactant.h>
 #include <PetscSolver.h>
@@ -146,6 +147,9 @@ int runXolotl(const Options& opts) {
 	// Access our performance handler registry to obtain a Timer
 	// measuring the runtime of the entire program.
 	auto handlerRegistry = xolotlPerf::getHandlerRegistry();
+	// Record the timeline of the timers if it was asked for
+	if (!opts.getPerfTraceName().empty())
+		handlerRegistry->startTrace();
 	auto totalTimer = handlerRegistry->getTimer("total");
 	totalTimer->start();
 
@@ -187,6 +191,10 @@ int runXolotl(const Options& opts) {
 
 	totalTimer->stop();
 
+	// Write the timeline of this process
+	if (!opts.getPerfTraceName().empty())
+		handlerRegistry->writeTrace(opts.getPerfTraceName());
+
 	// Report statistics about the performance data collected during
 	// the run we just completed.
 	xperf::PerfObjStatsMap < xperf::ITimer::ValType > timerStats;
@@ -201,6 +209,39 @@ int runXolotl(const Options& opts) {
 	return 0;
 }
 
+/**
+ * Check whether the PETSc arguments of the parameter file ask for the
+ * start/stop checkpoints to be written in the background, which needs
+ * MPI_THREAD_MULTIPLE. MPI is not initialized yet when this is needed so the
+ * file is only scanned here, it is read with the other options later.
+ *
+ * @param argc The number of command line arguments
+ * @param argv The command line arguments, the parameter file first
+ * after the executable name
+ * @return True if -start_stop_async is given
+ */
+bool asyncCheckpointsRequested(int argc, char **argv) {
+	if (argc < 2)
+		return false;
+
+	std::ifstream paramFile(argv[1]);
+	std::string line;
+	while (std::getline(paramFile, line)) {
+		// Only the PETSc arguments can hold the option
+		if (line.compare(0, 10, "petscArgs=") != 0)
+			continue;
+
+		std::istringstream petscArgs(line.substr(10));
+		std::string arg;
+		while (petscArgs >> arg) {
+			if (arg == "-start_stop_async")
+				return true;
+		}
+	}
+
+	return false;
+}
+
 //! Main program
 int main(int argc, char **argv) {
 
@@ -212,7 +253,15 @@ int main(int argc, char **argv) {
 	// with overlapping Timer scopes.
 	// We do this before our own parsing of the command line,
 	// because it may change the command line.
-	MPI_Init(&argc, &argv);
+	// Ask for the full thread support only if the checkpoints must be
+	// written in the background, the writer falls back to writing them
+	// synchronously if it is not provided.
+	if (asyncCheckpointsRequested(argc, argv)) {
+		int provided;
+		MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+	} else {
+		MPI_Init(&argc, &argv);
+	}
 
 	try {
 		// Check the command line arguments.
@@ -110,7 +110,11 @@ BOOST_AUTO_TEST_CASE(goodParamFile) {
 			<< std::endl << "voidPortion=60.0" << std::endl << "regularGrid=no"
 			<< std::endl << "process=diff" << std::endl << "grouping=11 2 4"
 			<< std::endl << "sputtering=0.5" << std::endl << "boundary=1 1"
-			<< std::endl << "burstingDepth=5.0" << std::endl << "zeta=0.6" << std::endl;
+			<< std::endl << "burstingDepth=5.0" << std::endl << "zeta=0.6" << std::endl
+			<< "rateCacheTolerance=0.5" << std::endl << "concFormat=dense 4 30"
+			<< std::endl << "networkCache=netCache" << std::endl
+			<< "networkBroadcast=yes" << std::endl << "perfTrace=trace"
+			<< std::endl;
 	goodParamFile.close();
 
 	string pathToFile("param_good.txt");
@@ -188,6 +192,23 @@ BOOST_AUTO_TEST_CASE(goodParamFile) {
 	// Check the electronic stopping power option
 	BOOST_REQUIRE_EQUAL(opts.getZeta(), 0.6);
 
+	// Check the rate cache option
+	BOOST_REQUIRE_EQUAL(opts.getRateCacheTolerance(), 0.5);
+
+	// Check the concentration format option
+	BOOST_REQUIRE_EQUAL(opts.useDenseConcentrations(), true);
+	BOOST_REQUIRE_EQUAL(opts.getConcCompressionLevel(), 4);
+	BOOST_REQUIRE_EQUAL(opts.getConcMantissaBits(), 30);
+
+	// Check the network cache option
+	BOOST_REQUIRE_EQUAL(opts.getNetworkCacheDir(), "netCache");
+
+	// Check the network broadcast option
+	BOOST_REQUIRE_EQUAL(opts.broadcastNetwork(), true);
+
+	// Check the performance timeline option
+	BOOST_REQUIRE_EQUAL(opts.getPerfTraceName(), "trace");
+
 	// Check the physical processes option
 	auto map = opts.getProcesses();
 	BOOST_REQUIRE_EQUAL(map["diff"], true);
@@ -307,6 +328,62 @@ BOOST_AUTO_TEST_CASE(wrongPerfHandler) {
 	std::remove(tempFile.c_str());
 }
 
+BOOST_AUTO_TEST_CASE(activeWindowWithoutDenseFormat) {
+	xolotlCore::Options opts;
+
+	// Create a parameter file asking for the active window with the
+	// default ragged format
+	std::ofstream paramFile("param_window_wrong.txt");
+	paramFile << "petscArgs=-active_window 5" << std::endl
+			<< "process=diff movingSurface" << std::endl;
+	paramFile.close();
+
+	string pathToFile("param_window_wrong.txt");
+	string filename = pathToFile;
+	const char* fname = filename.c_str();
+
+	// Build a command line with the parameter file
+	char* args[3];
+	args[0] = const_cast<char*>("./xolotl");
+	args[1] = const_cast<char*>(fname);
+	args[2] = NULL;
+	char** fargv = args;
+
+	// Attempt to read the parameter file
+	fargv += 1;
+	opts.readParams(fargv);
+
+	// Xolotl should not be able to run without the dense format
+	BOOST_REQUIRE_EQUAL(opts.shouldRun(), false);
+	BOOST_REQUIRE_EQUAL(opts.getExitCode(), EXIT_FAILURE);
+
+	// Nor without the checkpoints that move the window
+	xolotlCore::Options noStopOpts;
+	paramFile.open("param_window_wrong.txt");
+	paramFile << "petscArgs=-active_window 5" << std::endl
+			<< "process=diff movingSurface" << std::endl
+			<< "concFormat=dense" << std::endl;
+	paramFile.close();
+	fargv = args + 1;
+	noStopOpts.readParams(fargv);
+	BOOST_REQUIRE_EQUAL(noStopOpts.shouldRun(), false);
+
+	// It can with the dense format and the checkpoints
+	xolotlCore::Options denseOpts;
+	paramFile.open("param_window_wrong.txt");
+	paramFile << "petscArgs=-active_window 5 -start_stop 1.0" << std::endl
+			<< "process=diff movingSurface" << std::endl
+			<< "concFormat=dense" << std::endl;
+	paramFile.close();
+	fargv = args + 1;
+	denseOpts.readParams(fargv);
+	BOOST_REQUIRE_EQUAL(denseOpts.shouldRun(), true);
+
+	// Remove the created file
+	std::string tempFile = "param_window_wrong.txt";
+	std::remove(tempFile.c_str());
+}
+
 BOOST_AUTO_TEST_CASE(wrongVizHandler) {
 	xolotlCore::Options opts;
 
@@ -215,8 +215,9 @@ BOOST_AUTO_TEST_CASE(checkIO) {
 		auto networkGroup =
 				testFile.getGroup<xolotlCore::XFile::NetworkGroup>();
 		BOOST_REQUIRE(networkGroup);
-		int normalSize = 0, superSize = 0;
-		networkGroup->readNetworkSize(normalSize, superSize);
+		BOOST_REQUIRE(networkGroup->isColumnar());
+		auto clusters = networkGroup->readClusters();
+		int normalSize = clusters.normalSize;
 		// Get all the reactants
 		auto const& reactants = network->getAll();
 		// Check the network vector
@@ -224,16 +225,15 @@ BOOST_AUTO_TEST_CASE(checkIO) {
 			// Get the i-th reactant in the network
 			auto& reactant = (PSICluster&) it;
 			int id = reactant.getId() - 1;
-			// Open the cluster group
-			XFile::ClusterGroup clusterGroup(*networkGroup, id);
 
 			if (id < normalSize) {
 				// Normal cluster
 				// Read the composition
-				double formationEnergy = 0.0, migrationEnergy = 0.0,
-						diffusionFactor = 0.0;
-				auto comp = clusterGroup.readCluster(formationEnergy,
-						migrationEnergy, diffusionFactor);
+				auto comp = clusters.compositions.data()
+						+ id * clusters.compSize;
+				double formationEnergy = clusters.energies[3 * id],
+						migrationEnergy = clusters.energies[3 * id + 1],
+						diffusionFactor = clusters.energies[3 * id + 2];
 				// Check the composition
 				auto& composition = reactant.getComposition();
 				BOOST_REQUIRE_EQUAL(comp[toCompIdx(Species::He)],
@@ -521,4 +521,236 @@ BOOST_AUTO_TEST_CASE(checkSurface3D) {
 	}
 }
 
+/**
+ * Method checking the writing and reading of the concentrations of a 2D grid,
+ * one dataset per grid point.
+ */
+BOOST_AUTO_TEST_CASE(checkConcentrationDatasets) {
+
+	// Determine where we are in the MPI world.
+	int commRank = -1;
+	MPI_Comm_rank(MPI_COMM_WORLD, &commRank);
+	const int nGridPointsPerRank = 3;
+	double const factor = 1.5;
+
+	// Create the test HDF5 file.
+	// Done in its own scope so that it closes when the
+	// object goes out of scope.
+	const std::string testFileName = "test_concentrations2D.h5";
+	{
+		BOOST_TEST_MESSAGE("Creating 2D test file");
+
+		// Set the number of grid points and step size
+		int nGrid = nGridPointsPerRank;
+		double stepSize = 0.5;
+		std::vector<double> grid;
+		for (int i = 0; i < nGrid + 2; i++)
+			grid.push_back((double) i * stepSize);
+
+		xolotlCore::XFile testFile(testFileName, grid, createTestNetworkComps(),
+		MPI_COMM_WORLD);
+	}
+
+	// Each process owns one row of the grid, the first grid point of the
+	// row has no concentrations
+	std::vector<std::array<int, 3> > positions;
+	XFile::TimestepGroup::Concs1DType myConcs(nGridPointsPerRank);
+	for (auto i = 0; i < nGridPointsPerRank; ++i) {
+		positions.push_back( { { i, commRank, -1 } });
+		for (auto j = 0; j < i; ++j) {
+			myConcs[i].emplace_back(j, factor * (commRank + i + j));
+		}
+	}
+
+	// Open the file to add concentrations.
+	{
+		BOOST_TEST_MESSAGE("Opening 2D file to add concentrations.");
+		xolotlCore::XFile testFile(testFileName,
+		MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadWrite);
+
+		auto concGroup =
+				testFile.getGroup<xolotlCore::XFile::ConcentrationGroup>();
+		BOOST_REQUIRE(concGroup);
+		auto tsGroup = concGroup->addTimestepGroup(0, 0.0001, 0.00001,
+				0.000001);
+		BOOST_REQUIRE(tsGroup);
+
+		tsGroup->writeConcentrationDatasets(testFile, positions, myConcs);
+	}
+
+	// Read back our part of the concentrations.
+	{
+		BOOST_TEST_MESSAGE("Opening 2D file to check its concentrations.");
+		xolotlCore::XFile testFile(testFileName,
+		MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadOnly);
+
+		auto concGroup =
+				testFile.getGroup<xolotlCore::XFile::ConcentrationGroup>();
+		BOOST_REQUIRE(concGroup);
+		auto tsGroup = concGroup->getLastTimestepGroup();
+		BOOST_REQUIRE(tsGroup);
+
+		auto readConcs = tsGroup->readConcentrationDatasets(positions);
+		BOOST_REQUIRE_EQUAL(readConcs.size(), myConcs.size());
+		for (auto ptIdx = 0; ptIdx < nGridPointsPerRank; ++ptIdx) {
+			BOOST_REQUIRE_EQUAL(readConcs[ptIdx].size(),
+					myConcs[ptIdx].size());
+			for (auto i = 0; i < myConcs[ptIdx].size(); ++i) {
+				BOOST_REQUIRE_EQUAL(readConcs[ptIdx][i].first,
+						myConcs[ptIdx][i].first);
+				BOOST_REQUIRE_CLOSE(readConcs[ptIdx][i].second,
+						myConcs[ptIdx][i].second, 0.0001);
+			}
+		}
+	}
+}
+
+/**
+ * Method checking the writing and reading of the concentrations in the
+ * dense format, without and with the rounding of the mantissa.
+ */
+BOOST_AUTO_TEST_CASE(checkDenseConcentrations) {
+
+	// Determine where we are in the MPI world.
+	int commRank = -1, commSize = -1;
+	MPI_Comm_rank(MPI_COMM_WORLD, &commRank);
+	MPI_Comm_size(MPI_COMM_WORLD, &commSize);
+	const int nGridPointsPerRank = 3, dof = 4;
+	double const factor = 1.5;
+
+	// Create the test HDF5 file.
+	const std::string testFileName = "test_denseConcentrations.h5";
+	{
+		BOOST_TEST_MESSAGE("Creating dense test file");
+
+		// Set the number of grid points and step size
+		int nGrid = nGridPointsPerRank;
+		double stepSize = 0.5;
+		std::vector<double> grid;
+		for (int i = 0; i < nGrid + 2; i++)
+			grid.push_back((double) i * stepSize);
+
+		xolotlCore::XFile testFile(testFileName, grid, createTestNetworkComps(),
+		MPI_COMM_WORLD);
+	}
+
+	// Each process owns one row of the grid, the first grid point of the
+	// row has no concentrations
+	std::vector<std::array<int, 3> > positions;
+	std::vector<double> myConcs(nGridPointsPerRank * dof, 0.0);
+	for (auto i = 0; i < nGridPointsPerRank; ++i) {
+		positions.push_back( { { i, commRank, -1 } });
+		for (auto j = 0; j < i; ++j) {
+			myConcs[i * dof + j] = factor * (commRank + i + j) / 7.0;
+		}
+	}
+
+	// Write the same concentrations at full and at reduced precision
+	XFile::TimestepGroup::ConcsFormat format;
+	format.dense = true;
+	for (int mantissaBits : { 52, 20 }) {
+		format.mantissaBits = mantissaBits;
+		{
+			xolotlCore::XFile testFile(testFileName,
+			MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadWrite);
+
+			auto concGroup = testFile.getGroup<
+					xolotlCore::XFile::ConcentrationGroup>();
+			BOOST_REQUIRE(concGroup);
+			auto tsGroup = concGroup->addTimestepGroup(mantissaBits, 0.0001,
+					0.00001, 0.000001);
+			BOOST_REQUIRE(tsGroup);
+
+			tsGroup->writeDenseConcentrations(testFile,
+					{ { nGridPointsPerRank, commSize, 1 } },
+					{ { 0, commRank, 0 } }, { { nGridPointsPerRank, 1, 1 } },
+					dof, myConcs.data(), format);
+		}
+
+		// Read back our part of the concentrations.
+		xolotlCore::XFile testFile(testFileName,
+		MPI_COMM_WORLD, xolotlCore::XFile::AccessMode::OpenReadOnly);
+
+		auto concGroup =
+				testFile.getGroup<xolotlCore::XFile::ConcentrationGroup>();
+		BOOST_REQUIRE(concGroup);
+		auto tsGroup = concGroup->getLastTimestepGroup();
+		BOOST_REQUIRE(tsGroup);
+
+		// Only the non-zero values are returned, 2^-20 is about 1.0e-4 %
+		double tolerance = (mantissaBits == 52) ? 1.0e-12 : 1.0e-4;
+		auto readConcs = tsGroup->readConcentrationDatasets(positions);
+		BOOST_REQUIRE_EQUAL(readConcs.size(), nGridPointsPerRank);
+		for (auto ptIdx = 0; ptIdx < nGridPointsPerRank; ++ptIdx) {
+			BOOST_REQUIRE_EQUAL(readConcs[ptIdx].size(), ptIdx);
+			for (auto i = 0; i < ptIdx; ++i) {
+				BOOST_REQUIRE_EQUAL(readConcs[ptIdx][i].first, i);
+				BOOST_REQUIRE_CLOSE(readConcs[ptIdx][i].second,
+						myConcs[ptIdx * dof + i], tolerance);
+			}
+		}
+	}
+}
+
+/**
+ * Method checking that a network written with one group per cluster is
+ * written by columns when it is copied, without changing its content.
+ */
+BOOST_AUTO_TEST_CASE(checkNetworkConversion) {
+
+	// Determine where we are in the MPI world.
+	int commRank = -1;
+	MPI_Comm_rank(MPI_COMM_WORLD, &commRank);
+
+	// Only one process writes the network, like for the checkpoints
+	if (commRank != 0)
+		return;
+
+	// The network file in the older layout
+	string sourceDir(XolotlSourceDirectory);
+	string oldFileName = sourceDir + "/tests/testfiles/tungsten_diminutive.h5";
+	xolotlCore::XFile oldFile(oldFileName, MPI_COMM_SELF);
+	auto oldGroup = oldFile.getGroup<xolotlCore::XFile::NetworkGroup>();
+	BOOST_REQUIRE(oldGroup);
+	BOOST_REQUIRE(!oldGroup->isColumnar());
+
+	// Copy it in a new file
+	const std::string testFileName = "test_networkConversion.h5";
+	{
+		std::vector<double> grid { 0.0, 0.5, 1.0 };
+		xolotlCore::XFile testFile(testFileName, grid, createTestNetworkComps(),
+		MPI_COMM_SELF);
+		oldGroup->copyTo(testFile);
+	}
+
+	// Compare the two networks
+	xolotlCore::XFile testFile(testFileName, MPI_COMM_SELF);
+	auto newGroup = testFile.getGroup<xolotlCore::XFile::NetworkGroup>();
+	BOOST_REQUIRE(newGroup);
+	BOOST_REQUIRE(newGroup->isColumnar());
+
+	auto oldClusters = oldGroup->readClusters();
+	auto newClusters = newGroup->readClusters();
+	BOOST_REQUIRE_EQUAL(newClusters.normalSize, oldClusters.normalSize);
+	BOOST_REQUIRE_EQUAL(newClusters.superSize, oldClusters.superSize);
+	BOOST_REQUIRE_EQUAL(newClusters.compSize, oldClusters.compSize);
+	BOOST_REQUIRE(newClusters.compositions == oldClusters.compositions);
+	BOOST_REQUIRE(newClusters.energies == oldClusters.energies);
+	BOOST_REQUIRE(newClusters.heVOffsets == oldClusters.heVOffsets);
+	BOOST_REQUIRE(newClusters.heVList == oldClusters.heVList);
+
+	auto oldReactions = oldGroup->readReactionTables();
+	auto newReactions = newGroup->readReactionTables();
+	for (int kind = 0; kind < 4; kind++) {
+		BOOST_REQUIRE_EQUAL(newReactions[kind].offsets.size(),
+				oldClusters.normalSize + oldClusters.superSize + 1);
+		BOOST_REQUIRE(
+				newReactions[kind].offsets == oldReactions[kind].offsets);
+		BOOST_REQUIRE(newReactions[kind].widths == oldReactions[kind].widths);
+		BOOST_REQUIRE(newReactions[kind].data == oldReactions[kind].data);
+	}
+	// There are production reactions in this network
+	BOOST_REQUIRE(newReactions[0].data.size() > 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -143,7 +143,7 @@ BOOST_AUTO_TEST_CASE(checkModifiedTrapMutation) {
 
 	// Compute the partial derivatives for the modified trap-mutation at the grid point 8
 	int nMutating = trapMutationHandler.computePartialsForTrapMutation(*network,
-			valPointer, indicesPointer, 8, 0, 3);
+			concOffset, valPointer, indicesPointer, 8, 0, 3);
 
 	// Check the values for the indices
 	BOOST_REQUIRE_EQUAL(nMutating, 4);
@@ -162,15 +162,14 @@ BOOST_AUTO_TEST_CASE(checkModifiedTrapMutation) {
 	BOOST_REQUIRE_CLOSE(val[4], 6.34804e+14, 0.01);
 	BOOST_REQUIRE_CLOSE(val[5], 6.34804e+14, 0.01);
 
-	// Change the temperature of the network
-	network->setTemperature(500.0);
-
-	// Update the bursting rate
-	trapMutationHandler.updateTrapMutationRate(*network);
+	// Change the temperature of the network at every grid point
+	for (int l = 0; l < nGrid; l++) {
+		network->setTemperature(500.0, l);
+	}
 
 	// Compute the partial derivatives for the bursting a the grid point 8
 	nMutating = trapMutationHandler.computePartialsForTrapMutation(*network,
-			valPointer, indicesPointer, 8, 0, 3);
+			concOffset, valPointer, indicesPointer, 8, 0, 3);
 
 	// Check values
 	BOOST_REQUIRE_EQUAL(nMutating, 4);
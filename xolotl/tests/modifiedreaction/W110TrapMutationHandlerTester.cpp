@@ -137,7 +137,7 @@ BOOST_AUTO_TEST_CASE(checkModifiedTrapMutation) {
 
 	// Compute the partial derivatives for the modified trap-mutation at the grid point 9
 	int nMutating = trapMutationHandler.computePartialsForTrapMutation(*network,
-			valPointer, indicesPointer, 9, 0);
+			concOffset, valPointer, indicesPointer, 9, 0);
 
 	// Check the values for the indices
 	BOOST_REQUIRE_EQUAL(nMutating, 3);
@@ -156,17 +156,17 @@ BOOST_AUTO_TEST_CASE(checkModifiedTrapMutation) {
 	BOOST_REQUIRE_CLOSE(val[4], 6.575931697e+14, 0.01);
 	BOOST_REQUIRE_CLOSE(val[5], 6.575931697e+14, 0.01);
 
-	// Change the temperature of the network
-	network->setTemperature(500.0);
+	// Change the temperature of the network at every grid point
+	for (int l = 0; l < nGrid; l++) {
+		network->setTemperature(500.0, l);
+	}
 
 	// Reinitialize the handler
 	trapMutationHandler.initialize(*network, grid);
-	// Update the bursting rate
-	trapMutationHandler.updateTrapMutationRate(*network);
 
 	// Compute the partial derivatives for the bursting a the grid point 9
 	nMutating = trapMutationHandler.computePartialsForTrapMutation(*network,
-			valPointer, indicesPointer, 9, 0);
+			concOffset, valPointer, indicesPointer, 9, 0);
 
 	// Check values
 	BOOST_REQUIRE_EQUAL(nMutating, 3);
@@ -137,7 +137,7 @@ BOOST_AUTO_TEST_CASE(checkModifiedTrapMutation) {
 
 	// Compute the partial derivatives for the modified trap-mutation at the grid point 11
 	int nMutating = trapMutationHandler.computePartialsForTrapMutation(*network,
-			valPointer, indicesPointer, 11, 0);
+			concOffset, valPointer, indicesPointer, 11, 0);
 
 	// Check the values for the indices
 	BOOST_REQUIRE_EQUAL(nMutating, 5);
@@ -156,17 +156,17 @@ BOOST_AUTO_TEST_CASE(checkModifiedTrapMutation) {
 	BOOST_REQUIRE_CLOSE(val[4], 6.575931697e+14, 0.01);
 	BOOST_REQUIRE_CLOSE(val[5], 6.575931697e+14, 0.01);
 
-	// Change the temperature of the network
-	network->setTemperature(500.0);
+	// Change the temperature of the network at every grid point
+	for (int l = 0; l < nGrid; l++) {
+		network->setTemperature(500.0, l);
+	}
 
 	// Reinitialize the handler
 	trapMutationHandler.initialize(*network, grid);
-	// Update the bursting rate
-	trapMutationHandler.updateTrapMutationRate(*network);
 
 	// Compute the partial derivatives for the bursting a the grid point 11
 	nMutating = trapMutationHandler.computePartialsForTrapMutation(*network,
-			valPointer, indicesPointer, 11, 0);
+			concOffset, valPointer, indicesPointer, 11, 0);
 
 	// Check values
 	BOOST_REQUIRE_EQUAL(nMutating, 5);
@@ -177,6 +177,44 @@ BOOST_AUTO_TEST_CASE(checkModifiedTrapMutation) {
 	BOOST_REQUIRE_CLOSE(val[4], 5.536237e+14, 0.01);
 	BOOST_REQUIRE_CLOSE(val[5], 5.536237e+14, 0.01);
 
+	// The desorption rate must only depend on the concentrations at the
+	// grid point, not on the ones last put in the network.
+	// Compute the baseline at the seventh grid point with its own
+	// concentrations in the network
+	concOffset = conc + 6 * dof;
+	double baseline[dof], updated[dof];
+	double baselineVal[3 * nHelium];
+	int baselineIndices[3 * nHelium];
+	for (int i = 0; i < dof; i++) {
+		baseline[i] = 0.0;
+		updated[i] = 0.0;
+	}
+	network->updateConcentrationsFromArray(concOffset);
+	trapMutationHandler.computeTrapMutation(*network, concOffset, baseline, 6,
+			0);
+	int nBaseline = trapMutationHandler.computePartialsForTrapMutation(
+			*network, concOffset, baselineVal, baselineIndices, 6, 0);
+
+	// Put the concentrations of another grid point in the network
+	network->updateConcentrationsFromArray(conc + 11 * dof);
+
+	// Compute the modified trap mutation at the seventh grid point again
+	trapMutationHandler.computeTrapMutation(*network, concOffset, updated, 6,
+			0);
+	nMutating = trapMutationHandler.computePartialsForTrapMutation(*network,
+			concOffset, valPointer, indicesPointer, 6, 0);
+
+	// Check that the desorpting He contributes and that nothing changed
+	BOOST_REQUIRE(baseline[6] < 0.0);
+	for (int i = 0; i < dof; i++) {
+		BOOST_REQUIRE_CLOSE(updated[i], baseline[i], 1.0e-10);
+	}
+	BOOST_REQUIRE_EQUAL(nMutating, nBaseline);
+	for (int i = 0; i < 3 * nMutating; i++) {
+		BOOST_REQUIRE_EQUAL(indices[i], baselineIndices[i]);
+		BOOST_REQUIRE_CLOSE(val[i], baselineVal[i], 1.0e-10);
+	}
+
 	// Remove the created file
 	std::string tempFile = "param.txt";
 	std::remove(tempFile.c_str());
@@ -0,0 +1,117 @@
+#define BOOST_TEST_MODULE Regression
+
+#include <string>
+#include <stdexcept>
+#include <unistd.h>
+#include <boost/test/included/unit_test.hpp>
+#include "xolotlPerf/HotCounter.h"
+#include "xolotlPerf/HotTimer.h"
+#include "xolotlPerf/os/OSHandlerRegistry.h"
+#include "xolotlPerf/dummy/DummyHandlerRegistry.h"
+
+using namespace std;
+namespace xperf = xolotlPerf;
+
+/**
+ * This suite is responsible for testing the HotCounter and HotTimer.
+ */
+BOOST_AUTO_TEST_SUITE (HotCounter_testSuite)
+
+BOOST_AUTO_TEST_CASE(checkThreadedCount) {
+	xperf::HotCounter tester("test");
+	BOOST_REQUIRE_EQUAL("test", tester.getName());
+	BOOST_REQUIRE_EQUAL(tester.getValue(), 0U);
+
+	// Count from all the threads at once
+	const int nEvents = 100000;
+#pragma omp parallel for
+	for (int i = 0; i < nEvents; i++) {
+		tester.increment();
+	}
+	tester.add(5);
+
+#ifdef XOLOTL_HOT_COUNTERS
+	BOOST_REQUIRE_EQUAL(tester.getValue(), nEvents + 5UL);
+#else
+	BOOST_REQUIRE_EQUAL(tester.getValue(), 0U);
+#endif
+
+	// More shards than threads, or fewer, still count everything
+	xperf::HotCounter one("one", 1);
+	xperf::HotCounter many("many", 64);
+#pragma omp parallel for
+	for (int i = 0; i < nEvents; i++) {
+		one.increment();
+		many.increment();
+	}
+#ifdef XOLOTL_HOT_COUNTERS
+	BOOST_REQUIRE_EQUAL(one.getValue(), nEvents + 0UL);
+	BOOST_REQUIRE_EQUAL(many.getValue(), nEvents + 0UL);
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(checkThreadedTiming) {
+	xperf::HotTimer tester("test");
+	BOOST_REQUIRE_EQUAL("s", tester.getUnits());
+
+	// Each iteration sleeps 10 ms, whatever the thread doing it
+	const int nSleeps = 8;
+#pragma omp parallel for
+	for (int i = 0; i < nSleeps; i++) {
+		tester.start();
+		usleep(10000);
+		tester.stop();
+	}
+
+	BOOST_TEST_MESSAGE(
+			"\n" << "HotTimer Message: \n" << "tester.getValue() = " << tester.getValue() << "s");
+
+#ifdef XOLOTL_HOT_COUNTERS
+	// The time of all the threads adds up
+	BOOST_REQUIRE(tester.getValue() >= nSleeps * 0.01);
+	BOOST_REQUIRE(tester.getValue() < nSleeps * 0.01 * 1.5);
+#endif
+
+	tester.reset();
+	BOOST_REQUIRE_EQUAL(tester.getValue(), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(checkDisabled) {
+	// Without shards nothing is counted or timed
+	xperf::HotCounter counter("counter", 0);
+	xperf::HotTimer timer("timer", 0);
+	counter.increment();
+	timer.start();
+	usleep(1000);
+	timer.stop();
+	BOOST_REQUIRE_EQUAL(counter.getValue(), 0U);
+	BOOST_REQUIRE_EQUAL(timer.getValue(), 0.0);
+
+	// The dummy registry hands out such objects
+	xperf::DummyHandlerRegistry reg;
+	auto dummyCounter = reg.getHotCounter("counter");
+	dummyCounter->increment();
+	BOOST_REQUIRE_EQUAL(dummyCounter->getValue(), 0U);
+}
+
+BOOST_AUTO_TEST_CASE(checkRegistry) {
+	xperf::OSHandlerRegistry reg;
+
+	// The same name gives the same object
+	auto counter = reg.getHotCounter("counter");
+	BOOST_REQUIRE_EQUAL(counter, reg.getHotCounter("counter"));
+	auto timer = reg.getHotTimer("timer");
+	BOOST_REQUIRE_EQUAL(timer, reg.getHotTimer("timer"));
+
+	// They are also found as plain objects, to be reported with them
+	BOOST_REQUIRE_EQUAL(reg.getEventCounter("counter"), counter);
+	BOOST_REQUIRE_EQUAL(reg.getTimer("timer"), timer);
+
+	// But plain objects cannot be used from threads
+	reg.getEventCounter("plain");
+	BOOST_REQUIRE_THROW(reg.getHotCounter("plain"), std::invalid_argument);
+	reg.getTimer("plainTimer");
+	BOOST_REQUIRE_THROW(reg.getHotTimer("plainTimer"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,83 @@
+#define BOOST_TEST_MODULE Regression
+
+#include <string>
+#include <sstream>
+#include <memory>
+#include <boost/test/included/unit_test.hpp>
+#include "xolotlPerf/standard/TraceRecorder.h"
+#include "xolotlPerf/os/OSTimer.h"
+
+using namespace std;
+namespace xperf = xolotlPerf;
+
+/**
+ * This suite is responsible for testing the TraceRecorder.
+ */
+BOOST_AUTO_TEST_SUITE (TraceRecorder_testSuite)
+
+BOOST_AUTO_TEST_CASE(checkDisabled) {
+	auto trace = std::make_shared<xperf::TraceRecorder>();
+	xperf::OSTimer tester("test", trace);
+
+	// Nothing is recorded before the trace is started
+	BOOST_REQUIRE_EQUAL(trace->isEnabled(), false);
+	tester.start();
+	tester.stop();
+	trace->markTimeStep(0, 0.0);
+	BOOST_REQUIRE_EQUAL(trace->size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(checkNesting) {
+	auto trace = std::make_shared<xperf::TraceRecorder>();
+	xperf::OSTimer outer("outer", trace);
+	xperf::OSTimer inner("in\"ner", trace);
+	trace->start();
+	BOOST_REQUIRE_EQUAL(trace->isEnabled(), true);
+
+	// Two steps with the inner timer nested in the outer one
+	for (int step = 0; step < 2; step++) {
+		outer.start();
+		inner.start();
+		inner.stop();
+		outer.stop();
+		trace->markTimeStep(step, 1.0e-3 * (step + 1));
+	}
+	BOOST_REQUIRE_EQUAL(trace->size(), 10);
+
+	// The same name always gets the same id
+	BOOST_REQUIRE_EQUAL(trace->getNameId("outer"), trace->getNameId("outer"));
+	BOOST_REQUIRE(trace->getNameId("outer") != trace->getNameId("in\"ner"));
+
+	std::ostringstream os;
+	trace->write(os, 3);
+	std::string json = os.str();
+
+	BOOST_TEST_MESSAGE("\n" << "TraceRecorder Message: \n" << json);
+
+	// The events are written in the order they happened
+	auto outerBegin = json.find("\"name\":\"outer\",\"ph\":\"B\"");
+	auto innerBegin = json.find("\"name\":\"in\\\"ner\",\"ph\":\"B\"");
+	auto innerEnd = json.find("\"name\":\"in\\\"ner\",\"ph\":\"E\"");
+	auto outerEnd = json.find("\"name\":\"outer\",\"ph\":\"E\"");
+	auto step = json.find("\"step\":0");
+	BOOST_REQUIRE(outerBegin != std::string::npos);
+	BOOST_REQUIRE(innerBegin != std::string::npos);
+	BOOST_REQUIRE(innerEnd != std::string::npos);
+	BOOST_REQUIRE(outerEnd != std::string::npos);
+	BOOST_REQUIRE(step != std::string::npos);
+	BOOST_REQUIRE(outerBegin < innerBegin);
+	BOOST_REQUIRE(innerBegin < innerEnd);
+	BOOST_REQUIRE(innerEnd < outerEnd);
+	BOOST_REQUIRE(outerEnd < step);
+	BOOST_REQUIRE(json.find("\"step\":1") != std::string::npos);
+
+	// The rank is the process id
+	BOOST_REQUIRE(json.find("\"pid\":3") != std::string::npos);
+	BOOST_REQUIRE(json.find("\"pid\":0") == std::string::npos);
+
+	// Starting again forgets the previous events
+	trace->start();
+	BOOST_REQUIRE_EQUAL(trace->size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -9,10 +9,13 @@
 #include <mpi.h>
 #include <memory>
 #include <Options.h>
+#include "xolotlCore/io/Filesystem.h"
 #include "tests/utils/MPIFixture.h"
+#include "ReactionTestUtils.h"
 
 using namespace std;
 using namespace xolotlCore;
+using namespace testUtils;
 
 // Initialize MPI before running any tests; finalize it running all tests.
 BOOST_GLOBAL_FIXTURE(MPIFixture);
@@ -99,4 +102,108 @@ BOOST_AUTO_TEST_CASE(checkLoad) {
 	return;
 }
 
+/**
+ * Method checking that a generated network is saved in the cache and loaded
+ * from it by the next generation with the same parameters.
+ */
+BOOST_AUTO_TEST_CASE(checkCache) {
+	// Read the options
+	Options opts;
+	readOptions(opts, "netParam=8 0 0 5 3\ngrid=100 0.5\n"
+			"networkCache=testNetworkCache\n");
+
+	// Start from an empty cache
+	fs::remove_all("testNetworkCache");
+
+	// Generate the network, it is saved in the cache
+	HDF5NetworkLoader loader = HDF5NetworkLoader(
+			make_shared<xolotlPerf::DummyHandlerRegistry>());
+	auto network = loader.generate(opts);
+	BOOST_REQUIRE_EQUAL(network->size(), 104);
+	BOOST_REQUIRE(fs::exists("testNetworkCache"));
+	BOOST_REQUIRE(!fs::is_empty("testNetworkCache"));
+
+	// Generate it again, it is loaded from the cache
+	HDF5NetworkLoader otherLoader = HDF5NetworkLoader(
+			make_shared<xolotlPerf::DummyHandlerRegistry>());
+	auto cachedNetwork = otherLoader.generate(opts);
+	BOOST_REQUIRE_EQUAL(cachedNetwork->size(), network->size());
+	BOOST_REQUIRE_EQUAL(cachedNetwork->getSuperSize(),
+			network->getSuperSize());
+	BOOST_REQUIRE(
+			cachedNetwork->getCompositionList()
+					== network->getCompositionList());
+
+	// Check the reactions of each cluster
+	auto& reactants = network->getAll();
+	auto& cachedReactants = cachedNetwork->getAll();
+	for (int i = 0; i < reactants.size(); i++) {
+		IReactant& reactant = reactants.at(i);
+		IReactant& cachedReactant = cachedReactants.at(i);
+		BOOST_REQUIRE(
+				cachedReactant.getComposition() == reactant.getComposition());
+		BOOST_REQUIRE_EQUAL(cachedReactant.getFormationEnergy(),
+				reactant.getFormationEnergy());
+		BOOST_REQUIRE_EQUAL(cachedReactant.getProdVector().size(),
+				reactant.getProdVector().size());
+		BOOST_REQUIRE_EQUAL(cachedReactant.getCombVector().size(),
+				reactant.getCombVector().size());
+		BOOST_REQUIRE_EQUAL(cachedReactant.getDissoVector().size(),
+				reactant.getDissoVector().size());
+		BOOST_REQUIRE_EQUAL(cachedReactant.getEmitVector().size(),
+				reactant.getEmitVector().size());
+	}
+
+	// A different network is not taken from the cache
+	opts.setMaxV(4);
+	auto smallerNetwork = otherLoader.generate(opts);
+	BOOST_REQUIRE(smallerNetwork->size() < network->size());
+
+	// Remove the created cache
+	fs::remove_all("testNetworkCache");
+
+	return;
+}
+
+/**
+ * Method checking that the networks broadcast by the master process are the
+ * same as the ones built by every process.
+ */
+BOOST_AUTO_TEST_CASE(checkBroadcast) {
+	// Read the options
+	Options opts;
+	readOptions(opts, "netParam=8 0 0 5 3\ngrid=100 0.5\n");
+
+	// Generate the network on every process
+	HDF5NetworkLoader loader = HDF5NetworkLoader(
+			make_shared<xolotlPerf::DummyHandlerRegistry>());
+	auto network = loader.generate(opts);
+
+	// Generate it on the master and broadcast it
+	opts.setBroadcastNetwork(true);
+	auto broadcastNetwork = loader.generate(opts);
+	BOOST_REQUIRE_EQUAL(broadcastNetwork->size(), network->size());
+	BOOST_REQUIRE(
+			broadcastNetwork->getCompositionList()
+					== network->getCompositionList());
+	auto& reactants = network->getAll();
+	auto& broadcastReactants = broadcastNetwork->getAll();
+	for (int i = 0; i < reactants.size(); i++) {
+		IReactant& reactant = reactants.at(i);
+		IReactant& broadcastReactant = broadcastReactants.at(i);
+		BOOST_REQUIRE_EQUAL(broadcastReactant.getProdVector().size(),
+				reactant.getProdVector().size());
+		BOOST_REQUIRE_EQUAL(broadcastReactant.getDissoVector().size(),
+				reactant.getDissoVector().size());
+	}
+
+	// Read a network file on the master and broadcast it
+	string sourceDir(XolotlSourceDirectory);
+	loader.setFilename(sourceDir + "/tests/testfiles/tungsten_diminutive.h5");
+	auto loadedNetwork = loader.load(opts);
+	BOOST_REQUIRE_EQUAL(loadedNetwork->size(), 9);
+
+	return;
+}
+
 BOOST_AUTO_TEST_SUITE_END()
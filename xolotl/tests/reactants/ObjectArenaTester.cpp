@@ -0,0 +1,140 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Regression
+
+#include <boost/test/unit_test.hpp>
+#include <ObjectArena.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace xolotlCore;
+
+/**
+ * An object that records its destruction and owns heap memory, so that
+ * destroying the wrong object or destroying one twice is detected.
+ */
+struct Tracked {
+	//! The list where the ids of the destroyed objects are written
+	vector<int>& destroyed;
+
+	//! The id of this object
+	int id;
+
+	//! Some heap memory
+	string name;
+
+	Tracked(vector<int>& d, int i) :
+			destroyed(d), id(i), name("object number " + to_string(i)) {
+	}
+
+	~Tracked() {
+		destroyed.push_back(id);
+	}
+};
+
+/**
+ * This suite is responsible for testing the ObjectArena.
+ */BOOST_AUTO_TEST_SUITE(ObjectArena_testSuite)
+
+/**
+ * This operation checks that the objects are kept in creation order,
+ * across several blocks, and do not move.
+ */
+BOOST_AUTO_TEST_CASE(checkEmplace) {
+	vector<int> destroyed;
+	{
+		// Small blocks to use several of them
+		ObjectArena<Tracked, 4> arena;
+		vector<Tracked*> addresses;
+		for (int i = 0; i < 10; i++) {
+			Tracked& object = arena.emplace_back(destroyed, i);
+			BOOST_REQUIRE_EQUAL(object.id, i);
+			addresses.push_back(&object);
+		}
+		BOOST_REQUIRE_EQUAL(arena.size(), 10);
+		BOOST_REQUIRE_EQUAL(arena.back().id, 9);
+
+		// Check the objects
+		for (int i = 0; i < 10; i++) {
+			BOOST_REQUIRE_EQUAL(arena[i].id, i);
+			BOOST_REQUIRE_EQUAL(arena[i].name, "object number " + to_string(i));
+			BOOST_REQUIRE_EQUAL(&arena[i], addresses[i]);
+		}
+		BOOST_REQUIRE(destroyed.empty());
+	}
+
+	// The destructor destroyed each object once, the last one first
+	BOOST_REQUIRE_EQUAL(destroyed.size(), 10);
+	for (int i = 0; i < 10; i++) {
+		BOOST_REQUIRE_EQUAL(destroyed[i], 9 - i);
+	}
+}
+
+/**
+ * This operation checks that pop_back destroys the last object only.
+ */
+BOOST_AUTO_TEST_CASE(checkPopBack) {
+	vector<int> destroyed;
+	ObjectArena<Tracked, 4> arena;
+	for (int i = 0; i < 5; i++) {
+		arena.emplace_back(destroyed, i);
+	}
+
+	// Remove the object alone in its block
+	arena.pop_back();
+	BOOST_REQUIRE_EQUAL(arena.size(), 4);
+	BOOST_REQUIRE_EQUAL(destroyed.size(), 1);
+	BOOST_REQUIRE_EQUAL(destroyed[0], 4);
+	BOOST_REQUIRE_EQUAL(arena.back().id, 3);
+	BOOST_REQUIRE_EQUAL(arena.back().name, "object number 3");
+
+	// Its storage is reused by the next object
+	arena.emplace_back(destroyed, 5);
+	BOOST_REQUIRE_EQUAL(arena.size(), 5);
+	BOOST_REQUIRE_EQUAL(arena[4].id, 5);
+
+	// Remove it again and one more
+	arena.pop_back();
+	arena.pop_back();
+	BOOST_REQUIRE_EQUAL(arena.size(), 3);
+	BOOST_REQUIRE_EQUAL(destroyed.size(), 3);
+	BOOST_REQUIRE_EQUAL(destroyed[1], 5);
+	BOOST_REQUIRE_EQUAL(destroyed[2], 3);
+	for (int i = 0; i < 3; i++) {
+		BOOST_REQUIRE_EQUAL(arena[i].name, "object number " + to_string(i));
+	}
+}
+
+/**
+ * This operation checks that clear destroys all the objects and that the
+ * arena can be used again.
+ */
+BOOST_AUTO_TEST_CASE(checkClear) {
+	vector<int> destroyed;
+	ObjectArena<Tracked, 4> arena;
+
+	// Clearing an empty arena does nothing
+	arena.clear();
+	BOOST_REQUIRE_EQUAL(arena.size(), 0);
+	BOOST_REQUIRE(destroyed.empty());
+
+	for (int i = 0; i < 6; i++) {
+		arena.emplace_back(destroyed, i);
+	}
+	arena.clear();
+	BOOST_REQUIRE_EQUAL(arena.size(), 0);
+	BOOST_REQUIRE_EQUAL(destroyed.size(), 6);
+	for (int i = 0; i < 6; i++) {
+		BOOST_REQUIRE_EQUAL(destroyed[i], 5 - i);
+	}
+
+	// Fill it again
+	arena.emplace_back(destroyed, 6);
+	BOOST_REQUIRE_EQUAL(arena.size(), 1);
+	BOOST_REQUIRE_EQUAL(arena.back().id, 6);
+	arena.clear();
+	BOOST_REQUIRE_EQUAL(destroyed.size(), 7);
+	BOOST_REQUIRE_EQUAL(destroyed[6], 6);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
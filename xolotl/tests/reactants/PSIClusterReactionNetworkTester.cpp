@@ -159,6 +159,53 @@ BOOST_AUTO_TEST_CASE(checkReactants) {
 	return;
 }
 
+/**
+ * Method checking that adding a known reaction returns the reaction
+ * already in the network.
+ */
+BOOST_AUTO_TEST_CASE(checkReactions) {
+	// Create the network
+	auto psiNetwork = make_shared<PSIClusterReactionNetwork>(registry);
+
+	// Add He_1, He_2 and He_3
+	for (int i = 1; i <= 3; i++) {
+		auto cluster = std::unique_ptr<PSIHeCluster>(
+				new PSIHeCluster(i, *(psiNetwork.get()), registry));
+		psiNetwork->add(std::move(cluster));
+	}
+	auto& he1 = *(psiNetwork->get(Species::He, 1));
+	auto& he2 = *(psiNetwork->get(Species::He, 2));
+	auto& he3 = *(psiNetwork->get(Species::He, 3));
+
+	// Add the production reactions, in both orders
+	auto& reaction = psiNetwork->addProductionReaction(he1, he2);
+	auto& sameReaction = psiNetwork->addProductionReaction(he2, he1);
+	BOOST_REQUIRE_EQUAL(&reaction, &sameReaction);
+	auto& otherReaction = psiNetwork->addProductionReaction(he1, he1);
+	BOOST_REQUIRE(&otherReaction != &reaction);
+	BOOST_REQUIRE(otherReaction.getRateIndex() != reaction.getRateIndex());
+
+	// Earlier reactions are not moved by the new ones
+	BOOST_REQUIRE_EQUAL(&(reaction.first), &he1);
+	BOOST_REQUIRE_EQUAL(&(reaction.second), &he2);
+
+	// Same for the dissociation
+	auto& dissociation = psiNetwork->addDissociationReaction(he3, he1, he2,
+			&reaction);
+	auto& sameDissociation = psiNetwork->addDissociationReaction(he3, he2,
+			he1, &reaction);
+	BOOST_REQUIRE_EQUAL(&dissociation, &sameDissociation);
+	BOOST_REQUIRE_EQUAL(dissociation.reverseReaction, &reaction);
+
+	// The old interface gives the same reactions
+	std::unique_ptr<ProductionReaction> newReaction(
+			new ProductionReaction(he2, he1));
+	BOOST_REQUIRE_EQUAL(&(psiNetwork->add(std::move(newReaction))),
+			&reaction);
+
+	return;
+}
+
 BOOST_AUTO_TEST_CASE(checkProperties) {
 	// Create the network
 	auto psiNetwork = make_shared<PSIClusterReactionNetwork>(registry);
@@ -260,4 +307,68 @@ BOOST_AUTO_TEST_CASE(checkArrayOperations) {
 	return;
 }
 
+/**
+ * This operation checks that the grid points at the same temperature share
+ * the rate constants through the cache.
+ */
+BOOST_AUTO_TEST_CASE(checkRateCache) {
+	// Get the simple reaction network with 4 grid points
+	auto network = getSimplePSIReactionNetwork();
+	network->addGridPoints(4);
+	int dof = network->getDOF();
+
+	// Set the concentrations
+	std::vector<double> concentrations(dof, 0.0);
+	for (int n = 0; n < network->size(); n++) {
+		concentrations[n] = 1.0 + n;
+	}
+
+	// Compute the fluxes at each grid point
+	auto getFluxes = [&](int i) {
+		std::vector<double> fluxes(dof, 0.0);
+		network->computeAllFluxes(concentrations.data(), fluxes.data(), i);
+		return fluxes;
+	};
+
+	// The first grid point computes the rates, the second one takes them
+	// from the cache
+	network->setTemperature(1000.0, 0);
+	network->setTemperature(1000.0, 1);
+	auto refFluxes = getFluxes(0);
+	auto fluxes = getFluxes(1);
+	for (int n = 0; n < dof; n++) {
+		BOOST_REQUIRE_EQUAL(fluxes[n], refFluxes[n]);
+	}
+
+	// Same without the cache
+	network->setRateCacheTolerance(-1.0);
+	network->setTemperature(1000.0, 2);
+	fluxes = getFluxes(2);
+	for (int n = 0; n < dof; n++) {
+		BOOST_REQUIRE_EQUAL(fluxes[n], refFluxes[n]);
+	}
+
+	// A close temperature gets the same rates with a tolerance
+	network->setRateCacheTolerance(10.0);
+	network->setTemperature(1000.0, 0);
+	network->setTemperature(1001.0, 3);
+	fluxes = getFluxes(3);
+	for (int n = 0; n < dof; n++) {
+		BOOST_REQUIRE_EQUAL(fluxes[n], refFluxes[n]);
+	}
+
+	// But not without it
+	network->setRateCacheTolerance(0.0);
+	network->setTemperature(1001.0, 3);
+	fluxes = getFluxes(3);
+	bool differ = false;
+	for (int n = 0; n < dof; n++) {
+		if (fluxes[n] != refFluxes[n])
+			differ = true;
+	}
+	BOOST_REQUIRE(differ);
+
+	return;
+}
+
 BOOST_AUTO_TEST_SUITE_END()
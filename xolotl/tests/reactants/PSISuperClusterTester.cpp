@@ -11,11 +11,19 @@
 #include <DummyHandlerRegistry.h>
 #include <Constants.h>
 #include <Options.h>
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <mpi.h>
+#include "tests/utils/MPIFixture.h"
+#include "ReactionTestUtils.h"
 
 using namespace std;
 using namespace xolotlCore;
+using namespace testUtils;
+
+// Initialize MPI before running any tests; finalize it running all tests.
+BOOST_GLOBAL_FIXTURE(MPIFixture);
 
 /**
  * This suite is responsible for testing the PSISuperCluster.
@@ -34,15 +42,12 @@ BOOST_AUTO_TEST_CASE(checkConnectivity) {
 	paramFile.close();
 
 	// Create a fake command line to read the options
-	int argc = 0;
 	char **argv;
 	argv = new char*[2];
 	std::string parameterFile = "param.txt";
 	argv[0] = new char[parameterFile.length() + 1];
 	strcpy(argv[0], parameterFile.c_str());
 	argv[1] = 0; // null-terminate the array
-	// Initialize MPI for HDF5
-	MPI_Init(&argc, &argv);
 
 	// Read the options
 	Options opts;
@@ -92,7 +97,6 @@ BOOST_AUTO_TEST_CASE(checkTotalFlux) {
 	paramFile.close();
 
 	// Create a fake command line to read the options
-	int argc = 0;
 	char **argv;
 	argv = new char*[2];
 	std::string parameterFile = "param.txt";
@@ -140,6 +144,230 @@ BOOST_AUTO_TEST_CASE(checkTotalFlux) {
 	return;
 }
 
+/**
+ * This operation checks that the network computes the same fluxes as the
+ * clusters themselves.
+ */
+BOOST_AUTO_TEST_CASE(checkAllFluxes) {
+	// Generate the grouped network
+	auto network = getGroupedPSIReactionNetwork();
+	// Add a grid point for the rates
+	network->addGridPoints(1);
+
+	// Set the temperature in the network
+	double temperature = 1000.0;
+	network->setTemperature(temperature, 0);
+	// Recompute Ids and network size and redefine the connectivities
+	network->reinitializeConnectivities();
+
+	// Set different concentrations and moments everywhere
+	const int dof = network->getDOF();
+	std::vector<double> concentrations(dof, 0.0);
+	for (int i = 0; i < dof - 1; i++) {
+		concentrations[i] = 0.5 + 0.01 * (double) i;
+	}
+	network->updateConcentrationsFromArray(concentrations.data());
+
+	// Compute all the fluxes
+	std::vector<double> updatedConcentrations(dof, 0.0);
+	network->computeAllFluxes(updatedConcentrations.data(), 0);
+
+	// Compare with the flux of each cluster
+	for (IReactant& reactant : network->getAll()) {
+		double flux = reactant.getTotalFlux(0);
+		BOOST_REQUIRE_CLOSE(flux, updatedConcentrations[reactant.getId() - 1],
+				0.0001);
+	}
+
+	// And with the moment fluxes
+	int psDim = 1
+			+ (dof - 1 - network->size()) / network->getSuperSize();
+	auto indexList = network->getPhaseSpaceList();
+	for (auto const& superMapItem : network->getAll(ReactantType::PSISuper)) {
+		auto& cluster = static_cast<PSISuperCluster&>(*(superMapItem.second));
+		cluster.getTotalFlux(0);
+		for (int i = 1; i < psDim; i++) {
+			int axis = indexList[i] - 1;
+			BOOST_REQUIRE_CLOSE(cluster.getMomentFlux(axis),
+					updatedConcentrations[cluster.getMomentId(axis) - 1],
+					0.0001);
+		}
+	}
+
+	return;
+}
+
+/**
+ * This operation checks that the partial derivatives computed directly from
+ * the concentration array are the same as the ones computed by the clusters.
+ */
+BOOST_AUTO_TEST_CASE(checkAllPartials) {
+	// Generate the grouped network
+	auto network = getGroupedPSIReactionNetwork();
+	// Add a grid point for the rates
+	network->addGridPoints(1);
+
+	// Set the temperature in the network
+	double temperature = 1000.0;
+	network->setTemperature(temperature, 0);
+	// Recompute Ids and network size and redefine the connectivities
+	network->reinitializeConnectivities();
+
+	// Set up the network to be able to compute the partial derivatives
+	std::vector<int> reactionSize, reactionIndices;
+	std::vector<size_t> reactionStartingIdx;
+	auto nPartials = initPartials(*network, reactionSize, reactionStartingIdx,
+			reactionIndices);
+	const int dof = network->getDOF();
+
+	// Set different concentrations and moments everywhere
+	std::vector<double> concentrations(dof, 0.0);
+	for (int i = 0; i < dof - 1; i++) {
+		concentrations[i] = 0.5 + 0.01 * (double) i;
+	}
+
+	// Compute the partial derivatives with the clusters
+	network->updateConcentrationsFromArray(concentrations.data());
+	std::vector<double> knownVals(nPartials);
+	network->computeAllPartials(reactionStartingIdx, reactionIndices,
+			knownVals, 0);
+
+	// And directly from the concentrations
+	std::vector<double> reactionVals(nPartials);
+	network->computeAllPartials(concentrations.data(), reactionStartingIdx,
+			reactionIndices, reactionVals, 0);
+
+	// Check all the values
+	for (int i = 0; i < nPartials; i++) {
+		BOOST_REQUIRE_CLOSE(knownVals[i], reactionVals[i], 0.0001);
+	}
+
+	return;
+}
+
+/**
+ * This operation checks that the fluxes and partial derivatives are the same
+ * once the reaction table is shared on the node.
+ */
+BOOST_AUTO_TEST_CASE(checkSharedReactionTable) {
+	// Generate the grouped network
+	auto network = getGroupedPSIReactionNetwork();
+	// Add a grid point for the rates
+	network->addGridPoints(1);
+
+	// Set the temperature in the network
+	double temperature = 1000.0;
+	network->setTemperature(temperature, 0);
+	// Recompute Ids and network size and redefine the connectivities
+	network->reinitializeConnectivities();
+
+	// The table can only be shared once the partials positions are set
+	BOOST_REQUIRE(!network->shareOnNode(MPI_COMM_WORLD));
+
+	// Set up the network to be able to compute the partial derivatives
+	std::vector<int> reactionSize, reactionIndices;
+	std::vector<size_t> reactionStartingIdx;
+	auto nPartials = initPartials(*network, reactionSize, reactionStartingIdx,
+			reactionIndices);
+	const int dof = network->getDOF();
+
+	// Set different concentrations and moments everywhere
+	std::vector<double> concentrations(dof, 0.0);
+	for (int i = 0; i < dof - 1; i++) {
+		concentrations[i] = 0.5 + 0.01 * (double) i;
+	}
+
+	// Compute the fluxes and partials with the private table
+	std::vector<double> knownFluxes(dof, 0.0);
+	network->computeAllFluxes(concentrations.data(), knownFluxes.data(), 0);
+	std::vector<double> knownVals(nPartials);
+	network->computeAllPartials(concentrations.data(), reactionStartingIdx,
+			reactionIndices, knownVals, 0);
+
+	// Share it and compute them again
+	BOOST_REQUIRE(network->shareOnNode(MPI_COMM_WORLD));
+	std::vector<double> fluxes(dof, 0.0);
+	network->computeAllFluxes(concentrations.data(), fluxes.data(), 0);
+	std::vector<double> vals(nPartials);
+	network->computeAllPartials(concentrations.data(), reactionStartingIdx,
+			reactionIndices, vals, 0);
+
+	// The values are exactly the same
+	for (int i = 0; i < dof; i++) {
+		BOOST_REQUIRE_EQUAL(knownFluxes[i], fluxes[i]);
+	}
+	for (int i = 0; i < nPartials; i++) {
+		BOOST_REQUIRE_EQUAL(knownVals[i], vals[i]);
+	}
+
+	// Release the shared memory, the table is copied back
+	network->releaseShared();
+	std::fill(fluxes.begin(), fluxes.end(), 0.0);
+	network->computeAllFluxes(concentrations.data(), fluxes.data(), 0);
+	network->computeAllPartials(concentrations.data(), reactionStartingIdx,
+			reactionIndices, vals, 0);
+	for (int i = 0; i < dof; i++) {
+		BOOST_REQUIRE_EQUAL(knownFluxes[i], fluxes[i]);
+	}
+	for (int i = 0; i < nPartials; i++) {
+		BOOST_REQUIRE_EQUAL(knownVals[i], vals[i]);
+	}
+
+	// It can be shared again
+	BOOST_REQUIRE(network->shareOnNode(MPI_COMM_WORLD));
+	network->releaseShared();
+
+	return;
+}
+
+/**
+ * This operation checks that the clusters are found from their composition
+ * once the network is indexed.
+ */
+BOOST_AUTO_TEST_CASE(checkClusterIndex) {
+	// Generate the grouped network
+	auto network = getGroupedPSIReactionNetwork();
+
+	// Every normal cluster is found from its composition
+	for (IReactant& reactant : network->getAll()) {
+		if (reactant.getType() == ReactantType::PSISuper)
+			continue;
+		BOOST_REQUIRE_EQUAL(
+				network->get(reactant.getType(), reactant.getComposition()),
+				&reactant);
+	}
+
+	// Every composition grouped in a super cluster gives this super cluster
+	int nGrouped = 0;
+	for (auto const& superMapItem : network->getAll(ReactantType::PSISuper)) {
+		auto& cluster = static_cast<PSISuperCluster&>(*(superMapItem.second));
+		for (auto nHe : cluster.getBounds(0)) {
+			for (auto nV : cluster.getBounds(3)) {
+				if (!cluster.isIn(nHe, 0, 0, nV))
+					continue;
+				BOOST_REQUIRE_EQUAL(network->getSuperFromComp(nHe, 0, 0, nV),
+						&cluster);
+				// And is not a normal cluster
+				IReactant::Composition comp;
+				comp[toCompIdx(Species::He)] = nHe;
+				comp[toCompIdx(Species::V)] = nV;
+				BOOST_REQUIRE(!network->get(ReactantType::PSIMixed, comp));
+				nGrouped++;
+			}
+		}
+	}
+	BOOST_REQUIRE(nGrouped > 0);
+
+	// Normal clusters and compositions outside of the network have no super
+	BOOST_REQUIRE(!network->getSuperFromComp(1, 0, 0, 1));
+	BOOST_REQUIRE(!network->getSuperFromComp(1000, 0, 0, 1000));
+	IReactant::Composition comp;
+	comp[toCompIdx(Species::He)] = 1000;
+	BOOST_REQUIRE(!network->get(ReactantType::He, comp));
+
+	return;
+}
+
 /**
  * This operation checks the PSISuperCluster get*PartialDerivatives methods.
  */
@@ -151,7 +379,6 @@ BOOST_AUTO_TEST_CASE(checkPartialDerivatives) {
 	paramFile.close();
 
 	// Create a fake command line to read the options
-	int argc = 0;
 	char **argv;
 	argv = new char*[2];
 	std::string parameterFile = "param.txt";
@@ -239,7 +466,6 @@ BOOST_AUTO_TEST_CASE(checkReactionRadius) {
 	paramFile.close();
 
 	// Create a fake command line to read the options
-	int argc = 0;
 	char **argv;
 	argv = new char*[2];
 	std::string parameterFile = "param.txt";
@@ -338,7 +564,6 @@ BOOST_AUTO_TEST_CASE(checkBoundaries) {
 	paramFile.close();
 
 	// Create a fake command line to read the options
-	int argc = 0;
 	char **argv;
 	argv = new char*[2];
 	std::string parameterFile = "param.txt";
@@ -385,9 +610,6 @@ BOOST_AUTO_TEST_CASE(checkBoundaries) {
 	std::string tempFile = "param.txt";
 	std::remove(tempFile.c_str());
 
-	// Finalize MPI
-	MPI_Finalize();
-
 	return;
 }
 
@@ -0,0 +1,87 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Regression
+
+#include <boost/test/unit_test.hpp>
+#include <RateConstants.h>
+
+using namespace std;
+using namespace xolotlCore;
+
+/**
+ * This suite is responsible for testing the RateConstants.
+ */BOOST_AUTO_TEST_SUITE(RateConstants_testSuite)
+
+/**
+ * This operation checks that the rates are kept when rates are added.
+ */
+BOOST_AUTO_TEST_CASE(checkAddRate) {
+	// Create the storage with 3 grid points
+	RateConstants rates;
+	rates.addGridPoints(3);
+	BOOST_REQUIRE_EQUAL(rates.getNumGridPoints(), 3);
+	BOOST_REQUIRE_EQUAL(rates.getNumRates(), 0);
+
+	// Add rates, more than the padding
+	for (int r = 0; r < 20; r++) {
+		BOOST_REQUIRE_EQUAL(rates.addRate(), r);
+		// Set the new rate at each grid point
+		for (int i = 0; i < 3; i++) {
+			rates.getRow(i)[r] = 100.0 * i + r;
+		}
+	}
+	BOOST_REQUIRE_EQUAL(rates.getNumRates(), 20);
+
+	// Check all the values
+	for (int i = 0; i < 3; i++) {
+		for (int r = 0; r < 20; r++) {
+			BOOST_REQUIRE_EQUAL(rates.get(i, r), 100.0 * i + r);
+		}
+	}
+
+	return;
+}
+
+/**
+ * This operation checks adding and removing grid points at the beginning.
+ */
+BOOST_AUTO_TEST_CASE(checkAddGridPoints) {
+	// Create the storage with 2 rates and 2 grid points
+	RateConstants rates;
+	rates.addRate();
+	rates.addRate();
+	rates.addGridPoints(2);
+	for (int i = 0; i < 2; i++) {
+		rates.getRow(i)[0] = 1.0 + i;
+		rates.getRow(i)[1] = 10.0 + i;
+	}
+
+	// Add grid points one at a time, the previous ones are shifted
+	for (int n = 1; n <= 5; n++) {
+		rates.addGridPoints(1);
+		BOOST_REQUIRE_EQUAL(rates.getNumGridPoints(), 2 + n);
+		BOOST_REQUIRE_EQUAL(rates.get(0, 0), 0.0);
+		BOOST_REQUIRE_EQUAL(rates.get(0, 1), 0.0);
+		BOOST_REQUIRE_EQUAL(rates.get(n, 0), 1.0);
+		BOOST_REQUIRE_EQUAL(rates.get(n + 1, 1), 11.0);
+	}
+
+	// Remove the new grid points
+	rates.addGridPoints(-5);
+	BOOST_REQUIRE_EQUAL(rates.getNumGridPoints(), 2);
+	BOOST_REQUIRE_EQUAL(rates.get(0, 0), 1.0);
+	BOOST_REQUIRE_EQUAL(rates.get(1, 1), 11.0);
+
+	// Add them again, they are reset
+	rates.addGridPoints(3);
+	BOOST_REQUIRE_EQUAL(rates.getNumGridPoints(), 5);
+	for (int i = 0; i < 3; i++) {
+		BOOST_REQUIRE_EQUAL(rates.get(i, 0), 0.0);
+		BOOST_REQUIRE_EQUAL(rates.get(i, 1), 0.0);
+	}
+	BOOST_REQUIRE_EQUAL(rates.get(3, 0), 1.0);
+	BOOST_REQUIRE_EQUAL(rates.get(4, 1), 11.0);
+
+	return;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,70 @@
+#include "ReactionTestUtils.h"
+#include <PSIClusterNetworkLoader.h>
+#include <DummyHandlerRegistry.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+using namespace xolotlCore;
+
+namespace testUtils {
+
+void readOptions(Options& opts, const std::string& params) {
+	// Create the parameter file
+	std::string fileName = "param.txt";
+	std::ofstream paramFile(fileName);
+	paramFile << params;
+	paramFile.close();
+
+	// Create a fake command line to read the options
+	char *argv[2];
+	argv[0] = new char[fileName.length() + 1];
+	strcpy(argv[0], fileName.c_str());
+	argv[1] = 0; // null-terminate the array
+	opts.readParams(argv);
+	delete[] argv[0];
+
+	// Remove the created file
+	std::remove(fileName.c_str());
+
+	return;
+}
+
+std::unique_ptr<IReactionNetwork> getGroupedPSIReactionNetwork() {
+	// Read the options
+	Options opts;
+	readOptions(opts, "netParam=8 0 0 5 0\ngrid=100 0.5\n");
+
+	// Create the loader
+	PSIClusterNetworkLoader loader = PSIClusterNetworkLoader(
+			std::make_shared<xolotlPerf::DummyHandlerRegistry>());
+	// Set grouping parameters
+	loader.setVMin(4);
+	loader.setWidth(4, 0);
+	loader.setWidth(1, 3);
+
+	// Generate the network from the options
+	return loader.generate(opts);
+}
+
+size_t initPartials(IReactionNetwork& network, std::vector<int>& reactionSize,
+		std::vector<size_t>& reactionStartingIdx,
+		std::vector<int>& reactionIndices) {
+	// The diagonal fill sets the positions of the partials in the network
+	IReactionNetwork::SparseFillMap dfill;
+	network.getDiagonalFill(dfill);
+
+	// Size the arrays
+	const int dof = network.getDOF();
+	reactionSize.resize(dof);
+	reactionStartingIdx.resize(dof);
+	auto nPartials = network.initPartialsSizes(reactionSize,
+			reactionStartingIdx);
+	reactionIndices.resize(nPartials);
+	network.initPartialsIndices(reactionSize, reactionStartingIdx,
+			reactionIndices);
+
+	return nPartials;
+}
+
+} /* end namespace testUtils */
@@ -0,0 +1,47 @@
+#ifndef REACTIONTESTUTILS_H_
+#define REACTIONTESTUTILS_H_
+
+#include <IReactionNetwork.h>
+#include <Options.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace testUtils {
+
+/**
+ * This operation reads the options from a parameter file with the given
+ * content, the same way they are read from the command line. The parameter
+ * file is removed once it is read.
+ *
+ * @param opts The options to set
+ * @param params The content of the parameter file
+ */
+void readOptions(xolotlCore::Options& opts, const std::string& params);
+
+/**
+ * This operation generates the PSI network with super clusters used for
+ * testing: He up to 8 and V up to 5 on a grid of 100 points, grouped from
+ * 4 V with a width of 4 in He and 1 in V.
+ *
+ * @return The reaction network.
+ */
+std::unique_ptr<xolotlCore::IReactionNetwork> getGroupedPSIReactionNetwork();
+
+/**
+ * This operation sets up the network to compute the partial derivatives
+ * of all the reactions at once, the way the solver does.
+ *
+ * @param network The network
+ * @param reactionSize The number of partial derivatives of each DOF
+ * @param reactionStartingIdx The position of the first partial derivative
+ * of each DOF
+ * @param reactionIndices The column of each partial derivative
+ * @return The number of partial derivatives
+ */
+size_t initPartials(xolotlCore::IReactionNetwork& network,
+		std::vector<int>& reactionSize, std::vector<size_t>& reactionStartingIdx,
+		std::vector<int>& reactionIndices);
+
+} /* end namespace testUtils */
+#endif
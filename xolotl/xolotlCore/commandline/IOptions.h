@@ -702,6 +702,111 @@ public:
 	 */
 	virtual bool printRNGSeed(void) const = 0;
 
+	/**
+	 * Obtain the width of the temperature buckets sharing the same
+	 * rate constants in the network.
+	 *
+	 * @return The tolerance in K
+	 */
+	virtual double getRateCacheTolerance() const = 0;
+
+	/**
+	 * Set the width of the temperature buckets sharing the same
+	 * rate constants in the network.
+	 *
+	 * @param tolerance The tolerance in K
+	 */
+	virtual void setRateCacheTolerance(double tolerance) = 0;
+
+	/**
+	 * Should the concentrations be written as dense compressed datasets
+	 * instead of ragged ones?
+	 *
+	 * @return True for the dense format
+	 */
+	virtual bool useDenseConcentrations() const = 0;
+
+	/**
+	 * Choose the format of the concentrations.
+	 *
+	 * @param isDense True for the dense format
+	 */
+	virtual void setDenseConcentrations(bool isDense) = 0;
+
+	/**
+	 * Obtain the deflate level of the dense concentrations.
+	 *
+	 * @return The level, 0 to 9
+	 */
+	virtual int getConcCompressionLevel() const = 0;
+
+	/**
+	 * Set the deflate level of the dense concentrations.
+	 *
+	 * @param level The level, 0 to 9
+	 */
+	virtual void setConcCompressionLevel(int level) = 0;
+
+	/**
+	 * Obtain the number of mantissa bits kept in the dense concentrations.
+	 *
+	 * @return The number of bits, 52 to keep the full precision
+	 */
+	virtual int getConcMantissaBits() const = 0;
+
+	/**
+	 * Set the number of mantissa bits kept in the dense concentrations.
+	 *
+	 * @param bits The number of bits, 52 to keep the full precision
+	 */
+	virtual void setConcMantissaBits(int bits) = 0;
+
+	/**
+	 * Obtain the directory where the generated networks are cached.
+	 *
+	 * @return The directory, empty if the networks are not cached
+	 */
+	virtual std::string getNetworkCacheDir() const = 0;
+
+	/**
+	 * Set the directory where the generated networks are cached.
+	 *
+	 * @param dir The directory
+	 */
+	virtual void setNetworkCacheDir(const std::string& dir) = 0;
+
+	/**
+	 * Should the network be built by the master process only and broadcast
+	 * to the other processes?
+	 *
+	 * @return True if the network is broadcast
+	 */
+	virtual bool broadcastNetwork() const = 0;
+
+	/**
+	 * Choose if the network is built by the master process only and
+	 * broadcast to the other processes.
+	 *
+	 * @param flag True to broadcast the network
+	 */
+	virtual void setBroadcastNetwork(bool flag) = 0;
+
+	/**
+	 * Obtain the base name of the files where the performance timeline
+	 * is written.
+	 *
+	 * @return The name, empty if the timeline is not recorded
+	 */
+	virtual std::string getPerfTraceName() const = 0;
+
+	/**
+	 * Set the base name of the files where the performance timeline
+	 * is written.
+	 *
+	 * @param name The name
+	 */
+	virtual void setPerfTraceName(const std::string& name) = 0;
+
 };
 //end class IOptions
 
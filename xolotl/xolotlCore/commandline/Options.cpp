@@ -1,6 +1,7 @@
 #include <cassert>
 #include <limits>
 #include <fstream>
+#include <cstring>
 #include <TokenizedLineReader.h>
 #include <NetworkOptionHandler.h>
 #include <PetscOptionHandler.h>
@@ -26,6 +27,11 @@
 #include <BurstingDepthOptionHandler.h>
 #include <RNGOptionHandler.h>
 #include <EStoppingPowerOptionHandler.h>
+#include <RateCacheOptionHandler.h>
+#include <ConcFormatOptionHandler.h>
+#include <NetworkCacheOptionHandler.h>
+#include <NetworkBroadcastOptionHandler.h>
+#include <PerfTraceOptionHandler.h>
 #include "Options.h"
 
 namespace xolotlCore {
@@ -45,7 +51,9 @@ Options::Options() :
 				10), nY(0), nZ(0), xStepSize(0.5), yStepSize(0.0), zStepSize(
 				0.0), leftBoundary(1), rightBoundary(1), bottomBoundary(1), topBoundary(
 				1), frontBoundary(1), backBoundary(1), burstingDepth(10.0), rngUseSeed(
-				false), rngSeed(0), rngPrintSeed(false), zeta(0.73) {
+				false), rngSeed(0), rngPrintSeed(false), zeta(0.73), rateCacheTolerance(0.0), denseConcs(
+				false), concCompressionLevel(6), concMantissaBits(52), networkCacheDir(""), networkBroadcastFlag(
+				false), perfTraceName("") {
 
 	// Create the network option handler
 	auto networkHandler = new NetworkOptionHandler();
@@ -95,6 +103,16 @@ Options::Options() :
 	auto rngHandler = new RNGOptionHandler();
 	// Create handler for the electronic stopping power options.
 	auto espHandler = new EStoppingPowerOptionHandler();
+	// Create handler for the rate constant cache tolerance.
+	auto rateCacheHandler = new RateCacheOptionHandler();
+	// Create handler for the format of the concentrations.
+	auto concFormatHandler = new ConcFormatOptionHandler();
+	// Create handler for the cache of generated networks.
+	auto networkCacheHandler = new NetworkCacheOptionHandler();
+	// Create handler for the broadcast of the network.
+	auto networkBroadcastHandler = new NetworkBroadcastOptionHandler();
+	// Create handler for the performance timeline.
+	auto perfTraceHandler = new PerfTraceOptionHandler();
 
 	// Add our notion of which options we support.
 	optionsMap[networkHandler->key] = networkHandler;
@@ -121,6 +139,11 @@ Options::Options() :
 	optionsMap[burstingHandler->key] = burstingHandler;
 	optionsMap[rngHandler->key] = rngHandler;
 	optionsMap[espHandler->key] = espHandler;
+	optionsMap[rateCacheHandler->key] = rateCacheHandler;
+	optionsMap[concFormatHandler->key] = concFormatHandler;
+	optionsMap[networkCacheHandler->key] = networkCacheHandler;
+	optionsMap[networkBroadcastHandler->key] = networkBroadcastHandler;
+	optionsMap[perfTraceHandler->key] = perfTraceHandler;
 }
 
 Options::~Options(void) {
@@ -211,6 +234,30 @@ void Options::readParams(char* argv[]) {
 		line = reader.loadLine();
 	}
 
+	// The -active_window PETSc option depends on other options that can be
+	// given in any order, so it is checked once they are all read. The
+	// window is moved through a checkpoint, hence -start_stop.
+	bool activeWindow = false, startStop = false;
+	for (int i = 1; i < petscArgc; ++i) {
+		if (strcmp(petscArgv[i], "-active_window") == 0)
+			activeWindow = true;
+		if (strcmp(petscArgv[i], "-start_stop") == 0)
+			startStop = true;
+	}
+	if (shouldRunFlag && activeWindow) {
+		auto process = processMap.find("movingSurface");
+		bool movingSurface = (process != processMap.end() && process->second);
+		if (dimensionNumber != 1 || !movingSurface || !denseConcs
+				|| !startStop) {
+			std::cerr
+					<< "\nOption: -active_window needs a 1D grid, the movingSurface "
+							"process, concFormat=dense, and -start_stop."
+					<< std::endl;
+			shouldRunFlag = false;
+			exitCode = EXIT_FAILURE;
+		}
+	}
+
 	return;
 }
 
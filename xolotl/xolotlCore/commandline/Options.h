@@ -256,6 +256,41 @@ protected:
 	 */
 	bool rngPrintSeed;
 
+	/**
+	 * Width in K of the temperature buckets sharing the same rate constants.
+	 */
+	double rateCacheTolerance;
+
+	/**
+	 * Are the concentrations written as dense compressed datasets?
+	 */
+	bool denseConcs;
+
+	/**
+	 * The deflate level of the dense concentrations.
+	 */
+	int concCompressionLevel;
+
+	/**
+	 * The number of mantissa bits kept in the dense concentrations.
+	 */
+	int concMantissaBits;
+
+	/**
+	 * The directory where the generated networks are cached.
+	 */
+	std::string networkCacheDir;
+
+	/**
+	 * Should the network be built by the master process and broadcast?
+	 */
+	bool networkBroadcastFlag;
+
+	/**
+	 * The base name of the performance timeline files.
+	 */
+	std::string perfTraceName;
+
 public:
 
 	/**
@@ -1061,6 +1096,120 @@ public:
 		return rngPrintSeed;
 	}
 
+	/**
+	 * Obtain the width of the temperature buckets sharing the same
+	 * rate constants in the network.
+	 * \see IOptions.h
+	 */
+	double getRateCacheTolerance() const override {
+		return rateCacheTolerance;
+	}
+
+	/**
+	 * Set the width of the temperature buckets sharing the same
+	 * rate constants in the network.
+	 * \see IOptions.h
+	 */
+	void setRateCacheTolerance(double tolerance) override {
+		rateCacheTolerance = tolerance;
+	}
+
+	/**
+	 * Should the concentrations be written as dense compressed datasets?
+	 * \see IOptions.h
+	 */
+	bool useDenseConcentrations() const override {
+		return denseConcs;
+	}
+
+	/**
+	 * Choose the format of the concentrations.
+	 * \see IOptions.h
+	 */
+	void setDenseConcentrations(bool isDense) override {
+		denseConcs = isDense;
+	}
+
+	/**
+	 * Obtain the deflate level of the dense concentrations.
+	 * \see IOptions.h
+	 */
+	int getConcCompressionLevel() const override {
+		return concCompressionLevel;
+	}
+
+	/**
+	 * Set the deflate level of the dense concentrations.
+	 * \see IOptions.h
+	 */
+	void setConcCompressionLevel(int level) override {
+		concCompressionLevel = level;
+	}
+
+	/**
+	 * Obtain the number of mantissa bits kept in the dense concentrations.
+	 * \see IOptions.h
+	 */
+	int getConcMantissaBits() const override {
+		return concMantissaBits;
+	}
+
+	/**
+	 * Set the number of mantissa bits kept in the dense concentrations.
+	 * \see IOptions.h
+	 */
+	void setConcMantissaBits(int bits) override {
+		concMantissaBits = bits;
+	}
+
+	/**
+	 * Obtain the directory where the generated networks are cached.
+	 * \see IOptions.h
+	 */
+	std::string getNetworkCacheDir() const override {
+		return networkCacheDir;
+	}
+
+	/**
+	 * Set the directory where the generated networks are cached.
+	 * \see IOptions.h
+	 */
+	void setNetworkCacheDir(const std::string& dir) override {
+		networkCacheDir = dir;
+	}
+
+	/**
+	 * Should the network be built by the master process and broadcast?
+	 * \see IOptions.h
+	 */
+	bool broadcastNetwork() const override {
+		return networkBroadcastFlag;
+	}
+
+	/**
+	 * Choose if the network is built by the master process and broadcast.
+	 * \see IOptions.h
+	 */
+	void setBroadcastNetwork(bool flag) override {
+		networkBroadcastFlag = flag;
+	}
+
+	/**
+	 * Obtain the base name of the performance timeline files.
+	 * \see IOptions.h
+	 */
+	std::string getPerfTraceName() const override {
+		return perfTraceName;
+	}
+
+	/**
+	 * Set the base name of the performance timeline files.
+	 * \see IOptions.h
+	 */
+	void setPerfTraceName(const std::string& name) override {
+		perfTraceName = name;
+	}
+
 };
 //end class Options
 
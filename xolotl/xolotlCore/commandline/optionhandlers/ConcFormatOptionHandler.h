@@ -0,0 +1,92 @@
+#ifndef CONCFORMATOPTIONHANDLER_H
+#define CONCFORMATOPTIONHANDLER_H
+
+// Includes
+#include "OptionHandler.h"
+
+namespace xolotlCore {
+
+/**
+ * ConcFormatOptionHandler handles the layout of the concentrations in the
+ * HDF5 checkpoint file.
+ */
+class ConcFormatOptionHandler: public OptionHandler {
+public:
+
+	/**
+	 * The default constructor
+	 */
+	ConcFormatOptionHandler() :
+			OptionHandler("concFormat",
+					"concFormat <format> [<level> <bits>]\n"
+							"                                    This option allows the user to choose how the "
+							"concentrations are written: \"ragged\" (default) keeps the non-zero "
+							"(index, value) pairs,\n"
+							"                                    \"dense\" writes every value in chunks "
+							"compressed with the given deflate level (0 to 9, 6 by default)\n"
+							"                                    after keeping the given number of mantissa "
+							"bits (1 to 52, 52 by default is lossless).\n") {
+	}
+
+	/**
+	 * The destructor
+	 */
+	~ConcFormatOptionHandler() {
+	}
+
+	/**
+	 * This method will set the IOptions concentration format
+	 * to the value given as the argument.
+	 *
+	 * @param opt The pointer to the option that will be modified.
+	 * @param arg The format, and the compression level and precision
+	 * of the dense one.
+	 */
+	bool handler(IOptions *opt, const std::string& arg) {
+
+		// Build an input stream from the argument string.
+		xolotlCore::TokenizedLineReader<std::string> reader;
+		auto argSS = std::make_shared<std::istringstream>(arg);
+		reader.setInputStream(argSS);
+
+		// Break the argument into tokens.
+		auto tokens = reader.loadLine();
+
+		// Check the format and its parameters
+		bool isDense = false;
+		int level = 6, bits = 52;
+		bool isValid = (tokens.size() > 0);
+		if (isValid && tokens[0] == "dense") {
+			isDense = true;
+			if (tokens.size() > 1)
+				level = strtol(tokens[1].c_str(), NULL, 10);
+			if (tokens.size() > 2)
+				bits = strtol(tokens[2].c_str(), NULL, 10);
+			isValid = (level >= 0 && level <= 9 && bits >= 1 && bits <= 52);
+		} else if (isValid) {
+			isValid = (tokens[0] == "ragged" && tokens.size() == 1);
+		}
+
+		if (!isValid) {
+			std::cerr
+					<< "Options: wrong value for the concentration format option handler: "
+					<< arg << std::endl;
+			opt->showHelp(std::cerr);
+			opt->setShouldRunFlag(false);
+			opt->setExitCode(EXIT_FAILURE);
+			return false;
+		}
+
+		opt->setDenseConcentrations(isDense);
+		opt->setConcCompressionLevel(level);
+		opt->setConcMantissaBits(bits);
+
+		return true;
+	}
+
+};
+//end class ConcFormatOptionHandler
+
+} /* namespace xolotlCore */
+
+#endif
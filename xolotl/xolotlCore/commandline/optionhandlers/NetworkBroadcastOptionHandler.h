@@ -0,0 +1,63 @@
+#ifndef NETWORKBROADCASTOPTIONHANDLER_H
+#define NETWORKBROADCASTOPTIONHANDLER_H
+
+// Includes
+#include "OptionHandler.h"
+
+namespace xolotlCore {
+
+/**
+ * NetworkBroadcastOptionHandler handles the choice to build the network
+ * on the master process only and to broadcast it to the other processes.
+ */
+class NetworkBroadcastOptionHandler: public OptionHandler {
+public:
+
+	/**
+	 * The default constructor
+	 */
+	NetworkBroadcastOptionHandler() :
+		OptionHandler("networkBroadcast",
+				"networkBroadcast {yes,  no}       "
+				"Will the network be built by the master process only and "
+				"broadcast to the other ones (no by default)?\n") {}
+
+	/**
+	 * The destructor
+	 */
+	~NetworkBroadcastOptionHandler() {
+	}
+
+	/**
+	 * This method will set the IOptions networkBroadcastFlag
+	 * to the value given as the argument.
+	 *
+	 * @param opt The pointer to the option that will be modified.
+	 * @param arg The argument for the flag.
+	 */
+	bool handler(IOptions *opt, const std::string& arg) {
+		// Determine if the network is broadcast
+		if (arg == "yes") {
+			opt->setBroadcastNetwork(true);
+		}
+		else if (arg == "no") {
+			opt->setBroadcastNetwork(false);
+		}
+		else {
+			std::cerr << "Options: unrecognized argument in the network broadcast option handler: "
+					<< arg << std::endl;
+			opt->showHelp(std::cerr);
+			opt->setShouldRunFlag(false);
+			opt->setExitCode(EXIT_FAILURE);
+			return false;
+		}
+
+		return true;
+	}
+
+};
+//end class NetworkBroadcastOptionHandler
+
+} /* namespace xolotlCore */
+
+#endif
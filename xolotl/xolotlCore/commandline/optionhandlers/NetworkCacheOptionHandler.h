@@ -0,0 +1,52 @@
+#ifndef NETWORKCACHEOPTIONHANDLER_H
+#define NETWORKCACHEOPTIONHANDLER_H
+
+// Includes
+#include "OptionHandler.h"
+
+namespace xolotlCore {
+
+/**
+ * NetworkCacheOptionHandler handles the directory where the generated
+ * networks are cached.
+ */
+class NetworkCacheOptionHandler: public OptionHandler {
+public:
+
+	/**
+	 * The default constructor
+	 */
+	NetworkCacheOptionHandler() :
+			OptionHandler("networkCache",
+					"networkCache <directory>          "
+							"The networks generated from netParam and grouping "
+							"are saved in this directory, and loaded from it by "
+							"the next runs with the same parameters.\n") {
+	}
+
+	/**
+	 * The destructor
+	 */
+	~NetworkCacheOptionHandler() {
+	}
+
+	/**
+	 * This method will set the IOptions networkCacheDir
+	 * to the value given as the argument.
+	 *
+	 * @param opt The pointer to the option that will be modified.
+	 * @param arg The directory.
+	 */
+	bool handler(IOptions *opt, const std::string& arg) {
+		// Set the directory of the cache
+		opt->setNetworkCacheDir(arg);
+
+		return true;
+	}
+
+};
+//end class NetworkCacheOptionHandler
+
+} /* namespace xolotlCore */
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef PERFTRACEOPTIONHANDLER_H
+#define PERFTRACEOPTIONHANDLER_H
+
+// Includes
+#include "OptionHandler.h"
+
+namespace xolotlCore {
+
+/**
+ * PerfTraceOptionHandler handles the name of the timeline files written
+ * by the performance handlers.
+ */
+class PerfTraceOptionHandler: public OptionHandler {
+public:
+
+	/**
+	 * The default constructor
+	 */
+	PerfTraceOptionHandler() :
+			OptionHandler("perfTrace",
+					"perfTrace <name>                  "
+							"Record when each timer starts and stops and when each "
+							"time step ends, and write this timeline to "
+							"<name>_<rank>.json in the Chrome trace event format. "
+							"Needs a perfHandler other than dummy.\n") {
+	}
+
+	/**
+	 * The destructor
+	 */
+	~PerfTraceOptionHandler() {
+	}
+
+	/**
+	 * This method will set the IOptions perfTraceName
+	 * to the value given as the argument.
+	 *
+	 * @param opt The pointer to the option that will be modified.
+	 * @param arg The base name of the files.
+	 */
+	bool handler(IOptions *opt, const std::string& arg) {
+		// Set the name of the timeline files
+		opt->setPerfTraceName(arg);
+
+		return true;
+	}
+
+};
+//end class PerfTraceOptionHandler
+
+} /* namespace xolotlCore */
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef RATECACHEOPTIONHANDLER_H
+#define RATECACHEOPTIONHANDLER_H
+
+// Includes
+#include "OptionHandler.h"
+
+namespace xolotlCore {
+
+/**
+ * RateCacheOptionHandler handles the temperature tolerance of the cache
+ * of rate constants shared by the grid points.
+ */
+class RateCacheOptionHandler: public OptionHandler {
+public:
+
+	/**
+	 * The default constructor
+	 */
+	RateCacheOptionHandler() :
+			OptionHandler("rateCacheTolerance",
+					"rateCacheTolerance <tolerance>    "
+							"This option allows the user to set the width in K "
+							"of the temperature buckets sharing the same rate "
+							"constants (0 by default: only identical temperatures "
+							"share them, a negative value disables the cache).  \n") {
+	}
+
+	/**
+	 * The destructor
+	 */
+	~RateCacheOptionHandler() {
+	}
+
+	/**
+	 * This method will set the IOptions rateCacheTolerance
+	 * to the value given as the argument.
+	 *
+	 * @param opt The pointer to the option that will be modified.
+	 * @param arg The tolerance in K.
+	 */
+	bool handler(IOptions *opt, const std::string& arg) {
+		// Convert to double
+		double tolerance = strtod(arg.c_str(), NULL);
+		// Set the tolerance
+		opt->setRateCacheTolerance(tolerance);
+
+		return true;
+	}
+
+};
+//end class RateCacheOptionHandler
+
+} /* namespace xolotlCore */
+
+#endif
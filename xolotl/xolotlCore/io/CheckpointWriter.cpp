@@ -0,0 +1,142 @@
+#include <cassert>
+#include <cmath>
+#include "hdf5.h"
+#include "xolotlCore/io/CheckpointWriter.h"
+
+namespace xolotlCore {
+
+CheckpointWriter::CheckpointWriter(MPI_Comm _comm, bool requestAsync) :
+		async(false) {
+	// Use our own communicator so that the collective calls of the
+	// background thread can't be mixed with the ones of the solver
+	MPI_Comm_dup(_comm, &comm);
+
+	// The background thread needs to call MPI and HDF5 while the solver
+	// is running
+	int provided = MPI_THREAD_SINGLE;
+	MPI_Query_thread(&provided);
+	async = requestAsync && (provided == MPI_THREAD_MULTIPLE);
+#ifndef H5_HAVE_THREADSAFE
+	async = false;
+#endif
+}
+
+CheckpointWriter::~CheckpointWriter() {
+	// Don't throw from the destructor
+	if (writer.joinable())
+		writer.join();
+
+	MPI_Comm_free(&comm);
+}
+
+double * CheckpointWriter::getBuffer(std::size_t size) {
+	// The previous checkpoint is still using the buffer
+	wait();
+
+	buffer.resize(size);
+
+	return buffer.data();
+}
+
+void CheckpointWriter::write(Checkpoint checkpoint) {
+	// Only one checkpoint at a time
+	wait();
+
+	if (!async) {
+		writeCheckpoint(checkpoint);
+		return;
+	}
+
+	// Write it in the background, keeping the exception for wait()
+	writer = std::thread([this, checkpoint]() {
+		try {
+			writeCheckpoint(checkpoint);
+		} catch (...) {
+			error = std::current_exception();
+		}
+	});
+
+	return;
+}
+
+void CheckpointWriter::wait() {
+	if (writer.joinable())
+		writer.join();
+
+	// Throw the error of the last checkpoint
+	if (error) {
+		auto lastError = error;
+		error = nullptr;
+		std::rethrow_exception(lastError);
+	}
+
+	return;
+}
+
+void CheckpointWriter::writeCheckpoint(const Checkpoint& checkpoint) {
+	// Open the existing HDF5 file
+	XFile checkpointFile(checkpoint.fileName, comm,
+			XFile::AccessMode::OpenReadWrite);
+
+	// Add a concentration time step group for the current time step.
+	auto concGroup = checkpointFile.getGroup<XFile::ConcentrationGroup>();
+	assert(concGroup);
+	auto tsGroup = concGroup->addTimestepGroup(checkpoint.timeStep,
+			checkpoint.time, checkpoint.previousTime, checkpoint.deltaTime);
+
+	// Write the surface and bottom data
+	if (checkpoint.writeGroupData)
+		checkpoint.writeGroupData(*tsGroup);
+
+	const int dof = checkpoint.dof;
+	const int nPoints = checkpoint.size[0] * checkpoint.size[1]
+			* checkpoint.size[2];
+	assert(buffer.size() == nPoints * dof);
+
+	// The dense format is written as it is in the buffer
+	if (checkpoint.format.dense) {
+		tsGroup->writeDenseConcentrations(checkpointFile, checkpoint.gridDims,
+				checkpoint.start, checkpoint.size, dof, buffer.data(),
+				checkpoint.format);
+		return;
+	}
+
+	// Determine the concentration values we will write.
+	// We only keep the non-zero ones of the grid points we own.
+	XFile::TimestepGroup::Concs1DType concs(nPoints);
+	for (auto i = 0; i < nPoints; ++i) {
+
+		// Access the solution data for the current grid point.
+		auto gridPointSolution = buffer.data() + i * dof;
+
+		for (auto l = 0; l < dof; ++l) {
+			if (std::fabs(gridPointSolution[l]) > 1.0e-16) {
+				concs[i].emplace_back(l, gridPointSolution[l]);
+			}
+		}
+	}
+
+	// Write our concentration data to the current timestep group,
+	// in one dataset in 1D and one dataset per grid point otherwise
+	if (checkpoint.dim == 1) {
+		tsGroup->writeConcentrations(checkpointFile, checkpoint.start[0],
+				concs);
+	} else {
+		// The grid points are ordered like the buffer, x first
+		std::vector<std::array<int, 3> > positions;
+		positions.reserve(nPoints);
+		for (auto k = 0; k < checkpoint.size[2]; ++k)
+			for (auto j = 0; j < checkpoint.size[1]; ++j)
+				for (auto i = 0; i < checkpoint.size[0]; ++i) {
+					positions.push_back( { { checkpoint.start[0] + i,
+							checkpoint.start[1] + j,
+							(checkpoint.dim == 3) ?
+									checkpoint.start[2] + k : -1 } });
+				}
+		tsGroup->writeConcentrationDatasets(checkpointFile, positions, concs);
+	}
+
+	return;
+}
+
+} /* namespace xolotlCore */
@@ -0,0 +1,154 @@
+#ifndef XCORE_CHECKPOINTWRITER_H
+#define XCORE_CHECKPOINTWRITER_H
+
+#include <string>
+#include <vector>
+#include <array>
+#include <thread>
+#include <exception>
+#include <functional>
+#include "mpi.h"
+#include "xolotlCore/io/XFile.h"
+
+namespace xolotlCore {
+
+/**
+ * This class writes the concentration checkpoints of the solver to an
+ * existing XFile. The local solution is copied in a buffer that is kept
+ * between checkpoints and the file is written from this copy, in a
+ * background thread when possible so that the solver does not wait for it.
+ *
+ * The background thread does all the (collective) HDF5 calls of a checkpoint
+ * on its own duplicate of the communicator, which requires an MPI library
+ * initialized with MPI_THREAD_MULTIPLE and a thread-safe HDF5 library.
+ * Otherwise the checkpoint is written before write() returns. The caller must
+ * not use HDF5 itself while a checkpoint is written in the background, the
+ * collective calls of both threads could wait on each other.
+ *
+ * Only one checkpoint is written at a time: the buffer is only given for the
+ * next one once the previous one is in the file.
+ */
+class CheckpointWriter {
+public:
+
+	/**
+	 * The function writing the small data of a time step group (surface,
+	 * bottom), called by the writer once the group is created. It must
+	 * only use copies of the data of the solver.
+	 */
+	using GroupWriter = std::function<void(XFile::TimestepGroup&)>;
+
+	/**
+	 * Everything the writer needs to know about one checkpoint, beside the
+	 * concentrations in the buffer.
+	 */
+	struct Checkpoint {
+		//! The name of the existing file
+		std::string fileName;
+		//! The number of the time step
+		int timeStep = 0;
+		//! The physical time at this time step
+		double time = 0.0;
+		//! The physical time at the previous time step
+		double previousTime = 0.0;
+		//! The physical length of the time step
+		double deltaTime = 0.0;
+		//! The number of dimensions of the grid, 1 to 3
+		int dim = 1;
+		//! The number of grid points of the whole grid in each direction
+		std::array<int, 3> gridDims { { 1, 1, 1 } };
+		//! The first grid point we own in each direction
+		std::array<int, 3> start { { 0, 0, 0 } };
+		//! The number of grid points we own in each direction
+		std::array<int, 3> size { { 1, 1, 1 } };
+		//! The number of degrees of freedom at each grid point
+		int dof = 0;
+		//! The format of the concentrations in the file
+		XFile::TimestepGroup::ConcsFormat format;
+		//! Writes the small data of the time step group
+		GroupWriter writeGroupData;
+	};
+
+private:
+
+	//! The duplicate of the communicator of the solver used to write
+	MPI_Comm comm;
+
+	//! Are the checkpoints written in the background?
+	bool async;
+
+	//! The local solution, grid point after grid point (x first)
+	std::vector<double> buffer;
+
+	//! The thread writing the last checkpoint
+	std::thread writer;
+
+	//! The exception that stopped the last checkpoint, if any
+	std::exception_ptr error;
+
+	/**
+	 * Write a checkpoint from the buffer.
+	 *
+	 * @param checkpoint The description of the checkpoint
+	 */
+	void writeCheckpoint(const Checkpoint& checkpoint);
+
+public:
+
+	/**
+	 * Default and copy constructors, deleted to prevent use.
+	 */
+	CheckpointWriter() = delete;
+	CheckpointWriter(const CheckpointWriter& other) = delete;
+
+	/**
+	 * The constructor.
+	 *
+	 * @param _comm The communicator of the solver, collective call
+	 * @param requestAsync Should the checkpoints be written in the
+	 * background if the MPI and HDF5 libraries allow it?
+	 */
+	CheckpointWriter(MPI_Comm _comm, bool requestAsync);
+
+	/**
+	 * The destructor. It waits for the last checkpoint, it must be called
+	 * before MPI is finalized.
+	 */
+	~CheckpointWriter();
+
+	/**
+	 * Are the checkpoints written in the background?
+	 *
+	 * @return True if write() returns before the file is written
+	 */
+	bool isAsync() const {
+		return async;
+	}
+
+	/**
+	 * Get the buffer where the local solution must be copied before calling
+	 * write(). It waits for the previous checkpoint to be written.
+	 *
+	 * @param size The number of values of the local solution
+	 * @return The pointer to the buffer
+	 */
+	double * getBuffer(std::size_t size);
+
+	/**
+	 * Write the checkpoint from the content of the buffer. It is a
+	 * collective call and every process must write the same checkpoints.
+	 *
+	 * @param checkpoint The description of the checkpoint
+	 */
+	void write(Checkpoint checkpoint);
+
+	/**
+	 * Wait for the last checkpoint to be written. The exception that
+	 * stopped it, if any, is thrown again here.
+	 */
+	void wait();
+};
+
+} /* namespace xolotlCore */
+
+#endif
@@ -2,6 +2,9 @@
 #include <sstream>
 #include <iterator>
 #include <array>
+#include <numeric>
+#include <cstring>
+#include <cstdint>
 #include "hdf5.h"
 #include "mpi.h"
 #include "xolotlCore/io/XFile.h"
@@ -222,6 +225,165 @@ const fs::path XFile::NetworkGroup::path = "/networkGroup";
 const std::string XFile::NetworkGroup::normalSizeAttrName = "normalSize";
 const std::string XFile::NetworkGroup::superSizeAttrName = "superSize";
 const std::string XFile::NetworkGroup::phaseSpaceAttrName = "phaseSpace";
+const std::string XFile::NetworkGroup::compositionsDataName = "compositions";
+const std::string XFile::NetworkGroup::energiesDataName = "energies";
+const std::string XFile::NetworkGroup::heVOffsetsDataName = "heVOffsets";
+const std::string XFile::NetworkGroup::heVListDataName = "heVList";
+const std::string XFile::NetworkGroup::boundsDataName = "bounds";
+const std::string XFile::NetworkGroup::nePropertiesDataName = "neProperties";
+const std::array<std::string, 4> XFile::NetworkGroup::reactionPrefixes { {
+		"prod", "comb", "disso", "emit" } };
+const std::string XFile::NetworkGroup::offsetsDataSuffix = "Offsets";
+const std::string XFile::NetworkGroup::widthsDataSuffix = "Widths";
+const std::string XFile::NetworkGroup::dataSuffix = "Data";
+
+namespace {
+
+/**
+ * Write a whole table in a new dataset.
+ *
+ * @param locId The group where to create the dataset.
+ * @param name The name of the dataset.
+ * @param fileType The type of the values in the file.
+ * @param memType The type of the values in memory.
+ * @param dims The dimensions of the table.
+ * @param data The values, row after row.
+ */
+template<uint32_t Rank>
+void writeTable(hid_t locId, const std::string& name, hid_t fileType,
+		hid_t memType, const std::array<hsize_t, Rank>& dims,
+		const void* data) {
+	XFile::SimpleDataSpace<Rank> dspace(dims);
+	hid_t datasetId = H5Dcreate2(locId, name.c_str(), fileType,
+			dspace.getId(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+	if (datasetId < 0) {
+		throw HDF5Exception("Failed to create network dataset " + name);
+	}
+
+	// Empty tables have no buffer
+	hsize_t nValues = 1;
+	for (auto dim : dims)
+		nValues *= dim;
+	if (nValues > 0)
+		H5Dwrite(datasetId, memType, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+	H5Dclose(datasetId);
+
+	return;
+}
+
+/**
+ * Read a whole table from an existing dataset.
+ *
+ * @param locId The group of the dataset.
+ * @param name The name of the dataset.
+ * @param memType The type of the values in memory.
+ * @param dims The dimensions of the table.
+ * @return The values, row after row.
+ */
+template<typename T, uint32_t Rank>
+std::vector<T> readTable(hid_t locId, const std::string& name, hid_t memType,
+		std::array<hsize_t, Rank>& dims) {
+	hid_t datasetId = H5Dopen(locId, name.c_str(), H5P_DEFAULT);
+	if (datasetId < 0) {
+		throw HDF5Exception("Failed to open network dataset " + name);
+	}
+	hid_t dataspaceId = H5Dget_space(datasetId);
+	H5Sget_simple_extent_dims(dataspaceId, dims.data(), nullptr);
+	H5Sclose(dataspaceId);
+
+	hsize_t nValues = 1;
+	for (auto dim : dims)
+		nValues *= dim;
+	std::vector<T> values(nValues);
+	if (nValues > 0)
+		H5Dread(datasetId, memType, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+				values.data());
+	H5Dclose(datasetId);
+
+	return values;
+}
+
+/**
+ * Add the reactions of one kind of a cluster to the network.
+ *
+ * @param network The network that need the reactions.
+ * @param cluster The cluster that needs reactions.
+ * @param kind The kind of reactions: production, combination, dissociation
+ * or emission.
+ * @param table The reactions of this kind.
+ * @param id The index of the cluster in the table.
+ */
+void addClusterReactions(IReactionNetwork& network, IReactant& cluster,
+		int kind, XFile::NetworkGroup::ReactionTable& table, int id) {
+	// Get all the reactants
+	auto& allReactants = network.getAll();
+
+	int width = table.widths[id];
+	for (auto row = table.offsets[id]; row < table.offsets[id + 1]; row +=
+			width) {
+		double *values = table.data.data() + row;
+		switch (kind) {
+		case 0: {
+			// Get pointers to the 2 reactants
+			auto& firstReactant = allReactants.at(values[0]);
+			auto& secondReactant = allReactants.at(values[1]);
+
+			// Create and add the reaction to the network
+			auto& prref = network.addProductionReaction(firstReactant,
+					secondReactant);
+
+			// Add the reaction to the cluster
+			cluster.resultFrom(prref, values + 2);
+			break;
+		}
+		case 1: {
+			// Get pointers to the combining reactant
+			auto& firstReactant = allReactants.at(values[0]);
+
+			// Create and add the reaction to the network
+			auto& prref = network.addProductionReaction(firstReactant, cluster);
+
+			// Add the reaction to the cluster
+			cluster.participateIn(prref, values + 1);
+			break;
+		}
+		case 2: {
+			// Get pointers to the other reactants
+			auto& emittingReactant = allReactants.at(values[0]);
+			auto& secondReactant = allReactants.at(values[1]);
+
+			// Create and add the reaction to the network
+			auto& prref = network.addProductionReaction(cluster,
+					secondReactant);
+			auto& drref = network.addDissociationReaction(emittingReactant,
+					prref.first, prref.second, &prref);
+
+			// Add the reaction to the cluster
+			cluster.participateIn(drref, values + 2);
+			break;
+		}
+		default: {
+			// Get pointers to the other reactants
+			auto& firstReactant = allReactants.at(values[0]);
+			auto& secondReactant = allReactants.at(values[1]);
+
+			// Create and add the reaction to the network
+			auto& prref = network.addProductionReaction(firstReactant,
+					secondReactant);
+			auto& drref = network.addDissociationReaction(cluster, prref.first,
+					prref.second, &prref);
+
+			// Add the reaction to the cluster
+			cluster.emitFrom(drref, values + 2);
+			break;
+		}
+		}
+	}
+
+	return;
+}
+
+} // namespace
 
 XFile::NetworkGroup::NetworkGroup(const XFile& file) :
 		HDF5File::Group(file, NetworkGroup::path, false) {
@@ -229,14 +391,11 @@ XFile::NetworkGroup::NetworkGroup(const XFile& file) :
 	// Base class opened the group, so nothing else to do.
 }
 
-XFile::NetworkGroup::NetworkGroup(const XFile& file, IReactionNetwork& network) :
+XFile::NetworkGroup::NetworkGroup(const XFile& file, int normalSize,
+		int superSize, const Array<int, 5>& phaseSpace) :
 		HDF5File::Group(file, NetworkGroup::path, true) {
 	// Base class created the group.
 
-	// Get the sizes information
-	int totalSize = network.size(), superSize = network.getSuperSize(),
-			normalSize = totalSize - superSize;
-
 	// Build a dataspace for our scalar attributes.
 	XFile::ScalarDataSpace scalarDSpace;
 
@@ -251,22 +410,153 @@ XFile::NetworkGroup::NetworkGroup(const XFile& file, IReactionNetwork& network)
 	superSizeAttr.setTo(superSize);
 
 	// Add the phase space attribute
-	auto list = network.getPhaseSpaceList();
 	std::array<hsize_t, 1> dim { 5 };
 	XFile::SimpleDataSpace<1> phaseDSpace(dim);
 	hid_t attrId = H5Acreate2(getId(), phaseSpaceAttrName.c_str(),
 	H5T_STD_I32LE, phaseDSpace.getId(), H5P_DEFAULT, H5P_DEFAULT);
-	auto status = H5Awrite(attrId, H5T_STD_I32LE, &list);
+	auto status = H5Awrite(attrId, H5T_STD_I32LE, &phaseSpace);
 	status = H5Aclose(attrId);
+}
 
-	// Loop on all the clusters
-	auto& allReactants = network.getAll();
-	std::for_each(allReactants.begin(), allReactants.end(),
-			[this](IReactant& currReactant) {
-				// Create and initialize the cluster group
-				int id = currReactant.getId() - 1;
-				ClusterGroup clusterGroup(*this, currReactant);
-			});
+XFile::NetworkGroup::NetworkGroup(const XFile& file, IReactionNetwork& network) :
+		NetworkGroup(file, network.size() - network.getSuperSize(),
+				network.getSuperSize(), network.getPhaseSpaceList()) {
+
+	// Write everything at once
+	ClusterTable clusterTable;
+	ReactionTables reactionTables;
+	makeTables(network, clusterTable, reactionTables);
+	writeTables(clusterTable, reactionTables);
+}
+
+void XFile::NetworkGroup::makeTables(IReactionNetwork& network,
+		ClusterTable& clusterTable, ReactionTables& reactionTables) {
+	// Get the sizes information
+	int totalSize = network.size(), superSize = network.getSuperSize(),
+			normalSize = totalSize - superSize;
+
+	// Put the clusters in the tables in the order of their ids
+	std::vector<IReactant*> clusters(totalSize, nullptr);
+	for (IReactant& currReactant : network.getAll()) {
+		clusters[currReactant.getId() - 1] = &currReactant;
+	}
+
+	clusterTable = ClusterTable();
+	clusterTable.normalSize = normalSize;
+	clusterTable.superSize = superSize;
+	reactionTables = ReactionTables();
+	for (auto& table : reactionTables) {
+		table.offsets.push_back(0);
+	}
+	for (int i = 0; i < totalSize; i++) {
+		auto& cluster = *clusters[i];
+
+		// Super PSI cluster case
+		if (cluster.getType() == ReactantType::PSISuper) {
+			// Keep the coordinate of each contained cluster
+			auto& currCluster = static_cast<PSISuperCluster&>(cluster);
+			if (clusterTable.heVOffsets.empty())
+				clusterTable.heVOffsets.resize(i - normalSize + 1, 0);
+			for (auto const& pair : currCluster.getCoordList()) {
+				clusterTable.heVList.push_back(std::get<0>(pair));
+				clusterTable.heVList.push_back(std::get<1>(pair));
+				clusterTable.heVList.push_back(std::get<2>(pair));
+				clusterTable.heVList.push_back(std::get<3>(pair));
+			}
+			clusterTable.heVOffsets.push_back(clusterTable.heVList.size() / 4);
+		}
+		// Super Fe cluster case
+		else if (cluster.getType() == ReactantType::FeSuper) {
+			// Keep the bounds
+			auto& currCluster = static_cast<FeSuperCluster&>(cluster);
+			auto bounds = currCluster.getBounds();
+			clusterTable.bounds.insert(clusterTable.bounds.end(),
+					bounds.begin(), bounds.end());
+		}
+		// Super NE cluster case
+		else if (cluster.getType() == ReactantType::NESuper) {
+			auto& currCluster = static_cast<NESuperCluster&>(cluster);
+			clusterTable.neProperties.push_back(currCluster.getNTot());
+			clusterTable.neProperties.push_back(currCluster.getAverage());
+			clusterTable.neProperties.push_back(
+					currCluster.getReactionRadius());
+		}
+		// Normal cluster case
+		else {
+			// Keep the composition and energies
+			auto& comp = cluster.getComposition();
+			clusterTable.compSize = comp.size();
+			clusterTable.compositions.insert(clusterTable.compositions.end(),
+					comp.begin(), comp.end());
+			clusterTable.energies.push_back(cluster.getFormationEnergy());
+			clusterTable.energies.push_back(cluster.getMigrationEnergy());
+			clusterTable.energies.push_back(cluster.getDiffusionFactor());
+		}
+
+		// Keep the reactions of each kind
+		std::array<std::vector<std::vector<double> >, 4> reactionVecs { {
+				cluster.getProdVector(), cluster.getCombVector(),
+				cluster.getDissoVector(), cluster.getEmitVector() } };
+		for (int kind = 0; kind < 4; kind++) {
+			auto& table = reactionTables[kind];
+			auto& reactionVec = reactionVecs[kind];
+			table.widths.push_back(
+					reactionVec.empty() ? 0 : reactionVec[0].size());
+			for (auto const& reaction : reactionVec) {
+				table.data.insert(table.data.end(), reaction.begin(),
+						reaction.end());
+			}
+			table.offsets.push_back(table.data.size());
+		}
+	}
+
+	return;
+}
+
+void XFile::NetworkGroup::writeTables(const ClusterTable& clusters,
+		const ReactionTables& reactions) const {
+	// The clusters
+	writeTable<2>(getId(), compositionsDataName, H5T_STD_I32LE,
+	H5T_NATIVE_INT, { { (hsize_t) clusters.normalSize,
+			(hsize_t) clusters.compSize } }, clusters.compositions.data());
+	writeTable<2>(getId(), energiesDataName, H5T_IEEE_F64LE,
+	H5T_NATIVE_DOUBLE, { { (hsize_t) clusters.normalSize, 3 } },
+			clusters.energies.data());
+	if (!clusters.heVOffsets.empty()) {
+		writeTable<1>(getId(), heVOffsetsDataName, H5T_STD_I32LE,
+		H5T_NATIVE_INT, { { (hsize_t) clusters.heVOffsets.size() } },
+				clusters.heVOffsets.data());
+		writeTable<2>(getId(), heVListDataName, H5T_STD_I32LE,
+		H5T_NATIVE_INT, { { (hsize_t) clusters.heVList.size() / 4, 4 } },
+				clusters.heVList.data());
+	}
+	if (!clusters.bounds.empty()) {
+		writeTable<2>(getId(), boundsDataName, H5T_STD_I32LE,
+		H5T_NATIVE_INT, { { (hsize_t) clusters.bounds.size() / 4, 4 } },
+				clusters.bounds.data());
+	}
+	if (!clusters.neProperties.empty()) {
+		writeTable<2>(getId(), nePropertiesDataName, H5T_IEEE_F64LE,
+		H5T_NATIVE_DOUBLE,
+				{ { (hsize_t) clusters.neProperties.size() / 3, 3 } },
+				clusters.neProperties.data());
+	}
+
+	// The reactions, one table of each kind
+	for (int kind = 0; kind < 4; kind++) {
+		auto& table = reactions[kind];
+		writeTable<1>(getId(), reactionPrefixes[kind] + offsetsDataSuffix,
+		H5T_STD_I64LE, H5T_NATIVE_INT64,
+				{ { (hsize_t) table.offsets.size() } }, table.offsets.data());
+		writeTable<1>(getId(), reactionPrefixes[kind] + widthsDataSuffix,
+		H5T_STD_I32LE, H5T_NATIVE_INT, { { (hsize_t) table.widths.size() } },
+				table.widths.data());
+		writeTable<1>(getId(), reactionPrefixes[kind] + dataSuffix,
+		H5T_IEEE_F64LE, H5T_NATIVE_DOUBLE,
+				{ { (hsize_t) table.data.size() } }, table.data.data());
+	}
+
+	return;
 }
 
 Array<int, 5> XFile::NetworkGroup::readNetworkSize(int &normalSize,
@@ -289,27 +579,188 @@ Array<int, 5> XFile::NetworkGroup::readNetworkSize(int &normalSize,
 	return list;
 }
 
+bool XFile::NetworkGroup::isColumnar(void) const {
+	// The offsets of the reactions are always written
+	return H5Lexists(getId(),
+			(reactionPrefixes[0] + offsetsDataSuffix).c_str(), H5P_DEFAULT)
+			> 0;
+}
+
+XFile::NetworkGroup::ClusterTable XFile::NetworkGroup::readClusters(
+		void) const {
+	ClusterTable clusters;
+	readNetworkSize(clusters.normalSize, clusters.superSize);
+
+	if (isColumnar()) {
+		// Read each dataset at once
+		std::array<hsize_t, 2> dims;
+		clusters.compositions = readTable<int, 2>(getId(),
+				compositionsDataName, H5T_NATIVE_INT, dims);
+		clusters.compSize = dims[1];
+		clusters.energies = readTable<double, 2>(getId(), energiesDataName,
+		H5T_NATIVE_DOUBLE, dims);
+		if (H5Lexists(getId(), heVOffsetsDataName.c_str(), H5P_DEFAULT) > 0) {
+			std::array<hsize_t, 1> offsetDims;
+			clusters.heVOffsets = readTable<int, 1>(getId(),
+					heVOffsetsDataName, H5T_NATIVE_INT, offsetDims);
+			clusters.heVList = readTable<int, 2>(getId(), heVListDataName,
+			H5T_NATIVE_INT, dims);
+		}
+		if (H5Lexists(getId(), boundsDataName.c_str(), H5P_DEFAULT) > 0) {
+			clusters.bounds = readTable<int, 2>(getId(), boundsDataName,
+			H5T_NATIVE_INT, dims);
+		}
+		if (H5Lexists(getId(), nePropertiesDataName.c_str(), H5P_DEFAULT)
+				> 0) {
+			clusters.neProperties = readTable<double, 2>(getId(),
+					nePropertiesDataName, H5T_NATIVE_DOUBLE, dims);
+		}
+
+		return clusters;
+	}
+
+	// Older files, one group per cluster
+	for (int i = 0; i < clusters.normalSize + clusters.superSize; i++) {
+		ClusterGroup clusterGroup(*this, i);
+
+		if (i < clusters.normalSize) {
+			// Normal cluster
+			double formationEnergy = 0.0, migrationEnergy = 0.0,
+					diffusionFactor = 0.0;
+			auto comp = clusterGroup.readCluster(formationEnergy,
+					migrationEnergy, diffusionFactor);
+			clusters.compSize = comp.size();
+			clusters.compositions.insert(clusters.compositions.end(),
+					comp.begin(), comp.end());
+			clusters.energies.push_back(formationEnergy);
+			clusters.energies.push_back(migrationEnergy);
+			clusters.energies.push_back(diffusionFactor);
+		}
+		// The kind of super cluster is found from what the group contains
+		else if (clusterGroup.isPSISuperCluster()) {
+			if (clusters.heVOffsets.empty())
+				clusters.heVOffsets.resize(i - clusters.normalSize + 1, 0);
+			for (auto const& coord : clusterGroup.readPSISuperCluster()) {
+				clusters.heVList.push_back(std::get<0>(coord));
+				clusters.heVList.push_back(std::get<1>(coord));
+				clusters.heVList.push_back(std::get<2>(coord));
+				clusters.heVList.push_back(std::get<3>(coord));
+			}
+			clusters.heVOffsets.push_back(clusters.heVList.size() / 4);
+		} else if (clusterGroup.isFeSuperCluster()) {
+			auto bounds = clusterGroup.readFeSuperCluster();
+			clusters.bounds.insert(clusters.bounds.end(), bounds.begin(),
+					bounds.end());
+		} else {
+			int nTot = 0;
+			double numXe = 0.0, radius = 0.0;
+			clusterGroup.readNESuperCluster(nTot, numXe, radius);
+			clusters.neProperties.push_back(nTot);
+			clusters.neProperties.push_back(numXe);
+			clusters.neProperties.push_back(radius);
+		}
+	}
+
+	return clusters;
+}
+
+XFile::NetworkGroup::ReactionTables XFile::NetworkGroup::readReactionTables(
+		void) const {
+	ReactionTables reactions;
+
+	if (isColumnar()) {
+		// Read each dataset at once
+		for (int kind = 0; kind < 4; kind++) {
+			auto& table = reactions[kind];
+			std::array<hsize_t, 1> dims;
+			table.offsets = readTable<int64_t, 1>(getId(),
+					reactionPrefixes[kind] + offsetsDataSuffix,
+					H5T_NATIVE_INT64, dims);
+			table.widths = readTable<int, 1>(getId(),
+					reactionPrefixes[kind] + widthsDataSuffix,
+					H5T_NATIVE_INT, dims);
+			table.data = readTable<double, 1>(getId(),
+					reactionPrefixes[kind] + dataSuffix, H5T_NATIVE_DOUBLE,
+					dims);
+		}
+
+		return reactions;
+	}
+
+	// Older files, one group per cluster
+	int normalSize = 0, superSize = 0;
+	readNetworkSize(normalSize, superSize);
+	for (auto& table : reactions) {
+		table.offsets.push_back(0);
+	}
+	for (int i = 0; i < normalSize + superSize; i++) {
+		ClusterGroup clusterGroup(*this, i);
+		clusterGroup.readReactions(reactions);
+	}
+
+	return reactions;
+}
+
 void XFile::NetworkGroup::readReactions(IReactionNetwork& network) const {
+	// Read all the reactions at once
+	auto reactions = readReactionTables();
+	addReactions(network, reactions);
+
+	return;
+}
+
+void XFile::NetworkGroup::addReactions(IReactionNetwork& network,
+		ReactionTables& reactions) {
 	// Loop on the reactants
 	auto& allReactants = network.getAll();
 	std::for_each(allReactants.begin(), allReactants.end(),
-			[&allReactants, &network, this](IReactant& currReactant) {
-				// Open the corresponding group
+			[&network, &reactions](IReactant& currReactant) {
+				// Add each kind of reactions, in the order of the tables
 				int id = currReactant.getId() - 1;
-				ClusterGroup clusterGroup(*this, id);
-				// Read and set the reactions
-				clusterGroup.readReactions(network, currReactant);
+				for (int kind = 0; kind < 4; kind++) {
+					addClusterReactions(network, currReactant, kind, reactions[kind],
+							id);
+				}
 			});
 
 	return;
 }
 
+void XFile::NetworkGroup::convertToColumnar(void) const {
+	if (isColumnar())
+		return;
+
+	// Read everything from the cluster groups
+	auto clusters = readClusters();
+	auto reactions = readReactionTables();
+
+	// Remove the cluster groups and write the datasets instead
+	for (int i = 0; i < clusters.normalSize + clusters.superSize; i++) {
+		H5Ldelete(getId(), ClusterGroup::makeGroupName(i).c_str(),
+		H5P_DEFAULT);
+	}
+	writeTables(clusters, reactions);
+
+	return;
+}
+
 void XFile::NetworkGroup::copyTo(const XFile& target) const {
 
-	H5Ocopy(getLocation().getId(), NetworkGroup::path.string().c_str(),
-			target.getId(), NetworkGroup::path.string().c_str(),
-			H5P_DEFAULT,
-			H5P_DEFAULT);
+	if (isColumnar()) {
+		H5Ocopy(getLocation().getId(), NetworkGroup::path.string().c_str(),
+				target.getId(), NetworkGroup::path.string().c_str(),
+				H5P_DEFAULT,
+				H5P_DEFAULT);
+		return;
+	}
+
+	// Write the older files by columns in the copy
+	int normalSize = 0, superSize = 0;
+	auto phaseSpace = readNetworkSize(normalSize, superSize);
+	NetworkGroup targetGroup(target, normalSize, superSize, phaseSpace);
+	targetGroup.writeTables(readClusters(), readReactionTables());
+
+	return;
 }
 
 //----------------------------------------------------------------------------
@@ -336,209 +787,20 @@ XFile::ClusterGroup::ClusterGroup(const NetworkGroup& networkGroup, int id) :
 		HDF5File::Group(networkGroup, makeGroupName(id), false) {
 }
 
-XFile::ClusterGroup::ClusterGroup(const NetworkGroup& networkGroup,
-		IReactant& cluster) :
-		HDF5File::Group(networkGroup, makeGroupName(cluster.getId() - 1), true) {
-	// Super PSI cluster case
-	if (cluster.getType() == ReactantType::PSISuper) {
-		// Write the dataset with the coordinate of each contained cluster
-		auto& currCluster = static_cast<PSISuperCluster&>(cluster);
-		int nTot = currCluster.getNTot();
-		int heVArray[nTot][4];
-		auto& heVList = currCluster.getCoordList();
-		int i = 0;
-		for (auto const& pair : heVList) {
-			heVArray[i][0] = std::get<0>(pair);
-			heVArray[i][1] = std::get<1>(pair);
-			heVArray[i][2] = std::get<2>(pair);
-			heVArray[i][3] = std::get<3>(pair);
-			i++;
-		}
-		// Create the dataspace for the dataset with dimension dim
-		std::array<hsize_t, 2> dim { (hsize_t) nTot, (hsize_t) 4 };
-		XFile::SimpleDataSpace<2> listDSpace(dim);
-		hid_t datasetId = H5Dcreate2(getId(), heVListDataName.c_str(),
-		H5T_STD_I32LE, listDSpace.getId(), H5P_DEFAULT, H5P_DEFAULT,
-		H5P_DEFAULT);
-		// Write in the dataset
-		auto status = H5Dwrite(datasetId, H5T_STD_I32LE, H5S_ALL, H5S_ALL,
-		H5P_DEFAULT, &heVArray);
-		// Close the dataset
-		status = H5Dclose(datasetId);
-	}
-	// Super Fe cluster case
-	else if (cluster.getType() == ReactantType::FeSuper) {
-		// Write the bounds
-		auto& currCluster = static_cast<FeSuperCluster&>(cluster);
-		auto bounds = currCluster.getBounds();
-		std::array<hsize_t, 1> dim { 4 };
-		XFile::SimpleDataSpace<1> boundDSpace(dim);
-		hid_t attrId = H5Acreate2(getId(), boundsAttrName.c_str(),
-		H5T_STD_I32LE, boundDSpace.getId(), H5P_DEFAULT, H5P_DEFAULT);
-		auto status = H5Awrite(attrId, H5T_STD_I32LE, &bounds);
-		status = H5Aclose(attrId);
-	}
-	// Super NE cluster case
-	else if (cluster.getType() == ReactantType::NESuper) {
-		auto& currCluster = static_cast<NESuperCluster&>(cluster);
-		// Build a dataspace for our scalar attributes.
-		XFile::ScalarDataSpace scalarDSpace;
-
-		// Add a nTot attribute.
-		int nTot = currCluster.getNTot();
-		Attribute<decltype(nTot)> nTotAttr(*this, nTotAttrName, scalarDSpace);
-		nTotAttr.setTo(nTot);
-		// Add a numXe attribute.
-		double numXe = currCluster.getAverage();
-		Attribute<decltype(numXe)> numXeAttr(*this, numXeAttrName,
-				scalarDSpace);
-		numXeAttr.setTo(numXe);
-		// Add a radius attribute.
-		double radius = currCluster.getReactionRadius();
-		Attribute<decltype(radius)> radiusAttr(*this, radiusAttrName,
-				scalarDSpace);
-		radiusAttr.setTo(radius);
-	}
-	// Normal cluster case
-	else {
-		// Write the composition attribute
-		auto& comp = cluster.getComposition();
-		std::array<hsize_t, 1> dim { (hsize_t) comp.size() };
-		int compArray[dim[0]];
-		for (int i = 0; i < dim[0]; i++) {
-			compArray[i] = comp[i];
-		}
-		XFile::SimpleDataSpace<1> compDSpace(dim);
-		hid_t attrId = H5Acreate2(getId(), compositionAttrName.c_str(),
-		H5T_STD_I32LE, compDSpace.getId(), H5P_DEFAULT, H5P_DEFAULT);
-		auto status = H5Awrite(attrId, H5T_STD_I32LE, &compArray);
-		status = H5Aclose(attrId);
-
-		// Build a dataspace for our scalar attributes.
-		XFile::ScalarDataSpace scalarDSpace;
-
-		// Add a formationEnergy attribute.
-		double formationEnergy = cluster.getFormationEnergy();
-		Attribute<decltype(formationEnergy)> formationEnergyAttr(*this,
-				formationEnergyAttrName, scalarDSpace);
-		formationEnergyAttr.setTo(formationEnergy);
-		// Add a migrationEnergy attribute.
-		double migrationEnergy = cluster.getMigrationEnergy();
-		Attribute<decltype(migrationEnergy)> migrationEnergyAttr(*this,
-				migrationEnergyAttrName, scalarDSpace);
-		migrationEnergyAttr.setTo(migrationEnergy);
-		// Add a diffusionFactor attribute.
-		double diffusionFactor = cluster.getDiffusionFactor();
-		Attribute<decltype(diffusionFactor)> diffusionFactorAttr(*this,
-				diffusionFactorAttrName, scalarDSpace);
-		diffusionFactorAttr.setTo(diffusionFactor);
-	}
-
-	// Write a dataset of production reactions
-	auto prodVec = cluster.getProdVector();
-	if (prodVec.size() > 0) {
-		int nReact = prodVec.size();
-		int dataSize = prodVec[0].size();
-		double prodArray[nReact][dataSize];
-		for (int i = 0; i < nReact; i++) {
-			for (int j = 0; j < dataSize; j++) {
-				prodArray[i][j] = prodVec[i][j];
-			}
-		}
-		// Create the dataspace for the dataset with dimension dims
-		std::array<hsize_t, 2> dims { (hsize_t) nReact, (hsize_t) dataSize };
-		XFile::SimpleDataSpace<2> prodDSpace(dims);
-		hid_t datasetId = H5Dcreate2(getId(), productionDataName.c_str(),
-		H5T_IEEE_F64LE, prodDSpace.getId(), H5P_DEFAULT, H5P_DEFAULT,
-		H5P_DEFAULT);
-		// Write in the dataset
-		auto status = H5Dwrite(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
-		H5P_DEFAULT, &prodArray);
-		// Close the dataset
-		status = H5Dclose(datasetId);
-	}
-
-	// Write a dataset of combination reactions
-	auto combVec = cluster.getCombVector();
-	if (combVec.size() > 0) {
-		int nReact = combVec.size();
-		int dataSize = combVec[0].size();
-		double combArray[nReact][dataSize];
-		for (int i = 0; i < nReact; i++) {
-			for (int j = 0; j < dataSize; j++) {
-				combArray[i][j] = combVec[i][j];
-			}
-		}
-		// Create the dataspace for the dataset with dimension dims
-		std::array<hsize_t, 2> dims { (hsize_t) nReact, (hsize_t) dataSize };
-		XFile::SimpleDataSpace<2> combDSpace(dims);
-		hid_t datasetId = H5Dcreate2(getId(), combinationDataName.c_str(),
-		H5T_IEEE_F64LE, combDSpace.getId(), H5P_DEFAULT, H5P_DEFAULT,
-		H5P_DEFAULT);
-		// Write in the dataset
-		auto status = H5Dwrite(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
-		H5P_DEFAULT, &combArray);
-		// Close the dataset
-		status = H5Dclose(datasetId);
-	}
-
-	// Write a dataset of dissociation reactions
-	auto dissoVec = cluster.getDissoVector();
-	if (dissoVec.size() > 0) {
-		int nReact = dissoVec.size();
-		int dataSize = dissoVec[0].size();
-		double dissoArray[nReact][dataSize];
-		for (int i = 0; i < nReact; i++) {
-			for (int j = 0; j < dataSize; j++) {
-				dissoArray[i][j] = dissoVec[i][j];
-			}
-		}
-		// Create the dataspace for the dataset with dimension dims
-		std::array<hsize_t, 2> dims { (hsize_t) nReact, (hsize_t) dataSize };
-		XFile::SimpleDataSpace<2> dissoDSpace(dims);
-		hid_t datasetId = H5Dcreate2(getId(), dissociationDataName.c_str(),
-		H5T_IEEE_F64LE, dissoDSpace.getId(), H5P_DEFAULT, H5P_DEFAULT,
-		H5P_DEFAULT);
-		// Write in the dataset
-		auto status = H5Dwrite(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
-		H5P_DEFAULT, &dissoArray);
-		// Close the dataset
-		status = H5Dclose(datasetId);
-	}
-
-	// Write a dataset of emission reactions
-	auto emitVec = cluster.getEmitVector();
-	if (emitVec.size() > 0) {
-		int nReact = emitVec.size();
-		int dataSize = emitVec[0].size();
-		double emitArray[nReact][dataSize];
-		for (int i = 0; i < nReact; i++) {
-			for (int j = 0; j < dataSize; j++) {
-				emitArray[i][j] = emitVec[i][j];
-			}
-		}
-		// Create the dataspace for the dataset with dimension dims
-		std::array<hsize_t, 2> dims { (hsize_t) nReact, (hsize_t) dataSize };
-		XFile::SimpleDataSpace<2> emitDSpace(dims);
-		hid_t datasetId = H5Dcreate2(getId(), emissionDataName.c_str(),
-		H5T_IEEE_F64LE, emitDSpace.getId(), H5P_DEFAULT, H5P_DEFAULT,
-		H5P_DEFAULT);
-		// Write in the dataset
-		auto status = H5Dwrite(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
-		H5P_DEFAULT, &emitArray);
-		// Close the dataset
-		status = H5Dclose(datasetId);
-	}
-
-	return;
-}
-
 std::string XFile::ClusterGroup::makeGroupName(int id) {
 	std::ostringstream namestr;
 	namestr << id;
 	return namestr.str();
 }
 
+bool XFile::ClusterGroup::isPSISuperCluster(void) const {
+	return H5Lexists(getId(), heVListDataName.c_str(), H5P_DEFAULT) > 0;
+}
+
+bool XFile::ClusterGroup::isFeSuperCluster(void) const {
+	return H5Aexists(getId(), boundsAttrName.c_str()) > 0;
+}
+
 XFile::ClusterGroup::clusterComp XFile::ClusterGroup::readCluster(
 		double &formationEnergy, double &migrationEnergy,
 		double &diffusionFactor) const {
@@ -623,137 +885,40 @@ void XFile::ClusterGroup::readNESuperCluster(int &nTot, double &numXe,
 	return;
 }
 
-void XFile::ClusterGroup::readReactions(IReactionNetwork& network,
-		IReactant &cluster) const {
-	// Get all the reactants
-	auto& allReactants = network.getAll();
-
-	// Read the production dataset
-	bool datasetExist = H5Lexists(getId(), productionDataName.c_str(),
-	H5P_DEFAULT);
-	if (datasetExist) {
-		hid_t datasetId = H5Dopen(getId(), productionDataName.c_str(),
-		H5P_DEFAULT);
-		hid_t dataspaceId = H5Dget_space(datasetId);
-		std::array<hsize_t, 2> dims;
-		herr_t status = H5Sget_simple_extent_dims(dataspaceId, dims.data(),
-		NULL);
-		double prodVec[dims[0]][dims[1]];
-		status = H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
-		H5P_DEFAULT, &prodVec);
-		status = H5Dclose(datasetId);
-		// Loop on the prod vector
-		for (int i = 0; i < dims[0]; i++) {
-			// Get pointers to the 2 reactants
-			auto& firstReactant = allReactants.at(prodVec[i][0]);
-			auto& secondReactant = allReactants.at(prodVec[i][1]);
-
-			// Create and add the reaction to the network
-			std::unique_ptr<ProductionReaction> reaction(
-					new ProductionReaction(firstReactant, secondReactant));
-			auto& prref = network.add(std::move(reaction));
+void XFile::ClusterGroup::readReactions(
+		NetworkGroup::ReactionTables& reactions) const {
+	// The datasets of the reactions of each kind, in the order of the tables
+	std::array<std::string, 4> dataNames { { productionDataName,
+			combinationDataName, dissociationDataName, emissionDataName } };
 
-			// Add the reaction to the cluster
-			cluster.resultFrom(prref, &(prodVec[i][2]));
-		}
-	}
+	for (int kind = 0; kind < 4; kind++) {
+		auto& table = reactions[kind];
+		int width = 0;
 
-	// Read the combination dataset
-	datasetExist = H5Lexists(getId(), combinationDataName.c_str(),
-	H5P_DEFAULT);
-	if (datasetExist) {
-		hid_t datasetId = H5Dopen(getId(), combinationDataName.c_str(),
+		// Read the dataset if there are reactions of this kind
+		bool datasetExist = H5Lexists(getId(), dataNames[kind].c_str(),
 		H5P_DEFAULT);
-		hid_t dataspaceId = H5Dget_space(datasetId);
-		std::array<hsize_t, 2> dims;
-		herr_t status = H5Sget_simple_extent_dims(dataspaceId, dims.data(),
-		NULL);
-		double combVec[dims[0]][dims[1]];
-		status = H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
-		H5P_DEFAULT, &combVec);
-		status = H5Dclose(datasetId);
-		// Loop on the prod vector
-		for (int i = 0; i < dims[0]; i++) {
-			// Get pointers to the combining reactant
-			auto& firstReactant = allReactants.at(combVec[i][0]);
-
-			// Create and add the reaction to the network
-			std::unique_ptr<ProductionReaction> reaction(
-					new ProductionReaction(firstReactant, cluster));
-			auto& prref = network.add(std::move(reaction));
-
-			// Add the reaction to the cluster
-			cluster.participateIn(prref, &(combVec[i][1]));
+		if (datasetExist) {
+			hid_t datasetId = H5Dopen(getId(), dataNames[kind].c_str(),
+			H5P_DEFAULT);
+			hid_t dataspaceId = H5Dget_space(datasetId);
+			std::array<hsize_t, 2> dims;
+			herr_t status = H5Sget_simple_extent_dims(dataspaceId,
+					dims.data(), NULL);
+			status = H5Sclose(dataspaceId);
+			width = dims[1];
+			auto start = table.data.size();
+			table.data.resize(start + dims[0] * dims[1]);
+			status = H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
+			H5P_DEFAULT, table.data.data() + start);
+			status = H5Dclose(datasetId);
 		}
-	}
-
-	// Read the dissociation dataset
-	datasetExist = H5Lexists(getId(), dissociationDataName.c_str(),
-	H5P_DEFAULT);
-	if (datasetExist) {
-		hid_t datasetId = H5Dopen(getId(), dissociationDataName.c_str(),
-		H5P_DEFAULT);
-		hid_t dataspaceId = H5Dget_space(datasetId);
-		std::array<hsize_t, 2> dims;
-		herr_t status = H5Sget_simple_extent_dims(dataspaceId, dims.data(),
-		NULL);
-		double dissoVec[dims[0]][dims[1]];
-		status = H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
-		H5P_DEFAULT, &dissoVec);
-		status = H5Dclose(datasetId);
-		// Loop on the prod vector
-		for (int i = 0; i < dims[0]; i++) {
-			// Get pointers to the other reactants
-			auto& emittingReactant = allReactants.at(dissoVec[i][0]);
-			auto& secondReactant = allReactants.at(dissoVec[i][1]);
 
-			// Create and add the reaction to the network
-			std::unique_ptr<ProductionReaction> reaction(
-					new ProductionReaction(cluster, secondReactant));
-			auto& prref = network.add(std::move(reaction));
-			std::unique_ptr<DissociationReaction> dissociationReaction(
-					new DissociationReaction(emittingReactant, prref.first,
-							prref.second, &prref));
-			auto& drref = network.add(std::move(dissociationReaction));
-
-			// Add the reaction to the cluster
-			cluster.participateIn(drref, &(dissoVec[i][2]));
-		}
+		table.widths.push_back(width);
+		table.offsets.push_back(table.data.size());
 	}
 
-	// Read the emission dataset
-	datasetExist = H5Lexists(getId(), emissionDataName.c_str(),
-	H5P_DEFAULT);
-	if (datasetExist) {
-		hid_t datasetId = H5Dopen(getId(), emissionDataName.c_str(),
-		H5P_DEFAULT);
-		hid_t dataspaceId = H5Dget_space(datasetId);
-		std::array<hsize_t, 2> dims;
-		herr_t status = H5Sget_simple_extent_dims(dataspaceId, dims.data(),
-		NULL);
-		double emitVec[dims[0]][dims[1]];
-		status = H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
-		H5P_DEFAULT, &emitVec);
-		status = H5Dclose(datasetId);
-		// Loop on the prod vector
-		for (int i = 0; i < dims[0]; i++) {
-			// Get pointers to the other reactants
-			auto& firstReactant = allReactants.at(emitVec[i][0]);
-			auto& secondReactant = allReactants.at(emitVec[i][1]);
-
-			// Create and add the reaction to the network
-			std::unique_ptr<ProductionReaction> reaction(
-					new ProductionReaction(firstReactant, secondReactant));
-			auto& prref = network.add(std::move(reaction));
-			std::unique_ptr<DissociationReaction> dissociationReaction(
-					new DissociationReaction(cluster, prref.first, prref.second,
-							&prref));
-			auto& drref = network.add(std::move(dissociationReaction));
-
-			// Add the reaction to the cluster
-			cluster.emitFrom(drref, &(emitVec[i][2]));
-		}
-	}
+	return;
 }
 
 //----------------------------------------------------------------------------
@@ -854,6 +1019,8 @@ const std::string XFile::TimestepGroup::nTAttrName = "nTritium";
 const std::string XFile::TimestepGroup::prevTFluxAttrName = "previousTFlux";
 
 const std::string XFile::TimestepGroup::concDatasetName = "concs";
+const std::string XFile::TimestepGroup::denseConcDatasetName = "denseConcs";
+const std::string XFile::TimestepGroup::denseGridDimsAttrName = "denseGridDims";
 
 std::string XFile::TimestepGroup::makeGroupName(
 		const XFile::ConcentrationGroup& concGroup, int timeStep) {
@@ -1168,6 +1335,83 @@ void XFile::TimestepGroup::writeConcentrationDataset(int size,
 	return;
 }
 
+void XFile::TimestepGroup::writeConcentrationDatasets(const XFile& file,
+		const std::vector<std::array<int, 3> >& positions,
+		const Concs1DType& concs) const {
+
+	// Determine our position within the MPI communicator used to
+	// access the file.
+	auto comm = file.getComm();
+	int commRank;
+	MPI_Comm_rank(comm, &commRank);
+	int commSize;
+	MPI_Comm_size(comm, &commSize);
+
+	// Describe each of our grid points with its indices and its size
+	std::vector<int> myPoints;
+	myPoints.reserve(4 * positions.size());
+	for (auto i = 0; i < positions.size(); ++i) {
+		myPoints.insert(myPoints.end(), positions[i].begin(),
+				positions[i].end());
+		myPoints.push_back(concs[i].size());
+	}
+
+	// Gather the descriptions of the grid points of all the processes
+	int myCount = myPoints.size();
+	std::vector<int> counts(commSize, 0);
+	MPI_Allgather(&myCount, 1, MPI_INT, counts.data(), 1, MPI_INT, comm);
+	std::vector<int> displs(commSize, 0);
+	std::partial_sum(counts.begin(), counts.end() - 1, displs.begin() + 1);
+	std::vector<int> allPoints(displs.back() + counts.back());
+	MPI_Allgatherv(myPoints.data(), myCount, MPI_INT, allPoints.data(),
+			counts.data(), displs.data(), MPI_INT, comm);
+
+	// Create property list for independent dataset write.
+	hid_t propertyListId = H5Pcreate(H5P_DATASET_XFER);
+	auto status = H5Pset_dxpl_mpio(propertyListId, H5FD_MPIO_INDEPENDENT);
+
+	// All processes create each dataset, only the owner fills it
+	std::vector<double> concArray;
+	for (auto n = 0; n < allPoints.size(); n += 4) {
+		// Skip the grid point if the size is 0
+		hsize_t size = allPoints[n + 3];
+		if (size == 0)
+			continue;
+
+		// Set the dataset name
+		std::stringstream datasetName;
+		datasetName << "position_" << allPoints[n] << "_" << allPoints[n + 1]
+				<< "_" << allPoints[n + 2];
+
+		// Create the dataset of concentrations for this position
+		std::array<hsize_t, 2> dims { size, (hsize_t) 2 };
+		XFile::SimpleDataSpace<2> concDSpace(dims);
+		hid_t datasetId = H5Dcreate2(getId(), datasetName.str().c_str(),
+		H5T_IEEE_F64LE, concDSpace.getId(),
+		H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+
+		// Write the concentrations if it is one of our grid points
+		if (n >= displs[commRank] && n < displs[commRank] + myCount) {
+			auto const& conc = concs[(n - displs[commRank]) / 4];
+			concArray.clear();
+			for (auto const& pair : conc) {
+				concArray.push_back(pair.first);
+				concArray.push_back(pair.second);
+			}
+			status = H5Dwrite(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
+					propertyListId, concArray.data());
+		}
+
+		// Close dataset
+		status = H5Dclose(datasetId);
+	}
+
+	// Close the property list
+	status = H5Pclose(propertyListId);
+
+	return;
+}
+
 // Caller gives us 2D ragged representation, and we flatten it into
 // a 1D dataset and add a 1D "starting index" array.
 // Assumes that grid point slabs are assigned to processes in 
@@ -1184,14 +1428,233 @@ void XFile::TimestepGroup::writeConcentrations(const XFile& file, int baseX,
 	// defines the dataset *and* writes the given data.
 }
 
+void XFile::TimestepGroup::writeDenseConcentrations(const XFile& file,
+		const std::array<int, 3>& gridDims, const std::array<int, 3>& start,
+		const std::array<int, 3>& size, int dof, const double* concs,
+		const ConcsFormat& format) const {
+
+	// The dataset has one row per grid point of the whole grid
+	const hsize_t nPoints = (hsize_t) gridDims[0] * gridDims[1] * gridDims[2];
+	std::array<hsize_t, 2> dims { nPoints, (hsize_t) dof };
+	XFile::SimpleDataSpace<2> concDSpace(dims);
+
+	// Chunk it along the grid points, about 1MB per chunk, and compress it
+	PropertyList createPlist(H5P_DATASET_CREATE);
+	std::array<hsize_t, 2> chunkDims { std::max((hsize_t) 1, std::min(nPoints,
+			(hsize_t) (131072 / dof))), (hsize_t) dof };
+	auto status = H5Pset_chunk(createPlist.getId(), 2, chunkDims.data());
+	if (format.compressionLevel > 0
+			&& H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0) {
+		// Group the bytes of same significance to compress them better
+		status = H5Pset_shuffle(createPlist.getId());
+		status = H5Pset_deflate(createPlist.getId(), format.compressionLevel);
+	}
+
+	hid_t datasetId = H5Dcreate2(getId(), denseConcDatasetName.c_str(),
+	H5T_IEEE_F64LE, concDSpace.getId(), H5P_DEFAULT, createPlist.getId(),
+	H5P_DEFAULT);
+
+	// Keep the size of the grid with the dataset to find the grid points
+	// when reading
+	std::array<hsize_t, 1> attrDims { 3 };
+	XFile::SimpleDataSpace<1> attrDSpace(attrDims);
+	hid_t attrId = H5Acreate2(datasetId, denseGridDimsAttrName.c_str(),
+	H5T_STD_I32LE, attrDSpace.getId(), H5P_DEFAULT, H5P_DEFAULT);
+	status = H5Awrite(attrId, H5T_NATIVE_INT, gridDims.data());
+	status = H5Aclose(attrId);
+
+	// Select our grid points, one block of rows for each z plane
+	XFile::SimpleDataSpace<2> fileDSpace(dims);
+	H5Sselect_none(fileDSpace.getId());
+	for (auto k = 0; k < size[2]; ++k) {
+		std::array<hsize_t, 2> offset { (hsize_t) ((start[2] + k) * gridDims[1]
+				+ start[1]) * gridDims[0] + start[0], 0 };
+		std::array<hsize_t, 2> stride { (hsize_t) gridDims[0], 1 };
+		std::array<hsize_t, 2> count { (hsize_t) size[1], 1 };
+		std::array<hsize_t, 2> block { (hsize_t) size[0], (hsize_t) dof };
+		H5Sselect_hyperslab(fileDSpace.getId(), H5S_SELECT_OR, offset.data(),
+				stride.data(), count.data(), block.data());
+	}
+
+	// Drop the least significant bits of the mantissa, rounding to the
+	// nearest value that is kept
+	const hsize_t nValues = (hsize_t) size[0] * size[1] * size[2] * dof;
+	const double *values = concs;
+	std::vector<double> roundedConcs;
+	if (format.mantissaBits < 52) {
+		const int droppedBits = 52 - format.mantissaBits;
+		const uint64_t half = (uint64_t) 1 << (droppedBits - 1);
+		const uint64_t mask = ~(((uint64_t) 1 << droppedBits) - 1);
+		roundedConcs.resize(nValues);
+		for (hsize_t n = 0; n < nValues; ++n) {
+			uint64_t bits;
+			std::memcpy(&bits, concs + n, sizeof(bits));
+			// Leave the infinities and NaNs alone
+			if ((bits & 0x7FF0000000000000ULL) != 0x7FF0000000000000ULL)
+				bits = (bits + half) & mask;
+			std::memcpy(&roundedConcs[n], &bits, sizeof(bits));
+		}
+		values = roundedConcs.data();
+	}
+
+	// Write our values with a collective write, needed for the filters
+	std::array<hsize_t, 2> memDims { nValues / dof, (hsize_t) dof };
+	XFile::SimpleDataSpace<2> memDSpace(memDims);
+	PropertyList plist(H5P_DATASET_XFER);
+	H5Pset_dxpl_mpio(plist.getId(), H5FD_MPIO_COLLECTIVE);
+	status = H5Dwrite(datasetId, H5T_NATIVE_DOUBLE, memDSpace.getId(),
+			fileDSpace.getId(), plist.getId(), values);
+
+	// Close dataset
+	status = H5Dclose(datasetId);
+
+	return;
+}
+
+auto XFile::TimestepGroup::readDenseConcentrations(
+		const std::vector<hsize_t>& points) const -> Concs1DType {
+
+	// Open the dataset
+	hid_t datasetId = H5Dopen(getId(), denseConcDatasetName.c_str(),
+	H5P_DEFAULT);
+	hid_t fileDSpaceId = H5Dget_space(datasetId);
+	std::array<hsize_t, 2> dims;
+	auto status = H5Sget_simple_extent_dims(fileDSpaceId, dims.data(),
+			nullptr);
+
+	// Select our grid points, one block for each run of consecutive ones
+	H5Sselect_none(fileDSpaceId);
+	for (auto n = 0; n < points.size();) {
+		auto end = n + 1;
+		while (end < points.size() && points[end] == points[end - 1] + 1)
+			++end;
+		std::array<hsize_t, 2> offset { points[n], 0 };
+		std::array<hsize_t, 2> count { (hsize_t) (end - n), dims[1] };
+		H5Sselect_hyperslab(fileDSpaceId, H5S_SELECT_OR, offset.data(),
+				nullptr, count.data(), nullptr);
+		n = end;
+	}
+
+	// Read them with a collective read
+	std::vector<double> values(points.size() * dims[1]);
+	std::array<hsize_t, 2> memDims { (hsize_t) points.size(), dims[1] };
+	XFile::SimpleDataSpace<2> memDSpace(memDims);
+	if (points.empty())
+		H5Sselect_none(memDSpace.getId());
+	PropertyList plist(H5P_DATASET_XFER);
+	H5Pset_dxpl_mpio(plist.getId(), H5FD_MPIO_COLLECTIVE);
+	status = H5Dread(datasetId, H5T_NATIVE_DOUBLE, memDSpace.getId(),
+			fileDSpaceId, plist.getId(), values.data());
+
+	// Keep the non-zero values, like in the ragged dataset
+	Concs1DType concs(points.size());
+	for (auto n = 0; n < points.size(); ++n) {
+		for (auto l = 0; l < dims[1]; ++l) {
+			double value = values[n * dims[1] + l];
+			if (value != 0.0)
+				concs[n].emplace_back(l, value);
+		}
+	}
+
+	// Close everything
+	status = H5Sclose(fileDSpaceId);
+	status = H5Dclose(datasetId);
+
+	return concs;
+}
+
 XFile::TimestepGroup::Concs1DType XFile::TimestepGroup::readConcentrations(
 		const XFile& file, int baseX, int numX) const {
 
+	// Read the dense dataset if there is one, the grid points are in order
+	if (H5Lexists(getId(), denseConcDatasetName.c_str(), H5P_DEFAULT) > 0) {
+		std::vector<hsize_t> points(numX);
+		std::iota(points.begin(), points.end(), (hsize_t) baseX);
+		return readDenseConcentrations(points);
+	}
+
 	// Open and read the ragged dataset.
 	RaggedDataSet2D<ConcType> dataset(file.getComm(), *this, concDatasetName);
 	return dataset.read(baseX, numX);
 }
 
+XFile::TimestepGroup::Concs1DType XFile::TimestepGroup::readConcentrationDatasets(
+		const std::vector<std::array<int, 3> >& positions) const {
+
+	// Read the dense dataset if there is one
+	if (H5Lexists(getId(), denseConcDatasetName.c_str(), H5P_DEFAULT) > 0) {
+		// Get the size of the grid
+		std::array<int, 3> gridDims;
+		hid_t datasetId = H5Dopen(getId(), denseConcDatasetName.c_str(),
+		H5P_DEFAULT);
+		hid_t attrId = H5Aopen(datasetId, denseGridDimsAttrName.c_str(),
+		H5P_DEFAULT);
+		auto status = H5Aread(attrId, H5T_NATIVE_INT, gridDims.data());
+		status = H5Aclose(attrId);
+		status = H5Dclose(datasetId);
+
+		// Find the index of each grid point, -1 means 0 for the
+		// directions that are not used
+		std::vector<std::pair<hsize_t, int> > points;
+		for (auto n = 0; n < positions.size(); ++n) {
+			hsize_t point = (std::max(positions[n][2], 0) * gridDims[1]
+					+ std::max(positions[n][1], 0)) * gridDims[0]
+					+ positions[n][0];
+			points.emplace_back(point, n);
+		}
+
+		// Read them in the order of the dataset
+		std::sort(points.begin(), points.end());
+		std::vector<hsize_t> sortedPoints;
+		for (auto const& point : points)
+			sortedPoints.push_back(point.first);
+		auto sortedConcs = readDenseConcentrations(sortedPoints);
+
+		// Give them back in the order of the positions
+		Concs1DType concs(positions.size());
+		for (auto n = 0; n < points.size(); ++n)
+			concs[points[n].second] = std::move(sortedConcs[n]);
+
+		return concs;
+	}
+
+	Concs1DType concs(positions.size());
+	std::vector<double> concArray;
+	for (auto n = 0; n < positions.size(); ++n) {
+		// Set the dataset name
+		std::stringstream datasetName;
+		datasetName << "position_" << positions[n][0] << "_" << positions[n][1]
+				<< "_" << positions[n][2];
+
+		// The grid points without concentrations have no dataset
+		if (H5Lexists(getId(), datasetName.str().c_str(), H5P_DEFAULT) <= 0)
+			continue;
+
+		// Open the dataset and get its dimensions
+		hid_t datasetId = H5Dopen(getId(), datasetName.str().c_str(),
+		H5P_DEFAULT);
+		hid_t dataspaceId = H5Dget_space(datasetId);
+		std::array<hsize_t, 2> dims;
+		auto status = H5Sget_simple_extent_dims(dataspaceId, dims.data(),
+				nullptr);
+
+		// Read the (index, concentration) pairs
+		concArray.resize(dims[0] * dims[1]);
+		status = H5Dread(datasetId, H5T_IEEE_F64LE, H5S_ALL, H5S_ALL,
+		H5P_DEFAULT, concArray.data());
+		concs[n].reserve(dims[0]);
+		for (auto l = 0; l < dims[0]; ++l) {
+			concs[n].emplace_back((int) concArray[2 * l], concArray[2 * l + 1]);
+		}
+
+		// Close everything
+		status = H5Sclose(dataspaceId);
+		status = H5Dclose(datasetId);
+	}
+
+	return concs;
+}
+
 std::pair<double, double> XFile::TimestepGroup::readTimes(void) const {
 
 	// Open the desired attributes.
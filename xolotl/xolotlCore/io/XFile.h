@@ -5,6 +5,8 @@
 #include <vector>
 #include <tuple>
 #include <set>
+#include <array>
+#include <cstdint>
 #include "xolotlCore/io/HDF5File.h"
 #include "xolotlCore/io/HDF5Exception.h"
 #include <IReactionNetwork.h>
@@ -56,6 +58,11 @@ public:
 		// Name of the concentrations data set.
 		static const std::string concDatasetName;
 
+		// Name of the dense concentrations data set and of the
+		// attribute with the size of its grid.
+		static const std::string denseConcDatasetName;
+		static const std::string denseGridDimsAttrName;
+
 		/**
 		 * Construct the group name for the given time step.
 		 *
@@ -85,6 +92,18 @@ public:
 		using ConcType = std::pair<int, double>;
 		using Concs1DType = HDF5File::RaggedDataSet2D<ConcType>::Ragged2DType;
 
+		/**
+		 * How the concentrations are written in the checkpoints.
+		 */
+		struct ConcsFormat {
+			//! Are they written with writeDenseConcentrations()?
+			bool dense = false;
+			//! The deflate level of the dense dataset, 0 to 9
+			int compressionLevel = 6;
+			//! The number of mantissa bits kept, 52 keeps the full precision
+			int mantissaBits = 52;
+		};
+
 		/**
 		 * Construct a TimestepGroup.
 		 * Default and copy constructors explicitly disallowed.
@@ -184,6 +203,25 @@ public:
 		void writeConcentrationDataset(int size, double concArray[][2], bool write, int i,
 				int j = -1, int k = -1);
 
+		/**
+		 * Add the concentration datasets of all the grid points we own in
+		 * a 2D or 3D problem, one dataset per grid point as with
+		 * writeConcentrationDataset(). The positions and sizes of every
+		 * grid point are gathered at once so that all the processes can
+		 * create all the datasets without going through the grid point by
+		 * point.
+		 *
+		 * @param file The HDF5 file that owns our group.  Needed to support
+		 *              parallel file access.
+		 * @param positions The (i, j, k) indices of the grid points we own,
+		 *              -1 for the directions that are not used.
+		 * @param concs Concentrations associated with grid points we own,
+		 *              in the same order as the positions.
+		 */
+		void writeConcentrationDatasets(const XFile& file,
+				const std::vector<std::array<int, 3> >& positions,
+				const Concs1DType& concs) const;
+
 		/**
 		 * Add a concentration dataset for all grid points in a 1D problem.
 		 * Caller gives us a 2D ragged representation, and we flatten
@@ -205,10 +243,37 @@ public:
 		void writeConcentrations(const XFile& file, int baseX,
 				const Concs1DType& concs) const;
 
+		/**
+		 * Add a dense concentration dataset for all grid points, with every
+		 * DOF of every grid point. The dataset is chunked along the grid
+		 * points and compressed, so that the zeros don't take space, and
+		 * the least significant bits of the mantissa can be dropped to
+		 * compress it more. It replaces the datasets of
+		 * writeConcentrations() and writeConcentrationDatasets() and is
+		 * read by readConcentrations() and readConcentrationDatasets().
+		 *
+		 * @param file The HDF5 file that owns our group.  Needed to support
+		 *              parallel file access.
+		 * @param gridDims The number of grid points in each direction,
+		 *              1 for the directions that are not used.
+		 * @param start The first grid point we own in each direction.
+		 * @param size The number of grid points we own in each direction.
+		 * @param dof The number of values at each grid point.
+		 * @param concs The values at the grid points we own, all the values
+		 *              of a grid point together, the grid points in x
+		 *              first, then y, then z.
+		 * @param format The compression and precision of the dataset.
+		 */
+		void writeDenseConcentrations(const XFile& file,
+				const std::array<int, 3>& gridDims,
+				const std::array<int, 3>& start, const std::array<int, 3>& size,
+				int dof, const double* concs, const ConcsFormat& format) const;
+
 		/**
 		 * Read concentration dataset for our grid points in a 1D problem.
 		 * Assumes that grid point slabs are assigned to processes in
-		 * MPI rank order.
+		 * MPI rank order.  The dense dataset is read instead if the
+		 * concentrations were written with writeDenseConcentrations().
 		 *
 		 * @param file The HDF5 file that owns our group.  Needed to support
 		 *              parallel file access.
@@ -221,6 +286,22 @@ public:
 		Concs1DType readConcentrations(const XFile& file, int baseX,
 				int numX) const;
 
+		/**
+		 * Read the concentration datasets of the grid points we own in a
+		 * 2D or 3D problem, as written by writeConcentrationDatasets().
+		 * Each process only opens the datasets of its own grid points.
+		 * The dense dataset is read instead, with one collective read, if
+		 * the concentrations were written with writeDenseConcentrations().
+		 *
+		 * @param positions The (i, j, k) indices of the grid points we own,
+		 *              -1 for the directions that are not used.
+		 * @return Concentrations associated with grid points we own,
+		 *              in the same order as the positions.  It is empty
+		 *              for the grid points without a dataset.
+		 */
+		Concs1DType readConcentrationDatasets(
+				const std::vector<std::array<int, 3> >& positions) const;
+
 		/**
 		 * Read the times from our timestep group.
 		 *
@@ -298,6 +379,18 @@ public:
 		// TODO remove once have added support for 0D, 2D, and 3D
 		// parallel reads of concentrations.
 		Data3DType readGridPoint(int i, int j = -1, int k = -1) const;
+
+	private:
+		/**
+		 * Read the dense concentrations of the given grid points, with
+		 * one collective read.
+		 *
+		 * @param points The sorted indices of the grid points in the
+		 *              dense dataset
+		 * @return The non-zero concentrations of each grid point
+		 */
+		Concs1DType readDenseConcentrations(
+				const std::vector<hsize_t>& points) const;
 	};
 
 	// Our concentrations group.
@@ -438,13 +531,100 @@ public:
 	};
 
 	// A group describing a network within our HDF5 file.
+	// The clusters and their reactions are stored by columns, in a few
+	// datasets read and written at once. Older files have one group per
+	// cluster instead (see ClusterGroup), they can still be read.
 	class NetworkGroup: public HDF5File::Group {
+	public:
+
+		/**
+		 * The properties of all the clusters, stored by columns.
+		 * The normal clusters come first, then the super clusters.
+		 */
+		struct ClusterTable {
+			//! The number of normal clusters
+			int normalSize = 0;
+			//! The number of super clusters
+			int superSize = 0;
+			//! The number of values in each composition
+			int compSize = 0;
+			//! The compositions of the normal clusters, compSize values each
+			std::vector<int> compositions;
+			//! The formation energy, migration energy and diffusion factor
+			//! of the normal clusters
+			std::vector<double> energies;
+			//! Where the coordinates of each PSI super cluster start in
+			//! heVList, superSize + 1 values
+			std::vector<int> heVOffsets;
+			//! The coordinates of the clusters contained in the PSI super
+			//! clusters, 4 values each
+			std::vector<int> heVList;
+			//! The bounds of the Fe super clusters, 4 values each
+			std::vector<int> bounds;
+			//! The total number of clusters, the average number of xenon and
+			//! the radius of the NE super clusters
+			std::vector<double> neProperties;
+		};
+
+		/**
+		 * The reactions of one kind of all the clusters, in compressed rows.
+		 * The reactions of the cluster i are the values from offsets[i] to
+		 * offsets[i + 1] in data, widths[i] values for each reaction.
+		 */
+		struct ReactionTable {
+			//! Where the reactions of each cluster start in data
+			std::vector<int64_t> offsets;
+			//! The number of values of each reaction of each cluster
+			std::vector<int> widths;
+			//! The ids and coefficients of the reactions
+			std::vector<double> data;
+		};
+
+		/**
+		 * The production, combination, dissociation and emission reactions.
+		 */
+		using ReactionTables = std::array<ReactionTable, 4>;
+
 	private:
 		// Names of network attributes.
 		static const std::string normalSizeAttrName;
 		static const std::string superSizeAttrName;
 		static const std::string phaseSpaceAttrName;
 
+		// Names of the cluster datasets.
+		static const std::string compositionsDataName;
+		static const std::string energiesDataName;
+		static const std::string heVOffsetsDataName;
+		static const std::string heVListDataName;
+		static const std::string boundsDataName;
+		static const std::string nePropertiesDataName;
+
+		// Names of the reaction datasets, the prefix is the kind of reaction.
+		static const std::array<std::string, 4> reactionPrefixes;
+		static const std::string offsetsDataSuffix;
+		static const std::string widthsDataSuffix;
+		static const std::string dataSuffix;
+
+		/**
+		 * Create an empty network group.
+		 *
+		 * @param file The file where to create the network group.
+		 * @param normalSize The number of normal clusters.
+		 * @param superSize The number of super clusters.
+		 * @param phaseSpace The phase space parameters.
+		 */
+		NetworkGroup(const XFile& file, int normalSize, int superSize,
+				const Array<int, 5>& phaseSpace);
+
+		/**
+		 * Write the clusters and reactions in our datasets.
+		 *
+		 * @param clusters The properties of the clusters.
+		 * @param reactions The reactions of the clusters.
+		 */
+		void writeTables(const ClusterTable& clusters,
+				const ReactionTables& reactions) const;
+
 	public:
 
 		// Path to the network group within our HDF5 file.
@@ -477,6 +657,27 @@ public:
 		 */
 		Array<int, 5> readNetworkSize(int &normalSize, int &superSize) const;
 
+		/**
+		 * Are the clusters stored by columns or in one group each?
+		 *
+		 * @return True if the clusters are stored by columns
+		 */
+		bool isColumnar(void) const;
+
+		/**
+		 * Read the properties of all the clusters, whatever the layout.
+		 *
+		 * @return The properties of the clusters.
+		 */
+		ClusterTable readClusters(void) const;
+
+		/**
+		 * Read the reactions of all the clusters, whatever the layout.
+		 *
+		 * @return The reactions of the clusters.
+		 */
+		ReactionTables readReactionTables(void) const;
+
 		/**
 		 * Read the reactions for every cluster.
 		 *
@@ -485,7 +686,33 @@ public:
 		void readReactions(IReactionNetwork& network) const;
 
 		/**
-		 * Copy ourself to the given file.
+		 * Put the clusters and reactions of a network in tables.
+		 *
+		 * @param network The network.
+		 * @param clusters The properties of the clusters.
+		 * @param reactions The reactions of the clusters.
+		 */
+		static void makeTables(IReactionNetwork& network,
+				ClusterTable& clusters, ReactionTables& reactions);
+
+		/**
+		 * Add the reactions from the tables to every cluster of a network.
+		 *
+		 * @param network The network with all its clusters.
+		 * @param reactions The reactions of the clusters.
+		 */
+		static void addReactions(IReactionNetwork& network,
+				ReactionTables& reactions);
+
+		/**
+		 * Replace the groups of the clusters by the columnar datasets.
+		 * The file must be open for writing, and the space used by the
+		 * groups is only given back by a copy of the file (h5repack).
+		 */
+		void convertToColumnar(void) const;
+
+		/**
+		 * Copy ourself to the given file, by columns.
 		 * A NetworkGroup must not already exist in the file.
 		 *
 		 * @param target The file to copy ourself to.
@@ -493,7 +720,8 @@ public:
 		void copyTo(const XFile& target) const;
 	};
 
-	// A group describing a cluster within our HDF5 file.
+	// A group describing a cluster within our HDF5 file, in the files
+	// written before the clusters were stored by columns.
 	class ClusterGroup: public HDF5File::Group {
 	public:
 		// Concise name for cluster representations.
@@ -529,14 +757,6 @@ public:
 		 */
 		ClusterGroup(const NetworkGroup& networkGroup, int id);
 
-		/**
-		 * Create a cluster group.
-		 *
-		 * @param networkGroup The group in which to write.
-		 * @param cluster The cluster.
-		 */
-		ClusterGroup(const NetworkGroup& networkGroup, IReactant& cluster);
-
 		/**
 		 * Construct the group name for the given time step.
 		 *
@@ -556,6 +776,20 @@ public:
 		clusterComp readCluster(double &formationEnergy, double &migrationEnergy,
 				double &diffusionFactor) const;
 
+		/**
+		 * Is it a PSI super cluster?
+		 *
+		 * @return True if the group contains the list of clusters.
+		 */
+		bool isPSISuperCluster(void) const;
+
+		/**
+		 * Is it a Fe super cluster?
+		 *
+		 * @return True if the group contains the bounds.
+		 */
+		bool isFeSuperCluster(void) const;
+
 		/**
 		 * Read the cluster properties from our group.
 		 *
@@ -580,12 +814,12 @@ public:
 		void readNESuperCluster(int &nTot, double &numXe, double &radius) const;
 
 		/**
-		 * Read the reactions from our group.
+		 * Read the reactions from our group and add them to the tables,
+		 * as the reactions of the next cluster.
 		 *
-		 * @param network The network that need the reactions.
-		 * @param cluster The cluster that needs reactions
+		 * @param reactions The tables of the reactions of the clusters.
 		 */
-		void readReactions(IReactionNetwork& network, IReactant& cluster) const;
+		void readReactions(NetworkGroup::ReactionTables& reactions) const;
 	};
 
 private:
@@ -86,15 +86,6 @@ public:
 			std::vector<IAdvectionHandler *> advectionHandlers,
 			std::vector<double> grid, int ny, double hy, int nz, double hz) = 0;
 
-	/**
-	 * This method update the rate for the modified trap-mutation if the rates
-	 * changed in the network, it should be called when temperature changes
-	 * for instance.
-	 *
-	 * @param network The network
-	 */
-	virtual void updateTrapMutationRate(const IReactionNetwork& network) = 0;
-
 	/**
 	 * This method set the boolean to remember if we want attenuation or not.
 	 *
@@ -137,6 +128,8 @@ public:
 	 * This method is called by the RHSJacobian from the PetscSolver.
 	 *
 	 * @param network The network
+	 * @param concOffset The pointer to the array of concentration at the grid
+	 * point where the trap-mutation is computed
 	 * @param val The pointer to the array that will contain the values of
 	 * partials for the trap-mutation
 	 * @param indices The pointer to the array that will contain the indices
@@ -150,8 +143,8 @@ public:
 	 * at this grid point
 	 */
 	virtual int computePartialsForTrapMutation(const IReactionNetwork& network,
-			double *val, int *indices, int xi, int xs, int yj = 0,
-			int zk = 0) = 0;
+			double *concOffset, double *val, int *indices, int xi, int xs,
+			int yj = 0, int zk = 0) = 0;
 
 	/**
 	 * Get the total number of clusters in the network that can undergo trap mutation.
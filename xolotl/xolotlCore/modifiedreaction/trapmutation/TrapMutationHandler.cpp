@@ -22,45 +22,12 @@ void TrapMutationHandler::initialize(const IReactionNetwork& network,
 	// If the I clusters are not in the network,
 	// there is no trap-mutation
 	if (!singleInterstitial || !doubleInterstitial || !tripleInterstitial) {
-		// Clear the vector of HeV indices created by He undergoing trap-mutation
-		// at each grid point
-		tmBubbles.clear();
-
-		// Change the value of ny and nz in 1D and 2D so that the same loop
-		// works in every case
-		if (nz == 0)
-			nz = 1;
-		if (ny == 0)
-			ny = 1;
-
-		// Loop on the grid points in the Z direction
-		// TODO even with the reserve ops, this might involve lots of
-		// separate memory allocations.
-		tmBubbles.reserve(nz);
-		for (int k = 0; k < nz; k++) {
-			// Create the temporary 2D vector
-			ReactantRefVector2D temp2DVector;
-
-			// Loop on the grid points in the Y direction
-			temp2DVector.reserve(ny);
-			for (int j = 0; j < ny; j++) {
-				// Create the temporary 1D vector
-				ReactantRefVector1D temp1DVector;
-
-				// Loop on the grid points in the depth direction
-				temp1DVector.reserve(grid.size() - 2);
-				for (int i = 0; i < grid.size() - 2; i++) {
-					// Indicate no bubbles at this grid point.
-					temp1DVector.emplace_back();
-				}
-
-				// Give the 1D vector to the 2D vector
-				temp2DVector.emplace_back(temp1DVector);
-			}
-
-			// Give the 2D vector to the final vector
-			tmBubbles.emplace_back(temp2DVector);
+		// No trap-mutation at any grid point
+		clearTrapMutations(network, grid.size() - 2, std::max(ny, 1));
+		for (int n = 0; n < std::max(nz, 1) * nyTM * nxTM; n++) {
+			nextGridPoint();
 		}
+
 		// Inform the user
 		int procId;
 		MPI_Comm_rank(MPI_COMM_WORLD, &procId);
@@ -113,9 +80,6 @@ void TrapMutationHandler::initialize(const IReactionNetwork& network,
 	// trap-mutates. Information about desorption is also initialized here.
 	initializeDepthSize(network.getTemperature());
 
-	// Update the bubble bursting rate
-	updateTrapMutationRate(network);
-
 	return;
 }
 
@@ -123,23 +87,17 @@ void TrapMutationHandler::initializeIndex1D(int surfacePos,
 		const IReactionNetwork& network,
 		std::vector<IAdvectionHandler *> advectionHandlers,
 		std::vector<double> grid) {
-	// Clear the vector of HeV indices created by He undergoing trap-mutation
-	// at each grid point
-	tmBubbles.clear();
+	// Start new trap-mutation tables
+	clearTrapMutations(network, grid.size() - 2);
 
 	// No GB trap mutation handler in 1D for now
 
-	// Create the temporary 2D vector
-	ReactantRefVector2D temp2DVector;
-	// Create the temporary 1D vector
-	ReactantRefVector1D temp1DVector;
-
 	// Loop on the grid points in the depth direction
 	for (int i = 0; i < grid.size() - 2; i++) {
 		// If we are on the left side of the surface there is no
 		// modified trap-mutation
 		if (i <= surfacePos) {
-			temp1DVector.emplace_back();
+			nextGridPoint();
 			continue;
 		}
 
@@ -148,42 +106,20 @@ void TrapMutationHandler::initializeIndex1D(int surfacePos,
 		double previousDepth = grid[i] - grid[surfacePos + 1];
 
 		// Loop on the depth vector
-		std::vector<std::reference_wrapper<IReactant> > indices;
 		for (int l = 0; l < depthVec.size(); l++) {
 			// Check if a helium cluster undergo TM at this depth
 			if (std::fabs(depth - depthVec[l]) < 0.01
 					|| (depthVec[l] - 0.01 < depth
 							&& depthVec[l] - 0.01 > previousDepth)) {
-				// Add the bubble of size l+1 to the indices
-				// Loop on the bubbles
-				for (auto const& heVMapItem : network.getAll(
-						ReactantType::PSIMixed)) {
-					// Get the bubble and its composition
-					auto& bubble =
-							static_cast<PSICluster&>(*(heVMapItem.second));
-					auto const& comp = bubble.getComposition();
-					// Get the correct bubble
-					if (comp[toCompIdx(Species::He)] == l + 1
-							&& comp[toCompIdx(Species::V)] == sizeVec[l]
-							&& comp[toCompIdx(Species::D)] == 0
-							&& comp[toCompIdx(Species::T)] == 0) {
-						// Add this bubble to the indices
-						indices.emplace_back(bubble);
-					}
-				}
+				// Add the bubble of size l+1
+				addTrapMutation(network, l + 1, sizeVec[l]);
 			}
 		}
 
-		// Add indices to the index vector
-		temp1DVector.emplace_back(indices);
+		// This grid point is done
+		nextGridPoint();
 	}
 
-	// Give the 1D vector to the 2D vector
-	temp2DVector.emplace_back(temp1DVector);
-
-	// Give the 2D vector to the final vector
-	tmBubbles.emplace_back(temp2DVector);
-
 	return;
 }
 
@@ -191,9 +127,8 @@ void TrapMutationHandler::initializeIndex2D(std::vector<int> surfacePos,
 		const IReactionNetwork& network,
 		std::vector<IAdvectionHandler *> advectionHandlers,
 		std::vector<double> grid, int ny, double hy) {
-	// Clear the vector of HeV indices created by He undergoing trap-mutation
-	// at each grid point
-	tmBubbles.clear();
+	// Start new trap-mutation tables
+	clearTrapMutations(network, grid.size() - 2, ny);
 
 	// Create a Sigma 3 trap mutation handler because it is the
 	// only one available right now
@@ -201,25 +136,14 @@ void TrapMutationHandler::initializeIndex2D(std::vector<int> surfacePos,
 	auto sigma3DistanceVec = sigma3Handler->getDistanceVector();
 	auto sigma3SizeVec = sigma3Handler->getSizeVector();
 
-	// Create the temporary 2D vector
-	ReactantRefVector2D temp2DVector;
-
 	// Loop on the grid points in the Y direction
-	temp2DVector.reserve(ny);
 	for (int j = 0; j < ny; j++) {
-
-		// Create the temporary 1D vector
-		ReactantRefVector1D temp1DVector;
-
 		// Loop on the grid points in the depth direction
 		for (int i = 0; i < grid.size() - 2; i++) {
-			// Create the list (vector) of indices at this grid point
-			std::vector<std::reference_wrapper<IReactant> > indices;
-
 			// If we are on the left side of the surface there is no
 			// modified trap-mutation
 			if (i <= surfacePos[j]) {
-				temp1DVector.push_back(indices);
+				nextGridPoint();
 				continue;
 			}
 
@@ -233,23 +157,8 @@ void TrapMutationHandler::initializeIndex2D(std::vector<int> surfacePos,
 				if (std::fabs(depth - depthVec[l]) < 0.01
 						|| (depthVec[l] - 0.01 < depth
 								&& depthVec[l] - 0.01 > previousDepth)) {
-					// Add the bubble of size l+1 to the indices
-					// Loop on the bubbles
-					for (auto const& heVMapItem : network.getAll(
-							ReactantType::PSIMixed)) {
-						// Get the bubble and its composition
-						auto& bubble =
-								static_cast<PSICluster&>(*(heVMapItem.second));
-						auto const& comp = bubble.getComposition();
-						// Get the correct bubble
-						if (comp[toCompIdx(Species::He)] == l + 1
-								&& comp[toCompIdx(Species::V)] == sizeVec[l]
-								&& comp[toCompIdx(Species::D)] == 0
-								&& comp[toCompIdx(Species::T)] == 0) {
-							// Add this bubble to the indices
-							indices.emplace_back(bubble);
-						}
-					}
+					// Add the bubble of size l+1
+					addTrapMutation(network, l + 1, sizeVec[l]);
 				}
 			}
 
@@ -265,49 +174,17 @@ void TrapMutationHandler::initializeIndex2D(std::vector<int> surfacePos,
 				for (int l = 0; l < sigma3DistanceVec.size(); l++) {
 					// Check if a helium cluster undergo TM at this depth
 					if (std::fabs(distance - sigma3DistanceVec[l]) < 0.01) {
-						// Add the bubble of size l+1 to the indices
-						// Loop on the bubbles
-						for (auto const& heVMapItem : network.getAll(
-								ReactantType::PSIMixed)) {
-							// Get the bubble and its composition
-							auto& bubble =
-									static_cast<PSICluster&>(*(heVMapItem.second));
-							auto const& comp = bubble.getComposition();
-							// Get the correct bubble
-							if (comp[toCompIdx(Species::He)] == l + 1
-									&& comp[toCompIdx(Species::V)]
-											== sigma3SizeVec[l]
-									&& comp[toCompIdx(Species::D)] == 0
-									&& comp[toCompIdx(Species::T)] == 0) {
-								// Check if this bubble is already 
-								// associated with this grid point.
-								auto biter =
-										std::find_if(indices.begin(),
-												indices.end(),
-												[&bubble](const IReactant& testReactant) {
-													return testReactant.getId() == bubble.getId();
-												});
-								if (biter == indices.end()) {
-									// Add this bubble to the indices
-									indices.emplace_back(bubble);
-								}
-							}
-						}
+						// Add the bubble of size l+1
+						addTrapMutation(network, l + 1, sigma3SizeVec[l]);
 					}
 				}
 			}
 
-			// Add indices to the index vector
-			temp1DVector.push_back(indices);
+			// This grid point is done
+			nextGridPoint();
 		}
-
-		// Give the 1D vector to the 2D vector
-		temp2DVector.push_back(temp1DVector);
 	}
 
-	// Give the 2D vector to the final vector
-	tmBubbles.push_back(temp2DVector);
-
 	// Clear the memory
 	delete sigma3Handler;
 
@@ -319,9 +196,8 @@ void TrapMutationHandler::initializeIndex3D(
 		const IReactionNetwork& network,
 		std::vector<IAdvectionHandler *> advectionHandlers,
 		std::vector<double> grid, int ny, double hy, int nz, double hz) {
-	// Clear the vector of HeV indices created by He undergoing trap-mutation
-	// at each grid point
-	tmBubbles.clear();
+	// Start new trap-mutation tables
+	clearTrapMutations(network, grid.size() - 2, ny);
 
 	// Create a Sigma 3 trap mutation handler because it is the
 	// only one available right now
@@ -330,27 +206,15 @@ void TrapMutationHandler::initializeIndex3D(
 	auto sigma3SizeVec = sigma3Handler->getSizeVector();
 
 	// Loop on the grid points in the Z direction
-	tmBubbles.reserve(nz);
 	for (int k = 0; k < nz; k++) {
-
-		// Create the temporary 2D vector
-		ReactantRefVector2D temp2DVector;
-
 		// Loop on the grid points in the Y direction
-		temp2DVector.reserve(ny);
 		for (int j = 0; j < ny; j++) {
-			// Create the temporary 1D vector
-			ReactantRefVector1D temp1DVector;
-
 			// Loop on the grid points in the depth direction
 			for (int i = 0; i < grid.size() - 2; i++) {
-				// Create the list (vector) of indices at this grid point
-				std::vector<std::reference_wrapper<IReactant> > indices;
-
 				// If we are on the left side of the surface there is no
 				// modified trap-mutation
 				if (i <= surfacePos[j][k]) {
-					temp1DVector.emplace_back(indices);
+					nextGridPoint();
 					continue;
 				}
 
@@ -364,23 +228,8 @@ void TrapMutationHandler::initializeIndex3D(
 					if (std::fabs(depth - depthVec[l]) < 0.01
 							|| (depthVec[l] - 0.01 < depth
 									&& depthVec[l] - 0.01 > previousDepth)) {
-						// Add the bubble of size l+1 to the indices
-						// Loop on the bubbles
-						for (auto const& heVMapItem : network.getAll(
-								ReactantType::PSIMixed)) {
-							// Get the bubble and its composition
-							auto& bubble =
-									static_cast<PSICluster&>(*(heVMapItem.second));
-							auto const& comp = bubble.getComposition();
-							// Get the correct bubble
-							if (comp[toCompIdx(Species::He)] == l + 1
-									&& comp[toCompIdx(Species::V)] == sizeVec[l]
-									&& comp[toCompIdx(Species::D)] == 0
-									&& comp[toCompIdx(Species::T)] == 0) {
-								// Add this bubble to the indices
-								indices.emplace_back(bubble);
-							}
-						}
+						// Add the bubble of size l+1
+						addTrapMutation(network, l + 1, sizeVec[l]);
 					}
 				}
 
@@ -397,48 +246,16 @@ void TrapMutationHandler::initializeIndex3D(
 					for (int l = 0; l < sigma3DistanceVec.size(); l++) {
 						// Check if a helium cluster undergo TM at this depth
 						if (std::fabs(distance - sigma3DistanceVec[l]) < 0.01) {
-							// Add the bubble of size l+1 to the indices
-							// Loop on the bubbles
-							for (auto const& heVMapItem : network.getAll(
-									ReactantType::PSIMixed)) {
-								// Get the bubble and its composition
-								auto& bubble =
-										static_cast<PSICluster&>(*(heVMapItem.second));
-								auto const& comp = bubble.getComposition();
-								// Get the correct bubble
-								if (comp[toCompIdx(Species::He)] == l + 1
-										&& comp[toCompIdx(Species::V)]
-												== sigma3SizeVec[l]
-										&& comp[toCompIdx(Species::D)] == 0
-										&& comp[toCompIdx(Species::T)] == 0) {
-									// Check if this bubble is already
-									// associated with this grid point.
-									auto biter =
-											std::find_if(indices.begin(),
-													indices.end(),
-													[&bubble](const IReactant& testReactant) {
-														return testReactant.getId() == bubble.getId();
-													});
-									if (biter == indices.end()) {
-										// Add this bubble to the indices
-										indices.emplace_back(bubble);
-									}
-								}
-							}
+							// Add the bubble of size l+1
+							addTrapMutation(network, l + 1, sigma3SizeVec[l]);
 						}
 					}
 				}
 
-				// Add indices to the index vector
-				temp1DVector.push_back(indices);
+				// This grid point is done
+				nextGridPoint();
 			}
-
-			// Give the 1D vector to the 2D vector
-			temp2DVector.push_back(temp1DVector);
 		}
-
-		// Give the 2D vector to the final vector
-		tmBubbles.push_back(temp2DVector);
 	}
 
 	// Clear the memory
@@ -447,11 +264,50 @@ void TrapMutationHandler::initializeIndex3D(
 	return;
 }
 
-void TrapMutationHandler::updateTrapMutationRate(
-		const IReactionNetwork& network) {
-	// Multiply the biggest rate in the network by 1000.0
-	// so that trap-mutation overcomes any other reaction
-	kMutation = 1000.0 * network.getBiggestRate();
+void TrapMutationHandler::clearTrapMutations(const IReactionNetwork& network,
+		int nx, int ny) {
+	// Forget the previous tables
+	tmReactions.clear();
+	tmStart.clear();
+	tmStart.push_back(0);
+	nxTM = nx;
+	nyTM = ny;
+
+	// Get the helium cluster that desorpts, its rate is needed at each call
+	desorptingCluster = nullptr;
+	if (desorp.size > 0)
+		desorptingCluster = (PSICluster *) network.get(Species::He,
+				desorp.size);
+
+	return;
+}
+
+void TrapMutationHandler::addTrapMutation(const IReactionNetwork& network,
+		int heSize, int vSize) {
+	// Get the bubble with heSize helium and vSize vacancies
+	IReactant::Composition comp;
+	comp[toCompIdx(Species::He)] = heSize;
+	comp[toCompIdx(Species::V)] = vSize;
+	auto bubble = network.get(ReactantType::PSIMixed, comp);
+	// Get the helium cluster with the same number of He
+	auto heCluster = network.get(Species::He, heSize);
+	// Get the interstitial cluster with the same number of I as the number
+	// of vacancies in the bubble
+	auto iCluster = network.get(Species::I, vSize);
+	if (!bubble || !heCluster || !iCluster)
+		return;
+
+	// Check if this bubble is already associated with this grid point
+	int bubbleIndex = bubble->getId() - 1;
+	auto biter = std::find_if(tmReactions.begin() + tmStart.back(),
+			tmReactions.end(), [bubbleIndex](const TrapMutation& tm) {
+				return tm.bubbleIndex == bubbleIndex;
+			});
+	if (biter != tmReactions.end())
+		return;
+
+	tmReactions.emplace_back(heCluster->getId() - 1, bubbleIndex,
+			iCluster->getId() - 1, heCluster == desorptingCluster);
 
 	return;
 }
@@ -474,37 +330,29 @@ void TrapMutationHandler::computeTrapMutation(const IReactionNetwork& network,
 		double *concOffset, double *updatedConcOffset, int xi, int xs, int yj,
 		int zk) {
 
+	// Get the trap-mutations at this grid point
+	int n = (zk * nyTM + yj) * nxTM + xi;
+	auto tmBegin = tmReactions.data() + tmStart[n];
+	auto tmEnd = tmReactions.data() + tmStart[n + 1];
+
+	// Multiply the biggest rate in the network at this grid point by 1000.0
+	// so that trap-mutation overcomes any other reaction
+	const double kMutation = 1000.0 * network.getBiggestRate(xi + 1 - xs);
+
 	// Initialize the rate of the reaction
 	double rate = 0.0;
 
 	// Loop on the list
-	for (IReactant const& currReactant : tmBubbles[zk][yj][xi]) {
-
-		// Get the stored bubble and its ID
-		auto const& bubble = static_cast<PSICluster const&>(currReactant);
-		auto bubbleIndex = bubble.getId() - 1;
-
-		// Get the helium cluster with the same number of He and its ID
-		// Note this composition has nonzero entries for both He and I,
-		// so we can't use the network's get function that takes a composition.
-		auto& comp = bubble.getComposition();
-		auto heCluster = (PSICluster *) network.get(Species::He,
-				comp[toCompIdx(Species::He)]);
-		auto heIndex = heCluster->getId() - 1;
-
-		// Get the interstitial cluster with the same number of I as the number
-		// of vacancies in the bubble and its ID
-		auto iCluster = (PSICluster *) network.get(Species::I,
-				comp[toCompIdx(Species::V)]);
-		auto iIndex = iCluster->getId() - 1;
+	for (auto tm = tmBegin; tm != tmEnd; ++tm) {
 
 		// Get the initial concentration of helium
-		double oldConc = concOffset[heIndex];
+		double oldConc = concOffset[tm->heIndex];
 
 		// Check the desorption
-		if (comp[toCompIdx(Species::He)] == desorp.size) {
+		if (tm->desorpts) {
 			// Get the left side rate (combination + emission)
-			double totalRate = heCluster->getLeftSideRate(xi + 1 - xs);
+			double totalRate = desorptingCluster->getLeftSideRate(concOffset,
+					xi + 1 - xs);
 			// Define the trap-mutation rate taking into account the desorption
 			rate = kDis * totalRate * (1.0 - desorp.portion) / desorp.portion;
 		} else {
@@ -512,17 +360,26 @@ void TrapMutationHandler::computeTrapMutation(const IReactionNetwork& network,
 		}
 
 		// Update the concentrations (the helium cluster loses its concentration)
-		updatedConcOffset[heIndex] -= rate * oldConc;
-		updatedConcOffset[bubbleIndex] += rate * oldConc;
-		updatedConcOffset[iIndex] += rate * oldConc;
+		updatedConcOffset[tm->heIndex] -= rate * oldConc;
+		updatedConcOffset[tm->bubbleIndex] += rate * oldConc;
+		updatedConcOffset[tm->iIndex] += rate * oldConc;
 	}
 
 	return;
 }
 
 int TrapMutationHandler::computePartialsForTrapMutation(
-		const IReactionNetwork& network, double *val, int *indices, int xi,
-		int xs, int yj, int zk) {
+		const IReactionNetwork& network, double *concOffset, double *val,
+		int *indices, int xi, int xs, int yj, int zk) {
+
+	// Get the trap-mutations at this grid point
+	int n = (zk * nyTM + yj) * nxTM + xi;
+	auto tmBegin = tmReactions.data() + tmStart[n];
+	auto tmEnd = tmReactions.data() + tmStart[n + 1];
+
+	// Multiply the biggest rate in the network at this grid point by 1000.0
+	// so that trap-mutation overcomes any other reaction
+	const double kMutation = 1000.0 * network.getBiggestRate(xi + 1 - xs);
 
 	// Initialize the rate of the reaction
 	double rate = 0.0;
@@ -531,30 +388,13 @@ int TrapMutationHandler::computePartialsForTrapMutation(
 	// TODO Relying on convention for indices in indices/vals arrays is
 	// error prone - could be done with multiple parallel arrays.
 	uint32_t i = 0;
-	for (IReactant const& currReactant : tmBubbles[zk][yj][xi]) {
-
-		// Get the stored bubble and its ID
-		auto const& bubble = static_cast<PSICluster const&>(currReactant);
-		auto bubbleIndex = bubble.getId() - 1;
-
-		// Get the helium cluster with the same number of He and its ID
-		// Note this composition has non-zero entries for both He and I.
-		// so we can't use the network's get function that takes a composition.
-		auto const& comp = bubble.getComposition();
-		auto heCluster = (PSICluster *) network.get(Species::He,
-				comp[toCompIdx(Species::He)]);
-		auto heIndex = heCluster->getId() - 1;
-
-		// Get the interstitial cluster with the same number of I as the number
-		// of vacancies in the bubble and its ID
-		auto iCluster = (PSICluster *) network.get(Species::I,
-				comp[toCompIdx(Species::V)]);
-		auto iIndex = iCluster->getId() - 1;
+	for (auto tm = tmBegin; tm != tmEnd; ++tm) {
 
 		// Check the desorption
-		if (comp[toCompIdx(Species::He)] == desorp.size) {
+		if (tm->desorpts) {
 			// Get the left side rate (combination + emission)
-			double totalRate = heCluster->getLeftSideRate(xi + 1 - xs);
+			double totalRate = desorptingCluster->getLeftSideRate(concOffset,
+					xi + 1 - xs);
 			// Define the trap-mutation rate taking into account the desorption
 			rate = kDis * totalRate * (1.0 - desorp.portion) / desorp.portion;
 		} else {
@@ -563,22 +403,22 @@ int TrapMutationHandler::computePartialsForTrapMutation(
 
 		// Set the helium cluster partial derivative
 		auto baseIndex = i * 3;
-		indices[baseIndex] = heIndex;
+		indices[baseIndex] = tm->heIndex;
 		val[baseIndex] = -rate;
 
 		// Set the bubble cluster partial derivative
-		indices[(baseIndex) + 1] = bubbleIndex;
+		indices[(baseIndex) + 1] = tm->bubbleIndex;
 		val[(baseIndex) + 1] = rate;
 
 		// Set the interstitial cluster partial derivative
-		indices[(baseIndex) + 2] = iIndex;
+		indices[(baseIndex) + 2] = tm->iIndex;
 		val[(baseIndex) + 2] = rate;
 
 		// Advance to next indices/vals index.
 		++i;
 	}
 
-	return (tmBubbles[zk][yj][xi]).size();
+	return tmEnd - tmBegin;
 }
 
 }/* end namespace xolotlCore */
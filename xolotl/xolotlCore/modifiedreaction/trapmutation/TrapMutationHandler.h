@@ -46,9 +46,6 @@ protected:
 	//! The vector containing the different vacancy size for the modified trap-mutation
 	std::vector<int> sizeVec;
 
-	//! The trap-mutation rate
-	double kMutation;
-
 	//! The disappearing rate
 	double kDis;
 
@@ -56,15 +53,47 @@ protected:
 	bool attenuation;
 
 	/**
-	 * The vector containing the indices of the bubbles created through modified
-	 * trap-mutation for each grid point. The difference between this vector and depthVec
-	 * is that this one is used for the actual computation whereas the other one is
-	 * defined by the user. tmBubbles is created with the depthVec information.
+	 * This is a protected class used to store one trap-mutation allowed at
+	 * a grid point, with the indices of the clusters involved.
+	 */
+	class TrapMutation {
+	public:
+
+		//! The index of the helium cluster that trap-mutates
+		int heIndex;
+
+		//! The index of the bubble created by the trap-mutation
+		int bubbleIndex;
+
+		//! The index of the interstitial cluster created by the trap-mutation
+		int iIndex;
+
+		//! Whether the helium cluster is also the one that desorpts
+		bool desorpts;
+
+		//! The constructor
+		TrapMutation(int he, int bubble, int i, bool d) :
+				heIndex(he), bubbleIndex(bubble), iIndex(i), desorpts(d) {
+		}
+	};
+
+	/**
+	 * The trap-mutations allowed at each grid point, one grid point after the
+	 * other. The ones at (xi, yj, zk) go from tmStart[n] to tmStart[n + 1]
+	 * with n = (zk * nyTM + yj) * nxTM + xi. They are built with the depthVec
+	 * information by initializeIndex*D, whenever the surface moves, so that
+	 * computing the fluxes and partials does not have to look up the clusters.
 	 */
-	using ReactantRefVector1D = std::vector<IReactant::RefVector>;
-	using ReactantRefVector2D = std::vector<ReactantRefVector1D>;
-	using ReactantRefVector3D = std::vector<ReactantRefVector2D>;
-	ReactantRefVector3D tmBubbles;
+	std::vector<TrapMutation> tmReactions;
+
+	//! Where the trap-mutations of each grid point start in tmReactions
+	std::vector<int> tmStart;
+
+	//! The number of grid points in the depth and Y directions
+	int nxTM, nyTM;
+
+	//! The helium cluster that desorpts, nullptr if there is none
+	PSICluster *desorptingCluster;
 
 	/**
 	 * The desorption information
@@ -85,13 +114,44 @@ protected:
 		return;
 	}
 
+	/**
+	 * Start new trap-mutation tables, nothing is allowed yet.
+	 *
+	 * @param network The network
+	 * @param nx The number of grid points in the depth direction
+	 * @param ny The number of grid points in the Y direction
+	 */
+	void clearTrapMutations(const IReactionNetwork& network, int nx,
+			int ny = 1);
+
+	/**
+	 * Allow the trap-mutation of the helium cluster of the given size into
+	 * the bubble with the given number of vacancies at the grid point being
+	 * defined, if it is not already allowed there.
+	 *
+	 * @param network The network
+	 * @param heSize The size of the helium cluster
+	 * @param vSize The number of vacancies in the created bubble
+	 */
+	void addTrapMutation(const IReactionNetwork& network, int heSize,
+			int vSize);
+
+	/**
+	 * Close the list of trap-mutations of the grid point being defined
+	 * and start the one of the next grid point.
+	 */
+	void nextGridPoint() {
+		tmStart.push_back(tmReactions.size());
+	}
+
 public:
 
 	/**
 	 * The constructor
 	 */
 	TrapMutationHandler() :
-			kMutation(0.0), kDis(1.0), attenuation(true), desorp(0, 0.0) {
+			kDis(1.0), attenuation(true), nxTM(0), nyTM(1),
+					desorptingCluster(nullptr), desorp(0, 0.0) {
 	}
 
 	/**
@@ -146,15 +206,6 @@ public:
 			std::vector<IAdvectionHandler *> advectionHandlers,
 			std::vector<double> grid, int ny, double hy, int nz, double hz);
 
-	/**
-	 * This method update the rate for the modified trap-mutation if the rates
-	 * changed in the network, it should be called when temperature changes
-	 * for instance.
-	 *
-	 * @param network The network
-	 */
-	void updateTrapMutationRate(const IReactionNetwork& network);
-
 	/**
 	 * This method set the boolean to remember if we want attenuation or not.
 	 *
@@ -199,7 +250,8 @@ public:
 	 * \see ITrapMutationHandler.h
 	 */
 	int computePartialsForTrapMutation(const IReactionNetwork& network,
-			double *val, int *indices, int xi, int xs, int yj = 0, int zk = 0);
+			double *concOffset, double *val, int *indices, int xi, int xs,
+			int yj = 0, int zk = 0);
 
 	/**
 	 * Get the total number of clusters in the network that can undergo trap mutation.
@@ -7,7 +7,7 @@ operator<<(std::ostream& os, const DissociationReaction& reaction) {
 
 	os << '[' << "diss: " << reaction.dissociating << "; " << "first: "
 			<< reaction.first << "; " << "second: " << reaction.second << "; "
-			<< "rate: " << reaction.kConstant.size() << "; " << "reverse: [";
+			<< "rate index: " << reaction.getRateIndex() << "; " << "reverse: [";
 	if (reaction.reverseReaction) {
 		os << *(reaction.reverseReaction);
 	} else {
@@ -506,6 +506,18 @@ public:
 	 */
 	virtual double getLeftSideRate(int i) const = 0;
 
+	/**
+	 * This operation returns the same rate as getLeftSideRate(int), with
+	 * the concentrations of the other reactants read from the given array
+	 * instead of the ones stored in the reactants.
+	 *
+	 * @param concentrations The concentrations at this grid point
+	 * @param i The position on the grid
+	 * @return The rate
+	 */
+	virtual double getLeftSideRate(const double *concentrations,
+			int i) const = 0;
+
 	/**
 	 * This operation returns the vector of production reactions in which
 	 * this cluster is involved, containing the id of the reactants, the rate, and
@@ -5,6 +5,7 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <mpi.h>
 #include "NDArray.h"
 #include "IReactant.h"
 
@@ -193,6 +194,32 @@ public:
 	virtual DissociationReaction& add(
 			std::unique_ptr<DissociationReaction> reaction) = 0;
 
+	/**
+	 * Add the production reaction between the two reactants to the network.
+	 * It is only constructed, in place, if the network does not know it yet.
+	 *
+	 * @param r1 The first reactant
+	 * @param r2 The second reactant
+	 * @return The reaction that is now in the network
+	 */
+	virtual ProductionReaction& addProductionReaction(IReactant& r1,
+			IReactant& r2) = 0;
+
+	/**
+	 * Add the dissociation reaction of a reactant into two others to the
+	 * network. It is only constructed, in place, if the network does not
+	 * know it yet.
+	 *
+	 * @param dissociating The dissociating reactant
+	 * @param r1 The first emitted reactant
+	 * @param r2 The second emitted reactant
+	 * @param reverse The reverse production reaction
+	 * @return The reaction that is now in the network
+	 */
+	virtual DissociationReaction& addDissociationReaction(
+			IReactant& dissociating, IReactant& r1, IReactant& r2,
+			ProductionReaction* reverse) = 0;
+
 	/**
 	 * This operation fills an array of doubles with the concentrations of all
 	 * of the reactants in the network.
@@ -213,7 +240,7 @@ public:
 	 * array. Properly aligning the array in memory so that this operation
 	 * does not overrun is up to the caller.
 	 */
-	virtual void updateConcentrationsFromArray(double * concentrations) = 0;
+	virtual void updateConcentrationsFromArray(const double * concentrations) = 0;
 
 	/**
 	 * Get the diagonal fill for the Jacobian, corresponding to the reactions.
@@ -277,6 +304,20 @@ public:
 	 */
 	virtual void computeAllFluxes(double *updatedConcOffset, int i = 0) = 0;
 
+	/**
+	 * Compute the fluxes generated by all the reactions
+	 * for all the clusters and their momentum, reading the concentrations
+	 * directly from the given array instead of the state of the reactants.
+	 *
+	 * @param concOffset The pointer to the array of the concentration at the grid
+	 * point where the fluxes are computed
+	 * @param updatedConcOffset The pointer to the array of the concentration at the grid
+	 * point where the fluxes are computed used to find the next solution
+	 * @param i The location on the grid in the depth direction
+	 */
+	virtual void computeAllFluxes(const double *concOffset,
+			double *updatedConcOffset, int i = 0) = 0;
+
 	/**
 	 * Determine the number of partials for each cluster
 	 * and their starting locations within the vectors used
@@ -318,11 +359,57 @@ public:
 			std::vector<double>& vals, int i = 0) const = 0;
 
 	/**
-	 * This operation returns the biggest production rate in the network.
+	 * Compute the partial derivatives generated by all the reactions
+	 * for all the clusters and their momentum, reading the concentrations
+	 * directly from the given array instead of the state of the reactants.
 	 *
+	 * @param concOffset The pointer to the array of the concentration at the grid
+	 * point where the partials are computed
+	 * @param startingIdx Starting index of items owned by each reactant
+	 *      within the partials values array and the indices array.
+	 * @param indices The indices of the clusters for the partial derivatives.
+	 * @param vals The values of partials for the reactions
+	 * @param i The location on the grid in the depth direction
+	 */
+	virtual void computeAllPartials(const double *concOffset,
+			const std::vector<size_t>& startingIdx,
+			const std::vector<int>& indices, std::vector<double>& vals,
+			int i = 0) = 0;
+
+	/**
+	 * Can the array based computeAllFluxes() and computeAllPartials() be
+	 * called concurrently from several threads for different grid points?
+	 * This is only true if they do not modify the state of the network.
+	 *
+	 * @return True if the grid point loops can be threaded
+	 */
+	virtual bool isThreadSafe() const = 0;
+
+	/**
+	 * Move the reaction data that does not change anymore to memory shared
+	 * by the processes of the same node. Has to be called by all the
+	 * processes of comm, after getDiagonalFill().
+	 *
+	 * @param comm The processes having the same network
+	 * @return True if the data is shared
+	 */
+	virtual bool shareOnNode(MPI_Comm comm) = 0;
+
+	/**
+	 * Move the reaction data shared with shareOnNode() back to the memory of
+	 * each process and free the shared memory. Has to be called by all the
+	 * processes that shared it, before MPI is finalized.
+	 */
+	virtual void releaseShared() = 0;
+
+	/**
+	 * This operation returns the biggest production rate in the network
+	 * at the given grid point.
+	 *
+	 * @param i The location on the grid in the depth direction
 	 * @return The biggest rate
 	 */
-	virtual double getBiggestRate() const = 0;
+	virtual double getBiggestRate(int i = 0) const = 0;
 
 	/**
 	 * Are dissociations enabled?
@@ -348,6 +435,15 @@ public:
 	 */
 	virtual Array<int, 5> getPhaseSpaceList() const = 0;
 
+	/**
+	 * Set the width of the temperature buckets sharing the same rate
+	 * constants. With 0 only the grid points at identical temperatures share
+	 * them and a negative value disables the sharing.
+	 *
+	 * @param tolerance The tolerance in K
+	 */
+	virtual void setRateCacheTolerance(double tolerance) = 0;
+
 	/**
 	 * This operation sets the fission rate, needed to compute the diffusion coefficient
 	 * in NE.
@@ -6,7 +6,7 @@ std::ostream&
 operator<<(std::ostream& os, const ProductionReaction& reaction) {
 
 	os << '[' << "first: " << reaction.first << "; " << "second: "
-			<< reaction.second << "; " << "rate: " << reaction.kConstant.size() << ']';
+			<< reaction.second << "; " << "rate index: " << reaction.getRateIndex() << ']';
 
 	return os;
 }
@@ -0,0 +1,51 @@
+#include "RateConstants.h"
+#include <algorithm>
+
+using namespace xolotlCore;
+
+void RateConstants::reallocate(int newStride, int headRoom) {
+	// Copy the rows in the new block
+	std::vector<double> newValues((headRoom + nGridPoints) * newStride, 0.0);
+	for (int i = 0; i < nGridPoints; i++) {
+		auto row = getRow(i);
+		std::copy(row, row + nRates,
+				newValues.begin() + (headRoom + i) * newStride);
+	}
+
+	values.swap(newValues);
+	stride = newStride;
+	firstRow = headRoom;
+
+	return;
+}
+
+int RateConstants::addRate() {
+	// Increase the size of the rows if there is no more padding
+	if (nRates == stride) {
+		reallocate(stride + rowPadding, firstRow);
+	}
+
+	// The new rate is already 0 in every row
+	return nRates++;
+}
+
+void RateConstants::addGridPoints(int i) {
+	// Add grid points
+	if (i > 0) {
+		// Keep at least as many empty rows in front as there are grid points
+		// to make the cost of adding them one by one constant
+		if (i > firstRow) {
+			reallocate(stride, std::max(i, nGridPoints));
+		}
+
+		firstRow -= i;
+		nGridPoints += i;
+		std::fill(getRow(0), getRow(i), 0.0);
+	} else {
+		// The removed rows become empty rows
+		firstRow -= i;
+		nGridPoints += i;
+	}
+
+	return;
+}
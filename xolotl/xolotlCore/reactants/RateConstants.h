@@ -0,0 +1,132 @@
+#ifndef XCORE_RATE_CONSTANTS_H
+#define XCORE_RATE_CONSTANTS_H
+
+// Includes
+#include <vector>
+
+namespace xolotlCore {
+
+/**
+ * This class stores the rate constants of all the reactions of a network
+ * at every local grid point in one contiguous block.
+ *
+ * The block is grid-major: the rates of all the reactions at a given grid
+ * point are contiguous (a row), ordered by the rate index given to each
+ * reaction by addRate(). Rows are padded to a multiple of 8 doubles (a cache
+ * line) so that each row starts on its own line relative to the block.
+ *
+ * Some empty rows are kept in front of the first grid point so that adding
+ * grid points at the beginning, as when the surface moves, only shifts the
+ * position of the first row instead of moving every rate.
+ */
+class RateConstants {
+
+private:
+
+	//! The number of doubles the rows are padded to
+	static const int rowPadding = 8;
+
+	//! All the values, including the padding and the empty rows in front
+	std::vector<double> values;
+
+	//! The number of rates in each row
+	int nRates = 0;
+
+	//! The number of doubles between two rows
+	int stride = 0;
+
+	//! The number of grid points
+	int nGridPoints = 0;
+
+	//! The row of values where the first grid point starts
+	int firstRow = 0;
+
+	/**
+	 * Move the values to a new block.
+	 *
+	 * @param newStride The new number of doubles between two rows
+	 * @param headRoom The number of empty rows to keep in front
+	 */
+	void reallocate(int newStride, int headRoom);
+
+public:
+
+	/**
+	 * The constructor.
+	 */
+	RateConstants() {
+	}
+
+	/**
+	 * Copy constructor, deleted to prevent use.
+	 */
+	RateConstants(const RateConstants& other) = delete;
+
+	/**
+	 * Add a rate to every grid point, initialized to 0.
+	 *
+	 * @return The index of the new rate
+	 */
+	int addRate();
+
+	/**
+	 * Add grid points at the beginning of the block, initialized to 0,
+	 * or remove them if the value is negative.
+	 *
+	 * @param i The number of grid points to add or remove
+	 */
+	void addGridPoints(int i);
+
+	/**
+	 * Get the number of rates.
+	 *
+	 * @return The number of rates
+	 */
+	int getNumRates() const {
+		return nRates;
+	}
+
+	/**
+	 * Get the number of grid points.
+	 *
+	 * @return The number of grid points
+	 */
+	int getNumGridPoints() const {
+		return nGridPoints;
+	}
+
+	/**
+	 * Get the rates at the given grid point, ordered by rate index.
+	 *
+	 * @param i The location on the grid in the depth direction
+	 * @return The pointer to the first rate
+	 */
+	double * getRow(int i) {
+		return values.data() + (firstRow + i) * stride;
+	}
+
+	/**
+	 * Get the rates at the given grid point, ordered by rate index.
+	 *
+	 * @param i The location on the grid in the depth direction
+	 * @return The pointer to the first rate
+	 */
+	const double * getRow(int i) const {
+		return values.data() + (firstRow + i) * stride;
+	}
+
+	/**
+	 * Get one rate at the given grid point.
+	 *
+	 * @param i The location on the grid in the depth direction
+	 * @param r The index of the rate
+	 * @return The rate
+	 */
+	double get(int i, int r) const {
+		return values[(firstRow + i) * stride + r];
+	}
+};
+
+} /* namespace xolotlCore */
+
+#endif
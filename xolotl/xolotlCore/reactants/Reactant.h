@@ -771,6 +771,19 @@ public:
 		return 0.0;
 	}
 
+	/**
+	 * This operation returns the sum of combination rate and emission rate
+	 * with the concentrations of the given array.
+	 *
+	 * @param concentrations The concentrations at this grid point
+	 * @param i The position on the grid
+	 * @return The rate
+	 */
+	virtual double getLeftSideRate(const double *concentrations, int i) const
+			override {
+		return 0.0;
+	}
+
 	/**
 	 * This operation returns the vector of production reactions in which
 	 * this cluster is involved, containing the id of the reactants, the rate, and
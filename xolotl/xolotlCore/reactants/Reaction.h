@@ -2,13 +2,15 @@
 #define XCORE_REACTION_H
 
 #include "IReactant.h"
+#include "RateConstants.h"
 
 namespace xolotlCore {
 
 /**
  * This is a public class that is used to store a reaction.
  *
- * The constant k is stored here and other information is implemented by
+ * The constant k is stored by the network at every grid point, the reaction
+ * only knows its index in this storage. Other information is implemented by
  * the daughter classes. k is computed when setTemperature() is called.
  */
 class Reaction {
@@ -20,6 +22,16 @@ private:
 	 */
 	bool paramsCorrectlyOrdered;
 
+	/**
+	 * The storage of the rate constants, owned by the network
+	 */
+	const RateConstants* rateConstants;
+
+	/**
+	 * The index of the rate constant of this reaction in the storage
+	 */
+	int rateIndex;
+
 protected:
 	/**
 	 * Construct a Reaction.
@@ -27,18 +39,14 @@ protected:
 	 * @param _r2 The other reactant.
 	 */
 	Reaction(IReactant& _r1, IReactant& _r2) :
-			paramsCorrectlyOrdered(_r1.getComposition() < _r2.getComposition()), first(
+			paramsCorrectlyOrdered(_r1.getComposition() < _r2.getComposition()), rateConstants(
+					nullptr), rateIndex(-1), first(
 					paramsCorrectlyOrdered ? _r1 : _r2), second(
 					paramsCorrectlyOrdered ? _r2 : _r1) {
 	}
 
 public:
 
-	/**
-	 * The rate constant
-	 */
-	std::vector<double> kConstant;
-
 	/**
 	 * First cluster in reaction pair.
 	 * Reactant concentration guaranteed to be <= that of second cluster.
@@ -60,6 +68,38 @@ public:
 	 * Copy constructor, deleted to ensure we are constructed with reactants.
 	 */
 	Reaction(const Reaction& other) = delete;
+
+	/**
+	 * Set where the rate constant of this reaction is stored.
+	 * Called by the network when the reaction is added to it.
+	 *
+	 * @param storage The storage of the rate constants
+	 * @param index The index of the rate constant in the storage
+	 */
+	void setRateIndex(const RateConstants& storage, int index) {
+		rateConstants = &storage;
+		rateIndex = index;
+	}
+
+	/**
+	 * Get the index of the rate constant of this reaction in the
+	 * storage of the network.
+	 *
+	 * @return The rate index
+	 */
+	int getRateIndex() const {
+		return rateIndex;
+	}
+
+	/**
+	 * Get the rate constant at the given grid point.
+	 *
+	 * @param i The location on the grid in the depth direction
+	 * @return The rate constant
+	 */
+	double getRateConstant(int i) const {
+		return rateConstants->get(i, rateIndex);
+	}
 };
 
 /**
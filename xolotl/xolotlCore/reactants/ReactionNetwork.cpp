@@ -2,6 +2,7 @@
 #include <xolotlPerf.h>
 #include <iostream>
 #include <cassert>
+#include <cmath>
 
 namespace xolotlCore {
 
@@ -11,7 +12,18 @@ ReactionNetwork::ReactionNetwork(
 		std::shared_ptr<xolotlPerf::IHandlerRegistry> _registry) :
 		knownReactantTypes(_knownReactantTypes), superClusterType(
 				_superClusterType), handlerRegistry(_registry), temperature(
-				0.0), dissociationsEnabled(true) {
+				0.0), rateCacheTolerance(0.0), dissociationsEnabled(true) {
+
+	// Create the counters for the rate cache
+	rateCacheHitCounter = handlerRegistry->getEventCounter("rateCacheHits");
+	rateCacheMissCounter = handlerRegistry->getEventCounter("rateCacheMisses");
+
+	// Create the thread-safe timers and counters of the reaction kernels
+	reactionFluxTimer = handlerRegistry->getHotTimer("reactionFluxes");
+	reactionPartialsTimer = handlerRegistry->getHotTimer("reactionPartials");
+	reactionFluxCounter = handlerRegistry->getHotCounter("reactionFluxCalls");
+	reactionPartialsCounter = handlerRegistry->getHotCounter(
+			"reactionPartialsCalls");
 
 	// Ensure our per-type cluster map can store Reactants of the types
 	// we support.
@@ -91,23 +103,6 @@ IReactant * ReactionNetwork::get(ReactantType type,
 	return ret;
 }
 
-double ReactionNetwork::calculateReactionRateConstant(
-		const ProductionReaction& reaction, int i) const {
-	// Get the reaction radii
-	double r_first = reaction.first.getReactionRadius();
-	double r_second = reaction.second.getReactionRadius();
-
-	// Get the diffusion coefficients
-	double firstDiffusion = reaction.first.getDiffusionCoefficient(i);
-	double secondDiffusion = reaction.second.getDiffusionCoefficient(i);
-
-	// Calculate and return
-	double k_plus = 4.0 * xolotlCore::pi * (r_first + r_second)
-			* (firstDiffusion + secondDiffusion);
-
-	return k_plus;
-}
-
 void ReactionNetwork::fillConcentrationsArray(double * concentrations) {
 
 	// Fill the array
@@ -120,7 +115,7 @@ void ReactionNetwork::fillConcentrationsArray(double * concentrations) {
 	return;
 }
 
-void ReactionNetwork::updateConcentrationsFromArray(double * concentrations) {
+void ReactionNetwork::updateConcentrationsFromArray(const double * concentrations) {
 
 	std::for_each(allReactants.begin(), allReactants.end(),
 			[&concentrations](IReactant& currReactant) {
@@ -149,41 +144,62 @@ void ReactionNetwork::setTemperature(double temp, int i) {
 
 ProductionReaction& ReactionNetwork::add(
 		std::unique_ptr<ProductionReaction> reaction) {
-	// Ensure we know about the reaction.
+	// The reaction is rebuilt in place in the network
+	return addProductionReaction(reaction->first, reaction->second);
+}
+
+DissociationReaction& ReactionNetwork::add(
+		std::unique_ptr<DissociationReaction> reaction) {
+	// The reaction is rebuilt in place in the network
+	return addDissociationReaction(reaction->dissociating, reaction->first,
+			reaction->second, reaction->reverseReaction);
+}
+
+ProductionReaction& ReactionNetwork::addProductionReaction(IReactant& r1,
+		IReactant& r2) {
+	// Build the reaction at the end of the arena, its key is only
+	// known once it is built.
+	auto& reaction = productionReactions.emplace_back(r1, r2);
+
 	// Map's emplace() returns a pair (iter, bool) where
 	// iter points to the item in the map and the bool indicates
 	// whether it was added by this emplace() call.
-	auto key = reaction->descriptiveKey();
-	auto eret = productionReactionMap.emplace(key, std::move(reaction));
-	// Regardless of whether we added it in this emplace() call or not,
-	// the iter within eret refers to the desired reaction in the map.
-	return *(eret.first->second);
+	auto eret = productionReactionMap.emplace(reaction.descriptiveKey(),
+			&reaction);
+	if (!eret.second) {
+		// We already knew about the reaction, drop the new one
+		productionReactions.pop_back();
+		return *(eret.first->second);
+	}
+
+	// Give a rate constant to the new reaction
+	reaction.setRateIndex(rateConstants, rateConstants.addRate());
+
+	return reaction;
 }
 
-DissociationReaction& ReactionNetwork::add(
-		std::unique_ptr<DissociationReaction> reaction) {
-	// Unlike addProductionReaction, we use a check-add approach
-	// instead of emplace() because if the item isn't already in
-	// the network, we will need to contruct its reverse reaction.
+DissociationReaction& ReactionNetwork::addDissociationReaction(
+		IReactant& dissociating, IReactant& r1, IReactant& r2,
+		ProductionReaction* reverse) {
+	// Build the reaction at the end of the arena, its key is only
+	// known once it is built.
+	auto& reaction = dissociationReactions.emplace_back(dissociating, r1, r2,
+			reverse);
 
 	// Check if we already know about this reaction.
-	auto key = reaction->descriptiveKey();
-	auto iter = dissociationReactionMap.find(key);
-	if (iter != dissociationReactionMap.end()) {
+	auto eret = dissociationReactionMap.emplace(reaction.descriptiveKey(),
+			&reaction);
+	if (!eret.second) {
 		// We already knew about the reaction.
-		// Return the existing one.
-		return *(iter->second);
+		// Drop the new one and return the existing one.
+		dissociationReactions.pop_back();
+		return *(eret.first->second);
 	}
 
-	// Add the dissociation reaction to our set of known reactions.
-	auto eret = dissociationReactionMap.emplace(key, std::move(reaction));
-
-	// Since we checked earlier and the reaction wasn't in the map,
-	// our emplace() call should have added it.
-	assert(eret.second);
+	// Give a rate constant to the new reaction
+	reaction.setRateIndex(rateConstants, rateConstants.addRate());
 
-	// Return the newly-added dissociation reaction.
-	return *(eret.first->second);
+	return reaction;
 }
 
 void ReactionNetwork::removeReactants(
@@ -219,6 +235,9 @@ void ReactionNetwork::removeReactants(
 
 	allReactants.erase(result, allReactants.end());
 
+	// The gathered rate parameters may point to them
+	rateParameters.nRates = -1;
+
 	// ...Next, examine each type's collection of clusters and remove the
 	// doomed reactants.
 	for (auto currType : typesUsed) {
@@ -234,41 +253,158 @@ void ReactionNetwork::removeReactants(
 	return;
 }
 
-void ReactionNetwork::computeRateConstants(int i) {
-	// Local declarations
-	double rate = 0.0;
-	// Initialize the value for the biggest production rate
-	double biggestProductionRate = 0.0;
+void ReactionNetwork::gatherRateParameters() {
+	auto& params = rateParameters;
+	params = RateParameters();
+
+	// The index of each reactant in the diffusion coefficient array
+	std::unordered_map<const IReactant*, int> reactantIndices;
+	auto getIndex = [&params,&reactantIndices](const IReactant& reactant) {
+		auto eret = reactantIndices.emplace(&reactant, params.reactants.size());
+		if (eret.second)
+			params.reactants.push_back(&reactant);
+		return eret.first->second;
+	};
+
+	// Loop on all the production reactions, in the order they were created
+	for (std::size_t n = 0; n < productionReactions.size(); n++) {
+		auto& currReaction = productionReactions[n];
+		params.first.push_back(getIndex(currReaction.first));
+		params.second.push_back(getIndex(currReaction.second));
+		params.radiusSum.push_back(
+				currReaction.first.getReactionRadius()
+						+ currReaction.second.getReactionRadius());
+		params.productionRate.push_back(currReaction.getRateIndex());
+	}
+	params.diffusion.resize(params.reactants.size(), 0.0);
+
+	// Loop on all the dissociation reactions, in the order they were created
+	for (std::size_t n = 0; n < dissociationReactions.size(); n++) {
+		auto& currReaction = dissociationReactions[n];
+		params.bindingEnergy.push_back(computeBindingEnergy(currReaction));
+		params.reverseRate.push_back(
+				currReaction.reverseReaction->getRateIndex());
+		params.dissociationRate.push_back(currReaction.getRateIndex());
+	}
+	params.boltzmann.resize(params.bindingEnergy.size(), 0.0);
 
-	// Loop on all the production reactions
-	for (auto& currReactionInfo : productionReactionMap) {
+	params.nRates = rateConstants.getNumRates();
 
-		auto& currReaction = currReactionInfo.second;
+	return;
+}
 
-		// Compute the rate
-		rate = calculateReactionRateConstant(*currReaction, i);
-		// Set it in the reaction
-		currReaction->kConstant[i] = rate;
+void ReactionNetwork::computeRateConstants(int i) {
+	// Gather the parameters again if reactions were added
+	if (rateParameters.nRates != rateConstants.getNumRates())
+		gatherRateParameters();
+
+	// Get the rates at this grid point
+	double *rates = rateConstants.getRow(i);
+
+	// Get the diffusion coefficients of the reactants
+	double *diffusion = rateParameters.diffusion.data();
+	int nReactants = rateParameters.reactants.size();
+	for (int n = 0; n < nReactants; n++) {
+		diffusion[n] = rateParameters.reactants[n]->getDiffusionCoefficient(i);
+	}
 
-		// Check if the rate is the biggest one up to now
-		if (rate > biggestProductionRate)
-			biggestProductionRate = rate;
+	// Compute the production rates, 4 pi (r_1 + r_2) (D_1 + D_2),
+	// and the biggest one
+	double biggestProductionRate = 0.0;
+	const int *first = rateParameters.first.data();
+	const int *second = rateParameters.second.data();
+	const double *radiusSum = rateParameters.radiusSum.data();
+	const int *productionRate = rateParameters.productionRate.data();
+	int nProductions = rateParameters.productionRate.size();
+	for (int n = 0; n < nProductions; n++) {
+		double rate = 4.0 * xolotlCore::pi * radiusSum[n]
+				* (diffusion[first[n]] + diffusion[second[n]]);
+		rates[productionRate[n]] = rate;
+		biggestProductionRate = std::max(biggestProductionRate, rate);
 	}
 
-	// Loop on all the dissociation reactions
-	for (auto& currReactionInfo : dissociationReactionMap) {
+	// Compute the dissociation rates from the rates of their reverse
+	// reactions, k+ exp(-E_b / kT) / atomic volume
+	const int *reverseRate = rateParameters.reverseRate.data();
+	const int *dissociationRate = rateParameters.dissociationRate.data();
+	int nDissociations = rateParameters.dissociationRate.size();
+	if (dissociationsEnabled) {
+		// Compute all the exponentials in one loop without dependencies
+		// so that it can be vectorized
+		const double *bindingEnergy = rateParameters.bindingEnergy.data();
+		double *boltzmann = rateParameters.boltzmann.data();
+		double kT = xolotlCore::kBoltzmann * temperature;
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+		for (int n = 0; n < nDissociations; n++) {
+			boltzmann[n] = exp(-1.0 * bindingEnergy[n] / kT);
+		}
+
+		double factor = 1.0 / getAtomicVolume();
+		for (int n = 0; n < nDissociations; n++) {
+			rates[dissociationRate[n]] = factor * rates[reverseRate[n]]
+					* boltzmann[n];
+		}
+	} else {
+		for (int n = 0; n < nDissociations; n++) {
+			rates[dissociationRate[n]] = 0.0;
+		}
+	}
 
-		auto& currReaction = currReactionInfo.second;
+	// Set the biggest rate
+	biggestRates[i] = biggestProductionRate;
 
-		// Compute the rate
-		rate = calculateDissociationConstant(*currReaction, i);
+	return;
+}
 
-		// Set it in the reaction
-		currReaction->kConstant[i] = rate;
+void ReactionNetwork::updateRateConstants(int i) {
+	// Compute the rates directly if the cache is disabled
+	if (rateCacheTolerance < 0.0) {
+		computeRateConstants(i);
+		return;
 	}
 
-	// Set the biggest rate
-	biggestRate = biggestProductionRate;
+	// Find the temperature bucket
+	double bucketTemp = temperature;
+	if (rateCacheTolerance > 0.0) {
+		bucketTemp = std::round(temperature / rateCacheTolerance)
+				* rateCacheTolerance;
+	}
+
+	// Copy the rates if they were already computed, the cached rows are
+	// stale if reactions were added since then
+	std::size_t nRates = rateConstants.getNumRates();
+	auto iter = rateCache.find(bucketTemp);
+	if (iter != rateCache.end() && iter->second.rates.size() == nRates) {
+		rateCacheHitCounter->increment();
+		std::copy(iter->second.rates.begin(), iter->second.rates.end(),
+				rateConstants.getRow(i));
+		biggestRates[i] = iter->second.biggestRate;
+
+		return;
+	}
+	rateCacheMissCounter->increment();
+
+	// Compute the rates at the temperature of the bucket so that they
+	// don't depend on which grid point filled it first
+	double temp = temperature;
+	if (bucketTemp != temp)
+		ReactionNetwork::setTemperature(bucketTemp, i);
+	computeRateConstants(i);
+	if (bucketTemp != temp)
+		ReactionNetwork::setTemperature(temp, i);
+
+	// Limit the memory used by the cache, it is emptied when it is full
+	if ((rateCache.size() + 1) * nRates > maxRateCacheSize) {
+		rateCache.clear();
+	}
+
+	// Store them
+	auto const rates = rateConstants.getRow(i);
+	auto& cached = rateCache[bucketTemp];
+	cached.rates.assign(rates, rates + nRates);
+	cached.biggestRate = biggestRates[i];
 
 	return;
 }
@@ -279,40 +415,14 @@ void ReactionNetwork::addGridPoints(int i) {
 		currReactant.addGridPoints(i);
 	}
 
-	// Add grid points
-	if (i > 0) {
-		while (i > 0) {
-			// Loop on all the production reactions
-			for (auto& currReactionInfo : productionReactionMap) {
-				currReactionInfo.second->kConstant.emplace(
-						currReactionInfo.second->kConstant.begin(), 0.0);
+	// Add grid points to the rate constants of all the reactions
+	rateConstants.addGridPoints(i);
 
-			}
-
-			// Loop on all the dissociation reactions
-			for (auto& currReactionInfo : dissociationReactionMap) {
-				currReactionInfo.second->kConstant.emplace(
-						currReactionInfo.second->kConstant.begin(), 0.0);
-
-			}
-
-			// Decrease i
-			i--;
-		}
-	} else {
-		// Loop on all the production reactions
-		for (auto& currReactionInfo : productionReactionMap) {
-			currReactionInfo.second->kConstant.erase(
-					currReactionInfo.second->kConstant.begin(),
-					currReactionInfo.second->kConstant.begin() - i);
-		}
-		// Loop on all the dissociation reactions
-		for (auto& currReactionInfo : dissociationReactionMap) {
-			currReactionInfo.second->kConstant.erase(
-					currReactionInfo.second->kConstant.begin(),
-					currReactionInfo.second->kConstant.begin() - i);
-		}
-	}
+	// And to their biggest rate, at the beginning as for the rates
+	if (i > 0)
+		biggestRates.insert(biggestRates.begin(), i, 0.0);
+	else
+		biggestRates.erase(biggestRates.begin(), biggestRates.begin() - i);
 
 	return;
 }
@@ -10,10 +10,13 @@
 #include <Constants.h>
 #include "IReactionNetwork.h"
 #include "Reactant.h"
+#include "ObjectArena.h"
 
 namespace xolotlPerf {
 class IHandlerRegistry;
 class IEventCounter;
+class HotCounter;
+class HotTimer;
 }
 
 // Using std::unordered_map often gives better performance than std::map,
@@ -125,19 +128,31 @@ protected:
 	 */
 	std::shared_ptr<xolotlPerf::IHandlerRegistry> handlerRegistry;
 
+	/**
+	 * All known ProductionReactions in the network, in the order they
+	 * were created.
+	 */
+	ObjectArena<ProductionReaction> productionReactions;
+
 	/**
 	 * All known ProductionReactions in the network, keyed by a
 	 * representation of the reaction.
 	 */
-	using ProductionReactionMap = std::unordered_map<ProductionReaction::KeyType, std::unique_ptr<ProductionReaction> >;
+	using ProductionReactionMap = std::unordered_map<ProductionReaction::KeyType, ProductionReaction*>;
 	ProductionReactionMap productionReactionMap;
 
+	/**
+	 * All known dissociation reactions in the network, in the order they
+	 * were created.
+	 */
+	ObjectArena<DissociationReaction> dissociationReactions;
+
 	/**
 	 * All known dissociation reactions in the network, keyed by a
 	 * representation of the reaction.
 	 */
 	using DissociationReactionMap = std::unordered_map<DissociationReaction::KeyType,
-	std::unique_ptr<DissociationReaction> >;
+	DissociationReaction*>;
 	DissociationReactionMap dissociationReactionMap;
 
 	/**
@@ -160,9 +175,59 @@ protected:
 	double temperature;
 
 	/**
-	 * The biggest rate for this cluster
+	 * The biggest production rate at each grid point
+	 */
+	std::vector<double> biggestRates;
+
+	/**
+	 * The rate constants of all the reactions at each grid point.
+	 * The reactions know their index in it.
+	 */
+	RateConstants rateConstants;
+
+	/**
+	 * The rate constants computed at a given temperature, with the
+	 * biggest production rate among them.
+	 */
+	struct CachedRates {
+		std::vector<double> rates;
+		double biggestRate;
+	};
+
+	/**
+	 * The rate constants already computed, shared by all the grid points at
+	 * the same temperature. The keys are the temperatures rounded to the
+	 * tolerance.
+	 */
+	std::unordered_map<double, CachedRates> rateCache;
+
+	/**
+	 * The maximum number of rates kept in the cache (32 MB).
+	 */
+	static const std::size_t maxRateCacheSize = 1 << 22;
+
+	/**
+	 * The width in K of the temperature buckets sharing the same rate
+	 * constants. With 0 only identical temperatures share them and a
+	 * negative value disables the cache.
+	 */
+	double rateCacheTolerance;
+
+	/**
+	 * The counters for the number of times the rate constants at a grid
+	 * point were found in the cache or had to be computed.
+	 */
+	std::shared_ptr<xolotlPerf::IEventCounter> rateCacheHitCounter;
+	std::shared_ptr<xolotlPerf::IEventCounter> rateCacheMissCounter;
+
+	/**
+	 * The time spent by all the threads in the array based
+	 * computeAllFluxes() and computeAllPartials(), and the number of calls.
 	 */
-	double biggestRate;
+	std::shared_ptr<xolotlPerf::HotTimer> reactionFluxTimer;
+	std::shared_ptr<xolotlPerf::HotTimer> reactionPartialsTimer;
+	std::shared_ptr<xolotlPerf::HotCounter> reactionFluxCounter;
+	std::shared_ptr<xolotlPerf::HotCounter> reactionPartialsCounter;
 
 	/**
 	 * Are dissociations enabled?
@@ -196,31 +261,50 @@ protected:
 	ReactantType superClusterType;
 
 	/**
-	 * Calculate the reaction constant dependent on the
-	 * reaction radii and the diffusion coefficients for the
-	 * ith and jth clusters, which itself depends on the current
-	 * temperature.
-	 *
-	 * @param reaction The reaction
-	 * @param i The location on the grid
-	 * @return The rate
+	 * The parameters of all the reactions gathered in flat arrays, so that
+	 * the rate constants are computed by a few loops over contiguous data
+	 * instead of a virtual call per reaction. They don't depend on the
+	 * temperature and are gathered again when reactions are added.
+	 */
+	struct RateParameters {
+		//! The number of rates when the parameters were gathered
+		int nRates = -1;
+		//! The reactants of the production reactions
+		std::vector<const IReactant*> reactants;
+		//! The diffusion coefficients of these reactants at one grid point
+		std::vector<double> diffusion;
+		//! For each production reaction, the index of both reactants
+		std::vector<int> first;
+		std::vector<int> second;
+		//! For each production reaction, the sum of the reaction radii
+		std::vector<double> radiusSum;
+		//! For each production reaction, its rate index
+		std::vector<int> productionRate;
+		//! For each dissociation reaction, the binding energy
+		std::vector<double> bindingEnergy;
+		//! For each dissociation reaction, exp(-E_b/kT) at one temperature
+		std::vector<double> boltzmann;
+		//! For each dissociation reaction, the rate index of its reverse reaction
+		std::vector<int> reverseRate;
+		//! For each dissociation reaction, its rate index
+		std::vector<int> dissociationRate;
+	};
+	RateParameters rateParameters;
+
+	/**
+	 * Gather the parameters of all the reactions in rateParameters.
 	 */
-	double calculateReactionRateConstant(const ProductionReaction& reaction,
-			int i) const;
+	void gatherRateParameters();
 
 	/**
-	 * Calculate the dissociation constant of the first cluster with respect to
-	 * the single-species cluster of the same type based on the current clusters
-	 * atomic volume, reaction rate constant, and binding energies.
+	 * Get the atomic volume of the material, needed for the dissociation
+	 * constants.
 	 *
-	 * Need to be overwritten by daughter classes because of the atomic volume.
+	 * Need to be overwritten by daughter classes.
 	 *
-	 * @param reaction The reaction
-	 * @param i The location on the grid in the depth direction
-	 * @return The dissociation constant
+	 * @return The atomic volume in nm3
 	 */
-	virtual double calculateDissociationConstant(
-			const DissociationReaction& reaction, int i) const = 0;
+	virtual double getAtomicVolume() const = 0;
 
 	/**
 	 * Calculate the binding energy for the dissociation cluster to emit the single
@@ -232,6 +316,19 @@ protected:
 	virtual double computeBindingEnergy(
 			const DissociationReaction& reaction) const = 0;
 
+	/**
+	 * Set the rate constants at the given grid point for the current
+	 * temperature, copying them from the cache if they were already computed
+	 * for this temperature bucket. Otherwise they are computed at the
+	 * temperature of the bucket and stored in the cache.
+	 *
+	 * The daughter classes call it instead of computeRateConstants() when
+	 * the temperature is set.
+	 *
+	 * @param i The location on the grid in the depth direction
+	 */
+	void updateRateConstants(int i);
+
 	/**
 	 * Find index of interval in boundVector that contains a value.
 	 * Assumes that:
@@ -458,6 +555,22 @@ public:
 	DissociationReaction& add(std::unique_ptr<DissociationReaction> reaction)
 			override;
 
+	/**
+	 * Add the production reaction between the two reactants to the network.
+	 * \see IReactionNetwork.h
+	 */
+	ProductionReaction& addProductionReaction(IReactant& r1, IReactant& r2)
+			override;
+
+	/**
+	 * Add the dissociation reaction of a reactant into two others to the
+	 * network.
+	 * \see IReactionNetwork.h
+	 */
+	DissociationReaction& addDissociationReaction(IReactant& dissociating,
+			IReactant& r1, IReactant& r2, ProductionReaction* reverse)
+					override;
+
 	/**
 	 * This operation fills an array of doubles with the concentrations of all
 	 * of the reactants in the network.
@@ -478,7 +591,7 @@ public:
 	 * array. Properly aligning the array in memory so that this operation
 	 * does not overrun is up to the caller.
 	 */
-	virtual void updateConcentrationsFromArray(double * concentrations)
+	virtual void updateConcentrationsFromArray(const double * concentrations)
 			override;
 
 	/**
@@ -573,12 +686,92 @@ public:
 	}
 
 	/**
-	 * This operation returns the biggest production rate in the network.
+	 * Compute the fluxes generated by all the reactions
+	 * for all the clusters and their momentum from the given concentrations.
+	 *
+	 * The default implementation copies the concentrations in the reactants
+	 * and calls computeAllFluxes(updatedConcOffset, i), subclasses that can
+	 * work on the array directly should override it.
+	 *
+	 * @param concOffset The pointer to the array of the concentration at the grid
+	 * point where the fluxes are computed
+	 * @param updatedConcOffset The pointer to the array of the concentration at the grid
+	 * point where the fluxes are computed used to find the next solution
+	 * @param i The location on the grid in the depth direction
+	 */
+	virtual void computeAllFluxes(const double *concOffset,
+			double *updatedConcOffset, int i = 0) override {
+		updateConcentrationsFromArray(concOffset);
+		computeAllFluxes(updatedConcOffset, i);
+
+		return;
+	}
+
+	// Keep the reactant based version visible
+	using IReactionNetwork::computeAllPartials;
+
+	/**
+	 * Compute the partial derivatives generated by all the reactions
+	 * for all the clusters and their momentum from the given concentrations.
+	 *
+	 * The default implementation copies the concentrations in the reactants
+	 * and calls computeAllPartials(startingIdx, indices, vals, i), subclasses
+	 * that can work on the array directly should override it.
+	 *
+	 * @param concOffset The pointer to the array of the concentration at the grid
+	 * point where the partials are computed
+	 * @param startingIdx Starting index of items owned by each reactant
+	 *      within the partials values array and the indices array.
+	 * @param indices The indices of the clusters for the partial derivatives.
+	 * @param vals The values of partials for the reactions
+	 * @param i The location on the grid in the depth direction
+	 */
+	virtual void computeAllPartials(const double *concOffset,
+			const std::vector<size_t>& startingIdx,
+			const std::vector<int>& indices, std::vector<double>& vals,
+			int i = 0) override {
+		updateConcentrationsFromArray(concOffset);
+		computeAllPartials(startingIdx, indices, vals, i);
+
+		return;
+	}
+
+	/**
+	 * The default implementations of the array based methods modify the
+	 * concentrations of the reactants so they cannot be threaded.
+	 *
+	 * @return False
+	 */
+	virtual bool isThreadSafe() const override {
+		return false;
+	}
+
+	/**
+	 * There is no compiled reaction data to share by default.
+	 *
+	 * @param comm The processes having the same network
+	 * @return False
+	 */
+	virtual bool shareOnNode(MPI_Comm comm) override {
+		return false;
+	}
+
+	/**
+	 * There is no shared reaction data to release by default.
+	 */
+	virtual void releaseShared() override {
+		return;
+	}
+
+	/**
+	 * This operation returns the biggest production rate in the network
+	 * at the given grid point.
 	 *
+	 * @param i The location on the grid in the depth direction
 	 * @return The biggest rate
 	 */
-	double getBiggestRate() const override {
-		return biggestRate;
+	double getBiggestRate(int i = 0) const override {
+		return biggestRates[i];
 	}
 
 	/**
@@ -606,6 +799,7 @@ public:
 	 */
 	void enableDissociations() {
 		dissociationsEnabled = true;
+		rateCache.clear();
 	}
 
 	/**
@@ -613,6 +807,18 @@ public:
 	 */
 	void disableDissociations() {
 		dissociationsEnabled = false;
+		rateCache.clear();
+	}
+
+	/**
+	 * Set the width of the temperature buckets sharing the same rate
+	 * constants.
+	 *
+	 * @param tolerance The tolerance in K
+	 */
+	void setRateCacheTolerance(double tolerance) override {
+		rateCacheTolerance = tolerance;
+		rateCache.clear();
 	}
 
 	/**
@@ -764,7 +764,7 @@ double FeCluster::getDissociationFlux(int xi) const {
 
 				// Calculate the Dissociation flux
 				return running +
-				(currPair.reaction.kConstant[xi] *
+				(currPair.reaction.getRateConstant(xi) *
 						(currPair.a00 * l0A +
 								currPair.a10 * lHeA +
 								currPair.a20 * lVA));
@@ -779,7 +779,7 @@ double FeCluster::getEmissionFlux(int xi) const {
 	// Sum rate constants from all emission pair reactions.
 	double flux = std::accumulate(emissionPairs.begin(), emissionPairs.end(),
 			0.0, [&xi](double running, const ClusterPair& currPair) {
-				return running + currPair.reaction.kConstant[xi] * currPair.a00;
+				return running + currPair.reaction.getRateConstant(xi) * currPair.a00;
 			});
 
 	return flux * concentration;
@@ -801,7 +801,7 @@ double FeCluster::getProductionFlux(int xi) const {
 			double lVA = firstReactant.getVMoment();
 			double lVB = secondReactant.getVMoment();
 			// Update the flux
-			return running + currPair.reaction.kConstant[xi] *
+			return running + currPair.reaction.getRateConstant(xi) *
 			(currPair.a00 * l0A * l0B + currPair.a01 * l0A * lHeB +
 					currPair.a02 * l0A * lVB + currPair.a10 * lHeA * l0B +
 					currPair.a11 * lHeA * lHeB + currPair.a12 * lHeA * lVB +
@@ -826,7 +826,7 @@ double FeCluster::getCombinationFlux(int xi) const {
 				double lHeB = combiningCluster.getHeMoment();
 				double lVB = combiningCluster.getVMoment();
 				// Calculate the combination flux
-				return running + (cc.reaction.kConstant[xi] *
+				return running + (cc.reaction.getRateConstant(xi) *
 						(cc.a0 * l0B + cc.a1 * lHeB + cc.a2 * lVB));
 
 			});
@@ -881,7 +881,7 @@ void FeCluster::getProductionPartialDerivatives(std::vector<double> & partials,
 				double lVB = secondReactant.getVMoment();
 
 				// Compute contribution from the first part of the reacting pair
-				double value = currPair.reaction.kConstant[xi];
+				double value = currPair.reaction.getRateConstant(xi);
 
 				partials[firstReactant.id - 1] += value *
 				(currPair.a00 * l0B + currPair.a01 * lHeB + currPair.a02 * lVB);
@@ -925,10 +925,10 @@ void FeCluster::getCombinationPartialDerivatives(std::vector<double> & partials,
 
 				// Remember that the flux due to combinations is OUTGOING (-=)!
 				// Compute the contribution from this cluster
-				partials[id - 1] -= cc.reaction.kConstant[xi]
+				partials[id - 1] -= cc.reaction.getRateConstant(xi)
 				* (cc.a0 * l0B + cc.a1 * lHeB + cc.a2 * lVB);
 				// Compute the contribution from the combining cluster
-				double value = cc.reaction.kConstant[xi] * concentration;
+				double value = cc.reaction.getRateConstant(xi) * concentration;
 				partials[cluster.id - 1] -= value * cc.a0;
 				partials[cluster.momId[0] - 1] -= value * cc.a1;
 				partials[cluster.momId[1] - 1] -= value * cc.a2;
@@ -950,7 +950,7 @@ void FeCluster::getDissociationPartialDerivatives(
 			[&partials,&xi](const ClusterPair& currPair) {
 				// Get the dissociating cluster
 				auto const& cluster = currPair.first;
-				double value = currPair.reaction.kConstant[xi];
+				double value = currPair.reaction.getRateConstant(xi);
 				partials[cluster.id - 1] += value * currPair.a00;
 				partials[cluster.momId[0] - 1] += value * currPair.a10;
 				partials[cluster.momId[1] - 1] += value * currPair.a20;
@@ -971,7 +971,7 @@ void FeCluster::getEmissionPartialDerivatives(std::vector<double> & partials,
 	double outgoingFlux = std::accumulate(emissionPairs.begin(),
 			emissionPairs.end(), 0.0,
 			[xi](double running, const ClusterPair& currPair) {
-				return running + currPair.reaction.kConstant[xi] * currPair.a00;
+				return running + currPair.reaction.getRateConstant(xi) * currPair.a00;
 			});
 	partials[id - 1] -= outgoingFlux;
 
@@ -985,14 +985,34 @@ double FeCluster::getLeftSideRate(int i) const {
 			combiningReactants.end(), 0.0,
 			[&i](double running, const CombiningCluster& cc) {
 				return running +
-				(cc.reaction.kConstant[i] * cc.combining.concentration);
+				(cc.reaction.getRateConstant(i) * cc.combining.concentration);
 			});
 
 	// Sum rate constants over all emission pair reactions.
 	double emissionRateTotal = std::accumulate(emissionPairs.begin(),
 			emissionPairs.end(), 0.0,
 			[&i](double running, const ClusterPair& currPair) {
-				return running + currPair.reaction.kConstant[i] * currPair.a00;
+				return running + currPair.reaction.getRateConstant(i) * currPair.a00;
+			});
+
+	return combiningRateTotal + emissionRateTotal;
+}
+
+double FeCluster::getLeftSideRate(const double *concentrations, int i) const {
+
+	// Sum rate constant-concentration product over combining reactants.
+	double combiningRateTotal = std::accumulate(combiningReactants.begin(),
+			combiningReactants.end(), 0.0,
+			[&i,concentrations](double running, const CombiningCluster& cc) {
+				return running +
+				(cc.reaction.getRateConstant(i) * concentrations[cc.combining.getId() - 1]);
+			});
+
+	// Sum rate constants over all emission pair reactions.
+	double emissionRateTotal = std::accumulate(emissionPairs.begin(),
+			emissionPairs.end(), 0.0,
+			[&i](double running, const ClusterPair& currPair) {
+				return running + currPair.reaction.getRateConstant(i) * currPair.a00;
 			});
 
 	return combiningRateTotal + emissionRateTotal;
@@ -637,6 +637,17 @@ public:
 	 */
 	double getLeftSideRate(int i) const override;
 
+	/**
+	 * This operation returns the same rate with the concentrations of the
+	 * combining clusters read from the given array.
+	 *
+	 * @param concentrations The concentrations at this grid point
+	 * @param i The position on the grid
+	 * @return The rate
+	 */
+	double getLeftSideRate(const double *concentrations, int i) const
+			override;
+
 	/**
 	 * This operation returns the vector of production reactions in which
 	 * this cluster is involved, containing the id of the reactants, the rate, and
@@ -123,16 +123,18 @@ std::unique_ptr<IReactionNetwork> FeClusterNetworkLoader::load(
 	std::unique_ptr<FeClusterReactionNetwork> network(
 			new FeClusterReactionNetwork(handlerRegistry));
 
+	// Read the properties of all the clusters at once
+	auto clusters = networkGroup->readClusters();
+
 	// Loop on the clusters
 	for (int i = 0; i < normalSize + superSize; i++) {
-		// Open the cluster group
-		XFile::ClusterGroup clusterGroup(*networkGroup, i);
-
 		if (i < normalSize) {
 			// Normal cluster
-			// Read the composition
-			auto comp = clusterGroup.readCluster(formationEnergy,
-					migrationEnergy, diffusionFactor);
+			// Get the composition and energies
+			auto comp = clusters.compositions.data() + i * clusters.compSize;
+			formationEnergy = clusters.energies[3 * i];
+			migrationEnergy = clusters.energies[3 * i + 1];
+			diffusionFactor = clusters.energies[3 * i + 2];
 			numHe = comp[toCompIdx(Species::He)];
 			numV = comp[toCompIdx(Species::V)];
 			numI = comp[toCompIdx(Species::I)];
@@ -154,7 +156,11 @@ std::unique_ptr<IReactionNetwork> FeClusterNetworkLoader::load(
 			network->add(std::move(nextCluster));
 		} else {
 			// Super cluster
-			auto bounds = clusterGroup.readFeSuperCluster();
+			// Get its bounds
+			int j = i - normalSize;
+			Array1D<int, 4> bounds;
+			for (int n = 0; n < 4; n++)
+				bounds[n] = clusters.bounds[4 * j + n];
 
 			// Create the cluster
 			auto nextCluster = createFeSuperCluster(bounds, *network);
@@ -21,13 +21,7 @@ FeClusterReactionNetwork::FeClusterReactionNetwork(
 	return;
 }
 
-double FeClusterReactionNetwork::calculateDissociationConstant(
-		const DissociationReaction& reaction, int i) const {
-
-	// If the dissociations are not allowed
-	if (!dissociationsEnabled)
-		return 0.0;
-
+double FeClusterReactionNetwork::getAtomicVolume() const {
 	// The atomic volume is computed by considering the BCC structure of the
 	// iron. In a given lattice cell in iron there are iron atoms
 	// at each corner and a iron atom in the center. The iron atoms at
@@ -37,16 +31,7 @@ double FeClusterReactionNetwork::calculateDissociationConstant(
 	double atomicVolume = 0.5 * xolotlCore::ironLatticeConstant
 			* xolotlCore::ironLatticeConstant * xolotlCore::ironLatticeConstant;
 
-	// Get the rate constant from the reverse reaction
-	double kPlus = reaction.reverseReaction->kConstant[i];
-
-	// Calculate and return
-	double bindingEnergy = computeBindingEnergy(reaction);
-	double k_minus_exp = exp(
-			-1.0 * bindingEnergy / (xolotlCore::kBoltzmann * temperature));
-	double k_minus = (1.0 / atomicVolume) * kPlus * k_minus_exp;
-
-	return k_minus;
+	return atomicVolume;
 }
 
 void FeClusterReactionNetwork::defineProductionReactions(IReactant& r1,
@@ -101,9 +86,7 @@ void FeClusterReactionNetwork::defineProductionReactions(IReactant& r1,
 	// Define the production reaction to the network.
 	// Do this *once* for the given reactants, since it doesn't
 	// depend on the product or the other parameters.
-	std::unique_ptr<ProductionReaction> reaction(
-			new ProductionReaction(r1, r2));
-	auto& prref = add(std::move(reaction));
+	auto& prref = addProductionReaction(r1, r2);
 
 	// Determine if reverse reaction is allowed.
 	auto dissociationAllowed = canDissociate(prref);
@@ -128,10 +111,8 @@ void FeClusterReactionNetwork::defineDissociationReactions(
 		ProductionReaction& forwardReaction, IReactant& disso) {
 	// Add a dissociation reaction to our network.
 	// Do this once here for each forward reaction product.
-	std::unique_ptr<DissociationReaction> dissociationReaction(
-			new DissociationReaction(disso, forwardReaction.first,
-					forwardReaction.second, &forwardReaction));
-	auto& drref = add(std::move(dissociationReaction));
+	auto& drref = addDissociationReaction(disso, forwardReaction.first,
+			forwardReaction.second, &forwardReaction);
 
 	// Tell all participants in this reaction of their involvement.
 	drref.first.participateIn(drref, disso);
@@ -509,7 +490,7 @@ void FeClusterReactionNetwork::checkForDissociation(IReactant& emittingReactant,
 void FeClusterReactionNetwork::setTemperature(double temp, int i) {
 	ReactionNetwork::setTemperature(temp, i);
 
-	computeRateConstants(i);
+	updateRateConstants(i);
 
 	return;
 }
@@ -602,7 +583,7 @@ void FeClusterReactionNetwork::reinitializeNetwork() {
 		}
 
 		void FeClusterReactionNetwork::updateConcentrationsFromArray(
-				double * concentrations) {
+				const double * concentrations) {
 
 			// Set the concentration on each reactant.
 			std::for_each(allReactants.begin(), allReactants.end(),
@@ -55,16 +55,12 @@ private:
 	HeVToSuperClusterMap superClusterLookupMap;
 
 	/**
-	 * Calculate the dissociation constant of the first cluster with respect to
-	 * the single-species cluster of the same type based on the current clusters
-	 * atomic volume, reaction rate constant, and binding energies.
+	 * Get the atomic volume of the material, needed for the dissociation
+	 * constants.
 	 *
-	 * @param reaction The reaction
-	 * @param i The location on the grid in the depth direction
-	 * @return The dissociation constant
+	 * @return The atomic volume in nm3
 	 */
-	double calculateDissociationConstant(
-			const DissociationReaction& reaction, int i) const override;
+	double getAtomicVolume() const override;
 
 	/**
 	 * Calculate the binding energy for the dissociation cluster to emit the single
@@ -92,9 +88,7 @@ private:
 			int a[4] = { }) __attribute__((always_inline)) {
 
 		// Add a production reaction to our network.
-		std::unique_ptr<ProductionReaction> reaction(
-				new ProductionReaction(r1, r2));
-		auto& prref = add(std::move(reaction));
+		auto& prref = addProductionReaction(r1, r2);
 
 		// Tell the reactants that they are involved in this reaction
 		r1.participateIn(prref, a);
@@ -149,10 +143,8 @@ private:
 	void defineDissociationReaction(ProductionReaction& forwardReaction,
 			IReactant& emitting, int a[4] = { }, int b[4] = { }) {
 
-		std::unique_ptr<DissociationReaction> dissociationReaction(
-				new DissociationReaction(emitting, forwardReaction.first,
-						forwardReaction.second, &forwardReaction));
-		auto& drref = add(std::move(dissociationReaction));
+		auto& drref = addDissociationReaction(emitting, forwardReaction.first,
+				forwardReaction.second, &forwardReaction);
 
 		// Tell the reactants that they are in this reaction
 		forwardReaction.first.participateIn(drref, a, b);
@@ -256,7 +248,7 @@ public:
 	 * array. Properly aligning the array in memory so that this operation
 	 * does not overrun is up to the caller.
 	 */
-	void updateConcentrationsFromArray(double * concentrations) override;
+	void updateConcentrationsFromArray(const double * concentrations) override;
 
 	/**
 	 * This operation returns the number of super reactants in the network.
@@ -351,7 +351,7 @@ double NECluster::getDissociationFlux(int xi) const {
 					auto& dissociatingCluster = currPair.first;
 					// Calculate the Dissociation flux
 					Reaction const& currReaction = currPair.reaction;
-					return running + (currReaction.kConstant[xi] *
+					return running + (currReaction.getRateConstant(xi) *
 							dissociatingCluster->getConcentration(currPair.firstDistance));
 				});
 
@@ -365,7 +365,7 @@ double NECluster::getEmissionFlux(int xi) const {
 	double flux = std::accumulate(emissionPairs.begin(), emissionPairs.end(),
 			0.0, [&xi](double running, const ClusterPair& currPair) {
 				Reaction const& currReaction = currPair.reaction;
-				return running + currReaction.kConstant[xi];
+				return running + currReaction.getRateConstant(xi);
 			});
 
 	return flux * concentration;
@@ -383,7 +383,7 @@ double NECluster::getProductionFlux(int xi) const {
 				NECluster* secondReactant = currPair.second;
 				// Update the flux
 				Reaction const& currReaction = currPair.reaction;
-				flux += currReaction.kConstant[xi]
+				flux += currReaction.getRateConstant(xi)
 				* firstReactant->getConcentration(
 						currPair.firstDistance)
 				* secondReactant->getConcentration(
@@ -405,7 +405,7 @@ double NECluster::getCombinationFlux(int xi) const {
 
 				// Calculate Second term of production flux
 				return running +
-				(currReaction.kConstant[xi] *
+				(currReaction.getRateConstant(xi) *
 						combiningCluster.getConcentration(currPair.distance));
 
 			});
@@ -453,7 +453,7 @@ void NECluster::getProductionPartialDerivatives(std::vector<double> & partials,
 				Reaction const& currReaction = currPair.reaction;
 
 				// Compute the contribution from the first part of the reacting pair
-				auto value = currReaction.kConstant[xi]
+				auto value = currReaction.getRateConstant(xi)
 				* currPair.second->getConcentration(
 						currPair.secondDistance);
 				auto index = currPair.first->id - 1;
@@ -461,7 +461,7 @@ void NECluster::getProductionPartialDerivatives(std::vector<double> & partials,
 				index = currPair.first->momId[0] - 1;
 				partials[index] += value * currPair.firstDistance;
 				// Compute the contribution from the second part of the reacting pair
-				value = currReaction.kConstant[xi]
+				value = currReaction.getRateConstant(xi)
 				* currPair.first->getConcentration(
 						currPair.firstDistance);
 				index = currPair.second->id - 1;
@@ -491,10 +491,10 @@ void NECluster::getCombinationPartialDerivatives(std::vector<double> & partials,
 
 				// Remember that the flux due to combinations is OUTGOING (-=)!
 				// Compute the contribution from this cluster
-				partials[id - 1] -= currReaction.kConstant[xi] *
+				partials[id - 1] -= currReaction.getRateConstant(xi) *
 				cluster.getConcentration(cc.distance);
 				// Compute the contribution from the combining cluster
-				double value = currReaction.kConstant[xi] * concentration;
+				double value = currReaction.getRateConstant(xi) * concentration;
 
 				partials[cluster.id - 1] -= value;
 				partials[cluster.momId[0] - 1] -= value * cc.distance;
@@ -517,8 +517,8 @@ void NECluster::getDissociationPartialDerivatives(
 				// Get the dissociating cluster
 				NECluster* cluster = currPair.first;
 				Reaction const& currReaction = currPair.reaction;
-				partials[cluster->id - 1] += currReaction.kConstant[xi];
-				partials[cluster->momId[0] - 1] += currReaction.kConstant[xi] *
+				partials[cluster->id - 1] += currReaction.getRateConstant(xi);
+				partials[cluster->momId[0] - 1] += currReaction.getRateConstant(xi) *
 				currPair.firstDistance;
 			});
 
@@ -538,7 +538,7 @@ void NECluster::getEmissionPartialDerivatives(std::vector<double> & partials,
 			emissionPairs.end(), 0.0,
 			[&xi](double running, const ClusterPair& currPair) {
 				Reaction const& currReaction = currPair.reaction;
-				return running + currReaction.kConstant[xi];
+				return running + currReaction.getRateConstant(xi);
 			});
 
 	// Recall emission flux is OUTGOING
@@ -556,7 +556,7 @@ double NECluster::getLeftSideRate(int i) const {
 				NECluster const& cluster = *currPair.combining;
 				Reaction const& currReaction = currPair.reaction;
 
-				return running + (currReaction.kConstant[i] *
+				return running + (currReaction.getRateConstant(i) *
 						cluster.concentration);
 			});
 
@@ -565,7 +565,32 @@ double NECluster::getLeftSideRate(int i) const {
 			emissionPairs.end(), 0.0,
 			[&i](double running, const ClusterPair& currPair) {
 				Reaction const& currReaction = currPair.reaction;
-				return running + currReaction.kConstant[i];
+				return running + currReaction.getRateConstant(i);
+			});
+
+	return combiningRateTotal + emissionRateTotal;
+}
+
+double NECluster::getLeftSideRate(const double *concentrations,
+		int i) const {
+
+	// Sum reaction rate contributions over all combining clusters.
+	double combiningRateTotal = std::accumulate(combiningReactants.begin(),
+			combiningReactants.end(), 0.0,
+			[&i,concentrations](double running, const CombiningCluster& currPair) {
+				NECluster const& cluster = *currPair.combining;
+				Reaction const& currReaction = currPair.reaction;
+
+				return running + (currReaction.getRateConstant(i) *
+						concentrations[cluster.getId() - 1]);
+			});
+
+	// Sum reaction rate constants over all emission pairs.
+	double emissionRateTotal = std::accumulate(emissionPairs.begin(),
+			emissionPairs.end(), 0.0,
+			[&i](double running, const ClusterPair& currPair) {
+				Reaction const& currReaction = currPair.reaction;
+				return running + currReaction.getRateConstant(i);
 			});
 
 	return combiningRateTotal + emissionRateTotal;
@@ -112,16 +112,18 @@ std::unique_ptr<IReactionNetwork> NEClusterNetworkLoader::load(
 	std::unique_ptr<NEClusterReactionNetwork> network(
 			new NEClusterReactionNetwork(handlerRegistry));
 
+	// Read the properties of all the clusters at once
+	auto clusters = networkGroup->readClusters();
+
 	// Loop on the clusters
 	for (int i = 0; i < normalSize + superSize; i++) {
-		// Open the cluster group
-		XFile::ClusterGroup clusterGroup(*networkGroup, i);
-
 		if (i < normalSize) {
 			// Normal cluster
-			// Read the composition
-			auto comp = clusterGroup.readCluster(formationEnergy,
-					migrationEnergy, diffusionFactor);
+			// Get the composition and energies
+			auto comp = clusters.compositions.data() + i * clusters.compSize;
+			formationEnergy = clusters.energies[3 * i];
+			migrationEnergy = clusters.energies[3 * i + 1];
+			diffusionFactor = clusters.energies[3 * i + 2];
 			numXe = comp[toCompIdx(Species::Xe)];
 
 			// Create the cluster
@@ -137,9 +139,11 @@ std::unique_ptr<IReactionNetwork> NEClusterNetworkLoader::load(
 			pushNECluster(network, reactants, nextCluster);
 		} else {
 			// Super cluster
-			int nTot = 0;
-			double average = 0.0, radius = 0.0;
-			clusterGroup.readNESuperCluster(nTot, average, radius);
+			// Get its size, average and radius
+			int j = i - normalSize;
+			int nTot = clusters.neProperties[3 * j];
+			double average = clusters.neProperties[3 * j + 1], radius =
+					clusters.neProperties[3 * j + 2];
 
 			// Create the cluster
 			auto nextCluster = createNESuperCluster(nTot, average, radius,
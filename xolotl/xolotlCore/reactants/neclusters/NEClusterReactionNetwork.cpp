@@ -21,28 +21,13 @@ NEClusterReactionNetwork::NEClusterReactionNetwork(
 	return;
 }
 
-double NEClusterReactionNetwork::calculateDissociationConstant(
-		const DissociationReaction& reaction, int i) const {
-
-	// If the dissociations are not allowed
-	if (!dissociationsEnabled)
-		return 0.0;
-
+double NEClusterReactionNetwork::getAtomicVolume() const {
 	// Compute the atomic volume
 	double atomicVolume = 0.5 * xolotlCore::uraniumDioxydeLatticeConstant
 			* xolotlCore::uraniumDioxydeLatticeConstant
 			* xolotlCore::uraniumDioxydeLatticeConstant;
 
-	// Get the rate constant from the reverse reaction
-	double kPlus = reaction.reverseReaction->kConstant[i];
-
-	// Calculate and return
-	double bindingEnergy = computeBindingEnergy(reaction);
-	double k_minus_exp = exp(
-			-1.0 * bindingEnergy / (xolotlCore::kBoltzmann * temperature));
-	double k_minus = (1.0 / atomicVolume) * kPlus * k_minus_exp;
-
-	return k_minus;
+	return atomicVolume;
 }
 
 void NEClusterReactionNetwork::createReactionConnectivity() {
@@ -114,7 +99,7 @@ void NEClusterReactionNetwork::checkForDissociation(
 void NEClusterReactionNetwork::setTemperature(double temp, int i) {
 	ReactionNetwork::setTemperature(temp, i);
 
-	computeRateConstants(i);
+	updateRateConstants(i);
 
 	return;
 }
@@ -159,7 +144,7 @@ void NEClusterReactionNetwork::reinitializeConnectivities() {
 }
 
 void NEClusterReactionNetwork::updateConcentrationsFromArray(
-		double * concentrations) {
+		const double * concentrations) {
 
 	// Set the concentration on each reactant.
 	std::for_each(allReactants.begin(), allReactants.end(),
@@ -35,16 +35,12 @@ private:
 	double fissionRate;
 
 	/**
-	 * Calculate the dissociation constant of the first cluster with respect to
-	 * the single-species cluster of the same type based on the current clusters
-	 * atomic volume, reaction rate constant, and binding energies.
+	 * Get the atomic volume of the material, needed for the dissociation
+	 * constants.
 	 *
-	 * @param reaction The reaction
-	 * @param i The location on the grid in the depth direction
-	 * @return The dissociation constant
+	 * @return The atomic volume in nm3
 	 */
-	double calculateDissociationConstant(const DissociationReaction& reaction,
-			int i) const override;
+	double getAtomicVolume() const override;
 
 	/**
 	 * Calculate the binding energy for the dissociation cluster to emit the single
@@ -131,7 +127,7 @@ public:
 	 * array. Properly aligning the array in memory so that this operation
 	 * does not overrun is up to the caller.
 	 */
-	void updateConcentrationsFromArray(double * concentrations) override;
+	void updateConcentrationsFromArray(const double * concentrations) override;
 
 	/**
 	 * This operation returns the number of super reactants in the network.
@@ -199,6 +195,8 @@ public:
 	 */
 	void setFissionRate(double rate) override {
 		fissionRate = rate;
+		// The diffusion coefficients depend on it
+		rateCache.clear();
 		return;
 	}
 
@@ -655,7 +655,7 @@ double NESuperCluster::getDissociationFlux(int xi) {
 		double l0A = dissociatingCluster->getConcentration(0.0);
 		double l1A = dissociatingCluster->getMoment();
 		// Update the flux
-		value = (*it).reaction.kConstant[xi] / (double) nTot;
+		value = (*it).reaction.getRateConstant(xi) / (double) nTot;
 		flux += value * ((*it).a00 * l0A + (*it).a10 * l1A);
 		// Compute the moment fluxes
 		momentFlux += value * ((*it).a01 * l0A + (*it).a11 * l1A);
@@ -672,7 +672,7 @@ double NESuperCluster::getEmissionFlux(int xi) {
 	// Loop over all the emission pairs
 	for (auto it = effEmissionList.begin(); it != effEmissionList.end(); ++it) {
 		// Update the flux
-		value = (*it).reaction.kConstant[xi] / (double) nTot;
+		value = (*it).reaction.getRateConstant(xi) / (double) nTot;
 		flux += value * ((*it).a00 * l0 + (*it).a10 * l1);
 		// Compute the moment fluxes
 		momentFlux -= value * ((*it).a01 * l0 + (*it).a11 * l1);
@@ -696,7 +696,7 @@ double NESuperCluster::getProductionFlux(int xi) {
 		double l1A = firstReactant->getMoment();
 		double l1B = secondReactant->getMoment();
 		// Update the flux
-		value = (*it).reaction.kConstant[xi] / (double) nTot;
+		value = (*it).reaction.getRateConstant(xi) / (double) nTot;
 		flux += value
 				* ((*it).a000 * l0A * l0B + (*it).a010 * l0A * l1B
 						+ (*it).a100 * l1A * l0B + (*it).a110 * l1A);
@@ -723,7 +723,7 @@ double NESuperCluster::getCombinationFlux(int xi) {
 		double l0A = combiningCluster->getConcentration();
 		double l1A = combiningCluster->getMoment();
 		// Update the flux
-		value = (*it).reaction.kConstant[xi] / (double) nTot;
+		value = (*it).reaction.getRateConstant(xi) / (double) nTot;
 		flux += value
 				* ((*it).a000 * l0A * l0 + (*it).a100 * l0A * l1
 						+ (*it).a010 * l1A * l0 + (*it).a110 * l1A * l1);
@@ -776,7 +776,7 @@ void NESuperCluster::getProductionPartialDerivatives(
 		double l1B = secondReactant->getMoment();
 
 		// Compute the contribution from the first part of the reacting pair
-		value = (*it).reaction.kConstant[xi] / (double) nTot;
+		value = (*it).reaction.getRateConstant(xi) / (double) nTot;
 		index = firstReactant->getId() - 1;
 		partials[index] += value * ((*it).a000 * l0B + (*it).a010 * l1B);
 		momentPartials[index] += value * ((*it).a001 * l0B + (*it).a011 * l1B);
@@ -819,7 +819,7 @@ void NESuperCluster::getCombinationPartialDerivatives(
 		double l1A = cluster->getMoment();
 
 		// Compute the contribution from the combining cluster
-		value = (*it).reaction.kConstant[xi] / (double) nTot;
+		value = (*it).reaction.getRateConstant(xi) / (double) nTot;
 		index = cluster->getId() - 1;
 		partials[index] -= value * ((*it).a000 * l0 + (*it).a100 * l1);
 		momentPartials[index] -= value * ((*it).a001 * l0 + (*it).a101 * l1);
@@ -859,7 +859,7 @@ void NESuperCluster::getDissociationPartialDerivatives(
 		cluster = (*it).first;
 
 		// Compute the contribution from the dissociating cluster
-		value = (*it).reaction.kConstant[xi] / (double) nTot;
+		value = (*it).reaction.getRateConstant(xi) / (double) nTot;
 		index = cluster->getId() - 1;
 		partials[index] += value * ((*it).a00);
 		momentPartials[index] += value * ((*it).a01);
@@ -887,7 +887,7 @@ void NESuperCluster::getEmissionPartialDerivatives(
 	// Loop over all the emission pairs
 	for (auto it = effEmissionList.begin(); it != effEmissionList.end(); ++it) {
 		// Compute the contribution from the dissociating cluster
-		value = (*it).reaction.kConstant[xi] / (double) nTot;
+		value = (*it).reaction.getRateConstant(xi) / (double) nTot;
 		index = id - 1;
 		partials[index] -= value * ((*it).a00);
 		momentPartials[index] -= value * ((*it).a01);
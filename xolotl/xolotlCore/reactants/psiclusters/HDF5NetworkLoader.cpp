@@ -3,21 +3,125 @@
 #include <limits>
 #include <algorithm>
 #include <vector>
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+#include <cstdint>
+#include <unistd.h>
 #include "PSIClusterReactionNetwork.h"
 #include <xolotlPerf.h>
 #include "xolotlCore/io/XFile.h"
 
 namespace xolotlCore {
 
-std::unique_ptr<IReactionNetwork> HDF5NetworkLoader::load(
-		const IOptions& options) {
+namespace {
+
+//! The version of the cached networks, to increase when the generation
+//! or the file layout change so that older caches are not used.
+const int cacheVersion = 1;
+
+/**
+ * Hash a string with the 64 bits FNV-1a function.
+ *
+ * @param str The string
+ * @return The hash
+ */
+uint64_t hashString(const std::string& str) {
+	uint64_t hash = 14695981039346656037ull;
+	for (unsigned char c : str) {
+		hash ^= c;
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
+
+/**
+ * Add a list of values to the description of a network.
+ *
+ * @param os The description
+ * @param values The values
+ */
+template<typename T>
+void describe(std::ostream& os, const std::vector<T>& values) {
+	for (auto value : values)
+		os << value << " ";
+	os << ";";
+}
+
+/**
+ * Broadcast a vector from the master process.
+ *
+ * @param values The values, resized on the other processes
+ * @param type The MPI type of the values
+ */
+template<typename T>
+void broadcastVector(std::vector<T>& values, MPI_Datatype type) {
+	int64_t size = values.size();
+	MPI_Bcast(&size, 1, MPI_INT64_T, 0, MPI_COMM_WORLD);
+	values.resize(size);
+	if (size > 0)
+		MPI_Bcast(values.data(), size, type, 0, MPI_COMM_WORLD);
+}
+
+/**
+ * Broadcast the tables of a network from the master process.
+ *
+ * @param clusters The properties of the clusters
+ * @param reactions The reactions of the clusters
+ * @param list The phase space parameters
+ */
+void broadcastTables(XFile::NetworkGroup::ClusterTable& clusters,
+		XFile::NetworkGroup::ReactionTables& reactions, Array<int, 5>& list) {
+	// The sizes
+	std::array<int, 8> sizes { { clusters.normalSize, clusters.superSize,
+			clusters.compSize, list[0], list[1], list[2], list[3], list[4] } };
+	MPI_Bcast(sizes.data(), sizes.size(), MPI_INT, 0, MPI_COMM_WORLD);
+	clusters.normalSize = sizes[0];
+	clusters.superSize = sizes[1];
+	clusters.compSize = sizes[2];
+	for (int i = 0; i < 5; i++)
+		list[i] = sizes[i + 3];
+
+	// The clusters
+	broadcastVector(clusters.compositions, MPI_INT);
+	broadcastVector(clusters.energies, MPI_DOUBLE);
+	broadcastVector(clusters.heVOffsets, MPI_INT);
+	broadcastVector(clusters.heVList, MPI_INT);
+
+	// The reactions of each kind
+	for (auto& table : reactions) {
+		broadcastVector(table.offsets, MPI_INT64_T);
+		broadcastVector(table.widths, MPI_INT);
+		broadcastVector(table.data, MPI_DOUBLE);
+	}
+}
+
+} // namespace
+
+Array<int, 5> HDF5NetworkLoader::readTables(MPI_Comm comm,
+		XFile::NetworkGroup::ClusterTable& clusters,
+		XFile::NetworkGroup::ReactionTables& reactions) const {
 	// Get the dataset from the HDF5 files
 	int normalSize = 0, superSize = 0;
-	XFile networkFile(fileName);
+	XFile networkFile(fileName, comm);
 	auto networkGroup = networkFile.getGroup<XFile::NetworkGroup>();
 	assert(networkGroup);
 	auto list = networkGroup->readNetworkSize(normalSize, superSize);
 
+	// Read the properties of all the clusters and their reactions at once
+	clusters = networkGroup->readClusters();
+	reactions = networkGroup->readReactionTables();
+
+	return list;
+}
+
+std::unique_ptr<IReactionNetwork> HDF5NetworkLoader::build(
+		const XFile::NetworkGroup::ClusterTable& clusters,
+		XFile::NetworkGroup::ReactionTables& reactions,
+		const Array<int, 5>& list) {
+	int normalSize = clusters.normalSize, superSize = clusters.superSize;
+
 	// Initialization
 	int numHe = 0, numV = 0, numI = 0, numD = 0, numT = 0;
 	double formationEnergy = 0.0, migrationEnergy = 0.0;
@@ -30,14 +134,13 @@ std::unique_ptr<IReactionNetwork> HDF5NetworkLoader::load(
 
 	// Loop on the clusters
 	for (int i = 0; i < normalSize + superSize; i++) {
-		// Open the cluster group
-		XFile::ClusterGroup clusterGroup(*networkGroup, i);
-
 		if (i < normalSize) {
 			// Normal cluster
-			// Read the composition
-			auto comp = clusterGroup.readCluster(formationEnergy,
-					migrationEnergy, diffusionFactor);
+			// Get the composition and energies
+			auto comp = clusters.compositions.data() + i * clusters.compSize;
+			formationEnergy = clusters.energies[3 * i];
+			migrationEnergy = clusters.energies[3 * i + 1];
+			diffusionFactor = clusters.energies[3 * i + 2];
 			numHe = comp[toCompIdx(Species::He)];
 			numD = comp[toCompIdx(Species::D)];
 			numT = comp[toCompIdx(Species::T)];
@@ -58,10 +161,18 @@ std::unique_ptr<IReactionNetwork> HDF5NetworkLoader::load(
 			pushPSICluster(network, reactants, nextCluster);
 		} else {
 			// Super cluster
-			auto list = clusterGroup.readPSISuperCluster();
+			// Get the coordinates of the clusters it contains
+			int j = i - normalSize;
+			XFile::ClusterGroup::clusterList coordList;
+			for (int n = clusters.heVOffsets[j]; n < clusters.heVOffsets[j + 1];
+					n++) {
+				coordList.emplace(clusters.heVList[4 * n],
+						clusters.heVList[4 * n + 1], clusters.heVList[4 * n + 2],
+						clusters.heVList[4 * n + 3]);
+			}
 
 			// Create the cluster
-			auto nextCluster = createPSISuperCluster(list, *network);
+			auto nextCluster = createPSISuperCluster(coordList, *network);
 
 			// Save it in the network
 			pushPSICluster(network, reactants, nextCluster);
@@ -85,7 +196,7 @@ std::unique_ptr<IReactionNetwork> HDF5NetworkLoader::load(
 	network->setPhaseSpace(nDim, list);
 
 	// Set the reactions
-	networkGroup->readReactions(*network);
+	XFile::NetworkGroup::addReactions(*network, reactions);
 
 	// Recompute Ids and network size
 	network->reinitializeNetwork();
@@ -97,5 +208,152 @@ std::unique_ptr<IReactionNetwork> HDF5NetworkLoader::load(
 	return std::move(network);
 }
 
+std::unique_ptr<IReactionNetwork> HDF5NetworkLoader::load(
+		const IOptions& options) {
+	XFile::NetworkGroup::ClusterTable clusters;
+	XFile::NetworkGroup::ReactionTables reactions;
+	Array<int, 5> list;
+
+	if (options.broadcastNetwork()) {
+		// Only the master reads the file
+		int procId;
+		MPI_Comm_rank(MPI_COMM_WORLD, &procId);
+		if (procId == 0)
+			list = readTables(MPI_COMM_SELF, clusters, reactions);
+		broadcastTables(clusters, reactions, list);
+	} else {
+		list = readTables(MPI_COMM_WORLD, clusters, reactions);
+	}
+
+	return build(clusters, reactions, list);
+}
+
+std::string HDF5NetworkLoader::getCacheFilename(
+		const IOptions& options) const {
+	// Describe everything the generated network depends on
+	std::ostringstream desc;
+	desc.precision(17);
+	desc << "PSI " << cacheVersion << " " << options.getMaxImpurity() << " "
+			<< options.getMaxD() << " " << options.getMaxT() << " "
+			<< options.getMaxV() << " " << options.getMaxI() << " "
+			<< options.usePhaseCut() << " " << vMin << " " << sectionWidth[0]
+			<< " " << sectionWidth[1] << " " << sectionWidth[2] << " "
+			<< sectionWidth[3] << " " << dummyReactions << ";";
+	describe(desc, iFormationEnergies);
+	describe(desc, iDiffusion);
+	describe(desc, iMigration);
+	describe(desc, heFormationEnergies);
+	describe(desc, heDiffusion);
+	describe(desc, heMigration);
+	describe(desc, maxHePerV);
+	desc << dOneDiffusionFactor << " " << dOneMigrationEnergy << " "
+			<< tOneDiffusionFactor << " " << tOneMigrationEnergy << " "
+			<< vOneDiffusion << " " << vOneMigration << ";";
+
+	// Name the file after the hash of the description
+	std::ostringstream name;
+	name << "network_" << std::hex << std::setw(16) << std::setfill('0')
+			<< hashString(desc.str()) << ".h5";
+
+	return (fs::path(options.getNetworkCacheDir()) / name.str()).string();
+}
+
+std::unique_ptr<IReactionNetwork> HDF5NetworkLoader::generateOrReadCache(
+		const IOptions& options, MPI_Comm comm) {
+	// Nothing to do with the cache if there is no directory for it
+	if (options.getNetworkCacheDir().empty())
+		return PSIClusterNetworkLoader::generate(options);
+
+	// Get the process ID among the ones building the network
+	int procId;
+	MPI_Comm_rank(comm, &procId);
+
+	// The master decides for all the processes if the network is cached
+	// because another job could add it to the cache in the meantime
+	auto cacheName = getCacheFilename(options);
+	int isCached = 0;
+	if (procId == 0)
+		isCached = fs::exists(cacheName);
+	MPI_Bcast(&isCached, 1, MPI_INT, 0, comm);
+
+	if (isCached) {
+		if (procId == 0) {
+			std::cout << "\nHDF5NetworkLoader Message: "
+					<< "Loading the network from the cache " << cacheName
+					<< std::endl;
+		}
+
+		// Read it as a network file
+		XFile::NetworkGroup::ClusterTable clusters;
+		XFile::NetworkGroup::ReactionTables reactions;
+		auto networkName = fileName;
+		fileName = cacheName;
+		auto list = readTables(comm, clusters, reactions);
+		fileName = networkName;
+
+		return build(clusters, reactions, list);
+	}
+
+	// Generate the network
+	auto network = PSIClusterNetworkLoader::generate(options);
+
+	// Save it for the next runs
+	if (procId == 0) {
+		// Write a temporary file first and rename it once complete, the
+		// other jobs using the cache never read a partially written network
+		char hostName[MPI_MAX_PROCESSOR_NAME];
+		int nameLength = 0;
+		MPI_Get_processor_name(hostName, &nameLength);
+		std::string tempName = cacheName + "."
+				+ std::string(hostName, nameLength) + "."
+				+ std::to_string(getpid());
+		try {
+			fs::create_directories(options.getNetworkCacheDir());
+			{
+				XFile cacheFile(tempName, std::vector<double>(),
+						network->getCompositionList(), MPI_COMM_SELF);
+				XFile::NetworkGroup networkGroup(cacheFile, *network);
+			}
+			fs::rename(tempName, cacheName);
+		} catch (const std::exception& e) {
+			// The run goes on without the cache
+			std::cout << "\nHDF5NetworkLoader Warning: "
+					<< "Could not save the network in the cache: " << e.what()
+					<< std::endl;
+		}
+	}
+
+	return network;
+}
+
+std::unique_ptr<IReactionNetwork> HDF5NetworkLoader::generate(
+		const IOptions& options) {
+	// Every process builds its own network
+	if (!options.broadcastNetwork())
+		return generateOrReadCache(options, MPI_COMM_WORLD);
+
+	// Get the current process ID
+	int procId;
+	MPI_Comm_rank(MPI_COMM_WORLD, &procId);
+
+	// The master builds the network and puts it in tables
+	std::unique_ptr<IReactionNetwork> network;
+	XFile::NetworkGroup::ClusterTable clusters;
+	XFile::NetworkGroup::ReactionTables reactions;
+	Array<int, 5> list;
+	if (procId == 0) {
+		network = generateOrReadCache(options, MPI_COMM_SELF);
+		XFile::NetworkGroup::makeTables(*network, clusters, reactions);
+		list = network->getPhaseSpaceList();
+	}
+
+	// The other processes build theirs from the tables
+	broadcastTables(clusters, reactions, list);
+	if (procId != 0)
+		network = build(clusters, reactions, list);
+
+	return network;
+}
+
 } // namespace xolotlCore
 
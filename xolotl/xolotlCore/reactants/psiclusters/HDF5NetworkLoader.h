@@ -2,17 +2,73 @@
 #define HDF5NETWORKLOADER_H_
 
 //Includes
+#include <mpi.h>
 #include <PSIClusterNetworkLoader.h>
+#include "xolotlCore/io/XFile.h"
 
 namespace xolotlCore {
 
 /**
  * This class overwrites the load() methods of PSIClusterNetworkLoader
  * for HDF5 files.
+ *
+ * When a cache directory is given in the options, generate() saves the
+ * network it builds in an HDF5 file of this directory, named after a hash
+ * of the generation parameters. The next runs with the same parameters load
+ * this file instead of building the network again.
+ *
+ * When the broadcast is chosen in the options, only the master process
+ * generates the network or reads the file. It broadcasts the network
+ * tables and the other processes build their network from them.
  */
 class HDF5NetworkLoader: public PSIClusterNetworkLoader {
 private:
 
+	/**
+	 * This operation builds the name of the cache file of the network
+	 * generated with the given options.
+	 *
+	 * @param options The command line options
+	 * @return The path of the file in the cache directory
+	 */
+	std::string getCacheFilename(const IOptions& options) const;
+
+	/**
+	 * This operation reads the tables of the network from the HDF5 file.
+	 *
+	 * @param comm The processes reading the file
+	 * @param clusters The properties of the clusters
+	 * @param reactions The reactions of the clusters
+	 * @return The phase space parameters
+	 */
+	Array<int, 5> readTables(MPI_Comm comm,
+			XFile::NetworkGroup::ClusterTable& clusters,
+			XFile::NetworkGroup::ReactionTables& reactions) const;
+
+	/**
+	 * This operation builds the network from its tables.
+	 *
+	 * @param clusters The properties of the clusters
+	 * @param reactions The reactions of the clusters
+	 * @param list The phase space parameters
+	 * @return The reaction network
+	 */
+	std::unique_ptr<IReactionNetwork> build(
+			const XFile::NetworkGroup::ClusterTable& clusters,
+			XFile::NetworkGroup::ReactionTables& reactions,
+			const Array<int, 5>& list);
+
+	/**
+	 * This operation generates the network from options, or reads it from
+	 * the cache if it was already generated with the same parameters.
+	 *
+	 * @param options The command line options
+	 * @param comm The processes building the network
+	 * @return The reaction network
+	 */
+	std::unique_ptr<IReactionNetwork> generateOrReadCache(
+			const IOptions& options, MPI_Comm comm);
+
 	/**
 	 * Private nullary constructor.
 	 */
@@ -43,6 +99,17 @@ public:
 	 */
 	std::unique_ptr<IReactionNetwork> load(const IOptions& options) override;
 
+	/**
+	 * This operation will generate the reaction network from options,
+	 * or load it from the cache if it was already generated with the same
+	 * parameters.
+	 *
+	 * @param options The command line options
+	 * @return The reaction network.
+	 */
+	std::unique_ptr<IReactionNetwork> generate(const IOptions& options)
+			override;
+
 };
 
 } /* namespace xolotlCore */
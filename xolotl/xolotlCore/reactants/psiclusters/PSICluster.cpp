@@ -2,6 +2,7 @@
 #include <cassert>
 #include <iterator>
 #include "PSICluster.h"
+#include "PSIClusterReactionNetwork.h"
 #include <xolotlPerf.h>
 #include <Constants.h>
 #include <MathUtils.h>
@@ -13,7 +14,8 @@ void PSICluster::resultFrom(ProductionReaction& reaction, int a[4], int b[4]) {
 	// Add a cluster pair for the given reaction.
 	reactingPairs.emplace_back(reaction,
 			static_cast<PSICluster&>(reaction.first),
-			static_cast<PSICluster&>(reaction.second), psDim);
+			static_cast<PSICluster&>(reaction.second),
+			getCoefficientArena(), psDim);
 	auto& newPair = reactingPairs.back();
 
 	// NB: newPair's reactants are same as reaction's.
@@ -52,7 +54,8 @@ void PSICluster::resultFrom(ProductionReaction& reaction,
 	// Add a cluster pair for the given reaction.
 	reactingPairs.emplace_back(reaction,
 			static_cast<PSICluster&>(reaction.first),
-			static_cast<PSICluster&>(reaction.second), psDim);
+			static_cast<PSICluster&>(reaction.second),
+			getCoefficientArena(), psDim);
 	auto& newPair = reactingPairs.back();
 
 	// NB: newPair's reactants are same as reaction's.
@@ -91,7 +94,8 @@ void PSICluster::resultFrom(ProductionReaction& reaction, IReactant& product) {
 	// Add a cluster pair for the given reaction.
 	reactingPairs.emplace_back(reaction,
 			static_cast<PSICluster&>(reaction.first),
-			static_cast<PSICluster&>(reaction.second), psDim);
+			static_cast<PSICluster&>(reaction.second),
+			getCoefficientArena(), psDim);
 	auto& newPair = reactingPairs.back();
 
 	auto const& superR1 = static_cast<PSICluster const&>(newPair.first);
@@ -165,7 +169,8 @@ void PSICluster::resultFrom(ProductionReaction& reaction, double *coef) {
 	// Add a cluster pair for the given reaction.
 	reactingPairs.emplace_back(reaction,
 			static_cast<PSICluster&>(reaction.first),
-			static_cast<PSICluster&>(reaction.second), psDim);
+			static_cast<PSICluster&>(reaction.second),
+			getCoefficientArena(), psDim);
 	auto& newPair = reactingPairs.back();
 
 	// NB: newPair's reactants are same as reaction's.
@@ -200,7 +205,8 @@ void PSICluster::participateIn(ProductionReaction& reaction, int a[4]) {
 	if (it == combiningReactants.rend()) {
 		// We did not already know about this combination.
 		// Note that we combine with the other cluster in this reaction.
-		combiningReactants.emplace_back(reaction, otherCluster, psDim);
+		combiningReactants.emplace_back(reaction, otherCluster,
+				getCoefficientArena(), psDim);
 		it = combiningReactants.rbegin();
 	}
 
@@ -233,7 +239,8 @@ void PSICluster::participateIn(ProductionReaction& reaction,
 	if (it == combiningReactants.rend()) {
 		// We did not already know about this combination.
 		// Note that we combine with the other cluster in this reaction.
-		combiningReactants.emplace_back(reaction, otherCluster, psDim);
+		combiningReactants.emplace_back(reaction, otherCluster,
+				getCoefficientArena(), psDim);
 		it = combiningReactants.rbegin();
 	}
 	assert(it != combiningReactants.rend());
@@ -271,7 +278,8 @@ void PSICluster::participateIn(ProductionReaction& reaction,
 	if (it == combiningReactants.rend()) {
 		// We did not already know about this combination.
 		// Note that we combine with the other cluster in this reaction.
-		combiningReactants.emplace_back(reaction, otherCluster, psDim);
+		combiningReactants.emplace_back(reaction, otherCluster,
+				getCoefficientArena(), psDim);
 		it = combiningReactants.rbegin();
 	}
 
@@ -341,7 +349,8 @@ void PSICluster::participateIn(ProductionReaction& reaction, double *coef) {
 	if (it == combiningReactants.rend()) {
 		// We did not already know about this combination.
 		// Note that we combine with the other cluster in this reaction.
-		combiningReactants.emplace_back(reaction, otherCluster, psDim);
+		combiningReactants.emplace_back(reaction, otherCluster,
+				getCoefficientArena(), psDim);
 		it = combiningReactants.rbegin();
 	}
 
@@ -376,7 +385,8 @@ void PSICluster::participateIn(DissociationReaction& reaction, int a[4],
 		// dissociating cluster is the first one
 		dissociatingPairs.emplace_back(reaction,
 				static_cast<PSICluster&>(reaction.dissociating),
-				static_cast<PSICluster&>(emittedCluster), psDim);
+				static_cast<PSICluster&>(emittedCluster),
+				getCoefficientArena(), psDim);
 		it = dissociatingPairs.rbegin();
 	}
 
@@ -414,7 +424,8 @@ void PSICluster::participateIn(DissociationReaction& reaction,
 		// dissociating cluster is the first one
 		dissociatingPairs.emplace_back(reaction,
 				static_cast<PSICluster&>(reaction.dissociating),
-				static_cast<PSICluster&>(emittedCluster), psDim);
+				static_cast<PSICluster&>(emittedCluster),
+				getCoefficientArena(), psDim);
 		it = dissociatingPairs.rbegin();
 	}
 	assert(it != dissociatingPairs.rend());
@@ -457,7 +468,8 @@ void PSICluster::participateIn(DissociationReaction& reaction,
 		// dissociating cluster is the first one
 		dissociatingPairs.emplace_back(reaction,
 				static_cast<PSICluster&>(reaction.dissociating),
-				static_cast<PSICluster&>(emittedCluster), psDim);
+				static_cast<PSICluster&>(emittedCluster),
+				getCoefficientArena(), psDim);
 		it = dissociatingPairs.rbegin();
 	}
 
@@ -531,7 +543,8 @@ void PSICluster::participateIn(DissociationReaction& reaction, double *coef) {
 		// dissociating cluster is the first one
 		dissociatingPairs.emplace_back(reaction,
 				static_cast<PSICluster&>(reaction.dissociating),
-				static_cast<PSICluster&>(emittedCluster), psDim);
+				static_cast<PSICluster&>(emittedCluster),
+				getCoefficientArena(), psDim);
 		it = dissociatingPairs.rbegin();
 	}
 
@@ -555,7 +568,8 @@ void PSICluster::emitFrom(DissociationReaction& reaction, int a[4]) {
 	// this reaction?
 	emissionPairs.emplace_back(reaction,
 			static_cast<PSICluster&>(reaction.first),
-			static_cast<PSICluster&>(reaction.second), psDim);
+			static_cast<PSICluster&>(reaction.second),
+			getCoefficientArena(), psDim);
 	auto& dissPair = emissionPairs.back();
 
 	// Count the number of reactions
@@ -573,7 +587,8 @@ void PSICluster::emitFrom(DissociationReaction& reaction,
 	// this reaction?
 	emissionPairs.emplace_back(reaction,
 			static_cast<PSICluster&>(reaction.first),
-			static_cast<PSICluster&>(reaction.second), psDim);
+			static_cast<PSICluster&>(reaction.second),
+			getCoefficientArena(), psDim);
 	auto& dissPair = emissionPairs.back();
 
 	// Update the coefficients
@@ -594,7 +609,8 @@ void PSICluster::emitFrom(DissociationReaction& reaction, IReactant& disso) {
 	// this reaction?
 	emissionPairs.emplace_back(reaction,
 			static_cast<PSICluster&>(reaction.first),
-			static_cast<PSICluster&>(reaction.second), psDim);
+			static_cast<PSICluster&>(reaction.second),
+			getCoefficientArena(), psDim);
 	auto& dissPair = emissionPairs.back();
 
 	auto const& superR1 = static_cast<PSICluster const&>(dissPair.first);
@@ -658,7 +674,8 @@ void PSICluster::emitFrom(DissociationReaction& reaction, double *coef) {
 	// this reaction?
 	emissionPairs.emplace_back(reaction,
 			static_cast<PSICluster&>(reaction.first),
-			static_cast<PSICluster&>(reaction.second), psDim);
+			static_cast<PSICluster&>(reaction.second),
+			getCoefficientArena(), psDim);
 	auto& dissPair = emissionPairs.back();
 
 	// Count the number of reactions
@@ -752,6 +769,11 @@ void PSICluster::resetConnectivities() {
 	return;
 }
 
+PSICoefficientArena& PSICluster::getCoefficientArena() const {
+	return static_cast<PSIClusterReactionNetwork&>(network)
+			.getCoefficientArena();
+}
+
 void PSICluster::updateFromNetwork() {
 
 	// Clear the flux-related arrays
@@ -783,7 +805,7 @@ double PSICluster::getDissociationFlux(int xi) const {
 
 				// Calculate the Dissociation flux
 				return running +
-				(currPair.reaction.kConstant[xi] * sum);
+				(currPair.reaction.getRateConstant(xi) * sum);
 			});
 
 	// Return the flux
@@ -796,7 +818,7 @@ double PSICluster::getEmissionFlux(int xi) const {
 	double flux =
 			std::accumulate(emissionPairs.begin(), emissionPairs.end(), 0.0,
 					[&xi](double running, const ClusterPair& currPair) {
-						return running + (currPair.reaction.kConstant[xi] * currPair.coefs[0][0]);
+						return running + (currPair.reaction.getRateConstant(xi) * currPair.coefs[0][0]);
 					});
 
 	return flux * concentration;
@@ -826,7 +848,7 @@ double PSICluster::getProductionFlux(int xi) const {
 				}
 			}
 			// Update the flux
-			return running + (currPair.reaction.kConstant[xi] *
+			return running + (currPair.reaction.getRateConstant(xi) *
 					sum);
 		});
 
@@ -854,7 +876,7 @@ double PSICluster::getCombinationFlux(int xi) const {
 					sum += cc.coefs[i] * lB[i];
 				}
 				// Calculate the combination flux
-				return running + (cc.reaction.kConstant[xi] *
+				return running + (cc.reaction.getRateConstant(xi) *
 						sum);
 
 			});
@@ -862,6 +884,56 @@ double PSICluster::getCombinationFlux(int xi) const {
 	return flux * concentration;
 }
 
+void PSICluster::addFluxTerms(PSIReactionTable& table) const {
+	// The flux of this cluster updates its concentration
+	int out = id - 1;
+
+	// Production: k * coefs[i][j] * lA[i] * lB[j]
+	for (auto const& currPair : reactingPairs) {
+		for (int i = 0; i < psDim; i++) {
+			int a = getMomentIndex(currPair.first, i);
+			if (a < 0)
+				continue;
+			for (int j = 0; j < psDim; j++) {
+				int b = getMomentIndex(currPair.second, j);
+				if (b < 0)
+					continue;
+				table.addQuadraticTerm(currPair.reaction, a, b, out,
+						currPair.coefs[i][j]);
+			}
+		}
+	}
+
+	// Combination: - k * coefs[i] * lB[i] * concentration
+	for (auto const& cc : combiningReactants) {
+		for (int i = 0; i < psDim; i++) {
+			int b = getMomentIndex(cc.combining, i);
+			if (b < 0)
+				continue;
+			table.addQuadraticTerm(cc.reaction, out, b, out, -cc.coefs[i]);
+		}
+	}
+
+	// Dissociation: k * coefs[i][0] * lA[i]
+	for (auto const& currPair : dissociatingPairs) {
+		for (int i = 0; i < psDim; i++) {
+			int a = getMomentIndex(currPair.first, i);
+			if (a < 0)
+				continue;
+			table.addLinearTerm(currPair.reaction, a, out,
+					currPair.coefs[i][0]);
+		}
+	}
+
+	// Emission: - k * coefs[0][0] * concentration
+	for (auto const& currPair : emissionPairs) {
+		table.addLinearTerm(currPair.reaction, out, out,
+				-currPair.coefs[0][0]);
+	}
+
+	return;
+}
+
 std::vector<double> PSICluster::getPartialDerivatives(int i) const {
 	// Local Declarations
 	std::vector<double> partials(network.getDOF(), 0.0);
@@ -910,7 +982,7 @@ void PSICluster::getProductionPartialDerivatives(std::vector<double> & partials,
 				}
 
 				// Compute contribution from the first part of the reacting pair
-				double value = currPair.reaction.kConstant[xi];
+				double value = currPair.reaction.getRateConstant(xi);
 
 				double sum[5][2] = {};
 				for (int j = 0; j < psDim; j++) {
@@ -957,10 +1029,10 @@ void PSICluster::getCombinationPartialDerivatives(
 
 				// Remember that the flux due to combinations is OUTGOING (-=)!
 				// Compute the contribution from this cluster
-				partials[id - 1] -= cc.reaction.kConstant[xi]
+				partials[id - 1] -= cc.reaction.getRateConstant(xi)
 				* sum;
 				// Compute the contribution from the combining cluster
-				double value = cc.reaction.kConstant[xi] * concentration;
+				double value = cc.reaction.getRateConstant(xi) * concentration;
 				partials[cluster.id - 1] -= value * cc.coefs[0];
 
 				for (int i = 1; i < psDim; i++) {
@@ -984,7 +1056,7 @@ void PSICluster::getDissociationPartialDerivatives(
 			[&partials,this,&xi](const ClusterPair& currPair) {
 				// Get the dissociating cluster
 				auto const& cluster = currPair.first;
-				double value = currPair.reaction.kConstant[xi];
+				double value = currPair.reaction.getRateConstant(xi);
 				partials[cluster.id - 1] += value * currPair.coefs[0][0];
 				for (int i = 1; i < psDim; i++) {
 					partials[cluster.momId[indexList[i] - 1] - 1] += value * currPair.coefs[i][0];
@@ -1006,7 +1078,7 @@ void PSICluster::getEmissionPartialDerivatives(std::vector<double> & partials,
 	double outgoingFlux =
 			std::accumulate(emissionPairs.begin(), emissionPairs.end(), 0.0,
 					[&xi](double running, const ClusterPair& currPair) {
-						return running + (currPair.reaction.kConstant[xi] * currPair.coefs[0][0]);
+						return running + (currPair.reaction.getRateConstant(xi) * currPair.coefs[0][0]);
 					});
 	partials[id - 1] -= outgoingFlux;
 
@@ -1021,14 +1093,36 @@ double PSICluster::getLeftSideRate(int i) const {
 					combiningReactants.end(), 0.0,
 					[&i](double running, const CombiningCluster& cc) {
 						return running +
-						(cc.reaction.kConstant[i] * cc.combining.concentration * cc.coefs[0]);
+						(cc.reaction.getRateConstant(i) * cc.combining.concentration * cc.coefs[0]);
+					});
+
+	// Sum rate constants over all emission pair reactions.
+	double emissionRateTotal =
+			std::accumulate(emissionPairs.begin(), emissionPairs.end(), 0.0,
+					[&i](double running, const ClusterPair& currPair) {
+						return running + (currPair.reaction.getRateConstant(i) * currPair.coefs[0][0]);
+					});
+
+	return combiningRateTotal + emissionRateTotal;
+}
+
+double PSICluster::getLeftSideRate(const double *concentrations,
+		int i) const {
+
+	// Sum rate constant-concentration product over combining reactants.
+	double combiningRateTotal =
+			std::accumulate(combiningReactants.begin(),
+					combiningReactants.end(), 0.0,
+					[&i,concentrations](double running, const CombiningCluster& cc) {
+						return running +
+						(cc.reaction.getRateConstant(i) * concentrations[cc.combining.getId() - 1] * cc.coefs[0]);
 					});
 
 	// Sum rate constants over all emission pair reactions.
 	double emissionRateTotal =
 			std::accumulate(emissionPairs.begin(), emissionPairs.end(), 0.0,
 					[&i](double running, const ClusterPair& currPair) {
-						return running + (currPair.reaction.kConstant[i] * currPair.coefs[0][0]);
+						return running + (currPair.reaction.getRateConstant(i) * currPair.coefs[0][0]);
 					});
 
 	return combiningRateTotal + emissionRateTotal;
@@ -4,6 +4,8 @@
 // Includes
 #include <Reactant.h>
 #include "IntegerRange.h"
+#include "PSIReactionTable.h"
+#include "PSICoefficientArena.h"
 
 namespace xolotlPerf {
 class ITimer;
@@ -69,50 +71,23 @@ protected:
 		 * 2 -> D
 		 * 3 -> T
 		 * 4 -> V
+		 *
+		 * They are stored in a slab of the coefficient arena of the network.
 		 */
-		double **coefs;
-
-		//! The dimension, needed to be able to use the copy constructor
-		int dim = 0;
+		PSICoefficientMatrix coefs;
 
 		//! The constructor
 		ClusterPair(Reaction& _reaction, PSICluster& _first,
-				PSICluster& _second, const int _dim) :
-				first(_first), second(_second), reaction(_reaction), dim(_dim) {
-			// Create the array of the right dimension
-			coefs = new double*[dim];
-			for (int i = 0; i < dim; i++) {
-				coefs[i] = new double[dim];
-				for (int j = 0; j < dim; j++) {
-					coefs[i][j] = 0.0;
-				}
-			}
+				PSICluster& _second, PSICoefficientArena& arena,
+				const int _dim) :
+				first(_first), second(_second), reaction(_reaction), coefs(
+						arena.allocate(_dim * _dim), _dim) {
 		}
 
 		/**
 		 * Default constructor, disallowed.
 		 */
 		ClusterPair() = delete;
-
-		// NB: if PSICluster keeps these in a std::vector,
-		// copy ctor is needed.
-		ClusterPair(const ClusterPair& other) :
-				dim(other.dim), first(other.first), second(other.second), reaction(
-						other.reaction) {
-			// Create the array of the right dimension
-			coefs = new double*[dim];
-			for (int i = 0; i < dim; i++) {
-				coefs[i] = new double[dim];
-				for (int j = 0; j < dim; j++) {
-					coefs[i][j] = other.coefs[i][j];
-				}
-			}
-		}
-
-		//! The destructor
-		~ClusterPair() {
-			delete[] coefs;
-		}
 	};
 
 	/**
@@ -145,43 +120,22 @@ protected:
 		 * 2 -> D
 		 * 3 -> T
 		 * 4 -> V
+		 *
+		 * They are stored in a slab of the coefficient arena of the network.
 		 */
 		double *coefs;
 
-		//! The dimension, needed to be able to use the copy constructor
-		int dim = 0;
-
 		//! The constructor
-		CombiningCluster(Reaction& _reaction, PSICluster& _comb, const int _dim) :
-				combining(_comb), reaction(_reaction), dim(_dim) {
-			// Create the array of the right dimension
-			coefs = new double[dim];
-			for (int j = 0; j < dim; j++) {
-				coefs[j] = 0.0;
-			}
+		CombiningCluster(Reaction& _reaction, PSICluster& _comb,
+				PSICoefficientArena& arena, const int _dim) :
+				combining(_comb), reaction(_reaction), coefs(
+						arena.allocate(_dim)) {
 		}
 
 		/**
 		 * Default constructor, disallowed to prohibit building without args.
 		 */
 		CombiningCluster() = delete;
-
-		// NB: if PSICluster keeps these in a std::vector,
-		// copy ctor is needed.
-		CombiningCluster(const CombiningCluster& other) :
-				dim(other.dim), combining(other.combining), reaction(
-						other.reaction) {
-			// Create the array of the right dimension
-			coefs = new double[dim];
-			for (int j = 0; j < dim; j++) {
-				coefs[j] = other.coefs[j];
-			}
-		}
-
-		//! The destructor
-		~CombiningCluster() {
-			delete[] coefs;
-		}
 	};
 
 	/**
@@ -225,6 +179,32 @@ protected:
 	void dumpCoefficients(std::ostream& os, ClusterPair const& curr) const;
 	void dumpCoefficients(std::ostream& os, CombiningCluster const& curr) const;
 
+	/**
+	 * Get the arena of the network where the coefficients of the reacting
+	 * pairs and combining clusters are stored.
+	 *
+	 * @return The coefficient arena
+	 */
+	PSICoefficientArena& getCoefficientArena() const;
+
+	/**
+	 * This operation returns the index in the concentration array of the
+	 * given moment of a cluster.
+	 *
+	 * @param cluster The cluster
+	 * @param i The position of the moment in the phase space, 0 being
+	 * the concentration
+	 * @return The index, or -1 if this moment is always null (first moments
+	 * of normal clusters)
+	 */
+	int getMomentIndex(const PSICluster& cluster, int i) const {
+		if (i == 0)
+			return cluster.id - 1;
+		if (cluster.type != ReactantType::PSISuper)
+			return -1;
+		return cluster.momId[indexList[i] - 1] - 1;
+	}
+
 public:
 
 	/**
@@ -558,6 +538,16 @@ public:
 	 */
 	virtual double getCombinationFlux(int i) const;
 
+	/**
+	 * This operation adds the terms of all the reactions contributing
+	 * to the flux of this cluster to the compiled reaction table of
+	 * the network. It gives the same result as getTotalFlux() once
+	 * evaluated.
+	 *
+	 * @param table The reaction table
+	 */
+	virtual void addFluxTerms(PSIReactionTable& table) const;
+
 	/**
 	 * This operation returns the list of partial derivatives of this cluster
 	 * with respect to all other clusters in the network. The combined lists
@@ -654,6 +644,17 @@ public:
 	 */
 	double getLeftSideRate(int i) const override;
 
+	/**
+	 * This operation returns the same rate with the concentrations of the
+	 * combining clusters read from the given array.
+	 *
+	 * @param concentrations The concentrations at this grid point
+	 * @param i The position on the grid
+	 * @return The rate
+	 */
+	double getLeftSideRate(const double *concentrations, int i) const
+			override;
+
 	/**
 	 * This operation returns the vector of production reactions in which
 	 * this cluster is involved, containing the id of the reactants, and
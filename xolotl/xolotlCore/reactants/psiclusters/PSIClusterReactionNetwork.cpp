@@ -28,13 +28,7 @@ PSIClusterReactionNetwork::PSIClusterReactionNetwork(
 	return;
 }
 
-double PSIClusterReactionNetwork::calculateDissociationConstant(
-		const DissociationReaction& reaction, int i) const {
-
-	// If the dissociations are not allowed
-	if (!dissociationsEnabled)
-		return 0.0;
-
+double PSIClusterReactionNetwork::getAtomicVolume() const {
 	// The atomic volume is computed by considering the BCC structure of the
 	// tungsten. In a given lattice cell in tungsten there are tungsten atoms
 	// at each corner and a tungsten atom in the center. The tungsten atoms at
@@ -45,20 +39,7 @@ double PSIClusterReactionNetwork::calculateDissociationConstant(
 			* xolotlCore::tungstenLatticeConstant
 			* xolotlCore::tungstenLatticeConstant;
 
-	// Get the rate constant from the reverse reaction
-	double kPlus = reaction.reverseReaction->kConstant[i];
-
-	// Calculate and return
-	double bindingEnergy = computeBindingEnergy(reaction);
-	double k_minus_exp = exp(
-			-1.0 * bindingEnergy
-					/ (xolotlCore::kBoltzmann
-							* temperature)); // We can use the network temperature
-											// because this method is called only
-											// when the temperature is updated
-	double k_minus = (1.0 / atomicVolume) * kPlus * k_minus_exp;
-
-	return k_minus;
+	return atomicVolume;
 }
 
 void PSIClusterReactionNetwork::defineProductionReactions(IReactant& r1,
@@ -69,9 +50,7 @@ void PSIClusterReactionNetwork::defineProductionReactions(IReactant& r1,
 	// Define the production reaction to the network.
 	// Do this *once* for the given reactants, since it doesn't
 	// depend on the product or the other parameters.
-	std::unique_ptr<ProductionReaction> reaction(
-			new ProductionReaction(r1, r2));
-	auto& prref = add(std::move(reaction));
+	auto& prref = addProductionReaction(r1, r2);
 
 	// Determine if reverse reaction is allowed.
 	auto dissociationAllowed = canDissociate(pendingPRInfos[0].product, prref);
@@ -116,9 +95,7 @@ void PSIClusterReactionNetwork::defineAnaProductionReactions(IReactant& r1,
 	// Define the production reaction to the network.
 	// Do this *once* for the given reactants, since it doesn't
 	// depend on the product or the other parameters.
-	std::unique_ptr<ProductionReaction> reaction(
-			new ProductionReaction(r1, r2));
-	auto& prref = add(std::move(reaction));
+	auto& prref = addProductionReaction(r1, r2);
 
 	// Determine if reverse reaction is allowed.
 	auto dissociationAllowed = canDissociate(product, prref);
@@ -150,9 +127,9 @@ void PSIClusterReactionNetwork::defineDissociationReactions(
 				// Do this once here for each forward reaction product.
 				IReactant& emitting = *(currMapItem.first);
 
-				std::unique_ptr<DissociationReaction> dissociationReaction(new DissociationReaction(emitting,
-								forwardReaction.first, forwardReaction.second, &forwardReaction));
-				auto& drref = add(std::move(dissociationReaction));
+				auto& drref = addDissociationReaction(emitting,
+						forwardReaction.first, forwardReaction.second,
+						&forwardReaction);
 
 				// Tell all participants in this reaction of their involvement.
 				ProductToProductionMap::mapped_type const& currPRIs = currMapItem.second;
@@ -165,10 +142,8 @@ void PSIClusterReactionNetwork::defineDissociationReactions(
 void PSIClusterReactionNetwork::defineAnaDissociationReactions(
 		ProductionReaction& forwardReaction, IReactant& emitting) {
 
-	std::unique_ptr<DissociationReaction> dissociationReaction(
-			new DissociationReaction(emitting, forwardReaction.first,
-					forwardReaction.second, &forwardReaction));
-	auto& drref = add(std::move(dissociationReaction));
+	auto& drref = addDissociationReaction(emitting, forwardReaction.first,
+			forwardReaction.second, &forwardReaction);
 
 	// Tell the reactants that they are in this reaction
 	forwardReaction.first.participateIn(drref, emitting);
@@ -177,6 +152,9 @@ void PSIClusterReactionNetwork::defineAnaDissociationReactions(
 }
 
 void PSIClusterReactionNetwork::createReactionConnectivity() {
+	// Index the clusters for the product lookups
+	buildClusterIndex();
+
 	// Initial declarations
 	IReactant::SizeType firstSize = 0, secondSize = 0, productSize = 0, maxI =
 			getAll(ReactantType::I).size();
@@ -1381,7 +1359,7 @@ void PSIClusterReactionNetwork::setTemperature(double temp, int i) {
 	setTempTimer->start();
 	ReactionNetwork::setTemperature(temp, i);
 
-	computeRateConstants(i);
+	updateRateConstants(i);
 	setTempTimer->stop();
 
 	return;
@@ -1424,6 +1402,12 @@ void PSIClusterReactionNetwork::reinitializeNetwork() {
 				}
 			});
 
+	// The ids changed
+	reactionTableCompiled = false;
+
+	// The clusters are final, index them for the lookups while solving
+	buildClusterIndex();
+
 	return;
 }
 
@@ -1435,11 +1419,32 @@ void PSIClusterReactionNetwork::reinitializeConnectivities() {
 				currReactant.resetConnectivities();
 			});
 
+	// Flatten the reactions now that they are final
+	compileReactionTable();
+
+	return;
+}
+
+void PSIClusterReactionNetwork::compileReactionTable() {
+
+	// Start from an empty table
+	reactionTable.clear();
+
+	// Let each cluster add its terms
+	std::for_each(allReactants.begin(), allReactants.end(),
+			[this](IReactant& currReactant) {
+				auto const& cluster = static_cast<PSICluster&>(currReactant);
+				cluster.addFluxTerms(reactionTable);
+			});
+	reactionTable.finalize();
+
+	reactionTableCompiled = true;
+
 	return;
 }
 
 void PSIClusterReactionNetwork::updateConcentrationsFromArray(
-		double * concentrations) {
+		const double * concentrations) {
 
 	// Set the concentration on each reactant.
 	std::for_each(allReactants.begin(), allReactants.end(),
@@ -1560,6 +1565,24 @@ void PSIClusterReactionNetwork::getDiagonalFill(SparseFillMap& fillMap) {
 		}
 	}
 
+	// Tell the reaction table where its partial derivatives go, following
+	// the layout given by initPartialsSizes
+	std::vector<int> partialsSize(dof);
+	std::vector<size_t> partialsStartingIdx(dof);
+	initPartialsSizes(partialsSize, partialsStartingIdx);
+	if (!reactionTableCompiled)
+		compileReactionTable();
+	reactionTable.setPartialsPositions(
+			[this,&partialsStartingIdx](int row, int col) {
+				auto rowIter = dFillInvMap.find(row);
+				if (rowIter == dFillInvMap.end())
+					return -1;
+				auto colIter = rowIter->second.find(col);
+				if (colIter == rowIter->second.end())
+					return -1;
+				return (int) partialsStartingIdx[row] + colIter->second;
+			});
+
 	return;
 }
 
@@ -1725,33 +1748,64 @@ double PSIClusterReactionNetwork::getTotalIConcentration() {
 void PSIClusterReactionNetwork::computeAllFluxes(double *updatedConcOffset,
 		int xi) {
 
-	// ----- Compute all of the new fluxes -----
-	std::for_each(allReactants.begin(), allReactants.end(),
-			[&updatedConcOffset,&xi](IReactant& cluster) {
-				// Compute the flux
-				auto flux = cluster.getTotalFlux(xi);
-				// Update the concentration of the cluster
-				auto reactantIndex = cluster.getId() - 1;
-				updatedConcOffset[reactantIndex] += flux;
-			});
-
-	// ---- Moments ----
-	for (auto const& currMapItem : getAll(ReactantType::PSISuper)) {
-
-		auto const& superCluster =
+	// Gather the concentrations and moments of the reactants in one array
+	// for the compiled reaction table
+	flatConcentrations.resize(getDOF());
+	fillConcentrationsArray(flatConcentrations.data());
+	auto const& superTypeMap = getAll(ReactantType::PSISuper);
+	for (auto const& currMapItem : superTypeMap) {
+		auto const& cluster =
 				static_cast<PSISuperCluster&>(*(currMapItem.second));
-
-		// Loop on the axis
+		// Loop on the used moments
 		for (int i = 1; i < psDim; i++) {
-
-			// Compute the moment flux
-			auto flux = superCluster.getMomentFlux(indexList[i] - 1);
-			// Update the concentration of the cluster
-			auto reactantIndex = superCluster.getMomentId(indexList[i] - 1) - 1;
-			updatedConcOffset[reactantIndex] += flux;
+			flatConcentrations[cluster.getMomentId(indexList[i] - 1) - 1] =
+					cluster.getMoment(indexList[i] - 1);
 		}
 	}
 
+	computeAllFluxes(flatConcentrations.data(), updatedConcOffset, xi);
+
+	return;
+}
+
+void PSIClusterReactionNetwork::computeAllFluxes(const double *concOffset,
+		double *updatedConcOffset, int xi) {
+
+	// Make sure the reactions are flattened
+	if (!reactionTableCompiled)
+		compileReactionTable();
+
+	// ----- Compute all of the new fluxes and moment fluxes -----
+	reactionFluxTimer->start();
+	reactionTable.computeFluxes(concOffset, rateConstants.getRow(xi),
+			updatedConcOffset);
+	reactionFluxTimer->stop();
+	reactionFluxCounter->increment();
+
+	return;
+}
+
+void PSIClusterReactionNetwork::computeAllPartials(const double *concOffset,
+		const std::vector<size_t>& startingIdx, const std::vector<int>& indices,
+		std::vector<double>& vals, int xi) {
+
+	// The positions of the partials are set with the diagonal fill
+	if (!reactionTable.hasPartialsPositions())
+		throw std::string(
+				"\nPSIClusterReactionNetwork::computeAllPartials: "
+						"getDiagonalFill must be called first.");
+
+	// Because we accumulate partials we must start with
+	// all partials values at zero.
+	reactionPartialsTimer->start();
+	std::fill(vals.begin(), vals.end(), 0.0);
+
+	// Compute the partials of all the terms
+	reactionTable.computePartials(concOffset, rateConstants.getRow(xi),
+			vals.data());
+	reactionPartialsTimer->stop();
+	reactionPartialsCounter->increment();
+
 	return;
 }
 
@@ -2712,20 +2766,143 @@ double PSIClusterReactionNetwork::computeBindingEnergy(
 	return max(bindingEnergy, -5.0);
 }
 
+void PSIClusterReactionNetwork::add(std::unique_ptr<IReactant> reactant) {
+
+	// The positions in allReactants will not match the index anymore
+	clusterIndexValid = false;
+
+	ReactionNetwork::add(std::move(reactant));
+
+	return;
+}
+
+void PSIClusterReactionNetwork::removeReactants(
+		const IReactionNetwork::ReactantVector& reactants) {
+
+	// The positions in allReactants will not match the index anymore
+	clusterIndexValid = false;
+
+	ReactionNetwork::removeReactants(reactants);
+
+	return;
+}
+
+IReactant * PSIClusterReactionNetwork::get(ReactantType type,
+		const IReactant::Composition& comp) const {
+
+	// Only the normal He, D, T, V and mixed clusters are in the index
+	if (clusterIndexValid && comp[toCompIdx(Species::I)] == 0
+			&& (type == ReactantType::He || type == ReactantType::D
+					|| type == ReactantType::T || type == ReactantType::V
+					|| type == ReactantType::PSIMixed)) {
+		auto ret = findInClusterIndex(comp[toCompIdx(Species::He)],
+				comp[toCompIdx(Species::D)], comp[toCompIdx(Species::T)],
+				comp[toCompIdx(Species::V)]);
+		// The cell can hold a cluster of another type or a super cluster
+		return (ret && ret->getType() == type) ? ret : nullptr;
+	}
+
+	return ReactionNetwork::get(type, comp);
+}
+
+void PSIClusterReactionNetwork::buildClusterIndex() {
+
+	clusterIndexValid = false;
+	clusterIndex.clear();
+
+	// Find the bounding box of the indexed clusters
+	std::array<std::size_t, 4> extent { 1, 1, 1, 1 };
+	for (IReactant const& currReactant : allReactants) {
+		auto type = currReactant.getType();
+		if (type == ReactantType::PSISuper) {
+			auto const& currCluster =
+					static_cast<PSISuperCluster const&>(currReactant);
+			for (int axis = 0; axis < 4; axis++) {
+				extent[axis] = std::max<std::size_t>(extent[axis],
+						*(currCluster.getBounds(axis).end()));
+			}
+		} else if (type == ReactantType::He || type == ReactantType::D
+				|| type == ReactantType::T || type == ReactantType::V
+				|| type == ReactantType::PSIMixed) {
+			auto const& comp = currReactant.getComposition();
+			extent[0] = std::max<std::size_t>(extent[0],
+					comp[toCompIdx(Species::He)] + 1);
+			extent[1] = std::max<std::size_t>(extent[1],
+					comp[toCompIdx(Species::D)] + 1);
+			extent[2] = std::max<std::size_t>(extent[2],
+					comp[toCompIdx(Species::T)] + 1);
+			extent[3] = std::max<std::size_t>(extent[3],
+					comp[toCompIdx(Species::V)] + 1);
+		}
+	}
+
+	// Keep using the maps if the box is too large
+	if (extent[0] * extent[1] * extent[2] * extent[3] > maxClusterIndexSize)
+		return;
+	clusterIndexExtent = extent;
+	clusterIndex.assign(extent[0] * extent[1] * extent[2] * extent[3], 0);
+
+	// Claim the cell of the given composition, false if it is already taken
+	auto claim = [this](std::size_t nHe, std::size_t nD, std::size_t nT,
+			std::size_t nV, int cell) {
+		auto& current = clusterIndex[((nHe * clusterIndexExtent[1] + nD)
+				* clusterIndexExtent[2] + nT) * clusterIndexExtent[3] + nV];
+		if (current > 0)
+			return false;
+		current = cell;
+		return true;
+	};
+
+	// Fill the cells, keeping the maps if two clusters overlap
+	int cell = 0;
+	for (IReactant const& currReactant : allReactants) {
+		cell++;
+		auto type = currReactant.getType();
+		if (type == ReactantType::PSISuper) {
+			auto const& currCluster =
+					static_cast<PSISuperCluster const&>(currReactant);
+			for (auto nHe : currCluster.getBounds(0)) {
+				for (auto nD : currCluster.getBounds(1)) {
+					for (auto nT : currCluster.getBounds(2)) {
+						for (auto nV : currCluster.getBounds(3)) {
+							if (currCluster.isIn(nHe, nD, nT, nV)
+									&& !claim(nHe, nD, nT, nV, cell)) {
+								clusterIndex.clear();
+								return;
+							}
+						}
+					}
+				}
+			}
+		} else if (type == ReactantType::He || type == ReactantType::D
+				|| type == ReactantType::T || type == ReactantType::V
+				|| type == ReactantType::PSIMixed) {
+			auto const& comp = currReactant.getComposition();
+			if (!claim(comp[toCompIdx(Species::He)],
+					comp[toCompIdx(Species::D)], comp[toCompIdx(Species::T)],
+					comp[toCompIdx(Species::V)], cell)) {
+				clusterIndex.clear();
+				return;
+			}
+		}
+	}
+
+	clusterIndexValid = true;
+
+	return;
+}
+
 IReactant * PSIClusterReactionNetwork::getSuperFromComp(IReactant::SizeType nHe,
 		IReactant::SizeType nD, IReactant::SizeType nT,
 		IReactant::SizeType nV) const {
 
-	// Requests for finding a particular supercluster have high locality.
-	// See if the last supercluster we were asked to find is the right
-	// one for this request.
-	static IReactant* lastRet;
-	if (lastRet
-			and static_cast<PSISuperCluster*>(lastRet)->isIn(nHe, nD, nT, nV)) {
-		return lastRet;
+	// Use the dense index if it is up to date
+	if (clusterIndexValid) {
+		auto ret = findInClusterIndex(nHe, nD, nT, nV);
+		return (ret && ret->getType() == ReactantType::PSISuper) ? ret : nullptr;
 	}
 
-	// We didn't find the last supercluster in our cache, so do a full lookup.
+	// Otherwise look at each super cluster
 	IReactant* ret = nullptr;
 
 	for (auto const& superMapItem : getAll(ReactantType::PSISuper)) {
@@ -2733,7 +2910,6 @@ IReactant * PSIClusterReactionNetwork::getSuperFromComp(IReactant::SizeType nHe,
 		auto const& reactant =
 				static_cast<PSISuperCluster&>(*(superMapItem.second));
 		if (reactant.isIn(nHe, nD, nT, nV)) {
-			lastRet = superMapItem.second.get();
 			return superMapItem.second.get();
 		}
 	}
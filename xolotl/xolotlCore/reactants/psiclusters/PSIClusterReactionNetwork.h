@@ -10,8 +10,11 @@
 #include <map>
 #include <unordered_map>
 #include <algorithm>
+#include <array>
 #include "ReactionNetwork.h"
 #include "PSISuperCluster.h"
+#include "PSIReactionTable.h"
+#include "PSICoefficientArena.h"
 #include "ReactantType.h"
 
 namespace xolotlCore {
@@ -32,27 +35,56 @@ class PSIClusterReactionNetwork: public ReactionNetwork {
 
 private:
 	/**
-	 * Concise name for map supporting quick lookup of supercluster containing
-	 * specifc number of He and V.
+	 * Dense index of the clusters by their number of He, D, T and V atoms,
+	 * stored as a single vector indexed by nHe, nD, nT and nV in the
+	 * bounding box of the network.
 	 *
-	 * We could use a map, but because we expect it to be dense (i.e.,
-	 * most pairs of He and V counts will have a valid super cluster),
-	 * a 2D matrix indexed by nHe and nV gives better performance for
-	 * lookups without costing too much more (if any) in terms of memory.
-	 * We use a vector of vectors instead of array of arrays because
-	 * we don't know the dimensions at compile time.  We use a vector of
-	 * vectors instead of a single vector with more complex indexing
-	 * to simplify indexing.  It may be worthwhile to compare performance
-	 * with a single vector implementation to see if the single
-	 * memory allocation ends up giving better performance.
+	 * Each cell holds 1 + the position in allReactants of the normal He, D,
+	 * T, V or mixed cluster with this composition, or of the super cluster
+	 * that contains it, and 0 if there is none. It replaces hashing the
+	 * composition, where most of the keys collide because the hash is the
+	 * sum of the numbers of atoms, and scanning all the super clusters.
 	 */
-	using HeVToSuperClusterMap = std::vector<std::vector<ReactantMap::const_iterator> >;
+	std::vector<int> clusterIndex;
+
+	//! The size of the index along He, D, T and V
+	std::array<std::size_t, 4> clusterIndexExtent;
+
+	//! Whether the index is up to date with allReactants
+	bool clusterIndexValid = false;
+
+	//! The largest number of cells in the index
+	static constexpr std::size_t maxClusterIndexSize = 1 << 24;
+
+	/**
+	 * Build the dense index from allReactants. The index is left invalid,
+	 * and the lookups use the maps, if it would be too large or if a
+	 * composition would be claimed by more than one cluster.
+	 */
+	void buildClusterIndex();
 
 	/**
-	 * Map supporting quick identification of super cluster containing
-	 * given number of He and V.
+	 * Find the cluster stored in the dense index for the given composition.
+	 * The index has to be valid.
+	 *
+	 * @param nHe The number of helium atoms
+	 * @param nD The number of deuterium atoms
+	 * @param nT The number of tritium atoms
+	 * @param nV The number of vacancies
+	 * @return The normal or super cluster, or nullptr if there is none
 	 */
-	HeVToSuperClusterMap superClusterLookupMap;
+	IReactant * findInClusterIndex(IReactant::SizeType nHe,
+			IReactant::SizeType nD, IReactant::SizeType nT,
+			IReactant::SizeType nV) const {
+		if (nHe >= clusterIndexExtent[0] || nD >= clusterIndexExtent[1]
+				|| nT >= clusterIndexExtent[2] || nV >= clusterIndexExtent[3])
+			return nullptr;
+
+		int cell = clusterIndex[((nHe * clusterIndexExtent[1] + nD)
+				* clusterIndexExtent[2] + nT) * clusterIndexExtent[3] + nV];
+
+		return cell > 0 ? &(allReactants[cell - 1].get()) : nullptr;
+	}
 
 	//! The dimension of the phase space
 	int psDim = 0;
@@ -60,17 +92,31 @@ private:
 	//! The indexList.
 	Array<int, 5> indexList;
 
+	//! The storage of the coefficients of the reactions of each cluster
+	PSICoefficientArena coefArena;
+
+	//! The compiled reaction table used to compute the fluxes
+	PSIReactionTable reactionTable;
+
+	//! Whether the reaction table is up to date with the connectivities
+	bool reactionTableCompiled = false;
+
+	//! The concentrations of the reactants gathered for the reaction table
+	std::vector<double> flatConcentrations;
+
 	/**
-	 * Calculate the dissociation constant of the first cluster with respect to
-	 * the single-species cluster of the same type based on the current clusters
-	 * atomic volume, reaction rate constant, and binding energies.
+	 * Build the compiled reaction table from the reactions of
+	 * each cluster. Ids and connectivities have to be final.
+	 */
+	void compileReactionTable();
+
+	/**
+	 * Get the atomic volume of the material, needed for the dissociation
+	 * constants.
 	 *
-	 * @param reaction The reaction
-	 * @param i The location on the grid in the depth direction
-	 * @return The dissociation constant
+	 * @return The atomic volume in nm3
 	 */
-	double calculateDissociationConstant(
-			const DissociationReaction& reaction, int i) const override;
+	double getAtomicVolume() const override;
 
 	/**
 	 * Calculate the binding energy for the dissociation cluster to emit the single
@@ -103,9 +149,7 @@ private:
 					__attribute__((always_inline)) {
 
 		// Add a production reaction to our network.
-		std::unique_ptr<ProductionReaction> reaction(
-				new ProductionReaction(r1, r2));
-		auto& prref = add(std::move(reaction));
+		auto& prref = addProductionReaction(r1, r2);
 
 		// Tell the reactants that they are involved in this reaction
 		// if this is not the second product
@@ -182,10 +226,8 @@ private:
 			IReactant& emitting, int a[4] = defaultInit,
 			int b[4] = defaultInit) {
 
-		std::unique_ptr<DissociationReaction> dissociationReaction(
-				new DissociationReaction(emitting, forwardReaction.first,
-						forwardReaction.second, &forwardReaction));
-		auto& drref = add(std::move(dissociationReaction));
+		auto& drref = addDissociationReaction(emitting, forwardReaction.first,
+				forwardReaction.second, &forwardReaction);
 
 		// Tell the reactants that they are in this reaction
 		forwardReaction.first.participateIn(drref, a, b);
@@ -371,6 +413,43 @@ public:
 	 */
 	void createReactionConnectivity();
 
+	// Keep the other overloads visible next to the overrides below
+	using ReactionNetwork::add;
+	using ReactionNetwork::get;
+
+	/**
+	 * Give the reactant to the network.
+	 *
+	 * Overridden to invalidate the dense index.
+	 *
+	 * @param reactant The reactant that should be added to the network.
+	 */
+	void add(std::unique_ptr<IReactant> reactant) override;
+
+	/**
+	 * Remove the given reactants from the network.
+	 *
+	 * Overridden to invalidate the dense index.
+	 *
+	 * @param reactants The reactants that should be removed.
+	 */
+	void removeReactants(const ReactantVector& reactants) override;
+
+	/**
+	 * Retrieve the reactant with the given type and composition if
+	 * exists in the network.
+	 *
+	 * The normal He, D, T, V and mixed clusters are found in the dense index
+	 * when it is valid, the other ones in the maps.
+	 *
+	 * @param type The type of the reactant
+	 * @param comp The composition of the reactant
+	 * @return A pointer to the reactant of type 'type' and with composition
+	 * 'comp.' nullptr if no such reactant exists.
+	 */
+	IReactant * get(ReactantType type, const IReactant::Composition& comp) const
+			override;
+
 	/**
 	 * This operation sets the temperature at which the reactants currently
 	 * exists. It calls setTemperature() on each reactant.
@@ -405,7 +484,7 @@ public:
 	 * array. Properly aligning the array in memory so that this operation
 	 * does not overrun is up to the caller.
 	 */
-	void updateConcentrationsFromArray(double * concentrations) override;
+	void updateConcentrationsFromArray(const double * concentrations) override;
 
 	/**
 	 * This operation returns the number of super reactants in the network.
@@ -489,6 +568,20 @@ public:
 	 */
 	void computeAllFluxes(double *updatedConcOffset, int i) override;
 
+	/**
+	 * Compute the fluxes generated by all the reactions
+	 * for all the clusters and their momentums directly from the
+	 * concentration array. The state of the network is not used nor modified.
+	 *
+	 * @param concOffset The pointer to the array of the concentration at the grid
+	 * point where the fluxes are computed
+	 * @param updatedConcOffset The pointer to the array of the concentration at the grid
+	 * point where the fluxes are computed used to find the next solution
+	 * @param i The location on the grid in the depth direction
+	 */
+	void computeAllFluxes(const double *concOffset, double *updatedConcOffset,
+			int i) override;
+
 	/**
 	 * Compute the partial derivatives generated by all the reactions
 	 * for all the clusters and their momentum.
@@ -503,6 +596,62 @@ public:
 			const std::vector<int>& indices, std::vector<double>& vals, int i) const
 					override;
 
+	/**
+	 * Compute the partial derivatives generated by all the reactions
+	 * for all the clusters and their momentum directly from the
+	 * concentration array. The state of the network is not used nor modified.
+	 * getDiagonalFill() must have been called before and the partials
+	 * arrays must be the ones given by initPartialsSizes() and
+	 * initPartialsIndices().
+	 *
+	 * @param concOffset The pointer to the array of the concentration at the grid
+	 * point where the partials are computed
+	 * @param startingIdx Starting index of items owned by each reactant
+	 *      within the partials values array and the indices array.
+	 * @param indices The indices of the clusters for the partial derivatives.
+	 * @param vals The values of partials for the reactions
+	 * @param i The location on the grid in the depth direction
+	 */
+	void computeAllPartials(const double *concOffset,
+			const std::vector<size_t>& startingIdx,
+			const std::vector<int>& indices, std::vector<double>& vals, int i)
+					override;
+
+	/**
+	 * The array based methods only read the compiled reaction table, they
+	 * can be threaded once it is compiled and the partials positions are set.
+	 *
+	 * @return True if the grid point loops can be threaded
+	 */
+	bool isThreadSafe() const override {
+		return reactionTableCompiled && reactionTable.hasPartialsPositions();
+	}
+
+	/**
+	 * Get the arena holding the coefficients of the reactions of each cluster.
+	 *
+	 * @return The coefficient arena
+	 */
+	PSICoefficientArena& getCoefficientArena() {
+		return coefArena;
+	}
+
+	/**
+	 * Move the compiled reaction table to memory shared on the node.
+	 * \see IReactionNetwork.h
+	 */
+	bool shareOnNode(MPI_Comm comm) override {
+		return reactionTable.shareOnNode(comm);
+	}
+
+	/**
+	 * Release the memory shared on the node by the reaction table.
+	 * \see IReactionNetwork.h
+	 */
+	void releaseShared() override {
+		reactionTable.releaseShared();
+	}
+
 	/**
 	 * Set the phase space to save time and memory
 	 *
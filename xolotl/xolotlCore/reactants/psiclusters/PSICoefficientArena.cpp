@@ -0,0 +1,30 @@
+#include "PSICoefficientArena.h"
+#include <algorithm>
+
+using namespace xolotlCore;
+
+constexpr std::size_t PSICoefficientArena::blockSize;
+
+double* PSICoefficientArena::allocate(std::size_t n) {
+	used += n;
+
+	// Start a new block if the slab does not fit in the current one
+	if (blockUsed + n > blockSize) {
+		// Slabs bigger than a block get a block of their own
+		blocks.emplace_back(new double[std::max(n, blockSize)]());
+		blockUsed = 0;
+	}
+
+	double *slab = blocks.back().get() + blockUsed;
+	blockUsed += n;
+
+	return slab;
+}
+
+void PSICoefficientArena::clear() {
+	blocks.clear();
+	blockUsed = blockSize;
+	used = 0;
+
+	return;
+}
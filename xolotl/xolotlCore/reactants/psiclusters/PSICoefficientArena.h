@@ -0,0 +1,124 @@
+#ifndef PSICOEFFICIENTARENA_H
+#define PSICOEFFICIENTARENA_H
+
+// Includes
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+namespace xolotlCore {
+
+/**
+ * A square matrix of coefficients, stored row after row in a slab of
+ * a PSICoefficientArena. coefs[i][j] reads as with a double** array.
+ */
+class PSICoefficientMatrix {
+public:
+
+	//! The first coefficient
+	double *data;
+
+	//! The number of rows and columns
+	int dim;
+
+	//! The constructor
+	PSICoefficientMatrix(double *_data, int _dim) :
+			data(_data), dim(_dim) {
+	}
+
+	//! Return the row i
+	double* operator[](int i) const {
+		return data + i * dim;
+	}
+};
+
+/**
+ * A cube of coefficients, stored matrix after matrix in a slab of
+ * a PSICoefficientArena. coefs[i][j][k] reads as with a double*** array.
+ */
+class PSICoefficientCube {
+public:
+
+	//! The first coefficient
+	double *data;
+
+	//! The size of each dimension
+	int dim;
+
+	//! The constructor
+	PSICoefficientCube(double *_data, int _dim) :
+			data(_data), dim(_dim) {
+	}
+
+	//! Return the matrix i
+	PSICoefficientMatrix operator[](int i) const {
+		return PSICoefficientMatrix(data + i * dim * dim, dim);
+	}
+};
+
+/**
+ * This class owns the coefficients of all the reacting pairs and combining
+ * clusters of a PSI network.
+ *
+ * Each pair used to allocate its coefficients as nested arrays, one heap
+ * block per row, deep copied every time the vectors of pairs grew. Here they
+ * are instead handed out as zeroed slabs carved one after the other from
+ * large blocks, so the coefficients of the pairs of a cluster end up next to
+ * each other in memory and the pairs are small records that are cheap to
+ * copy. A slab never moves once it is handed out, the pairs keep a pointer
+ * to it.
+ */
+class PSICoefficientArena {
+
+private:
+
+	//! The number of coefficients in each block
+	static constexpr std::size_t blockSize = 1 << 16;
+
+	//! The blocks
+	std::vector<std::unique_ptr<double[]>> blocks;
+
+	//! The number of coefficients already handed out from the last block
+	std::size_t blockUsed;
+
+	//! The total number of coefficients handed out
+	std::size_t used;
+
+public:
+
+	//! The constructor
+	PSICoefficientArena() :
+			blockUsed(blockSize), used(0) {
+	}
+
+	/**
+	 * The copy constructor, disallowed because the pairs point to the slabs.
+	 */
+	PSICoefficientArena(const PSICoefficientArena& other) = delete;
+
+	/**
+	 * Hand out a new slab of coefficients, all set to 0.
+	 *
+	 * @param n The number of coefficients in the slab
+	 * @return The first coefficient
+	 */
+	double* allocate(std::size_t n);
+
+	/**
+	 * Release all the slabs. The pairs using them must be gone.
+	 */
+	void clear();
+
+	/**
+	 * Get the number of coefficients handed out.
+	 *
+	 * @return The number of coefficients
+	 */
+	std::size_t size() const {
+		return used;
+	}
+};
+
+} /* namespace xolotlCore */
+
+#endif /* PSICOEFFICIENTARENA_H */
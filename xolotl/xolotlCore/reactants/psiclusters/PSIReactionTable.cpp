@@ -0,0 +1,362 @@
+#include "PSIReactionTable.h"
+#include <numeric>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+using namespace xolotlCore;
+
+namespace {
+
+/**
+ * Reorder the given array following the permutation.
+ */
+template<typename T>
+void permute(std::vector<T>& vec, const std::vector<int>& perm) {
+	std::vector<T> tmp(vec.size());
+	for (size_t n = 0; n < perm.size(); n++) {
+		tmp[n] = vec[perm[n]];
+	}
+	vec.swap(tmp);
+
+	return;
+}
+
+/**
+ * Compress the sorted output indices into rows and release them.
+ */
+void buildRows(std::vector<int>& out, std::vector<int>& rowOut,
+		std::vector<int>& rowPtr) {
+	rowOut.clear();
+	rowPtr.clear();
+	for (size_t n = 0; n < out.size(); n++) {
+		if (n == 0 || out[n] != out[n - 1]) {
+			rowOut.push_back(out[n]);
+			rowPtr.push_back(n);
+		}
+	}
+	rowPtr.push_back(out.size());
+	std::vector<int>().swap(out);
+
+	return;
+}
+
+/**
+ * Hash the content of an array with the 64 bits FNV-1a function.
+ */
+uint64_t hashBytes(const void* data, size_t size, uint64_t hash) {
+	auto bytes = static_cast<const unsigned char*>(data);
+	for (size_t n = 0; n < size; n++) {
+		hash ^= bytes[n];
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
+
+}
+
+void PSIReactionTable::setPrivateView() {
+	view.quadRate = quadRate.data();
+	view.quadA = quadA.data();
+	view.quadB = quadB.data();
+	view.quadRowOut = quadRowOut.data();
+	view.quadRowPtr = quadRowPtr.data();
+	view.quadPosA = quadPosA.data();
+	view.quadPosB = quadPosB.data();
+	view.quadCoef = quadCoef.data();
+	view.linRate = linRate.data();
+	view.linA = linA.data();
+	view.linRowOut = linRowOut.data();
+	view.linRowPtr = linRowPtr.data();
+	view.linPosA = linPosA.data();
+	view.linCoef = linCoef.data();
+	view.nQuad = quadCoef.size();
+	view.nQuadRows = quadRowOut.size();
+	view.nLin = linCoef.size();
+	view.nLinRows = linRowOut.size();
+	isShared = false;
+
+	return;
+}
+
+void PSIReactionTable::makePrivate() {
+	if (!isShared)
+		return;
+
+	// Copy the shared arrays, the window is only freed by releaseShared()
+	quadRate.assign(view.quadRate, view.quadRate + view.nQuad);
+	quadA.assign(view.quadA, view.quadA + view.nQuad);
+	quadB.assign(view.quadB, view.quadB + view.nQuad);
+	quadRowOut.assign(view.quadRowOut, view.quadRowOut + view.nQuadRows);
+	quadRowPtr.assign(view.quadRowPtr, view.quadRowPtr + view.nQuadRows + 1);
+	quadPosA.assign(view.quadPosA, view.quadPosA + view.nQuad);
+	quadPosB.assign(view.quadPosB, view.quadPosB + view.nQuad);
+	quadCoef.assign(view.quadCoef, view.quadCoef + view.nQuad);
+	linRate.assign(view.linRate, view.linRate + view.nLin);
+	linA.assign(view.linA, view.linA + view.nLin);
+	linRowOut.assign(view.linRowOut, view.linRowOut + view.nLinRows);
+	linRowPtr.assign(view.linRowPtr, view.linRowPtr + view.nLinRows + 1);
+	linPosA.assign(view.linPosA, view.linPosA + view.nLin);
+	linCoef.assign(view.linCoef, view.linCoef + view.nLin);
+	setPrivateView();
+
+	return;
+}
+
+bool PSIReactionTable::shareOnNode(MPI_Comm comm) {
+	// Only a complete table is shared, and only once
+	int ready = partialsPositionsSet && sharedWindow == MPI_WIN_NULL;
+	MPI_Allreduce(MPI_IN_PLACE, &ready, 1, MPI_INT, MPI_MIN, comm);
+	if (!ready)
+		return false;
+
+	// The arrays to share
+	std::vector<std::vector<int>*> intArrays { &quadRate, &quadA, &quadB,
+			&quadRowOut, &quadRowPtr, &quadPosA, &quadPosB, &linRate, &linA,
+			&linRowOut, &linRowPtr, &linPosA };
+	std::vector<const int**> intViews { &view.quadRate, &view.quadA,
+			&view.quadB, &view.quadRowOut, &view.quadRowPtr, &view.quadPosA,
+			&view.quadPosB, &view.linRate, &view.linA, &view.linRowOut,
+			&view.linRowPtr, &view.linPosA };
+	std::vector<std::vector<double>*> doubleArrays { &quadCoef, &linCoef };
+	std::vector<const double**> doubleViews { &view.quadCoef, &view.linCoef };
+
+	// The processes of a node must have the same table as the first one
+	uint64_t hash = 14695981039346656037ull;
+	size_t nBytes = 0;
+	for (auto array : doubleArrays) {
+		hash = hashBytes(array->data(), array->size() * sizeof(double), hash);
+		nBytes += array->size() * sizeof(double);
+	}
+	for (auto array : intArrays) {
+		hash = hashBytes(array->data(), array->size() * sizeof(int), hash);
+		nBytes += array->size() * sizeof(int);
+	}
+	MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL,
+			&nodeComm);
+	int nodeRank = 0;
+	MPI_Comm_rank(nodeComm, &nodeRank);
+	uint64_t leaderHash = hash;
+	MPI_Bcast(&leaderHash, 1, MPI_UINT64_T, 0, nodeComm);
+	int same = (leaderHash == hash);
+	MPI_Allreduce(MPI_IN_PLACE, &same, 1, MPI_INT, MPI_MIN, comm);
+	if (!same) {
+		MPI_Comm_free(&nodeComm);
+		return false;
+	}
+
+	// Only the first process of the node allocates the memory
+	char *base = nullptr;
+	MPI_Win_allocate_shared(nodeRank == 0 ? nBytes : 0, 1, MPI_INFO_NULL,
+			nodeComm, &base, &sharedWindow);
+	MPI_Aint sharedSize = 0;
+	int dispUnit = 0;
+	MPI_Win_shared_query(sharedWindow, 0, &sharedSize, &dispUnit, &base);
+
+	// It fills it, the doubles first to keep them aligned
+	MPI_Win_fence(0, sharedWindow);
+	size_t offset = 0;
+	for (size_t i = 0; i < doubleArrays.size(); i++) {
+		auto& array = *doubleArrays[i];
+		if (nodeRank == 0)
+			std::memcpy(base + offset, array.data(),
+					array.size() * sizeof(double));
+		*doubleViews[i] = reinterpret_cast<const double*>(base + offset);
+		offset += array.size() * sizeof(double);
+		std::vector<double>().swap(array);
+	}
+	for (size_t i = 0; i < intArrays.size(); i++) {
+		auto& array = *intArrays[i];
+		if (nodeRank == 0)
+			std::memcpy(base + offset, array.data(),
+					array.size() * sizeof(int));
+		*intViews[i] = reinterpret_cast<const int*>(base + offset);
+		offset += array.size() * sizeof(int);
+		std::vector<int>().swap(array);
+	}
+	MPI_Win_fence(0, sharedWindow);
+	isShared = true;
+
+	return true;
+}
+
+void PSIReactionTable::releaseShared() {
+	// The table is shared on all the processes or on none of them
+	if (sharedWindow == MPI_WIN_NULL)
+		return;
+
+	makePrivate();
+	MPI_Win_free(&sharedWindow);
+	MPI_Comm_free(&nodeComm);
+
+	return;
+}
+
+void PSIReactionTable::clear() {
+	quadRate.clear();
+	quadA.clear();
+	quadB.clear();
+	quadOut.clear();
+	quadRowOut.clear();
+	quadRowPtr.clear();
+	quadCoef.clear();
+	linRate.clear();
+	linA.clear();
+	linOut.clear();
+	linRowOut.clear();
+	linRowPtr.clear();
+	linCoef.clear();
+	quadPosA.clear();
+	quadPosB.clear();
+	linPosA.clear();
+	partialsPositionsSet = false;
+	setPrivateView();
+
+	return;
+}
+
+void PSIReactionTable::addQuadraticTerm(Reaction& reaction, int a, int b,
+		int out, double coef) {
+	// Nothing to do for null coefficients
+	if (coef == 0.0)
+		return;
+
+	quadRate.push_back(reaction.getRateIndex());
+	quadA.push_back(a);
+	quadB.push_back(b);
+	quadOut.push_back(out);
+	quadCoef.push_back(coef);
+
+	return;
+}
+
+void PSIReactionTable::addLinearTerm(Reaction& reaction, int a, int out,
+		double coef) {
+	// Nothing to do for null coefficients
+	if (coef == 0.0)
+		return;
+
+	linRate.push_back(reaction.getRateIndex());
+	linA.push_back(a);
+	linOut.push_back(out);
+	linCoef.push_back(coef);
+
+	return;
+}
+
+void PSIReactionTable::finalize() {
+	// Group the quadratic terms by output index
+	std::vector<int> perm(quadCoef.size());
+	std::iota(perm.begin(), perm.end(), 0);
+	std::stable_sort(perm.begin(), perm.end(), [this](int n, int m) {
+		return quadOut[n] < quadOut[m];
+	});
+	permute(quadRate, perm);
+	permute(quadA, perm);
+	permute(quadB, perm);
+	permute(quadOut, perm);
+	permute(quadCoef, perm);
+	buildRows(quadOut, quadRowOut, quadRowPtr);
+
+	// Same for the linear terms
+	perm.resize(linCoef.size());
+	std::iota(perm.begin(), perm.end(), 0);
+	std::stable_sort(perm.begin(), perm.end(), [this](int n, int m) {
+		return linOut[n] < linOut[m];
+	});
+	permute(linRate, perm);
+	permute(linA, perm);
+	permute(linOut, perm);
+	permute(linCoef, perm);
+	buildRows(linOut, linRowOut, linRowPtr);
+
+	// The positions of the partials have to be set again
+	partialsPositionsSet = false;
+	setPrivateView();
+
+	return;
+}
+
+std::vector<int> PSIReactionTable::termRows(const std::vector<int>& rowPtr) {
+	std::vector<int> rows(rowPtr.empty() ? 0 : rowPtr.back());
+	for (size_t row = 0; row + 1 < rowPtr.size(); row++) {
+		for (int n = rowPtr[row]; n < rowPtr[row + 1]; n++) {
+			rows[n] = row;
+		}
+	}
+
+	return rows;
+}
+
+void PSIReactionTable::computeFluxes(const double * __restrict concs,
+		const double * __restrict rates,
+		double * __restrict updatedConcOffset) const {
+	// Get the raw arrays
+	const int nQuadRows = view.nQuadRows;
+	const int * __restrict qRowOut = view.quadRowOut;
+	const int * __restrict qRowPtr = view.quadRowPtr;
+	const int * __restrict qRate = view.quadRate;
+	const int * __restrict qA = view.quadA;
+	const int * __restrict qB = view.quadB;
+	const double * __restrict qCoef = view.quadCoef;
+
+	// Production and combination
+	for (int row = 0; row < nQuadRows; row++) {
+		double flux = 0.0;
+		for (int n = qRowPtr[row]; n < qRowPtr[row + 1]; n++) {
+			flux += qCoef[n] * rates[qRate[n]] * concs[qA[n]] * concs[qB[n]];
+		}
+		updatedConcOffset[qRowOut[row]] += flux;
+	}
+
+	const int nLinRows = view.nLinRows;
+	const int * __restrict lRowOut = view.linRowOut;
+	const int * __restrict lRowPtr = view.linRowPtr;
+	const int * __restrict lRate = view.linRate;
+	const int * __restrict lA = view.linA;
+	const double * __restrict lCoef = view.linCoef;
+
+	// Dissociation and emission
+	for (int row = 0; row < nLinRows; row++) {
+		double flux = 0.0;
+		for (int n = lRowPtr[row]; n < lRowPtr[row + 1]; n++) {
+			flux += lCoef[n] * rates[lRate[n]] * concs[lA[n]];
+		}
+		updatedConcOffset[lRowOut[row]] += flux;
+	}
+
+	return;
+}
+
+void PSIReactionTable::computePartials(const double * __restrict concs,
+		const double * __restrict rates, double * __restrict vals) const {
+	// Get the raw arrays
+	const int nQuad = view.nQuad;
+	const int * __restrict qRate = view.quadRate;
+	const int * __restrict qA = view.quadA;
+	const int * __restrict qB = view.quadB;
+	const int * __restrict qPosA = view.quadPosA;
+	const int * __restrict qPosB = view.quadPosB;
+	const double * __restrict qCoef = view.quadCoef;
+
+	// Production and combination: d/dc[a] = coef * k * c[b] and
+	// d/dc[b] = coef * k * c[a]
+	for (int n = 0; n < nQuad; n++) {
+		double value = qCoef[n] * rates[qRate[n]];
+		vals[qPosA[n]] += value * concs[qB[n]];
+		vals[qPosB[n]] += value * concs[qA[n]];
+	}
+
+	const int nLin = view.nLin;
+	const int * __restrict lRate = view.linRate;
+	const int * __restrict lPosA = view.linPosA;
+	const double * __restrict lCoef = view.linCoef;
+
+	// Dissociation and emission: d/dc[a] = coef * k
+	for (int n = 0; n < nLin; n++) {
+		vals[lPosA[n]] += lCoef[n] * rates[lRate[n]];
+	}
+
+	return;
+}
@@ -0,0 +1,303 @@
+#ifndef PSIREACTIONTABLE_H
+#define PSIREACTIONTABLE_H
+
+// Includes
+#include <vector>
+#include <string>
+#include <mpi.h>
+#include <Reaction.h>
+
+namespace xolotlCore {
+
+/**
+ * This class is a compiled, flat version of the reactions of a PSI network.
+ *
+ * Every reaction a cluster takes part in is expanded into scalar terms of the
+ * form coef * k * c[a] * c[b] (quadratic terms, production and combination)
+ * or coef * k * c[a] (linear terms, dissociation and emission) that are added
+ * to the DOF out. The indices are directly the ones of the PETSc
+ * concentration array (cluster id - 1 or moment id - 1) and the coefficients
+ * already include the sign of the contribution and the 1 / nTot factor of
+ * the super clusters. Terms that multiply the moments of normal clusters
+ * (always 0) or that have a null coefficient are dropped.
+ *
+ * The terms are stored as a structure of arrays grouped by output index
+ * (compressed rows) so that the flux computation is a tight loop over
+ * contiguous memory, accumulating each row in a register, instead of
+ * following the ClusterPair and CombiningCluster references of each cluster.
+ *
+ * The rate constants are not stored in the table: each term keeps the rate
+ * index of its reaction and the caller provides the row of rate constants of
+ * the network at the grid point where the fluxes are computed.
+ *
+ * Once complete, the table does not change anymore and is the same on every
+ * process. shareOnNode() then moves it to MPI shared memory so that the
+ * processes of a node read a single copy.
+ */
+class PSIReactionTable {
+
+private:
+
+	//! The rate index of each quadratic term
+	std::vector<int> quadRate;
+
+	//! The index of the first concentration of each quadratic term
+	std::vector<int> quadA;
+
+	//! The index of the second concentration of each quadratic term
+	std::vector<int> quadB;
+
+	//! The index of the DOF updated by each quadratic term, only while compiling
+	std::vector<int> quadOut;
+
+	//! The distinct DOF updated by the quadratic terms
+	std::vector<int> quadRowOut;
+
+	//! The position of the first quadratic term of each row, plus the end
+	std::vector<int> quadRowPtr;
+
+	//! The coefficient of each quadratic term
+	std::vector<double> quadCoef;
+
+	//! The rate index of each linear term
+	std::vector<int> linRate;
+
+	//! The index of the concentration of each linear term
+	std::vector<int> linA;
+
+	//! The index of the DOF updated by each linear term, only while compiling
+	std::vector<int> linOut;
+
+	//! The distinct DOF updated by the linear terms
+	std::vector<int> linRowOut;
+
+	//! The position of the first linear term of each row, plus the end
+	std::vector<int> linRowPtr;
+
+	//! The coefficient of each linear term
+	std::vector<double> linCoef;
+
+	//! The position in the partials array of d/dc[a] of each quadratic term
+	std::vector<int> quadPosA;
+
+	//! The position in the partials array of d/dc[b] of each quadratic term
+	std::vector<int> quadPosB;
+
+	//! The position in the partials array of d/dc[a] of each linear term
+	std::vector<int> linPosA;
+
+	//! Whether the partials positions match the current terms
+	bool partialsPositionsSet = false;
+
+	/**
+	 * The arrays read by the flux and partials computations. They point
+	 * either to the vectors above or to the memory shared on the node.
+	 */
+	struct View {
+		const int *quadRate = nullptr, *quadA = nullptr, *quadB = nullptr,
+				*quadRowOut = nullptr, *quadRowPtr = nullptr, *quadPosA =
+						nullptr, *quadPosB = nullptr;
+		const double *quadCoef = nullptr;
+		const int *linRate = nullptr, *linA = nullptr, *linRowOut = nullptr,
+				*linRowPtr = nullptr, *linPosA = nullptr;
+		const double *linCoef = nullptr;
+		int nQuad = 0, nQuadRows = 0, nLin = 0, nLinRows = 0;
+	} view;
+
+	//! Whether the view points to the memory shared on the node
+	bool isShared = false;
+
+	//! The processes of the node sharing the table
+	MPI_Comm nodeComm = MPI_COMM_NULL;
+
+	//! The window of the memory shared on the node
+	MPI_Win sharedWindow = MPI_WIN_NULL;
+
+	/**
+	 * Point the view to the vectors.
+	 */
+	void setPrivateView();
+
+	/**
+	 * Copy the shared arrays back into the vectors, before modifying them.
+	 */
+	void makePrivate();
+
+	/**
+	 * Get the row corresponding to each term.
+	 *
+	 * @param rowPtr The position of the first term of each row
+	 * @return The row of each term
+	 */
+	static std::vector<int> termRows(const std::vector<int>& rowPtr);
+
+public:
+
+	/**
+	 * The constructor.
+	 */
+	PSIReactionTable() {
+	}
+
+	/**
+	 * Copy constructor, deleted to prevent use.
+	 */
+	PSIReactionTable(const PSIReactionTable& other) = delete;
+
+	/**
+	 * Remove all the terms from the table.
+	 */
+	void clear();
+
+	/**
+	 * Add a term coef * k * c[a] * c[b] to the DOF out.
+	 *
+	 * @param reaction The reaction providing k
+	 * @param a The index of the first concentration
+	 * @param b The index of the second concentration
+	 * @param out The index of the updated DOF
+	 * @param coef The coefficient
+	 */
+	void addQuadraticTerm(Reaction& reaction, int a, int b, int out,
+			double coef);
+
+	/**
+	 * Add a term coef * k * c[a] to the DOF out.
+	 *
+	 * @param reaction The reaction providing k
+	 * @param a The index of the concentration
+	 * @param out The index of the updated DOF
+	 * @param coef The coefficient
+	 */
+	void addLinearTerm(Reaction& reaction, int a, int out, double coef);
+
+	/**
+	 * Group the terms by output index and release the memory only needed
+	 * while compiling. Has to be called once all the terms are added.
+	 */
+	void finalize();
+
+	/**
+	 * Compute where the partial derivatives of each term go in the
+	 * partials values array.
+	 *
+	 * @param position A function taking the index of a row (DOF) and of a
+	 * column (DOF) and returning the position of the corresponding partial
+	 * derivative in the values array, or a negative value if the column is
+	 * not part of the row
+	 */
+	template<typename F>
+	void setPartialsPositions(F position) {
+		// The positions are about to change
+		makePrivate();
+
+		// Quadratic terms
+		auto rows = termRows(quadRowPtr);
+		quadPosA.resize(quadCoef.size());
+		quadPosB.resize(quadCoef.size());
+		for (size_t n = 0; n < quadCoef.size(); n++) {
+			quadPosA[n] = position(quadRowOut[rows[n]], quadA[n]);
+			quadPosB[n] = position(quadRowOut[rows[n]], quadB[n]);
+			if (quadPosA[n] < 0 || quadPosB[n] < 0)
+				throw std::string(
+						"\nPSIReactionTable: a partial derivative is missing "
+								"from the diagonal fill.");
+		}
+
+		// Linear terms
+		rows = termRows(linRowPtr);
+		linPosA.resize(linCoef.size());
+		for (size_t n = 0; n < linCoef.size(); n++) {
+			linPosA[n] = position(linRowOut[rows[n]], linA[n]);
+			if (linPosA[n] < 0)
+				throw std::string(
+						"\nPSIReactionTable: a partial derivative is missing "
+								"from the diagonal fill.");
+		}
+		partialsPositionsSet = true;
+		setPrivateView();
+
+		return;
+	}
+
+	/**
+	 * Have the partials positions been set since the last compilation?
+	 *
+	 * @return True if computePartials() can be called
+	 */
+	bool hasPartialsPositions() const {
+		return partialsPositionsSet;
+	}
+
+	/**
+	 * Get the number of quadratic terms.
+	 *
+	 * @return The number of terms
+	 */
+	int getNumQuadraticTerms() const {
+		return view.nQuad;
+	}
+
+	/**
+	 * Get the number of linear terms.
+	 *
+	 * @return The number of terms
+	 */
+	int getNumLinearTerms() const {
+		return view.nLin;
+	}
+
+	/**
+	 * Move the table to memory shared by the processes of the same node,
+	 * one copy per node. Has to be called by all the processes of comm once
+	 * the partials positions are set. Nothing is shared if the table is not
+	 * complete or is not the same on all the processes of a node.
+	 *
+	 * @param comm The processes having the same table
+	 * @return True if the table is shared
+	 */
+	bool shareOnNode(MPI_Comm comm);
+
+	/**
+	 * Copy the table shared on the node back to the vectors and free the
+	 * shared memory. Has to be called by all the processes that shared it,
+	 * before MPI is finalized, the destructor does not free it because it
+	 * is a collective call.
+	 */
+	void releaseShared();
+
+	/**
+	 * Is the table in memory shared on the node?
+	 *
+	 * @return True if it is shared
+	 */
+	bool isSharedOnNode() const {
+		return isShared;
+	}
+
+	/**
+	 * Add the reaction fluxes to the updated concentration array.
+	 *
+	 * @param concs The concentrations at the grid point
+	 * @param rates The rate constants of the network at the grid point
+	 * @param updatedConcOffset The array where the fluxes are added
+	 */
+	void computeFluxes(const double * __restrict concs,
+			const double * __restrict rates,
+			double * __restrict updatedConcOffset) const;
+
+	/**
+	 * Add the partial derivatives of the reaction fluxes to the partials
+	 * values array, at the positions given to setPartialsPositions().
+	 *
+	 * @param concs The concentrations at the grid point
+	 * @param rates The rate constants of the network at the grid point
+	 * @param vals The partials values array
+	 */
+	void computePartials(const double * __restrict concs,
+			const double * __restrict rates, double * __restrict vals) const;
+};
+
+} /* namespace xolotlCore */
+
+#endif
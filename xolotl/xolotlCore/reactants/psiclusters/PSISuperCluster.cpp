@@ -65,7 +65,8 @@ auto PSISuperCluster::addToEffReactingList(ProductionReaction& reaction)
 		// Add info about reaction to our list.
 		effReactingList.emplace_back(reaction,
 				static_cast<PSICluster&>(reaction.first),
-				static_cast<PSICluster&>(reaction.second), psDim);
+				static_cast<PSICluster&>(reaction.second),
+				getCoefficientArena(), psDim);
 		listit = effReactingList.end();
 		--listit;
 	}
@@ -90,7 +91,8 @@ auto PSISuperCluster::addToEffCombiningList(ProductionReaction& reaction)
 		// We did not already know about the reaction.
 		// Add info about reaction to our list.
 		effCombiningList.emplace_back(reaction,
-				static_cast<PSICluster&>(otherCluster), psDim);
+				static_cast<PSICluster&>(otherCluster),
+				getCoefficientArena(), psDim);
 		listit = effCombiningList.end();
 		--listit;
 	}
@@ -118,7 +120,8 @@ auto PSISuperCluster::addToEffDissociatingList(DissociationReaction& reaction)
 		// Add info about reaction to our list.
 		effDissociatingList.emplace_back(reaction,
 				static_cast<PSICluster&>(reaction.dissociating),
-				static_cast<PSICluster&>(emittedCluster), psDim);
+				static_cast<PSICluster&>(emittedCluster),
+				getCoefficientArena(), psDim);
 		listit = effDissociatingList.end();
 		--listit;
 	}
@@ -143,7 +146,8 @@ auto PSISuperCluster::addToEffEmissionList(DissociationReaction& reaction)
 		// reaction.
 		effEmissionList.emplace_back(reaction,
 				static_cast<PSICluster&>(reaction.first),
-				static_cast<PSICluster&>(reaction.second), psDim);
+				static_cast<PSICluster&>(reaction.second),
+				getCoefficientArena(), psDim);
 		listit = effEmissionList.end();
 		--listit;
 	}
@@ -1153,7 +1157,7 @@ double PSISuperCluster::getDissociationFlux(int xi) {
 					}
 				}
 				// Update the flux
-				auto value = currPair.reaction.kConstant[xi] / (double) nTot;
+				auto value = currPair.reaction.getRateConstant(xi) / (double) nTot;
 				flux += value * sum[0];
 				// Compute the moment fluxes
 				for (int i = 1; i < psDim; i++) {
@@ -1188,7 +1192,7 @@ double PSISuperCluster::getEmissionFlux(int xi) {
 					}
 				}
 				// Update the flux
-				auto value = currPair.reaction.kConstant[xi] / (double) nTot;
+				auto value = currPair.reaction.getRateConstant(xi) / (double) nTot;
 				flux += value * sum[0];
 				// Compute the moment fluxes
 				for (int i = 1; i < psDim; i++) {
@@ -1231,7 +1235,7 @@ double PSISuperCluster::getProductionFlux(int xi) {
 				}
 
 				// Update the flux
-				auto value = currPair.reaction.kConstant[xi] / (double) nTot;
+				auto value = currPair.reaction.getRateConstant(xi) / (double) nTot;
 				flux += value * sum[0];
 				// Compute the moment fluxes
 				for (int i = 1; i < psDim; i++) {
@@ -1272,7 +1276,7 @@ double PSISuperCluster::getCombinationFlux(int xi) {
 					}
 				}
 				// Update the flux
-				auto value = currComb.reaction.kConstant[xi] / (double) nTot;
+				auto value = currComb.reaction.getRateConstant(xi) / (double) nTot;
 				flux += value * sum[0];
 				// Compute the moment fluxes
 				for (int i = 1; i < psDim; i++) {
@@ -1283,6 +1287,72 @@ double PSISuperCluster::getCombinationFlux(int xi) {
 	return flux;
 }
 
+void PSISuperCluster::addFluxTerms(PSIReactionTable& table) const {
+	// The index of each moment of this cluster
+	int out[5] = { };
+	for (int k = 0; k < psDim; k++) {
+		out[k] = getMomentIndex(*this, k);
+	}
+
+	// Production: k / nTot * coefs[j][i][k] * lA[j] * lB[i]
+	for (auto const& currPair : effReactingList) {
+		for (int j = 0; j < psDim; j++) {
+			int a = getMomentIndex(currPair.first, j);
+			if (a < 0)
+				continue;
+			for (int i = 0; i < psDim; i++) {
+				int b = getMomentIndex(currPair.second, i);
+				if (b < 0)
+					continue;
+				for (int k = 0; k < psDim; k++) {
+					table.addQuadraticTerm(currPair.reaction, a, b, out[k],
+							currPair.coefs[j][i][k] / (double) nTot);
+				}
+			}
+		}
+	}
+
+	// Combination: - k / nTot * coefs[i][j][k] * l[i] * lB[j]
+	for (auto const& currComb : effCombiningList) {
+		for (int i = 0; i < psDim; i++) {
+			for (int j = 0; j < psDim; j++) {
+				int b = getMomentIndex(currComb.first, j);
+				if (b < 0)
+					continue;
+				for (int k = 0; k < psDim; k++) {
+					table.addQuadraticTerm(currComb.reaction, out[i], b,
+							out[k], -currComb.coefs[i][j][k] / (double) nTot);
+				}
+			}
+		}
+	}
+
+	// Dissociation: k / nTot * coefs[i][j] * lA[i]
+	for (auto const& currPair : effDissociatingList) {
+		for (int i = 0; i < psDim; i++) {
+			int a = getMomentIndex(currPair.first, i);
+			if (a < 0)
+				continue;
+			for (int j = 0; j < psDim; j++) {
+				table.addLinearTerm(currPair.reaction, a, out[j],
+						currPair.coefs[i][j] / (double) nTot);
+			}
+		}
+	}
+
+	// Emission: - k / nTot * coefs[i][j] * l[i]
+	for (auto const& currPair : effEmissionList) {
+		for (int i = 0; i < psDim; i++) {
+			for (int j = 0; j < psDim; j++) {
+				table.addLinearTerm(currPair.reaction, out[i], out[j],
+						-currPair.coefs[i][j] / (double) nTot);
+			}
+		}
+	}
+
+	return;
+}
+
 void PSISuperCluster::computePartialDerivatives(double* partials[5],
 		const std::array<const ReactionNetwork::PartialsIdxMap*, 5>& partialsIdxMap,
 		int i) const {
@@ -1335,7 +1405,7 @@ void PSISuperCluster::computeProductionPartialDerivatives(double* partials[5],
 				}
 
 				// Compute the contribution from the first and second part of the reacting pair
-				auto value = currPair.reaction.kConstant[xi] / (double) nTot;
+				auto value = currPair.reaction.getRateConstant(xi) / (double) nTot;
 				for (int j = 0; j < psDim; j++) {
 					int indexA = 0, indexB = 0;
 					if (j == 0) {
@@ -1395,7 +1465,7 @@ void PSISuperCluster::computeCombinationPartialDerivatives(double* partials[5],
 				}
 
 				// Compute the contribution from the both clusters
-				auto value = currComb.reaction.kConstant[xi] / (double) nTot;
+				auto value = currComb.reaction.getRateConstant(xi) / (double) nTot;
 				for (int j = 0; j < psDim; j++) {
 					int indexA = 0, indexB = 0;
 					if (j == 0) {
@@ -1437,7 +1507,7 @@ void PSISuperCluster::computeDissociationPartialDerivatives(double* partials[5],
 				// Get the dissociating clusters
 				auto const& cluster = currPair.first;
 				// Compute the contribution from the dissociating cluster
-				auto value = currPair.reaction.kConstant[xi] / (double) nTot;
+				auto value = currPair.reaction.getRateConstant(xi) / (double) nTot;
 
 				for (int j = 0; j < psDim; j++) {
 					int index = 0;
@@ -1474,7 +1544,7 @@ void PSISuperCluster::computeEmissionPartialDerivatives(double* partials[5],
 			&partials, &partialsIdxMap,&xi](DissociationPairList::value_type const& currPair) {
 
 				// Compute the contribution from the dissociating cluster
-				auto value = currPair.reaction.kConstant[xi] / (double) nTot;
+				auto value = currPair.reaction.getRateConstant(xi) / (double) nTot;
 				for (int j = 0; j < psDim; j++) {
 					int index = 0;
 					if (j == 0) {
@@ -97,58 +97,17 @@ protected:
 		 * 2 -> D
 		 * 3 -> T
 		 * 4 -> V
+		 *
+		 * They are stored in a slab of the coefficient arena of the network.
 		 */
-		double ***coefs;
-		const int dim;
+		PSICoefficientCube coefs;
 
 		//! The constructor, disallowed
 		ProductionCoefficientBase() = delete;
 
 		//! The constructor to use
-		ProductionCoefficientBase(const int _dim) :
-				dim(_dim) {
-
-			// Create the array of the right dimension
-			coefs = new double**[dim];
-			for (int i = 0; i < dim; i++) {
-				coefs[i] = new double*[dim];
-				for (int j = 0; j < dim; j++) {
-					coefs[i][j] = new double[dim];
-					for (int k = 0; k < dim; k++) {
-						coefs[i][j][k] = 0.0;
-					}
-				}
-			}
-		}
-
-		/**
-		 * Copy constructor.
-		 */
-		ProductionCoefficientBase(const ProductionCoefficientBase& other) :
-				dim(other.dim) {
-
-			// Create a deep copy of other's coeffs array.
-			coefs = new double**[dim];
-			for (int i = 0; i < dim; i++) {
-				coefs[i] = new double*[dim];
-				for (int j = 0; j < dim; j++) {
-					coefs[i][j] = new double[dim];
-					for (int k = 0; k < dim; k++) {
-						coefs[i][j][k] = other.coefs[i][j][k];
-					}
-				}
-			}
-		}
-
-		//! The destructor
-		~ProductionCoefficientBase() {
-			for (int i = 0; i < dim; i++) {
-				for (int j = 0; j < dim; j++) {
-					delete[] coefs[i][j];
-				}
-				delete[] coefs[i];
-			}
-			delete[] coefs;
+		ProductionCoefficientBase(PSICoefficientArena& arena, const int _dim) :
+				coefs(arena.allocate(_dim * _dim * _dim), _dim) {
 		}
 	};
 
@@ -170,9 +129,9 @@ protected:
 
 		//! The constructor
 		SuperClusterProductionPair(Reaction& _reaction, PSICluster& _first,
-				PSICluster& _second, int dim) :
+				PSICluster& _second, PSICoefficientArena& arena, int dim) :
 				ReactingPairBase(_reaction, _first, _second), ProductionCoefficientBase(
-						dim) {
+						arena, dim) {
 
 		}
 
@@ -205,9 +164,9 @@ protected:
 
 		//! The constructor
 		SuperClusterCombiningCluster(Reaction& _reaction, PSICluster& _first,
-				int dim) :
+				PSICoefficientArena& arena, int dim) :
 				ReactingInfoBase(_reaction, _first), ProductionCoefficientBase(
-						dim) {
+						arena, dim) {
 
 		}
 
@@ -253,52 +212,22 @@ protected:
 		 * 2 -> D
 		 * 3 -> T
 		 * 4 -> V
+		 *
+		 * They are stored in a slab of the coefficient arena of the network.
 		 */
-		double **coefs;
-		const int dim;
+		PSICoefficientMatrix coefs;
 
 		//! The constructor
 		SuperClusterDissociationPair(Reaction& _reaction, PSICluster& _first,
-				PSICluster& _second, int _dim) :
-				ReactingPairBase(_reaction, _first, _second), dim(_dim) {
-			// Create the array of the right dimension
-			coefs = new double*[dim];
-			for (int i = 0; i < dim; i++) {
-				coefs[i] = new double[dim];
-				for (int j = 0; j < dim; j++) {
-					coefs[i][j] = 0.0;
-				}
-			}
+				PSICluster& _second, PSICoefficientArena& arena, int _dim) :
+				ReactingPairBase(_reaction, _first, _second), coefs(
+						arena.allocate(_dim * _dim), _dim) {
 		}
 
 		/**
 		 * Default constructor, disallowed.
 		 */
 		SuperClusterDissociationPair() = delete;
-
-		/**
-		 * Copy constructor, needed to be element in a std::vector.
-		 */
-		SuperClusterDissociationPair(const SuperClusterDissociationPair& other) :
-				ReactingPairBase(other), dim(other.dim) {
-
-			// Create the array of the right dimension
-			coefs = new double*[dim];
-			for (int i = 0; i < dim; i++) {
-				coefs[i] = new double[dim];
-				for (int j = 0; j < dim; j++) {
-					coefs[i][j] = other.coefs[i][j];
-				}
-			}
-		}
-
-		//! The destructor
-		~SuperClusterDissociationPair() {
-			for (int i = 0; i < dim; i++) {
-				delete[] coefs[i];
-			}
-			delete[] coefs;
-		}
 	};
 
 	/**
@@ -848,6 +777,15 @@ public:
 	 */
 	double getCombinationFlux(int i);
 
+	/**
+	 * This operation adds the terms of all the reactions contributing
+	 * to the flux of this cluster and of its moments to the compiled
+	 * reaction table of the network.
+	 *
+	 * @param table The reaction table
+	 */
+	void addFluxTerms(PSIReactionTable& table) const override;
+
 	/**
 	 * This operation returns the total change for its first moment.
 	 *
@@ -67,6 +67,9 @@ public:
 			theNetworkHandler = theNetworkLoaderHandler->load(options);
 		else
 			theNetworkHandler = theNetworkLoaderHandler->generate(options);
+		// Set how the grid points share the rate constants
+		theNetworkHandler->setRateCacheTolerance(
+				options.getRateCacheTolerance());
 
 		if (procId == 0) {
 			std::cout << "\nFactory Message: "
@@ -0,0 +1,69 @@
+#ifndef HOTCOUNTER_H
+#define HOTCOUNTER_H
+
+#include <atomic>
+#include "xolotlCore/Identifiable.h"
+#include "xolotlPerf/IEventCounter.h"
+#include "xolotlPerf/ThreadShards.h"
+
+namespace xolotlPerf {
+
+/**
+ * An event counter that can be incremented from the threaded grid point
+ * loops.
+ *
+ * Each thread adds to its own shard with a relaxed atomic, which costs about
+ * as much as a plain increment since no other thread writes to that cache
+ * line, and getValue() sums the shards. Get the counter once from the
+ * handler registry and keep it, it is not meant to be looked up by name in
+ * the loops.
+ *
+ * The counting compiles to nothing without XOLOTL_HOT_COUNTERS, and is a
+ * single test when the counter comes from the dummy handler registry.
+ */
+class HotCounter final: public IEventCounter, public xolotlCore::Identifiable {
+private:
+
+	/// The count of each thread.
+	ThreadShards<std::atomic<IEventCounter::ValType> > counts;
+
+public:
+
+	/// Construct a counter.
+	///
+	/// @param name The counter's name.
+	/// @param nThreads The number of shards, 0 for a counter that never counts.
+	HotCounter(const std::string& name, int nThreads =
+			ThreadShards<int>::maxThreads()) :
+			xolotlCore::Identifiable(name), counts(nThreads) {
+	}
+
+	/// Add to the count of the calling thread.
+	///
+	/// @param n The number of events.
+	void add(IEventCounter::ValType n) {
+#ifdef XOLOTL_HOT_COUNTERS
+		if (counts.isEnabled())
+			counts.local().fetch_add(n, std::memory_order_relaxed);
+#endif
+	}
+
+	/// Count one event.
+	void increment(void) override {
+		add(1);
+	}
+
+	/// Sum the counts of all the threads.
+	///
+	/// @return The number of events.
+	IEventCounter::ValType getValue(void) const override {
+		IEventCounter::ValType value = 0;
+		for (int i = 0; i < counts.size(); i++)
+			value += counts[i].load(std::memory_order_relaxed);
+		return value;
+	}
+};
+
+} // namespace xolotlPerf
+
+#endif // HOTCOUNTER_H
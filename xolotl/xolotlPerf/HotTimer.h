@@ -0,0 +1,104 @@
+#ifndef HOTTIMER_H
+#define HOTTIMER_H
+
+#include <atomic>
+#include <chrono>
+#include "xolotlCore/Identifiable.h"
+#include "xolotlPerf/ITimer.h"
+#include "xolotlPerf/ThreadShards.h"
+
+namespace xolotlPerf {
+
+/**
+ * A timer that can be started and stopped from the threaded grid point
+ * loops, each thread timing its own work.
+ *
+ * Each thread keeps its start time and accumulated nanoseconds in its own
+ * shard, so start() and stop() take no lock and the threads do not share
+ * cache lines. getValue() sums the shards: with several threads it is the
+ * total time spent by all of them, not the elapsed time. Get the timer once
+ * from the handler registry and keep it, it is not meant to be looked up by
+ * name in the loops. The timer does not appear on the trace timeline, which
+ * only follows the master thread.
+ *
+ * The timing compiles to nothing without XOLOTL_HOT_COUNTERS, and is a
+ * single test when the timer comes from the dummy handler registry.
+ */
+class HotTimer final: public ITimer, public xolotlCore::Identifiable {
+private:
+
+	/// Concise name for type of our time source.
+	using Clock = std::chrono::steady_clock;
+
+	/// The state of one thread.
+	struct Shard {
+		/// The accumulated time, in nanoseconds.
+		std::atomic<long long> elapsed;
+
+		/// When the thread started the timer.
+		Clock::time_point startTime;
+
+		Shard(void) :
+				elapsed(0) {
+		}
+	};
+
+	/// The state of each thread.
+	ThreadShards<Shard> shards;
+
+public:
+
+	/// Construct a timer.
+	///
+	/// @param name The timer's name.
+	/// @param nThreads The number of shards, 0 for a timer that never runs.
+	HotTimer(const std::string& name, int nThreads =
+			ThreadShards<int>::maxThreads()) :
+			xolotlCore::Identifiable(name), shards(nThreads) {
+	}
+
+	/// Start timing the calling thread.
+	void start(void) override {
+#ifdef XOLOTL_HOT_COUNTERS
+		if (shards.isEnabled())
+			shards.local().startTime = Clock::now();
+#endif
+	}
+
+	/// Stop timing the calling thread and accumulate the time.
+	void stop(void) override {
+#ifdef XOLOTL_HOT_COUNTERS
+		if (shards.isEnabled()) {
+			auto& shard = shards.local();
+			auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+					Clock::now() - shard.startTime).count();
+			shard.elapsed.fetch_add(ns, std::memory_order_relaxed);
+		}
+#endif
+	}
+
+	/// Sum the time of all the threads.
+	///
+	/// @return The time in seconds.
+	ITimer::ValType getValue(void) const override {
+		long long elapsed = 0;
+		for (int i = 0; i < shards.size(); i++)
+			elapsed += shards[i].elapsed.load(std::memory_order_relaxed);
+		return elapsed * 1.0e-9;
+	}
+
+	/// Reset the time of all the threads, none of them may be timing.
+	void reset(void) override {
+		for (int i = 0; i < shards.size(); i++)
+			shards[i].elapsed.store(0, std::memory_order_relaxed);
+	}
+
+	/// Retrieve the timer value's units.
+	std::string getUnits(void) const override {
+		return std::string("s");
+	}
+};
+
+} // namespace xolotlPerf
+
+#endif // HOTTIMER_H
@@ -8,6 +8,8 @@
 #include "ITimer.h"
 #include "IEventCounter.h"
 #include "IHardwareCounter.h"
+#include "HotCounter.h"
+#include "HotTimer.h"
 #include "PerfObjStatistics.h"
 
 namespace xolotlPerf {
@@ -52,6 +54,21 @@ public:
 			const std::string& name,
 			const IHardwareCounter::SpecType& ctrSpec) = 0;
 
+	/**
+	 * This operation returns the HotCounter specified by the parameter,
+	 * an event counter that can be used by several threads at once.
+	 * Its value is reported with the other event counters.
+	 */
+	virtual std::shared_ptr<HotCounter> getHotCounter(
+			const std::string& name) = 0;
+
+	/**
+	 * This operation returns the HotTimer specified by the parameter,
+	 * a timer that can be used by several threads at once.
+	 * Its value is reported with the other timers.
+	 */
+	virtual std::shared_ptr<HotTimer> getHotTimer(const std::string& name) = 0;
+
 	/**
 	 * Collect statistics about any performance data collected by
 	 * processes of the program.
@@ -79,6 +96,35 @@ public:
 			const PerfObjStatsMap<IEventCounter::ValType>& counterStats,
 			const PerfObjStatsMap<IHardwareCounter::CounterType>& hwCounterStats) const = 0;
 
+	/**
+	 * Start recording the timeline of this process: the start and stop
+	 * of each timer and the end of each time step.
+	 */
+	virtual void startTrace(void) = 0;
+
+	/**
+	 * Determine if the timeline of this process is recorded.
+	 *
+	 * @return true if startTrace was called and the timeline is recorded
+	 */
+	virtual bool isTracing(void) const = 0;
+
+	/**
+	 * Mark the end of a time step on the timeline, if it is recorded.
+	 *
+	 * @param step The number of the time step.
+	 * @param time The physical time at the end of the step.
+	 */
+	virtual void markTimeStep(int step, double time) = 0;
+
+	/**
+	 * Write the recorded timeline of this process in the Chrome trace
+	 * event format, to the file name_rank.json.
+	 *
+	 * @param name The base name of the file.
+	 */
+	virtual void writeTrace(const std::string& name) const = 0;
+
 };
 
 } //end namespace xolotlPerf
@@ -0,0 +1,114 @@
+#ifndef THREADSHARDS_H
+#define THREADSHARDS_H
+
+#include <cstdlib>
+#include <new>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace xolotlPerf {
+
+/**
+ * One slot of type T per thread, each on its own cache line.
+ *
+ * The threads of the grid point loops each update the slot of their OpenMP
+ * thread number, so they never write to the same cache line and need no
+ * lock. Readers combine the slots. If a thread number is beyond the number
+ * of slots (more threads than when the shards were built) it wraps around,
+ * so the slots must stay correct when shared, e.g. by using atomics.
+ *
+ * With no slot at all, the shards are disabled and owners should skip
+ * their update.
+ */
+template<typename T>
+class ThreadShards {
+private:
+
+	/// The size of a cache line, the slots are aligned on it.
+	static constexpr std::size_t cacheLineSize = 64;
+
+	/// A slot, alone on its cache line.
+	struct alignas(cacheLineSize) Slot {
+		T value;
+	};
+
+	/// The slots, allocated on a cache line boundary.
+	Slot* slots;
+
+	/// The number of slots.
+	int nSlots;
+
+public:
+
+	/// Get the number of threads of the next parallel regions.
+	///
+	/// @return The number of OpenMP threads, 1 without OpenMP.
+	static int maxThreads(void) {
+#ifdef _OPENMP
+		return omp_get_max_threads();
+#else
+		return 1;
+#endif
+	}
+
+	/// Construct the shards.
+	///
+	/// @param n The number of slots, usually maxThreads(). 0 disables them.
+	ThreadShards(int n) :
+			slots(nullptr), nSlots(n > 0 ? n : 0) {
+		if (nSlots == 0)
+			return;
+		// new[] only aligns on alignof(std::max_align_t) before C++17
+		void* memory = nullptr;
+		if (posix_memalign(&memory, cacheLineSize, nSlots * sizeof(Slot))
+				!= 0)
+			throw std::bad_alloc();
+		slots = static_cast<Slot*>(memory);
+		for (int i = 0; i < nSlots; i++)
+			new (slots + i) Slot();
+	}
+
+	/// The destructor.
+	~ThreadShards() {
+		for (int i = 0; i < nSlots; i++)
+			slots[i].~Slot();
+		free(slots);
+	}
+
+	/// The copy constructor, disallowed because the slots are shared.
+	ThreadShards(const ThreadShards& other) = delete;
+
+	/// Determine if there are slots to update.
+	bool isEnabled(void) const {
+		return nSlots > 0;
+	}
+
+	/// Get the slot of the calling thread. The shards must be enabled.
+	///
+	/// @return The slot.
+	T& local(void) {
+#ifdef _OPENMP
+		return slots[omp_get_thread_num() % nSlots].value;
+#else
+		return slots[0].value;
+#endif
+	}
+
+	/// Get the number of slots.
+	int size(void) const {
+		return nSlots;
+	}
+
+	/// Get the slot n.
+	T& operator[](int n) {
+		return slots[n].value;
+	}
+	const T& operator[](int n) const {
+		return slots[n].value;
+	}
+};
+
+} // namespace xolotlPerf
+
+#endif // THREADSHARDS_H
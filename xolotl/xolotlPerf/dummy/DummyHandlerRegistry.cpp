@@ -30,6 +30,18 @@ std::shared_ptr<IHardwareCounter> DummyHandlerRegistry::getHardwareCounter(
 	return std::make_shared < DummyHardwareCounter > (name, ctrSpec);
 }
 
+std::shared_ptr<HotCounter> DummyHandlerRegistry::getHotCounter(
+		const std::string& name) {
+	// Without shards it does not count
+	return std::make_shared<HotCounter>(name, 0);
+}
+
+std::shared_ptr<HotTimer> DummyHandlerRegistry::getHotTimer(
+		const std::string& name) {
+	// Without shards it does not time
+	return std::make_shared<HotTimer>(name, 0);
+}
+
 void DummyHandlerRegistry::collectStatistics(
 		PerfObjStatsMap<ITimer::ValType>&,
 		PerfObjStatsMap<IEventCounter::ValType>&,
@@ -46,5 +58,20 @@ void DummyHandlerRegistry::reportStatistics(std::ostream&,
 	return;
 }
 
+void DummyHandlerRegistry::startTrace(void) {
+	// do nothing
+	return;
+}
+
+void DummyHandlerRegistry::markTimeStep(int, double) {
+	// do nothing
+	return;
+}
+
+void DummyHandlerRegistry::writeTrace(const std::string&) const {
+	// do nothing
+	return;
+}
+
 } // namespace xolotlPerf
 
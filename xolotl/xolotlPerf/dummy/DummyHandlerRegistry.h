@@ -34,6 +34,12 @@ public:
 	virtual std::shared_ptr<IHardwareCounter> getHardwareCounter(
 			const std::string& name, const IHardwareCounter::SpecType& ctrSpec);
 
+	// Obtain a HotCounter that never counts.
+	virtual std::shared_ptr<HotCounter> getHotCounter(const std::string& name);
+
+	// Obtain a HotTimer that never runs.
+	virtual std::shared_ptr<HotTimer> getHotTimer(const std::string& name);
+
 	/**
 	 * Collect statistics about any performance data collected by
 	 * processes of the program.
@@ -62,6 +68,20 @@ public:
 			const PerfObjStatsMap<ITimer::ValType>& timerStats,
 			const PerfObjStatsMap<IEventCounter::ValType>& counterStats,
 			const PerfObjStatsMap<IHardwareCounter::CounterType>& hwCounterStats) const;
+
+	// Start recording the timeline.  This method is a stub.
+	virtual void startTrace(void);
+
+	// The timeline is never recorded.
+	virtual bool isTracing(void) const {
+		return false;
+	}
+
+	// Mark the end of a time step.  This method is a stub.
+	virtual void markTimeStep(int step, double time);
+
+	// Write the timeline.  This method is a stub.
+	virtual void writeTrace(const std::string& name) const;
 };
 
 } //end namespace xolotlPerf
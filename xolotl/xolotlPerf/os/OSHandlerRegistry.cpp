@@ -18,7 +18,7 @@ std::shared_ptr<ITimer> OSHandlerRegistry::getTimer(const std::string& name) {
 	} else {
 		// We have not yet created a timer with this name.
 		// Build one, and keep track of it.
-		ret = std::make_shared<OSTimer>(name);
+		ret = std::make_shared<OSTimer>(name, trace);
 		allTimers[name] = ret;
 	}
 	return ret;
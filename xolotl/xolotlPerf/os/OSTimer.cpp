@@ -15,6 +15,10 @@ void OSTimer::start(void) {
 
 	// Start the timer by sampling the current time.
     startTime = Clock::now();
+
+	// Open our region on the timeline
+	if (trace && trace->isEnabled())
+		trace->begin(traceId);
 }
 
 void OSTimer::stop(void) {
@@ -26,6 +30,10 @@ void OSTimer::stop(void) {
 	// Stop the timer by sampling the ending time.
     auto endTime = Clock::now();
 
+	// Close our region on the timeline
+	if (trace && trace->isEnabled())
+		trace->end(traceId);
+
 	// Form the difference between the end timestamp and
 	// our saved start timestamp.
     val += static_cast<Duration>(endTime - startTime).count();
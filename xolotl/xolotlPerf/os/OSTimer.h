@@ -3,8 +3,10 @@
 
 #include <chrono>
 #include <limits>
+#include <memory>
 #include "xolotlPerf/perfConfig.h"
 #include "xolotlPerf/ITimer.h"
+#include "xolotlPerf/standard/TraceRecorder.h"
 #include "xolotlCore/Identifiable.h"
 
 namespace xolotlPerf {
@@ -32,20 +34,30 @@ private:
 	/// Will be invalidTimestamp if timer is not running.
 	Timestamp startTime;
 
+	/// The timeline on which to record when the timer runs, if any.
+	std::shared_ptr<TraceRecorder> trace;
+
+	/// The id of our name on the timeline.
+	int traceId;
+
 	/// Construct a timer.
 	/// The default constructor is private to force callers to provide a name for the timer object.
 	OSTimer(void) :
-			xolotlCore::Identifiable("unused"), val(0) {
+			xolotlCore::Identifiable("unused"), val(0), traceId(0) {
 	}
 public:
 	///
 	/// Construct a timer.
 	///
 	/// @param name The name to associate with the timer.
-	OSTimer(const std::string& name) :
+	/// @param _trace The timeline on which to record when the timer runs.
+	OSTimer(const std::string& name,
+			std::shared_ptr<TraceRecorder> _trace = nullptr) :
 			xolotlCore::Identifiable(name),
             val(0),
-            startTime(invalidTimestamp) {
+            startTime(invalidTimestamp),
+            trace(_trace),
+            traceId(_trace ? _trace->getNameId(name) : 0) {
 	}
 
 	///
@@ -29,7 +29,7 @@ std::shared_ptr<ITimer> PAPIHandlerRegistry::getTimer(const std::string& name) {
 	} else {
 		// We have not yet created a timer with this name.
 		// Build one, and keep track of it.
-		ret = std::make_shared<PAPITimer>(name);
+		ret = std::make_shared<PAPITimer>(name, trace);
 		allTimers[name] = ret;
 	}
 	return ret;
@@ -18,6 +18,10 @@ void PAPITimer::start(void) {
 
 	// Start the timer by sampling the current time.
 	startTime = GetCurrentTime();
+
+	// Open our region on the timeline
+	if (trace && trace->isEnabled())
+		trace->begin(traceId);
 }
 
 void PAPITimer::stop(void) {
@@ -30,6 +34,10 @@ void PAPITimer::stop(void) {
 	// our saved start timestamp.
 	val += ToSeconds(GetCurrentTime() - startTime);
 
+	// Close our region on the timeline
+	if (trace && trace->isEnabled())
+		trace->end(traceId);
+
 	// Indicate the timer is no longer running.
 	startTime = invalidValue;
 }
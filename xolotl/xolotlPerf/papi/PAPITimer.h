@@ -6,7 +6,9 @@
 #  error "Using PAPI-based handler registry classes but PAPI was not found when configured."
 #endif // !defined(HAVE_PAPI)
 
+#include <memory>
 #include "xolotlPerf/ITimer.h"
+#include "xolotlPerf/standard/TraceRecorder.h"
 #include "xolotlCore/Identifiable.h"
 #include "papi.h"
 
@@ -29,10 +31,16 @@ private:
 	/// Will be invalidValue if timer is not running.
 	Timestamp startTime;
 
+	/// The timeline on which to record when the timer runs, if any.
+	std::shared_ptr<TraceRecorder> trace;
+
+	/// The id of our name on the timeline.
+	int traceId;
+
 	/// Construct a timer.
 	/// The default constructor is private to force callers to provide a name for the timer object.
 	PAPITimer(void) :
-			xolotlCore::Identifiable("unused"), val(0) {
+			xolotlCore::Identifiable("unused"), val(0), traceId(0) {
 	}
 
 	/// Sample the current time.
@@ -56,8 +64,11 @@ public:
 	/// Construct a timer.
 	///
 	/// @param name The name to associate with the timer.
-	PAPITimer(const std::string& name) :
-			xolotlCore::Identifiable(name), val(0), startTime(invalidValue) {
+	/// @param _trace The timeline on which to record when the timer runs.
+	PAPITimer(const std::string& name,
+			std::shared_ptr<TraceRecorder> _trace = nullptr) :
+			xolotlCore::Identifiable(name), val(0), startTime(invalidValue),
+			trace(_trace), traceId(_trace ? _trace->getNameId(name) : 0) {
 	}
 
 	///
@@ -1,7 +1,9 @@
 #include <sstream>
 #include <iostream>
+#include <fstream>
 #include <cassert>
 #include <tuple>
+#include <stdexcept>
 #include "mpi.h"
 #include <unistd.h>
 #include <float.h>
@@ -12,7 +14,8 @@
 
 namespace xolotlPerf {
 
-StdHandlerRegistry::StdHandlerRegistry(void) {
+StdHandlerRegistry::StdHandlerRegistry(void) :
+		trace(std::make_shared<TraceRecorder>()) {
 	// nothing else to do
 }
 
@@ -25,6 +28,30 @@ StdHandlerRegistry::~StdHandlerRegistry(void) {
 	allHWCounterSets.clear();
 }
 
+void StdHandlerRegistry::startTrace(void) {
+	trace->start();
+}
+
+void StdHandlerRegistry::writeTrace(const std::string& name) const {
+	// Nothing to write if the timeline was not recorded
+	if (!trace->isEnabled())
+		return;
+
+	int myRank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &myRank);
+
+	// One file per process
+	std::ostringstream fileName;
+	fileName << name << "_" << myRank << ".json";
+	std::ofstream traceFile(fileName.str());
+	if (!traceFile) {
+		std::cerr << "Warning: could not write the performance trace to "
+				<< fileName.str() << std::endl;
+		return;
+	}
+	trace->write(traceFile, myRank);
+}
+
 // We can create the EventCounters, since they don't depend on
 // more specialized functionality from any of our subclasses.
 std::shared_ptr<IEventCounter> StdHandlerRegistry::getEventCounter(
@@ -47,6 +74,52 @@ std::shared_ptr<IEventCounter> StdHandlerRegistry::getEventCounter(
 	return ret;
 }
 
+std::shared_ptr<HotCounter> StdHandlerRegistry::getHotCounter(
+		const std::string& name) {
+	std::shared_ptr<HotCounter> ret;
+
+	// Check if we have already created an event counter with this name.
+	auto iter = allEventCounters.find(name);
+	if (iter != allEventCounters.end()) {
+		// It must be a thread-safe one
+		ret = std::dynamic_pointer_cast<HotCounter>(iter->second);
+		if (!ret) {
+			throw std::invalid_argument(
+					"StdHandlerRegistry::getHotCounter: the event counter "
+							+ name + " is not a HotCounter.");
+		}
+	} else {
+		// Build one with a shard per thread and report it with the
+		// other event counters.
+		ret = std::make_shared<HotCounter>(name);
+		allEventCounters[name] = ret;
+	}
+	return ret;
+}
+
+std::shared_ptr<HotTimer> StdHandlerRegistry::getHotTimer(
+		const std::string& name) {
+	std::shared_ptr<HotTimer> ret;
+
+	// Check if we have already created a timer with this name.
+	auto iter = allTimers.find(name);
+	if (iter != allTimers.end()) {
+		// It must be a thread-safe one
+		ret = std::dynamic_pointer_cast<HotTimer>(iter->second);
+		if (!ret) {
+			throw std::invalid_argument(
+					"StdHandlerRegistry::getHotTimer: the timer " + name
+							+ " is not a HotTimer.");
+		}
+	} else {
+		// Build one with a shard per thread and report it with the
+		// other timers.
+		ret = std::make_shared<HotTimer>(name);
+		allTimers[name] = ret;
+	}
+	return ret;
+}
+
 template<typename T, typename V>
 void StdHandlerRegistry::CollectAllObjectNames(int myRank,
 		const std::map<std::string, std::shared_ptr<T> >& myObjs,
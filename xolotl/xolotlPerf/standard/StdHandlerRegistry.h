@@ -5,6 +5,7 @@
 #include <memory>
 #include "xolotlPerf/IHandlerRegistry.h"
 #include "xolotlPerf/PerfObjStatistics.h"
+#include "xolotlPerf/standard/TraceRecorder.h"
 
 namespace xolotlPerf {
 
@@ -97,6 +98,11 @@ protected:
 	 */
 	std::map<std::string, std::shared_ptr<IHardwareCounter> > allHWCounterSets;
 
+	/**
+	 * The timeline of this process, shared with the timers we create.
+	 */
+	std::shared_ptr<TraceRecorder> trace;
+
 public:
 
 	/**
@@ -119,6 +125,29 @@ public:
 	std::shared_ptr<IEventCounter> getEventCounter(
 			const std::string& name) override;
 
+	/**
+	 * Look up and return a named thread-safe counter.
+	 * Create the counter if it does not already exist.
+	 * Throws std::invalid_argument if an event counter of another type
+	 * already has this name.
+	 *
+	 * @param name The object's name.
+	 * @return The object with the given name.
+	 */
+	std::shared_ptr<HotCounter> getHotCounter(const std::string& name)
+			override;
+
+	/**
+	 * Look up and return a named thread-safe timer.
+	 * Create the timer if it does not already exist.
+	 * Throws std::invalid_argument if a timer of another type
+	 * already has this name.
+	 *
+	 * @param name The object's name.
+	 * @return The object with the given name.
+	 */
+	std::shared_ptr<HotTimer> getHotTimer(const std::string& name) override;
+
 	/**
 	 * Collect statistics about any performance data collected by
 	 * processes of the program.
@@ -145,6 +174,34 @@ public:
         const PerfObjStatsMap<IEventCounter::ValType>& counterStats,
         const PerfObjStatsMap<IHardwareCounter::CounterType>& hwStats) const override;
 
+	/**
+	 * Start recording the timeline of this process.
+	 * \see IHandlerRegistry.h
+	 */
+	void startTrace(void) override;
+
+	/**
+	 * Determine if the timeline of this process is recorded.
+	 * \see IHandlerRegistry.h
+	 */
+	bool isTracing(void) const override {
+		return trace->isEnabled();
+	}
+
+	/**
+	 * Mark the end of a time step on the timeline.
+	 * \see IHandlerRegistry.h
+	 */
+	void markTimeStep(int step, double time) override {
+		trace->markTimeStep(step, time);
+	}
+
+	/**
+	 * Write the recorded timeline of this process to name_rank.json.
+	 * \see IHandlerRegistry.h
+	 */
+	void writeTrace(const std::string& name) const override;
+
 };
 
 } // namespace xolotlPerf
@@ -0,0 +1,69 @@
+#include <iomanip>
+#include "xolotlPerf/standard/TraceRecorder.h"
+
+namespace xolotlPerf {
+
+void TraceRecorder::start(void) {
+	// Forget what was recorded before
+	events.clear();
+	origin = Clock::now();
+	enabled = true;
+}
+
+int TraceRecorder::getNameId(const std::string& name) {
+	auto iter = nameIds.find(name);
+	if (iter != nameIds.end()) {
+		return iter->second;
+	}
+
+	// We have not seen this name yet.
+	int id = names.size();
+	names.push_back(name);
+	nameIds[name] = id;
+	return id;
+}
+
+// Write a string as a JSON string.
+static void writeJSONString(std::ostream& os, const std::string& str) {
+	os << '"';
+	for (char c : str) {
+		if (c == '"' || c == '\\') {
+			os << '\\' << c;
+		} else if (static_cast<unsigned char>(c) < 0x20) {
+			os << ' ';
+		} else {
+			os << c;
+		}
+	}
+	os << '"';
+}
+
+void TraceRecorder::write(std::ostream& os, int rank) const {
+	os << "{\"traceEvents\":[";
+	os << std::fixed << std::setprecision(3);
+
+	// Name the process after its rank
+	os << "\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank
+			<< ",\"tid\":0,\"args\":{\"name\":\"rank " << rank << "\"}}";
+
+	for (const auto& event : events) {
+		os << ",\n{\"name\":";
+		if (event.phase == 'i') {
+			os << "\"timestep\"";
+		} else {
+			writeJSONString(os, names[event.id]);
+		}
+		os << ",\"ph\":\"" << event.phase << "\",\"ts\":" << event.timestamp
+				<< ",\"pid\":" << rank << ",\"tid\":0";
+		if (event.phase == 'i') {
+			os << ",\"s\":\"p\",\"args\":{\"step\":" << event.id
+					<< ",\"time\":" << std::scientific << std::setprecision(10)
+					<< event.time << "}" << std::fixed << std::setprecision(3);
+		}
+		os << "}";
+	}
+
+	os << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+} // namespace xolotlPerf
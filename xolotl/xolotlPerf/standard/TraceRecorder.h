@@ -0,0 +1,132 @@
+#ifndef TRACERECORDER_H
+#define TRACERECORDER_H
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+#include <ostream>
+
+namespace xolotlPerf {
+
+/**
+ * Records a timeline of this process: when each timer starts and stops,
+ * and when each time step of the solver ends.
+ *
+ * The accumulated timer values only give one total per name. Because the
+ * timers are started inside each other (RHSFunction inside solve, the
+ * monitors and their I/O between the steps, ...), the start and stop events
+ * form nested regions that show where each step spends its time. The
+ * timeline is written in the Chrome trace event format, one file per
+ * process, which can be opened in chrome://tracing or Perfetto.
+ *
+ * Nothing is recorded until start() is called, so the timers only check a
+ * flag when tracing is off. The recorder is not thread-safe, as the timers.
+ */
+class TraceRecorder {
+private:
+
+	/// Concise name for type of our time source.
+	using Clock = std::chrono::steady_clock;
+
+	/// One event of the timeline.
+	struct Event {
+		/// The Chrome trace phase: 'B' begin, 'E' end, 'i' time step
+		char phase;
+
+		/// The name id for 'B' and 'E', the time step number for 'i'
+		int id;
+
+		/// When it happened, in microseconds since start()
+		double timestamp;
+
+		/// The physical time for 'i'
+		double time;
+	};
+
+	/// Whether the events are recorded.
+	bool enabled;
+
+	/// When the recording started.
+	Clock::time_point origin;
+
+	/// The names of the regions, indexed by their id.
+	std::vector<std::string> names;
+
+	/// The ids of the names.
+	std::map<std::string, int> nameIds;
+
+	/// The events, in the order they happened.
+	std::vector<Event> events;
+
+	/// Get the current time in microseconds since start().
+	double now(void) const {
+		return std::chrono::duration<double, std::micro>(
+				Clock::now() - origin).count();
+	}
+
+public:
+
+	/// Construct a recorder that does not record yet.
+	TraceRecorder(void) :
+			enabled(false) {
+	}
+
+	/// The copy constructor, disallowed because the timers share the recorder.
+	TraceRecorder(const TraceRecorder& other) = delete;
+
+	/// Start recording, the times are relative to this call.
+	void start(void);
+
+	/// Determine if the events are recorded.
+	bool isEnabled(void) const {
+		return enabled;
+	}
+
+	/// Get the id of a region name, to record its events without
+	/// looking up the name each time.
+	///
+	/// @param name The name of the region, usually a timer name.
+	/// @return The id of the name.
+	int getNameId(const std::string& name);
+
+	/// Record the beginning of a region.
+	///
+	/// @param nameId The id of the region name.
+	void begin(int nameId) {
+		events.push_back( { 'B', nameId, now(), 0.0 });
+	}
+
+	/// Record the end of a region.
+	///
+	/// @param nameId The id of the region name.
+	void end(int nameId) {
+		events.push_back( { 'E', nameId, now(), 0.0 });
+	}
+
+	/// Record the end of a time step, if recording.
+	///
+	/// @param step The number of the time step.
+	/// @param time The physical time at the end of the step.
+	void markTimeStep(int step, double time) {
+		if (enabled)
+			events.push_back( { 'i', step, now(), time });
+	}
+
+	/// Get the number of recorded events.
+	///
+	/// @return The number of events.
+	std::size_t size(void) const {
+		return events.size();
+	}
+
+	/// Write the timeline in the Chrome trace event format.
+	///
+	/// @param os The stream on which to write.
+	/// @param rank The MPI rank of this process, used as the process id.
+	void write(std::ostream& os, int rank) const;
+};
+
+} // namespace xolotlPerf
+
+#endif // TRACERECORDER_H
@@ -13,6 +13,7 @@
 #include <IReSolutionHandler.h>
 #include <IMaterialFactory.h>
 #include <IReactionNetwork.h>
+#include "xolotlCore/io/XFile.h"
 
 namespace xolotlSolver {
 
@@ -54,6 +55,13 @@ public:
 	 */
 	virtual void createSolverContext(DM &da) = 0;
 
+	/**
+	 * Release what was created with the solver context besides the
+	 * distributed array, collective call before PETSc is finalized. The
+	 * context can then be created again.
+	 */
+	virtual void destroySolverContext() = 0;
+
 	/**
 	 * Initialize the concentration solution vector.
 	 *
@@ -96,6 +104,59 @@ public:
 	virtual void computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 			PetscReal ftime) = 0;
 
+	/**
+	 * Is the reaction part of the Jacobian applied without being assembled?
+	 * In that case the assembled Jacobian only keeps the diagonal of the
+	 * reaction part and is used as the preconditioner.
+	 *
+	 * @return True if the reactions are matrix-free
+	 */
+	virtual bool isReactionMatrixFree() const = 0;
+
+	/**
+	 * Add the product of the off-diagonal reaction part of the Jacobian,
+	 * the part that is not assembled in the matrix-free mode, with the
+	 * given vector. The rate constants and the grid points are the ones of
+	 * the last call to computeDiagonalJacobian().
+	 *
+	 * @param C The PETSc global solution vector where the Jacobian is computed
+	 * @param x The PETSc global vector to multiply
+	 * @param y The PETSc global vector where the product is added
+	 */
+	virtual void multiplyReactionJacobian(Vec &C, Vec &x, Vec &y) = 0;
+
+	/**
+	 * Are the values of the off-diagonal part of the Jacobian (temperature,
+	 * diffusion and advection) that were kept with keepOffDiagonalJacobian()
+	 * still valid? They are not anymore when the temperature or the surface
+	 * changed since.
+	 *
+	 * @param J The Jacobian
+	 * @return True if the values stored in the matrix can be retrieved
+	 */
+	virtual bool isOffDiagonalJacobianCurrent(Mat &J) = 0;
+
+	/**
+	 * Record the state in which the off-diagonal part of the Jacobian was
+	 * just computed, if it is kept between evaluations.
+	 *
+	 * @param J The Jacobian
+	 * @return True if its values should be stored in the matrix
+	 */
+	virtual bool keepOffDiagonalJacobian(Mat &J) = 0;
+
+	/**
+	 * Report the imbalance of the cost of the RHS and Jacobian evaluations
+	 * between the processes since the last report, and write the ownership
+	 * ranges that would balance it to the file loadBalance.txt. It does
+	 * nothing if the cost is not measured (-load_balance PETSc option).
+	 * Collective call.
+	 *
+	 * @param da The DMDA
+	 * @param timestep The current time step
+	 */
+	virtual void reportLoadBalance(DM &da, PetscInt timestep) = 0;
+
 	/**
 	 * Get the grid in the x direction.
 	 *
@@ -142,6 +203,16 @@ public:
 	 */
 	virtual void setSurfacePosition(int pos, int j = -1, int k = -1) = 0;
 
+	/**
+	 * Get the number of grid points in the x direction left out before the
+	 * active window, the vacuum that is not solved (-active_window PETSc
+	 * option). The grid, the surface position, and the DMDA start after
+	 * them, while the checkpoints are written on the whole grid.
+	 *
+	 * @return The index of the first solved grid point on the whole grid
+	 */
+	virtual int getWindowStart() const = 0;
+
 	/**
 	 * Get the initial vacancy concentration.
 	 *
@@ -163,6 +234,13 @@ public:
 	 */
 	virtual double getTauBursting() const = 0;
 
+	/**
+	 * Get the format of the concentrations written in the checkpoints.
+	 *
+	 * @return The format of the concentrations
+	 */
+	virtual xolotlCore::XFile::TimestepGroup::ConcsFormat getConcsFormat() const = 0;
+
 	/**
 	 * Get the grid left offset.
 	 *
@@ -247,6 +325,14 @@ public:
 	 */
 	virtual std::string getNetworkName() const = 0;
 
+	/**
+	 * Set the name of the file the solver context is created from, to set
+	 * it up again from a checkpoint.
+	 *
+	 * @param name The name of the file
+	 */
+	virtual void setNetworkName(const std::string& name) = 0;
+
 	/**
 	 * Access the random number generator.
 	 * The generator will have already been seeded.
@@ -32,6 +32,20 @@ std::shared_ptr<xolotlPerf::ITimer> RHSFunctionTimer;
 ////Timer for RHSJacobian()
 std::shared_ptr<xolotlPerf::ITimer> RHSJacobianTimer;
 
+//! Timers for the phases of RHSFunction() and RHSJacobian(), nested in the
+//! timers above so that they show up as sub-regions on the timeline
+std::shared_ptr<xolotlPerf::ITimer> ghostExchangeTimer;
+std::shared_ptr<xolotlPerf::ITimer> updateConcentrationTimer;
+std::shared_ptr<xolotlPerf::ITimer> offDiagonalJacobianTimer;
+std::shared_ptr<xolotlPerf::ITimer> diagonalJacobianTimer;
+std::shared_ptr<xolotlPerf::ITimer> jacobianAssemblyTimer;
+
+//! The copy of the assembled Jacobian when the reactions are matrix-free
+Mat assembledJacobian = nullptr;
+
+//! The solution at which the matrix-free Jacobian was last computed
+Vec jacobianState = nullptr;
+
 //! Help message
 static char help[] =
 		"Solves C_t =  -D*C_xx + A*C_x + F(C) + R(C) + D(C) from Brian Wirth's SciDAC project.\n";
@@ -86,10 +100,12 @@ PetscErrorCode RHSFunction(TS ts, PetscReal ftime, Vec C, Vec F, void *) {
 	// DMGlobalToLocalBegin(),DMGlobalToLocalEnd().
 	// By placing code between these two statements, computations can be
 	// done while messages are in transition.
+	ghostExchangeTimer->start();
 	ierr = DMGlobalToLocalBegin(da, C, INSERT_VALUES, localC);
 	CHKERRQ(ierr);
 	ierr = DMGlobalToLocalEnd(da, C, INSERT_VALUES, localC);
 	CHKERRQ(ierr);
+	ghostExchangeTimer->stop();
 
 	// Set the initial values of F
 	ierr = VecSet(F, 0.0);
@@ -97,7 +113,9 @@ PetscErrorCode RHSFunction(TS ts, PetscReal ftime, Vec C, Vec F, void *) {
 
 	// Compute the new concentrations
 	auto& solverHandler = Solver::getSolverHandler();
+	updateConcentrationTimer->start();
 	solverHandler.updateConcentration(ts, localC, F, ftime);
+	updateConcentrationTimer->stop();
 
 	// Stop the RHSFunction Timer
 	RHSFunctionTimer->stop();
@@ -119,8 +137,6 @@ PetscErrorCode RHSJacobian(TS ts, PetscReal ftime, Vec C, Mat A, Mat J,
 
 	// Get the matrix from PETSc
 	PetscFunctionBeginUser;
-	ierr = MatZeroEntries(J);
-	CHKERRQ(ierr);
 	DM da;
 	ierr = TSGetDM(ts, &da);
 	CHKERRQ(ierr);
@@ -129,31 +145,68 @@ PetscErrorCode RHSJacobian(TS ts, PetscReal ftime, Vec C, Mat A, Mat J,
 	CHKERRQ(ierr);
 
 	// Get the complete data array
+	ghostExchangeTimer->start();
 	ierr = DMGlobalToLocalBegin(da, C, INSERT_VALUES, localC);
 	CHKERRQ(ierr);
 	ierr = DMGlobalToLocalEnd(da, C, INSERT_VALUES, localC);
 	CHKERRQ(ierr);
+	ghostExchangeTimer->stop();
 
 	// Get the solver handler
 	auto& solverHandler = Solver::getSolverHandler();
 
 	/* ----- Compute the off-diagonal part of the Jacobian ----- */
-	solverHandler.computeOffDiagonalJacobian(ts, localC, J, ftime);
+	// Start from the values stored in the matrix if they are still valid
+	offDiagonalJacobianTimer->start();
+	if (solverHandler.isOffDiagonalJacobianCurrent(J)) {
+		ierr = MatRetrieveValues(J);
+		CHKERRQ(ierr);
+	} else {
+		ierr = MatZeroEntries(J);
+		CHKERRQ(ierr);
+		solverHandler.computeOffDiagonalJacobian(ts, localC, J, ftime);
 
-	ierr = MatAssemblyBegin(J, MAT_FINAL_ASSEMBLY);
-	CHKERRQ(ierr);
-	ierr = MatAssemblyEnd(J, MAT_FINAL_ASSEMBLY);
-	CHKERRQ(ierr);
+		ierr = MatAssemblyBegin(J, MAT_FINAL_ASSEMBLY);
+		CHKERRQ(ierr);
+		ierr = MatAssemblyEnd(J, MAT_FINAL_ASSEMBLY);
+		CHKERRQ(ierr);
+
+		// Store them for the next evaluations
+		if (solverHandler.keepOffDiagonalJacobian(J)) {
+			ierr = MatSetOption(J, MAT_NEW_NONZERO_LOCATIONS, PETSC_FALSE);
+			CHKERRQ(ierr);
+			ierr = MatStoreValues(J);
+			CHKERRQ(ierr);
+		}
+	}
+	offDiagonalJacobianTimer->stop();
 
 	/* ----- Compute the partial derivatives for the reaction term ----- */
+	diagonalJacobianTimer->start();
 	solverHandler.computeDiagonalJacobian(ts, localC, J, ftime);
+	diagonalJacobianTimer->stop();
 
+	jacobianAssemblyTimer->start();
 	ierr = MatAssemblyBegin(J, MAT_FINAL_ASSEMBLY);
 	CHKERRQ(ierr);
 	ierr = MatAssemblyEnd(J, MAT_FINAL_ASSEMBLY);
 	CHKERRQ(ierr);
+	jacobianAssemblyTimer->stop();
+
+	// Keep the unscaled assembled part and the solution for the matrix-free
+	// reactions, TS shifts and scales J in place
+	if (jacobianState) {
+		ierr = MatCopy(J, assembledJacobian, SAME_NONZERO_PATTERN);
+		CHKERRQ(ierr);
+		ierr = VecCopy(C, jacobianState);
+		CHKERRQ(ierr);
+	}
 
 	if (A != J) {
+		// TS scales and shifts the shell after each evaluation and the shell
+		// accumulates them, reset them to apply the new Jacobian as is
+		ierr = MatZeroEntries(A);
+		CHKERRQ(ierr);
 		ierr = MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY);
 		CHKERRQ(ierr);
 		ierr = MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY);
@@ -168,11 +221,53 @@ PetscErrorCode RHSJacobian(TS ts, PetscReal ftime, Vec C, Mat A, Mat J,
 	PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "MatrixFreeJacobian")
+/*
+ Apply the Jacobian when the reactions are matrix-free: the assembled part
+ plus the reaction entries that are not in the preconditioner matrix
+ */
+PetscErrorCode MatrixFreeJacobian(Mat, Vec x, Vec y) {
+	PetscErrorCode ierr;
+
+	PetscFunctionBeginUser;
+	ierr = MatMult(assembledJacobian, x, y);
+	CHKERRQ(ierr);
+
+	// Add the reactions
+	auto& solverHandler = Solver::getSolverHandler();
+	solverHandler.multiplyReactionJacobian(jacobianState, x, y);
+
+	PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "markTimeStep")
+/*
+ Mark the end of each time step on the performance timeline, the context is
+ the handler registry
+ */
+PetscErrorCode markTimeStep(TS, PetscInt timestep, PetscReal time, Vec,
+		void *ctx) {
+	PetscFunctionBeginUser;
+	auto registry = static_cast<xolotlPerf::IHandlerRegistry*>(ctx);
+	registry->markTimeStep(timestep, time);
+
+	PetscFunctionReturn(0);
+}
+
 PetscSolver::PetscSolver(ISolverHandler& _solverHandler,
 		std::shared_ptr<xolotlPerf::IHandlerRegistry> registry) :
 		Solver(_solverHandler, registry) {
 	RHSFunctionTimer = handlerRegistry->getTimer("RHSFunctionTimer");
 	RHSJacobianTimer = handlerRegistry->getTimer("RHSJacobianTimer");
+	ghostExchangeTimer = handlerRegistry->getTimer("RHS:ghostExchange");
+	updateConcentrationTimer = handlerRegistry->getTimer(
+			"RHSFunction:updateConcentration");
+	offDiagonalJacobianTimer = handlerRegistry->getTimer(
+			"RHSJacobian:offDiagonal");
+	diagonalJacobianTimer = handlerRegistry->getTimer("RHSJacobian:diagonal");
+	jacobianAssemblyTimer = handlerRegistry->getTimer("RHSJacobian:assembly");
 }
 
 PetscSolver::~PetscSolver() {
@@ -194,6 +289,15 @@ void PetscSolver::initialize() {
 }
 
 void PetscSolver::solve() {
+	// The solver stops to move the active window, it is set up again from
+	// the checkpoint written at that time and continues
+	while (solveContext()) {
+	}
+
+	return;
+}
+
+bool PetscSolver::solveContext() {
 	PetscErrorCode ierr;
 
 	// Create the solver context
@@ -224,7 +328,31 @@ void PetscSolver::solve() {
 	checkPetscError(ierr, "PetscSolver::solve: TSSetProblemType failed.");
 	ierr = TSSetRHSFunction(ts, NULL, RHSFunction, NULL);
 	checkPetscError(ierr, "PetscSolver::solve: TSSetRHSFunction failed.");
-	ierr = TSSetRHSJacobian(ts, NULL, NULL, RHSJacobian, NULL);
+
+	// When the reactions are matrix-free the DM matrix only holds the
+	// diagonal of the reactions and is used as the preconditioner
+	Mat A = NULL, J = NULL;
+	if (getSolverHandler().isReactionMatrixFree()) {
+		ierr = DMCreateMatrix(da, &J);
+		checkPetscError(ierr, "PetscSolver::solve: DMCreateMatrix failed.");
+		ierr = MatDuplicate(J, MAT_DO_NOT_COPY_VALUES, &assembledJacobian);
+		checkPetscError(ierr, "PetscSolver::solve: MatDuplicate failed.");
+		ierr = VecDuplicate(C, &jacobianState);
+		checkPetscError(ierr, "PetscSolver::solve: VecDuplicate failed.");
+		PetscInt localSize, globalSize;
+		ierr = VecGetLocalSize(C, &localSize);
+		checkPetscError(ierr, "PetscSolver::solve: VecGetLocalSize failed.");
+		ierr = VecGetSize(C, &globalSize);
+		checkPetscError(ierr, "PetscSolver::solve: VecGetSize failed.");
+		ierr = MatCreateShell(PETSC_COMM_WORLD, localSize, localSize,
+				globalSize, globalSize, NULL, &A);
+		checkPetscError(ierr, "PetscSolver::solve: MatCreateShell failed.");
+		ierr = MatShellSetOperation(A, MATOP_MULT,
+				(void (*)(void)) MatrixFreeJacobian);
+		checkPetscError(ierr,
+				"PetscSolver::solve: MatShellSetOperation failed.");
+	}
+	ierr = TSSetRHSJacobian(ts, A, J, RHSJacobian, NULL);
 	checkPetscError(ierr, "PetscSolver::solve: TSSetRHSJacobian failed.");
 	ierr = TSSetSolution(ts, C);
 	checkPetscError(ierr, "PetscSolver::solve: TSSetSolution failed.");
@@ -286,6 +414,13 @@ void PetscSolver::solve() {
 				"to set the monitors.");
 	}
 
+	// Mark the time steps on the performance timeline
+	if (handlerRegistry->isTracing()) {
+		ierr = TSMonitorSet(ts, markTimeStep, handlerRegistry.get(), NULL);
+		checkPetscError(ierr,
+				"PetscSolver::solve: TSMonitorSet (markTimeStep) failed.");
+	}
+
 	/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 	 Set initial conditions
 	 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
@@ -297,10 +432,16 @@ void PetscSolver::solve() {
 	/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 	 Solve the ODE system
 	 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+	TSConvergedReason reason;
 	if (ts != NULL && C != NULL) {
 		ierr = TSSolve(ts, C);
 		checkPetscError(ierr, "PetscSolver::solve: TSSolve failed.");
 
+		// Get the converged reason from PETSc
+		ierr = TSGetConvergedReason(ts, &reason);
+		checkPetscError(ierr,
+				"PetscSolver::solve: TSGetConvergedReason failed.");
+
 		/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 		 Write in a file if everything went well or not.
 		 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
@@ -309,17 +450,12 @@ void PetscSolver::solve() {
 		ierr = PetscOptionsHasName(NULL, NULL, "-check_collapse", &flagCheck);
 		checkPetscError(ierr,
 				"PetscSolver::solve: PetscOptionsHasName (-check_collapse) failed.");
-		if (flagCheck) {
+		// Nothing to write yet if the solver only stopped to move the window
+		if (flagCheck && reason != TS_CONVERGED_USER) {
 			// Open the output file
 			std::ofstream outputFile;
 			outputFile.open("solverStatus.txt");
 
-			// Get the converged reason from PETSc
-			TSConvergedReason reason;
-			ierr = TSGetConvergedReason(ts, &reason);
-			checkPetscError(ierr,
-					"PetscSolver::solve: TSGetConvergedReason failed.");
-
 			// Write it
 			if (reason == TS_CONVERGED_EVENT)
 				outputFile << "collapsed" << std::endl;
@@ -341,12 +477,21 @@ void PetscSolver::solve() {
 	 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 	ierr = VecDestroy(&C);
 	checkPetscError(ierr, "PetscSolver::solve: VecDestroy failed.");
+	ierr = MatDestroy(&A);
+	checkPetscError(ierr, "PetscSolver::solve: MatDestroy failed.");
+	ierr = MatDestroy(&J);
+	checkPetscError(ierr, "PetscSolver::solve: MatDestroy failed.");
+	ierr = MatDestroy(&assembledJacobian);
+	checkPetscError(ierr, "PetscSolver::solve: MatDestroy failed.");
+	ierr = VecDestroy(&jacobianState);
+	checkPetscError(ierr, "PetscSolver::solve: VecDestroy failed.");
 	ierr = TSDestroy(&ts);
 	checkPetscError(ierr, "PetscSolver::solve: TSDestroy failed.");
+	getSolverHandler().destroySolverContext();
 	ierr = DMDestroy(&da);
 	checkPetscError(ierr, "PetscSolver::solve: DMDestroy failed.");
 
-	return;
+	return reason == TS_CONVERGED_USER;
 }
 
 void PetscSolver::finalize() {
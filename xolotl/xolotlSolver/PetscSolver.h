@@ -36,6 +36,15 @@ private:
 	 */
 	void setupInitialConditions(DM data, Vec solutionVector);
 
+	/**
+	 * This operation creates the solver context, solves until the end or
+	 * until the solver stops to move the active window, and destroys the
+	 * context.
+	 *
+	 * @return True if the solver stopped to move the active window
+	 */
+	bool solveContext();
+
 public:
 
 	/**
@@ -50,6 +50,32 @@ PetscErrorCode checkTimeStep(TS ts) {
 	PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "checkpointFailed")
+/**
+ * This method must be called from the catch block around the calls to a
+ * checkpoint writer: the exception that stopped the checkpoint is printed
+ * and turned into a PETSc error because it can't go through PETSc.
+ */
+PetscErrorCode checkpointFailed() {
+	PetscFunctionBeginUser;
+
+	// Get the message of the current exception
+	std::string message = "unrecognized exception";
+	try {
+		throw;
+	} catch (const std::exception& e) {
+		message = e.what();
+	} catch (const std::string& error) {
+		message = error;
+	} catch (...) {
+	}
+	std::cerr << "Writing the checkpoint failed: " << message << std::endl;
+
+	SETERRQ(PETSC_COMM_SELF, PETSC_ERR_FILE_WRITE,
+			"Writing the checkpoint failed.");
+}
+
 #undef __FUNCT__
 #define __FUNCT__ Actual__FUNCT__("xolotlSolver", "monitorTime")
 /**
@@ -24,6 +24,7 @@
 #include <MathUtils.h>
 #include "RandomNumberGenerator.h"
 #include "xolotlCore/io/XFile.h"
+#include "xolotlCore/io/CheckpointWriter.h"
 #include "xolotlSolver/monitor/Monitor.h"
 
 namespace xperf = xolotlPerf;
@@ -32,6 +33,7 @@ namespace xolotlSolver {
 
 // Declaration of the functions defined in Monitor.cpp
 extern PetscErrorCode checkTimeStep(TS ts);
+extern PetscErrorCode checkpointFailed();
 extern PetscErrorCode monitorTime(TS ts, PetscInt timestep, PetscReal time,
 		Vec solution, void *ictx);
 extern PetscErrorCode computeFluence(TS ts, PetscInt timestep, PetscReal time,
@@ -82,6 +84,11 @@ PetscReal negStride1D = 0.0;
 PetscInt negPrevious1D = 0;
 //! HDF5 output file name
 std::string hdf5OutputName1D = "xolotlStop.h5";
+//! The writer of the checkpoints in the HDF5 output file
+std::shared_ptr<xolotlCore::CheckpointWriter> checkpointWriter1D;
+//! Whether the monitors are set up again after moving the active window,
+//! they continue the outputs and the fluence instead of starting over
+bool windowMoved1D = false;
 // Declare the vector that will store the Id of the helium clusters
 std::vector<int> indices1D;
 // Declare the vector that will store the weight of the helium clusters
@@ -217,6 +224,16 @@ PetscErrorCode computeTRIDYN1D(TS ts, PetscInt timestep, PetscReal time,
 
 	PetscFunctionBeginUser;
 
+	// HDF5 can't be used while a checkpoint is written in the background
+	if (checkpointWriter1D) {
+		try {
+			checkpointWriter1D->wait();
+		} catch (...) {
+			ierr = checkpointFailed();
+			CHKERRQ(ierr);
+		}
+	}
+
 	// Get the number of processes
 	int worldSize;
 	MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
@@ -330,60 +347,33 @@ PetscErrorCode computeTRIDYN1D(TS ts, PetscInt timestep, PetscReal time,
 }
 
 #undef __FUNCT__
-#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "startStop1D")
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "writeCheckpoint1D")
 /**
- * This is a monitoring method that update an hdf5 file at each time step.
+ * This method writes the current state in the hdf5 file, on the whole grid
+ * including the grid points left out of the active window.
+ * The file is written in the background when the libraries allow it.
  */
-PetscErrorCode startStop1D(TS ts, PetscInt timestep, PetscReal time,
-		Vec solution, void *) {
-
-	xperf::ScopedTimer myTimer(startStopTimer);
+PetscErrorCode writeCheckpoint1D(TS ts, PetscInt timestep, PetscReal time,
+		Vec solution) {
 
 	// Initial declaration
 	PetscErrorCode ierr;
-	const double **solutionArray, *gridPointSolution;
 	PetscInt xs, xm, Mx;
 
 	PetscFunctionBeginUser;
 
-	// Compute the dt
-	double dt = time - previousTime;
-
-	// Don't do anything if it is not on the stride
-	if (((int) ((time + dt / 10.0) / hdf5Stride1D) <= hdf5Previous1D)
-			&& timestep > 0) {
-		PetscFunctionReturn(0);
-	}
-
-	// Update the previous time
-	if ((int) ((time + dt / 10.0) / hdf5Stride1D) > hdf5Previous1D)
-		hdf5Previous1D++;
-
-	// Get the number of processes
-	int worldSize;
-	MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
-
-	// Gets the process ID (important when it is running in parallel)
-	int procId;
-	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
-
 	// Get the da from ts
 	DM da;
 	ierr = TSGetDM(ts, &da);
 	CHKERRQ(ierr);
 
-	// Get the solutionArray
-	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
-
 	// Get the corners of the grid
 	ierr = DMDAGetCorners(da, &xs, NULL, NULL, &xm, NULL, NULL);
 	CHKERRQ(ierr);
 	// Get the size of the total grid
 	ierr = DMDAGetInfo(da, PETSC_IGNORE, &Mx, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE);
+	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
+	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE);
 	CHKERRQ(ierr);
 
 	// Get the solver handler
@@ -393,67 +383,142 @@ PetscErrorCode startStop1D(TS ts, PetscInt timestep, PetscReal time,
 	auto& network = solverHandler.getNetwork();
 	const int dof = network.getDOF();
 
-	// Create an array for the concentration
-	double concArray[dof][2];
-
-	// Get the position of the surface
-	int surfacePos = solverHandler.getSurfacePosition();
-
-	// Open the existing HDF5 file
-	xolotlCore::XFile checkpointFile(hdf5OutputName1D, PETSC_COMM_WORLD,
-			xolotlCore::XFile::AccessMode::OpenReadWrite);
-
 	// Get the current time step
 	double currentTimeStep;
 	ierr = TSGetTimeStep(ts, &currentTimeStep);
 	CHKERRQ(ierr);
 
-	// Add a concentration time step group for the current time step.
-	auto concGroup = checkpointFile.getGroup<
-			xolotlCore::XFile::ConcentrationGroup>();
-	assert(concGroup);
-	auto tsGroup = concGroup->addTimestepGroup(timestep, time, previousTime,
-			currentTimeStep);
+	// Get the buffer for the local solution, after the previous checkpoint
+	// is written
+	double *buffer = nullptr;
+	try {
+		buffer = checkpointWriter1D->getBuffer(xm * dof);
+	} catch (...) {
+		ierr = checkpointFailed();
+		CHKERRQ(ierr);
+	}
 
-	if (solverHandler.moveSurface()) {
-		// Write the surface positions and the associated interstitial quantities
-		// in the concentration sub group
-		tsGroup->writeSurface1D(surfacePos, nInterstitial1D, previousIFlux1D);
+	// Compute the TRIDYN data before the checkpoint can be written in the
+	// background
+	ierr = computeTRIDYN1D(ts, timestep, time, solution, NULL);
+	CHKERRQ(ierr);
+
+	// Copy the solution we own
+	const PetscScalar *solutionValues;
+	ierr = VecGetArrayRead(solution, &solutionValues);
+	CHKERRQ(ierr);
+	std::copy(solutionValues, solutionValues + xm * dof, buffer);
+	ierr = VecRestoreArrayRead(solution, &solutionValues);
+	CHKERRQ(ierr);
+
+	// The grid points before the active window are not written
+	const int windowStart = solverHandler.getWindowStart();
+
+	// Copy the surface and bottom data that will be written with it
+	const bool writeSurface = solverHandler.moveSurface();
+	const int surfacePos = solverHandler.getSurfacePosition() + windowStart;
+	const double nInter = nInterstitial1D, previousIFlux = previousIFlux1D;
+	const bool writeBottom = (solverHandler.getRightOffset() == 1);
+	const double nHe = nHelium1D, previousHeFlux = previousHeFlux1D, nD =
+			nDeuterium1D, previousDFlux = previousDFlux1D, nT = nTritium1D,
+			previousTFlux = previousTFlux1D;
+
+	// Write the checkpoint, only for the grid points we own
+	xolotlCore::CheckpointWriter::Checkpoint checkpoint;
+	checkpoint.fileName = hdf5OutputName1D;
+	checkpoint.timeStep = timestep;
+	checkpoint.time = time;
+	checkpoint.previousTime = previousTime;
+	checkpoint.deltaTime = currentTimeStep;
+	checkpoint.dim = 1;
+	checkpoint.gridDims = { { (int) Mx + windowStart, 1, 1 } };
+	checkpoint.start = { { (int) xs + windowStart, 0, 0 } };
+	checkpoint.size = { { (int) xm, 1, 1 } };
+	checkpoint.dof = dof;
+	checkpoint.format = solverHandler.getConcsFormat();
+	checkpoint.writeGroupData =
+			[=](xolotlCore::XFile::TimestepGroup& tsGroup) {
+				if (writeSurface) {
+					// Write the surface positions and the associated interstitial quantities
+					// in the concentration sub group
+					tsGroup.writeSurface1D(surfacePos, nInter, previousIFlux);
+				}
+
+				// Write the bottom impurity information if the bottom is a free surface
+				if (writeBottom)
+					tsGroup.writeBottom1D(nHe, previousHeFlux, nD,
+							previousDFlux, nT, previousTFlux);
+			};
+	try {
+		checkpointWriter1D->write(checkpoint);
+	} catch (...) {
+		ierr = checkpointFailed();
+		CHKERRQ(ierr);
 	}
 
-	// Write the bottom impurity information if the bottom is a free surface
-	if (solverHandler.getRightOffset() == 1)
-		tsGroup->writeBottom1D(nHelium1D, previousHeFlux1D, nDeuterium1D,
-				previousDFlux1D, nTritium1D, previousTFlux1D);
+	// Report the load imbalance since the previous checkpoint
+	solverHandler.reportLoadBalance(da, timestep);
+
+	PetscFunctionReturn(0);
+}
 
-	// Determine the concentration values we will write.
-	// We only examine and collect the grid points we own.
-	// TODO measure impact of us building the flattened representation
-	// rather than a ragged 2D representation.
-	XFile::TimestepGroup::Concs1DType concs(xm);
-	for (auto i = 0; i < xm; ++i) {
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "startStop1D")
+/**
+ * This is a monitoring method that update an hdf5 file at each time step.
+ */
+PetscErrorCode startStop1D(TS ts, PetscInt timestep, PetscReal time,
+		Vec solution, void *) {
 
-		// Access the solution data for the current grid point.
-		auto gridPointSolution = solutionArray[xs + i];
+	xperf::ScopedTimer myTimer(startStopTimer);
 
-		for (auto l = 0; l < dof; ++l) {
-			if (std::fabs(gridPointSolution[l]) > 1.0e-16) {
-				concs[i].emplace_back(l, gridPointSolution[l]);
-			}
-		}
+	// Initial declaration
+	PetscErrorCode ierr;
+
+	PetscFunctionBeginUser;
+
+	// Compute the dt
+	double dt = time - previousTime;
+
+	// Don't do anything if it is not on the stride
+	if (((int) ((time + dt / 10.0) / hdf5Stride1D) <= hdf5Previous1D)
+			&& timestep > 0) {
+		PetscFunctionReturn(0);
 	}
 
-	// Write our concentration data to the current timestep group
-	// in the HDF5 file.
-	// We only write the data for the grid points we own.
-	tsGroup->writeConcentrations(checkpointFile, xs, concs);
+	// Update the previous time
+	if ((int) ((time + dt / 10.0) / hdf5Stride1D) > hdf5Previous1D)
+		hdf5Previous1D++;
 
-	// Restore the solutionArray
-	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
+	// Write the checkpoint
+	ierr = writeCheckpoint1D(ts, timestep, time, solution);
 	CHKERRQ(ierr);
 
-	ierr = computeTRIDYN1D(ts, timestep, time, solution, NULL);
-	CHKERRQ(ierr);
+	PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "finishStartStop1D")
+/**
+ * This method waits for the last checkpoint when the startStop1D monitor
+ * is destroyed with the TS.
+ */
+PetscErrorCode finishStartStop1D(void **) {
+	// Initial declaration
+	PetscErrorCode ierr;
+
+	PetscFunctionBeginUser;
+
+	// Release the writer even if its last checkpoint failed
+	auto writer = std::move(checkpointWriter1D);
+	if (writer) {
+		try {
+			writer->wait();
+		} catch (...) {
+			ierr = checkpointFailed();
+			CHKERRQ(ierr);
+		}
+	}
 
 	PetscFunctionReturn(0);
 }
@@ -2364,6 +2429,8 @@ PetscErrorCode postEventFunction1D(TS ts, PetscInt nevents,
 	double threshold = (62.8 - initialVConc) * (grid[xi + 1] - grid[xi]);
 
 	if (movingUp) {
+		const int previousSurfacePos = surfacePos;
+		const double previousNInter = nInterstitial1D;
 		int nGridPoints = 0;
 		// Move the surface up until it is smaller than the next threshold
 		while (nInterstitial1D > threshold) {
@@ -2378,6 +2445,39 @@ PetscErrorCode postEventFunction1D(TS ts, PetscInt nevents,
 					* (grid[xi + 1] - grid[xi]);
 		}
 
+		// If the surface goes out of the active window but not out of the
+		// whole grid, stop with a checkpoint before moving it, the solver
+		// starts again from it with the window moved
+		if (surfacePos < 0 && solverHandler.getWindowStart() > 0
+				&& checkpointWriter1D) {
+			surfacePos = previousSurfacePos;
+			nInterstitial1D = previousNInter;
+
+			// Restore the solutionArray
+			ierr = DMDAVecRestoreArrayDOF(da, solution, &solutionArray);
+			CHKERRQ(ierr);
+
+			if (procId == 0) {
+				std::cout << "The surface reaches the start of the active "
+						"window at time: " << time
+						<< " s, moving the window." << std::endl;
+			}
+
+			// Write the checkpoint and stop, the solver is set up again
+			// from it
+			PetscInt timestep;
+			ierr = TSGetStepNumber(ts, &timestep);
+			CHKERRQ(ierr);
+			ierr = writeCheckpoint1D(ts, timestep, time, solution);
+			CHKERRQ(ierr);
+			solverHandler.setNetworkName(hdf5OutputName1D);
+			windowMoved1D = true;
+			ierr = TSSetConvergedReason(ts, TS_CONVERGED_USER);
+			CHKERRQ(ierr);
+
+			PetscFunctionReturn(0);
+		}
+
 		// Throw an exception if the position is negative
 		if (surfacePos < 0) {
 			PetscBool flagCheck;
@@ -2740,6 +2840,16 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 			// Get the physical grid
 			auto grid = solverHandler.getXGrid();
 
+			// Add back the grid points before the active window to describe
+			// the whole grid in the header, the vacuum has the step size of
+			// the first grid point with every type of grid
+			const int windowStart = solverHandler.getWindowStart();
+			const double hx = grid[1] - grid[0];
+			grid.insert(grid.begin(), windowStart, 0.0);
+			for (int i = windowStart - 1; i >= 0; i--) {
+				grid[i] = grid[i + 1] - hx;
+			}
+
 			// Get the compostion list and save it
 			auto compList = network.getCompositionList();
 
@@ -2764,8 +2874,17 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 					hdf5OutputName1D, network);
 		}
 
+		// Check if the checkpoints should be written in the background
+		PetscBool flagAsync = PETSC_FALSE;
+		ierr = PetscOptionsHasName(NULL, NULL, "-start_stop_async",
+				&flagAsync);
+		checkPetscError(ierr,
+				"setupPetsc1DMonitor: PetscOptionsHasName (-start_stop_async) failed.");
+		checkpointWriter1D = std::make_shared<xolotlCore::CheckpointWriter>(
+				PETSC_COMM_WORLD, flagAsync);
+
 		// startStop1D will be called at each timestep
-		ierr = TSMonitorSet(ts, startStop1D, NULL, NULL);
+		ierr = TSMonitorSet(ts, startStop1D, NULL, finishStartStop1D);
 		checkPetscError(ierr,
 				"setupPetsc1DMonitor: TSMonitorSet (startStop1D) failed.");
 	}
@@ -2793,9 +2912,11 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 			sputteringYield1D = solverHandler.getSputteringYield();
 
 			// Clear the file where the surface will be written
-			std::ofstream outputFile;
-			outputFile.open("surface.txt");
-			outputFile.close();
+			if (!windowMoved1D) {
+				std::ofstream outputFile;
+				outputFile.open("surface.txt");
+				outputFile.close();
+			}
 		}
 
 		// Bursting
@@ -2817,9 +2938,11 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 				"setupPetsc1DMonitor: TSSetEventHandler (eventFunction1D) failed.");
 
 		// Uncomment to clear the file where the bursting info will be written
-		std::ofstream outputFile;
-		outputFile.open("bursting.txt");
-		outputFile.close();
+		if (!windowMoved1D) {
+			std::ofstream outputFile;
+			outputFile.open("bursting.txt");
+			outputFile.close();
+		}
 	}
 
 // Set the monitor to save 1D plot of xenon distribution
@@ -2962,6 +3085,9 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 
 // Initialize indices1D and weights1D if we want to compute the
 // retention or the cumulative value and others
+	indices1D.clear();
+	weights1D.clear();
+	radii1D.clear();
 	if (flagMeanSize || flagConc || flagHeRetention) {
 		// Loop on the helium clusters
 		for (auto const& heMapItem : network.getAll(ReactantType::He)) {
@@ -3004,8 +3130,10 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 			auto fluxHandler = solverHandler.getFluxHandler();
 			// The length of the time step
 			double dt = time;
-			// Increment the fluence with the value at this current timestep
-			fluxHandler->incrementFluence(dt);
+			// Increment the fluence with the value at this current timestep,
+			// it is already there if the solver continues
+			if (!windowMoved1D)
+				fluxHandler->incrementFluence(dt);
 			// Get the previous time from the HDF5 file
 			// TODO isn't this the same as 'time' above?
 			previousTime = lastTsGroup->readPreviousTime();
@@ -3033,9 +3161,11 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 				"setupPetsc1DMonitor: TSMonitorSet (computeHeliumRetention1D) failed.");
 
 		// Uncomment to clear the file where the retention will be written
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt");
-		outputFile.close();
+		if (!windowMoved1D) {
+			std::ofstream outputFile;
+			outputFile.open("retentionOut.txt");
+			outputFile.close();
+		}
 	}
 
 // Set the monitor to compute the xenon fluence and the retention
@@ -3064,8 +3194,10 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 			auto fluxHandler = solverHandler.getFluxHandler();
 			// The length of the time step
 			double dt = time;
-			// Increment the fluence with the value at this current timestep
-			fluxHandler->incrementFluence(dt);
+			// Increment the fluence with the value at this current timestep,
+			// it is already there if the solver continues
+			if (!windowMoved1D)
+				fluxHandler->incrementFluence(dt);
 			// Get the previous time from the HDF5 file
 			// TODO isn't this the same as 'time' above?
 			previousTime = lastTsGroup->readPreviousTime();
@@ -3082,9 +3214,11 @@ PetscErrorCode setupPetsc1DMonitor(TS ts,
 				"setupPetsc1DMonitor: TSMonitorSet (computeXenonRetention1D) failed.");
 
 		// Uncomment to clear the file where the retention will be written
-		std::ofstream outputFile;
-		outputFile.open("retentionOut.txt");
-		outputFile.close();
+		if (!windowMoved1D) {
+			std::ofstream outputFile;
+			outputFile.open("retentionOut.txt");
+			outputFile.close();
+		}
 	}
 
 // Set the monitor to compute the cumulative helium concentration
@@ -20,12 +20,14 @@
 #include <MathUtils.h>
 #include "RandomNumberGenerator.h"
 #include "xolotlCore/io/XFile.h"
+#include "xolotlCore/io/CheckpointWriter.h"
 #include "xolotlSolver/monitor/Monitor.h"
 
 namespace xolotlSolver {
 
 // Declaration of the functions defined in Monitor.cpp
 extern PetscErrorCode checkTimeStep(TS ts);
+extern PetscErrorCode checkpointFailed();
 extern PetscErrorCode monitorTime(TS ts, PetscInt timestep, PetscReal time,
 		Vec solution, void *ictx);
 extern PetscErrorCode computeFluence(TS ts, PetscInt timestep, PetscReal time,
@@ -44,6 +46,8 @@ PetscReal hdf5Stride2D = 0.0;
 PetscInt hdf5Previous2D = 0;
 //! HDF5 output file name
 std::string hdf5OutputName2D = "xolotlStop.h5";
+//! The writer of the checkpoints in the HDF5 output file
+std::shared_ptr<xolotlCore::CheckpointWriter> checkpointWriter2D;
 //! The pointer to the 2D plot used in MonitorSurface.
 std::shared_ptr<xolotlViz::IPlot> surfacePlot2D;
 //! The variable to store the interstitial flux at the previous time step.
@@ -82,13 +86,13 @@ std::vector<double> radii2D;
 #define __FUNCT__ Actual__FUNCT__("xolotlSolver", "startStop2D")
 /**
  * This is a monitoring method that will update an hdf5 file at each time step.
+ * The file is written in the background when the libraries allow it.
  */
 PetscErrorCode startStop2D(TS ts, PetscInt timestep, PetscReal time,
 		Vec solution, void *) {
 	// Initial declaration
 	PetscErrorCode ierr;
-	const double ***solutionArray, *gridPointSolution;
-	PetscInt xs, xm, Mx, ys, ym, My;
+	PetscInt xs, xm, ys, ym, Mx, My;
 
 	PetscFunctionBeginUser;
 
@@ -104,29 +108,17 @@ PetscErrorCode startStop2D(TS ts, PetscInt timestep, PetscReal time,
 	if ((int) ((time + dt / 10.0) / hdf5Stride2D) > hdf5Previous2D)
 		hdf5Previous2D++;
 
-	// Get the number of processes
-	int worldSize;
-	MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
-
-	// Gets the process ID (important when it is running in parallel)
-	int procId;
-	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
-
 	// Get the da from ts
 	DM da;
 	ierr = TSGetDM(ts, &da);
 	CHKERRQ(ierr);
 
-	// Get the solutionArray
-	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
-
 	// Get the corners of the grid
 	ierr = DMDAGetCorners(da, &xs, &ys, NULL, &xm, &ym, NULL);
 	CHKERRQ(ierr);
 	// Get the size of the total grid
-	ierr = DMDAGetInfo(da, PETSC_IGNORE, &Mx, &My, PETSC_IGNORE, PETSC_IGNORE,
-	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
+	ierr = DMDAGetInfo(da, PETSC_IGNORE, &Mx, &My, PETSC_IGNORE,
+	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE,
 	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE);
 	CHKERRQ(ierr);
 
@@ -139,101 +131,104 @@ PetscErrorCode startStop2D(TS ts, PetscInt timestep, PetscReal time,
 	// Network size
 	const int dof = network.getDOF();
 
-	// Create an array for the concentration
-	double concArray[dof][2];
-
-	// Get the vector of positions of the surface
-	std::vector<int> surfaceIndices;
-	for (PetscInt i = 0; i < My; i++) {
-		surfaceIndices.push_back(solverHandler.getSurfacePosition(i));
-	}
-
-	// Open the existing checkpoint file.
-	xolotlCore::XFile checkpointFile(hdf5OutputName2D, PETSC_COMM_WORLD,
-			xolotlCore::XFile::AccessMode::OpenReadWrite);
-
 	// Get the current time step
 	double currentTimeStep;
 	ierr = TSGetTimeStep(ts, &currentTimeStep);
 	CHKERRQ(ierr);
 
-	// Add a concentration sub group
-	auto concGroup = checkpointFile.getGroup<
-			xolotlCore::XFile::ConcentrationGroup>();
-	assert(concGroup);
-	auto tsGroup = concGroup->addTimestepGroup(timestep, time, previousTime,
-			currentTimeStep);
-
-	if (solverHandler.moveSurface()) {
-		// Write the surface positions and the associated interstitial quantities
-		// in the concentration sub group
-		tsGroup->writeSurface2D(surfaceIndices, nInterstitial2D,
-				previousIFlux2D);
+	// Copy the solution we own, after the previous checkpoint is written
+	double *buffer = nullptr;
+	try {
+		buffer = checkpointWriter2D->getBuffer(xm * ym * dof);
+	} catch (...) {
+		ierr = checkpointFailed();
+		CHKERRQ(ierr);
 	}
+	const PetscScalar *solutionValues;
+	ierr = VecGetArrayRead(solution, &solutionValues);
+	CHKERRQ(ierr);
+	std::copy(solutionValues, solutionValues + xm * ym * dof, buffer);
+	ierr = VecRestoreArrayRead(solution, &solutionValues);
+	CHKERRQ(ierr);
 
-	// Write the bottom impurity information if the bottom is a free surface
-	if (solverHandler.getRightOffset() == 1)
-		tsGroup->writeBottom2D(nHelium2D, previousHeFlux2D, nDeuterium2D,
-				previousDFlux2D, nTritium2D, previousTFlux2D);
-
-	// Loop on the full grid
-	for (PetscInt j = 0; j < My; j++) {
-		for (PetscInt i = 0; i < Mx; i++) {
-			// Wait for all the processes
-			MPI_Barrier(PETSC_COMM_WORLD);
-
-			// Size of the concentration that will be stored
-			int concSize = -1;
-			// To save which proc has the information
-			int concId = 0;
-			// To know which process should write
-			bool write = false;
-
-			// If it is the locally owned part of the grid
-			if (i >= xs && i < xs + xm && j >= ys && j < ys + ym) {
-				write = true;
-				// Get the pointer to the beginning of the solution data for this grid point
-				gridPointSolution = solutionArray[j][i];
-
-				// Loop on the concentrations
-				for (int l = 0; l < dof; l++) {
-					if (std::fabs(gridPointSolution[l]) > 1.0e-16) {
-						// Increase concSize
-						concSize++;
-						// Fill the concArray
-						concArray[concSize][0] = (double) l;
-						concArray[concSize][1] = gridPointSolution[l];
-					}
+	// Copy the surface and bottom data that will be written with it
+	const bool writeSurface = solverHandler.moveSurface();
+	std::vector<int> surfaceIndices;
+	for (PetscInt i = 0; i < My; i++) {
+		surfaceIndices.push_back(solverHandler.getSurfacePosition(i));
+	}
+	const auto nInter = nInterstitial2D;
+	const auto previousIFlux = previousIFlux2D;
+	const bool writeBottom = (solverHandler.getRightOffset() == 1);
+	const auto nHe = nHelium2D;
+	const auto previousHeFlux = previousHeFlux2D;
+	const auto nD = nDeuterium2D;
+	const auto previousDFlux = previousDFlux2D;
+	const auto nT = nTritium2D;
+	const auto previousTFlux = previousTFlux2D;
+
+	// Write the checkpoint, only for the grid points we own
+	xolotlCore::CheckpointWriter::Checkpoint checkpoint;
+	checkpoint.fileName = hdf5OutputName2D;
+	checkpoint.timeStep = timestep;
+	checkpoint.time = time;
+	checkpoint.previousTime = previousTime;
+	checkpoint.deltaTime = currentTimeStep;
+	checkpoint.dim = 2;
+	checkpoint.gridDims = { { (int) Mx, (int) My, 1 } };
+	checkpoint.start = { { (int) xs, (int) ys, 0 } };
+	checkpoint.size = { { (int) xm, (int) ym, 1 } };
+	checkpoint.dof = dof;
+	checkpoint.format = solverHandler.getConcsFormat();
+	checkpoint.writeGroupData =
+			[=](xolotlCore::XFile::TimestepGroup& tsGroup) {
+				if (writeSurface) {
+					// Write the surface positions and the associated interstitial quantities
+					// in the concentration sub group
+					tsGroup.writeSurface2D(surfaceIndices, nInter, previousIFlux);
 				}
 
-				// Increase concSize one last time
-				concSize++;
+				// Write the bottom impurity information if the bottom is a free surface
+				if (writeBottom)
+					tsGroup.writeBottom2D(nHe, previousHeFlux, nD,
+							previousDFlux, nT, previousTFlux);
+			};
+	try {
+		checkpointWriter2D->write(checkpoint);
+	} catch (...) {
+		ierr = checkpointFailed();
+		CHKERRQ(ierr);
+	}
 
-				// Save the procId
-				concId = procId;
-			}
+	// Report the load imbalance since the previous checkpoint
+	solverHandler.reportLoadBalance(da, timestep);
 
-			// Get which processor will send the information
-			int concProc = 0;
-			MPI_Allreduce(&concId, &concProc, 1, MPI_INT, MPI_SUM,
-					PETSC_COMM_WORLD);
+	PetscFunctionReturn(0);
+}
 
-			// Broadcast the size
-			MPI_Bcast(&concSize, 1, MPI_INT, concProc, PETSC_COMM_WORLD);
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "finishStartStop2D")
+/**
+ * This method waits for the last checkpoint when the startStop2D monitor
+ * is destroyed with the TS.
+ */
+PetscErrorCode finishStartStop2D(void **) {
+	// Initial declaration
+	PetscErrorCode ierr;
 
-			// Skip the grid point if the size is 0
-			if (concSize == 0)
-				continue;
+	PetscFunctionBeginUser;
 
-			// All processes create the dataset and fill it
-			tsGroup->writeConcentrationDataset(concSize, concArray, write, i, j);
+	// Release the writer even if its last checkpoint failed
+	auto writer = std::move(checkpointWriter2D);
+	if (writer) {
+		try {
+			writer->wait();
+		} catch (...) {
+			ierr = checkpointFailed();
+			CHKERRQ(ierr);
 		}
 	}
 
-	// Restore the solutionArray
-	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
-
 	PetscFunctionReturn(0);
 }
 
@@ -1833,8 +1828,17 @@ PetscErrorCode setupPetsc2DMonitor(TS ts) {
 					hdf5OutputName2D, network);
 		}
 
+		// Check if the checkpoints should be written in the background
+		PetscBool flagAsync = PETSC_FALSE;
+		ierr = PetscOptionsHasName(NULL, NULL, "-start_stop_async",
+				&flagAsync);
+		checkPetscError(ierr,
+				"setupPetsc2DMonitor: PetscOptionsHasName (-start_stop_async) failed.");
+		checkpointWriter2D = std::make_shared<xolotlCore::CheckpointWriter>(
+				PETSC_COMM_WORLD, flagAsync);
+
 		// startStop2D will be called at each timestep
-		ierr = TSMonitorSet(ts, startStop2D, NULL, NULL);
+		ierr = TSMonitorSet(ts, startStop2D, NULL, finishStartStop2D);
 		checkPetscError(ierr,
 				"setupPetsc2DMonitor: TSMonitorSet (startStop2D) failed.");
 	}
@@ -20,12 +20,14 @@
 #include <MathUtils.h>
 #include "RandomNumberGenerator.h"
 #include "xolotlCore/io/XFile.h"
+#include "xolotlCore/io/CheckpointWriter.h"
 #include "xolotlSolver/monitor/Monitor.h"
 
 namespace xolotlSolver {
 
 // Declaration of the functions defined in Monitor.cpp
 extern PetscErrorCode checkTimeStep(TS ts);
+extern PetscErrorCode checkpointFailed();
 extern PetscErrorCode monitorTime(TS ts, PetscInt timestep, PetscReal time,
 		Vec solution, void *ictx);
 extern PetscErrorCode computeFluence(TS ts, PetscInt timestep, PetscReal time,
@@ -44,6 +46,8 @@ PetscReal hdf5Stride3D = 0.0;
 PetscInt hdf5Previous3D = 0;
 //! HDF5 output file name
 std::string hdf5OutputName3D = "xolotlStop.h5";
+//! The writer of the checkpoints in the HDF5 output file
+std::shared_ptr<xolotlCore::CheckpointWriter> checkpointWriter3D;
 //! The pointer to the 2D plot used in MonitorSurfaceXY3D.
 std::shared_ptr<xolotlViz::IPlot> surfacePlotXY3D;
 //! The pointer to the 2D plot used in MonitorSurfaceXZ3D.
@@ -72,12 +76,12 @@ std::vector<double> radii3D;
 #define __FUNCT__ Actual__FUNCT__("xolotlSolver", "startStop3D")
 /**
  * This is a monitoring method that will update an hdf5 file at each time step.
+ * The file is written in the background when the libraries allow it.
  */
 PetscErrorCode startStop3D(TS ts, PetscInt timestep, PetscReal time,
 		Vec solution, void *) {
 	// Initial declarations
 	PetscErrorCode ierr;
-	const double ****solutionArray, *gridPointSolution;
 	PetscInt xs, xm, Mx, ys, ym, My, zs, zm, Mz;
 
 	PetscFunctionBeginUser;
@@ -94,23 +98,11 @@ PetscErrorCode startStop3D(TS ts, PetscInt timestep, PetscReal time,
 	if ((int) ((time + dt / 10.0) / hdf5Stride3D) > hdf5Previous3D)
 		hdf5Previous3D++;
 
-	// Get the number of processes
-	int worldSize;
-	MPI_Comm_size(PETSC_COMM_WORLD, &worldSize);
-
-	// Gets the process ID (important when it is running in parallel)
-	int procId;
-	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
-
 	// Get the da from ts
 	DM da;
 	ierr = TSGetDM(ts, &da);
 	CHKERRQ(ierr);
 
-	// Get the solutionArray
-	ierr = DMDAVecGetArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
-
 	// Get the corners of the grid
 	ierr = DMDAGetCorners(da, &xs, &ys, &zs, &xm, &ym, &zm);
 	CHKERRQ(ierr);
@@ -129,10 +121,28 @@ PetscErrorCode startStop3D(TS ts, PetscInt timestep, PetscReal time,
 	// Network size
 	const int dof = network.getDOF();
 
-	// Create an array for the concentration
-	double concArray[dof][2];
+	// Get the current time step
+	double currentTimeStep;
+	ierr = TSGetTimeStep(ts, &currentTimeStep);
+	CHKERRQ(ierr);
+
+	// Copy the solution we own, after the previous checkpoint is written
+	double *buffer = nullptr;
+	try {
+		buffer = checkpointWriter3D->getBuffer(xm * ym * zm * dof);
+	} catch (...) {
+		ierr = checkpointFailed();
+		CHKERRQ(ierr);
+	}
+	const PetscScalar *solutionValues;
+	ierr = VecGetArrayRead(solution, &solutionValues);
+	CHKERRQ(ierr);
+	std::copy(solutionValues, solutionValues + xm * ym * zm * dof, buffer);
+	ierr = VecRestoreArrayRead(solution, &solutionValues);
+	CHKERRQ(ierr);
 
-	// Get the vector of positions of the surface
+	// Copy the surface data that will be written with it
+	const bool writeSurface = solverHandler.moveSurface();
 	std::vector<std::vector<int> > surfaceIndices;
 	for (PetscInt i = 0; i < My; i++) {
 		// Create a temporary vector
@@ -143,91 +153,65 @@ PetscErrorCode startStop3D(TS ts, PetscInt timestep, PetscReal time,
 		// Add the temporary vector to the vector of surface indices
 		surfaceIndices.push_back(temp);
 	}
-
-	// Open the existing HDF5 file.
-	xolotlCore::XFile checkpointFile(hdf5OutputName3D, PETSC_COMM_WORLD,
-			xolotlCore::XFile::AccessMode::OpenReadWrite);
-
-	// Get the current time step
-	double currentTimeStep;
-	ierr = TSGetTimeStep(ts, &currentTimeStep);
-	CHKERRQ(ierr);
-
-	// Add a concentration sub group
-	auto concGroup = checkpointFile.getGroup<
-			xolotlCore::XFile::ConcentrationGroup>();
-	assert(concGroup);
-	auto tsGroup = concGroup->addTimestepGroup(timestep, time, previousTime,
-			currentTimeStep);
-
-	if (solverHandler.moveSurface()) {
-		// Write the surface positions in the concentration sub group
-		tsGroup->writeSurface3D(surfaceIndices, nInterstitial3D,
-				previousIFlux3D);
+	const auto nInter = nInterstitial3D;
+	const auto previousIFlux = previousIFlux3D;
+
+	// Write the checkpoint, only for the grid points we own
+	xolotlCore::CheckpointWriter::Checkpoint checkpoint;
+	checkpoint.fileName = hdf5OutputName3D;
+	checkpoint.timeStep = timestep;
+	checkpoint.time = time;
+	checkpoint.previousTime = previousTime;
+	checkpoint.deltaTime = currentTimeStep;
+	checkpoint.dim = 3;
+	checkpoint.gridDims = { { (int) Mx, (int) My, (int) Mz } };
+	checkpoint.start = { { (int) xs, (int) ys, (int) zs } };
+	checkpoint.size = { { (int) xm, (int) ym, (int) zm } };
+	checkpoint.dof = dof;
+	checkpoint.format = solverHandler.getConcsFormat();
+	checkpoint.writeGroupData =
+			[=](xolotlCore::XFile::TimestepGroup& tsGroup) {
+				if (writeSurface) {
+					// Write the surface positions in the concentration sub group
+					tsGroup.writeSurface3D(surfaceIndices, nInter, previousIFlux);
+				}
+			};
+	try {
+		checkpointWriter3D->write(checkpoint);
+	} catch (...) {
+		ierr = checkpointFailed();
+		CHKERRQ(ierr);
 	}
 
-	// Loop on the full grid
-	for (PetscInt k = 0; k < Mz; k++) {
-		for (PetscInt j = 0; j < My; j++) {
-			for (PetscInt i = 0; i < Mx; i++) {
-				// Wait for all the processes
-				MPI_Barrier(PETSC_COMM_WORLD);
-
-				// Size of the concentration that will be stored
-				int concSize = -1;
-				// To save which proc has the information
-				int concId = 0;
-				// To know which process should write
-				bool write = false;
-
-				// If it is the locally owned part of the grid
-				if (i >= xs && i < xs + xm && j >= ys && j < ys + ym && k >= zs
-						&& k < zs + zm) {
-					write = true;
-					// Get the pointer to the beginning of the solution data for this grid point
-					gridPointSolution = solutionArray[k][j][i];
-
-					// Loop on the concentrations
-					for (int l = 0; l < dof; l++) {
-						if (std::fabs(gridPointSolution[l]) > 1.0e-16) {
-							// Increase concSize
-							concSize++;
-							// Fill the concArray
-							concArray[concSize][0] = (double) l;
-							concArray[concSize][1] = gridPointSolution[l];
-						}
-					}
-
-					// Increase concSize one last time
-					concSize++;
+	// Report the load imbalance since the previous checkpoint
+	solverHandler.reportLoadBalance(da, timestep);
 
-					// Save the procId
-					concId = procId;
-				}
-
-				// Get which processor will send the information
-				int concProc = 0;
-				MPI_Allreduce(&concId, &concProc, 1, MPI_INT, MPI_SUM,
-						PETSC_COMM_WORLD);
+	PetscFunctionReturn(0);
+}
 
-				// Broadcast the size
-				MPI_Bcast(&concSize, 1, MPI_INT, concProc, PETSC_COMM_WORLD);
+#undef __FUNCT__
+#define __FUNCT__ Actual__FUNCT__("xolotlSolver", "finishStartStop3D")
+/**
+ * This method waits for the last checkpoint when the startStop3D monitor
+ * is destroyed with the TS.
+ */
+PetscErrorCode finishStartStop3D(void **) {
+	// Initial declaration
+	PetscErrorCode ierr;
 
-				// Skip the grid point if the size is 0
-				if (concSize == 0)
-					continue;
+	PetscFunctionBeginUser;
 
-				// All processes create the dataset and fill it
-				tsGroup->writeConcentrationDataset(concSize, concArray, write, i, j,
-						k);
-			}
+	// Release the writer even if its last checkpoint failed
+	auto writer = std::move(checkpointWriter3D);
+	if (writer) {
+		try {
+			writer->wait();
+		} catch (...) {
+			ierr = checkpointFailed();
+			CHKERRQ(ierr);
 		}
 	}
 
-	// Restore the solutionArray
-	ierr = DMDAVecRestoreArrayDOFRead(da, solution, &solutionArray);
-	CHKERRQ(ierr);
-
 	PetscFunctionReturn(0);
 }
 
@@ -1775,8 +1759,17 @@ PetscErrorCode setupPetsc3DMonitor(TS ts) {
 					hdf5OutputName3D, network);
 		}
 
+		// Check if the checkpoints should be written in the background
+		PetscBool flagAsync = PETSC_FALSE;
+		ierr = PetscOptionsHasName(NULL, NULL, "-start_stop_async",
+				&flagAsync);
+		checkPetscError(ierr,
+				"setupPetsc3DMonitor: PetscOptionsHasName (-start_stop_async) failed.");
+		checkpointWriter3D = std::make_shared<xolotlCore::CheckpointWriter>(
+				PETSC_COMM_WORLD, flagAsync);
+
 		// startStop3D will be called at each timestep
-		ierr = TSMonitorSet(ts, startStop3D, NULL, NULL);
+		ierr = TSMonitorSet(ts, startStop3D, NULL, finishStartStop3D);
 		checkPetscError(ierr,
 				"setupPetsc3DMonitor: TSMonitorSet (startStop3D) failed.");
 	}
@@ -213,13 +213,6 @@ void PetscSolver0DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 		lastTemperature[0] = temperature;
 	}
 
-	// Copy data into the ReactionNetwork so that it can
-	// compute the fluxes properly. The network is only used to compute the
-	// fluxes and hold the state data from the last time step. I'm reusing
-	// it because it cuts down on memory significantly (about 400MB per
-	// grid point) at the expense of being a little tricky to comprehend.
-	network.updateConcentrationsFromArray(concOffset);
-
 	// ----- Account for flux of incoming particles -----
 	fluxHandler->computeIncidentFlux(ftime, updatedConcOffset, 0, 0);
 
@@ -228,7 +221,7 @@ void PetscSolver0DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 			0, 0);
 
 	// ----- Compute the reaction fluxes over the locally owned part of the grid -----
-	network.computeAllFluxes(updatedConcOffset);
+	network.computeAllFluxes(concOffset, updatedConcOffset);
 
 	/*
 	 Restore vectors
@@ -296,15 +289,11 @@ void PetscSolver0DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 		lastTemperature[0] = temperature;
 	}
 
-	// Copy data into the ReactionNetwork so that it can
-	// compute the new concentrations.
-	network.updateConcentrationsFromArray(concOffset);
-
 	// ----- Take care of the reactions for all the reactants -----
 
 	// Compute all the partial derivatives for the reactions
-	network.computeAllPartials(reactionStartingIdx, reactionIndices,
-			reactionVals);
+	network.computeAllPartials(concOffset, reactionStartingIdx,
+			reactionIndices, reactionVals);
 
 	// Update the column in the Jacobian that represents each DOF
 	for (int i = 0; i < dof - 1; i++) {
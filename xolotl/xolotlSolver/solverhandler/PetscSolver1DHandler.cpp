@@ -16,20 +16,10 @@ void PetscSolver1DHandler::createSolverContext(DM &da) {
 	// Degrees of freedom is the total number of clusters in the network
 	const int dof = network.getDOF();
 
-	/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-	 Create distributed array (DMDA) to manage parallel grid and vectors
-	 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
-
-	ierr = DMDACreate1d(PETSC_COMM_WORLD, DM_BOUNDARY_MIRROR, nX, dof, 1,
-	NULL, &da);
-	checkPetscError(ierr, "PetscSolver1DHandler::createSolverContext: "
-			"DMDACreate1d failed.");
-	ierr = DMSetFromOptions(da);
-	checkPetscError(ierr,
-			"PetscSolver1DHandler::createSolverContext: DMSetFromOptions failed.");
-	ierr = DMSetUp(da);
-	checkPetscError(ierr,
-			"PetscSolver1DHandler::createSolverContext: DMSetUp failed.");
+	// Start from the whole grid if a previous context left grid points out
+	// of the active window
+	nX += windowStart;
+	windowStart = 0;
 
 	// Set the position of the surface
 	surfacePosition = 0;
@@ -53,13 +43,66 @@ void PetscSolver1DHandler::createSolverContext(DM &da) {
 		}
 	}
 
+	// Leave the vacuum out of the solved grid, except for a buffer where the
+	// surface can move up, if asked
+	int procId;
+	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+	PetscBool flagWindow = PETSC_FALSE;
+	PetscInt buffer = 10;
+	ierr = PetscOptionsGetInt(NULL, NULL, "-active_window", &buffer,
+			&flagWindow);
+	checkPetscError(ierr, "PetscSolver1DHandler::createSolverContext: "
+			"PetscOptionsGetInt (-active_window) failed.");
+	if (flagWindow) {
+		// The options already checked that the window can be used: the
+		// checkpoints are written on the whole grid in the dense format, the
+		// grid points before the window are simply not written
+		if (!movingSurface || !concsFormat.dense)
+			throw std::string("\nxolotlSolver::PetscSolver1DHandler: "
+					"-active_window needs the movingSurface process and "
+					"concFormat=dense.");
+		if (buffer < 0)
+			throw std::string("\nxolotlSolver::PetscSolver1DHandler: "
+					"the -active_window buffer cannot be negative.");
+
+		windowStart = std::max(surfacePosition - (int) buffer, 0);
+		grid.erase(grid.begin(), grid.begin() + windowStart);
+		nX -= windowStart;
+		surfacePosition -= windowStart;
+
+		if (procId == 0)
+			std::cout << "Solving " << nX << " grid points, the first "
+					<< windowStart << " are vacuum left out of the "
+							"active window." << std::endl;
+	}
+
+	/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	 Create distributed array (DMDA) to manage parallel grid and vectors
+	 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+	// Use the ownership ranges balancing the cost of a previous run if given
+	std::vector<std::vector<PetscInt> > ranges;
+	bool balanced = readOwnershipRanges( { nX }, ranges);
+
+	ierr = DMDACreate1d(PETSC_COMM_WORLD, DM_BOUNDARY_MIRROR, nX, dof, 1,
+			balanced ? ranges[0].data() : NULL, &da);
+	checkPetscError(ierr, "PetscSolver1DHandler::createSolverContext: "
+			"DMDACreate1d failed.");
+	ierr = DMSetFromOptions(da);
+	checkPetscError(ierr,
+			"PetscSolver1DHandler::createSolverContext: DMSetFromOptions failed.");
+	ierr = DMSetUp(da);
+	checkPetscError(ierr,
+			"PetscSolver1DHandler::createSolverContext: DMSetUp failed.");
+
+	// Measure the cost of the grid points if asked
+	initializeLoadBalance(da);
+
 	// Initialize the surface of the first advection handler corresponding to the
 	// advection toward the surface (or a dummy one if it is deactivated)
 	advectionHandlers[0]->setLocation(grid[surfacePosition + 1] - grid[1]);
 
 	// Prints the grid on one process
-	int procId;
-	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
 	if (procId == 0) {
 		for (int i = 1; i < grid.size() - 1; i++) {
 			std::cout << grid[i + 1] - grid[surfacePosition + 1] << " ";
@@ -102,8 +145,11 @@ void PetscSolver1DHandler::createSolverContext(DM &da) {
 	// because it adds connectivity
 	resolutionHandler->initialize(network, electronicStoppingPower);
 
-	// Get the diagonal fill
-	network.getDiagonalFill(dfill);
+	// Get the diagonal fill of the reactions
+	initializeReactionFill(dfill);
+
+	// Check which parts of the Jacobian are kept between evaluations
+	initializeJacobianReuse();
 
 	// Load up the block fills
 	auto ofillsparse = ConvertToPetscSparseFillMap(dof, ofill);
@@ -121,7 +167,6 @@ void PetscSolver1DHandler::createSolverContext(DM &da) {
 	reactionIndices.resize(nPartials);
 	network.initPartialsIndices(reactionSize, reactionStartingIdx,
 			reactionIndices);
-	reactionVals.resize(nPartials);
 
 	return;
 }
@@ -214,10 +259,17 @@ void PetscSolver1DHandler::initializeConcentration(DM &da, Vec &C) {
 		assert(concGroup);
 		auto tsGroup = concGroup->getLastTimestepGroup();
 		assert(tsGroup);
-		auto myConcs = tsGroup->readConcentrations(*xfile, xs, xm);
+		// They were written on the whole grid
+		auto myConcs = tsGroup->readConcentrations(*xfile, xs + windowStart,
+				xm);
 
 		// Apply the concentrations we just read.
 		for (auto i = 0; i < xm; ++i) {
+			// The grid points that were left out of the active window
+			// were not written
+			if (myConcs[i].empty())
+				continue;
+
 			concOffset = concentrations[xs + i];
 
 			for (auto const& currConcData : myConcs[i]) {
@@ -226,9 +278,6 @@ void PetscSolver1DHandler::initializeConcentration(DM &da, Vec &C) {
 			// Set the temperature in the network
 			double temp = myConcs[i][myConcs[i].size() - 1].second;
 			network.setTemperature(temp, i);
-			// Update the modified trap-mutation rate
-			// that depends on the network reaction rates
-			mutationHandler->updateTrapMutationRate(network);
 			lastTemperature[i] = temp;
 		}
 	}
@@ -314,22 +363,25 @@ void PetscSolver1DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 	mutationHandler->updateDisappearingRate(totalAtomConc);
 
 	// Declarations for variables used in the loop
-	double **concVector = new double*[3];
 	xolotlCore::Point<3> gridPosition { 0.0, 0.0, 0.0 };
+	std::vector<PetscInt> points;
+	std::vector<bool> isComputed(xm + 2, false);
 
-	// Loop over grid points computing ODE terms for each grid point
+	// What modifies the network or the handlers is done serially first,
+	// the temperature of each grid point is set once and only read after
 	for (PetscInt xi = xs; xi < xs + xm; xi++) {
 		// Compute the old and new array offsets
 		concOffset = concs[xi];
 		updatedConcOffset = updatedConcs[xi];
 
-		// Fill the concVector with the pointer to the middle, left, and right grid points
-		concVector[0] = concOffset; // middle
-		concVector[1] = concs[xi - 1]; // left
-		concVector[2] = concs[xi + 1]; // right
-
 		// Heat condition
 		if (xi == surfacePosition) {
+			// Fill the concVector with the pointer to the middle, left, and right grid points
+			double *concVector[3];
+			concVector[0] = concOffset; // middle
+			concVector[1] = concs[xi - 1]; // left
+			concVector[2] = concs[xi + 1]; // right
+
 			temperatureHandler->computeTemperature(concVector,
 					updatedConcOffset, grid[xi + 1] - grid[xi],
 					grid[xi + 2] - grid[xi + 1], xi);
@@ -351,47 +403,54 @@ void PetscSolver1DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 		if (skip)
 			continue;
 
-		// Update the network if the temperature changed
-		// left
-		double temperature = concs[xi - 1][dof - 1];
-		if (std::fabs(lastTemperature[xi - xs] - temperature) > 0.1) {
-			network.setTemperature(temperature, xi - xs);
-			lastTemperature[xi - xs] = temperature;
-		}
-		// right
-		temperature = concs[xi + 1][dof - 1];
-		if (std::fabs(lastTemperature[xi + 2 - xs] - temperature) > 0.1) {
-			network.setTemperature(temperature, xi + 2 - xs);
-			lastTemperature[xi + 2 - xs] = temperature;
-		}
-
 		// Set the grid fraction
 		gridPosition[0] = (grid[xi + 1] - grid[surfacePosition + 1])
 				/ (grid[grid.size() - 1] - grid[surfacePosition + 1]);
 
-		// Get the temperature from the temperature handler
+		// Update the network if the temperature from the temperature
+		// handler changed
 		temperatureHandler->setTemperature(concOffset);
-		temperature = temperatureHandler->getTemperature(gridPosition, ftime);
-		// middle
-		if (std::fabs(lastTemperature[xi + 1 - xs] - temperature) > 0.1) {
-			network.setTemperature(temperature, xi + 1 - xs);
-			// Update the modified trap-mutation rate
-			// that depends on the network reaction rates
-			mutationHandler->updateTrapMutationRate(network);
-			lastTemperature[xi + 1 - xs] = temperature;
-		}
-
-		// Copy data into the ReactionNetwork so that it can
-		// compute the fluxes properly. The network is only used to compute the
-		// fluxes and hold the state data from the last time step. I'm reusing
-		// it because it cuts down on memory significantly (about 400MB per
-		// grid point) at the expense of being a little tricky to comprehend.
-		network.updateConcentrationsFromArray(concOffset);
+		updateTemperature(
+				temperatureHandler->getTemperature(gridPosition, ftime),
+				xi + 1 - xs);
+		isComputed[xi + 1 - xs] = true;
 
 		// ----- Account for flux of incoming particles -----
 		fluxHandler->computeIncidentFlux(ftime, updatedConcOffset, xi,
 				surfacePosition);
 
+		// The rest is computed in parallel
+		points.push_back(xi);
+	}
+
+	// The neighbors that are not computed here take the temperature
+	// of the solution
+	for (auto xi : points) {
+		// left
+		if (!isComputed[xi - xs])
+			updateTemperature(concs[xi - 1][dof - 1], xi - xs);
+		// right
+		if (!isComputed[xi + 2 - xs])
+			updateTemperature(concs[xi + 1][dof - 1], xi + 2 - xs);
+	}
+
+	// Loop over grid points computing ODE terms for each grid point, each
+	// thread only uses its own views of the concentrations
+	const int nPoints = points.size();
+#pragma omp parallel for if (getNumberOfThreads() > 1)
+	for (int p = 0; p < nPoints; p++) {
+		const PetscInt xi = points[p];
+		auto costStart = startPointCost();
+		PetscScalar *concOffset = concs[xi];
+		PetscScalar *updatedConcOffset = updatedConcs[xi];
+		xolotlCore::Point<3> threadPosition = gridPosition;
+
+		// Fill the concVector with the pointer to the middle, left, and right grid points
+		double *concVector[3];
+		concVector[0] = concOffset; // middle
+		concVector[1] = concs[xi - 1]; // left
+		concVector[2] = concs[xi + 1]; // right
+
 		// ---- Compute the temperature over the locally owned part of the grid -----
 		temperatureHandler->computeTemperature(concVector, updatedConcOffset,
 				grid[xi + 1] - grid[xi], grid[xi + 2] - grid[xi + 1], xi);
@@ -403,9 +462,9 @@ void PetscSolver1DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 
 		// ---- Compute advection over the locally owned part of the grid -----
 		// Set the grid position
-		gridPosition[0] = grid[xi + 1] - grid[1];
+		threadPosition[0] = grid[xi + 1] - grid[1];
 		for (int i = 0; i < advectionHandlers.size(); i++) {
-			advectionHandlers[i]->computeAdvection(network, gridPosition,
+			advectionHandlers[i]->computeAdvection(network, threadPosition,
 					concVector, updatedConcOffset, grid[xi + 1] - grid[xi],
 					grid[xi + 2] - grid[xi + 1], xi, xs);
 		}
@@ -419,7 +478,9 @@ void PetscSolver1DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 				updatedConcOffset, xi, xs);
 
 		// ----- Compute the reaction fluxes over the locally owned part of the grid -----
-		network.computeAllFluxes(updatedConcOffset, xi + 1 - xs);
+		network.computeAllFluxes(concOffset, updatedConcOffset, xi + 1 - xs);
+
+		addPointCost(xi - xs, costStart);
 	}
 
 	/*
@@ -435,9 +496,6 @@ void PetscSolver1DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 	checkPetscError(ierr, "PetscSolver1DHandler::updateConcentration: "
 			"DMRestoreLocalVector failed.");
 
-	// Clear memory
-	delete[] concVector;
-
 	return;
 }
 
@@ -732,8 +790,18 @@ void PetscSolver1DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 
 	// Declarations for variables used in the loop
 	xolotlCore::Point<3> gridPosition { 0.0, 0.0, 0.0 };
+	std::vector<PetscInt> points;
+
+	// Make sure each thread has its partials array
+	threadReactionVals.resize(getNumberOfThreads(),
+			std::vector<PetscScalar>(reactionIndices.size(), 0.0));
+
+	// Get the values of the Jacobian to add the reaction partials directly
+	PetscScalar *diagValues = getDiagonalValues(J);
+	reactionPoints.clear();
 
-	// Loop over the grid points
+	// Update the temperature of each grid point serially first
+	std::vector<double> temperatures(xm, 0.0);
 	for (PetscInt xi = xs; xi < xs + xm; xi++) {
 		// Boundary conditions
 		// Everything to the left of the surface is empty
@@ -754,55 +822,82 @@ void PetscSolver1DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 		gridPosition[0] = (grid[xi + 1] - grid[surfacePosition + 1])
 				/ (grid[grid.size() - 1] - grid[surfacePosition + 1]);
 
-		// Get the temperature from the temperature handler
+		// Update the network if the temperature from the temperature
+		// handler changed
 		concOffset = concs[xi];
 		temperatureHandler->setTemperature(concOffset);
-		double temperature = temperatureHandler->getTemperature(gridPosition,
-				ftime);
+		temperatures[xi - xs] = temperatureHandler->getTemperature(
+				gridPosition, ftime);
+		updateTemperature(temperatures[xi - xs], xi + 1 - xs);
 
-		// Update the network if the temperature changed
-		if (std::fabs(lastTemperature[xi + 1 - xs] - temperature) > 0.1) {
-			network.setTemperature(temperature, xi + 1 - xs);
-			// Update the modified trap-mutation rate
-			// that depends on the network reaction rates
-			mutationHandler->updateTrapMutationRate(network);
-			lastTemperature[xi + 1 - xs] = temperature;
-		}
+		points.push_back(xi);
+		reactionPoints.emplace_back(xi - xs, xi + 1 - xs);
+	}
 
-		// Copy data into the ReactionNetwork so that it can
-		// compute the new concentrations.
-		network.updateConcentrationsFromArray(concOffset);
+	// Use the reaction partials of the previous evaluations if they are
+	// lagged and the temperatures did not change
+	const bool lagged = lagReactionPartials(temperatures);
+
+	// ----- Take care of the reactions for all the reactants -----
+
+	// Compute all the partial derivatives for the reactions in parallel when
+	// they are added directly in the Jacobian or kept, otherwise they are
+	// computed below one grid point at a time
+	const bool threadedPartials = diagValues || reactionJacobianLag > 1;
+	const int nPoints = points.size();
+	if (threadedPartials) {
+#pragma omp parallel for if (getNumberOfThreads() > 1)
+		for (int p = 0; p < nPoints; p++) {
+			const PetscInt xi = points[p];
+			auto costStart = startPointCost();
+			auto& vals = getReactionVals(xi - xs);
+			if (!lagged)
+				network.computeAllPartials(concs[xi], reactionStartingIdx,
+						reactionIndices, vals, xi + 1 - xs);
+			if (diagValues)
+				addReactionPartials(diagValues, xi - xs, vals);
+
+			addPointCost(xi - xs, costStart);
+		}
+	}
 
-		// ----- Take care of the reactions for all the reactants -----
+	// Set the other partial derivatives in the Jacobian, one grid point at a time
+	for (int p = 0; p < nPoints; p++) {
+		const PetscInt xi = points[p];
 
-		// Compute all the partial derivatives for the reactions
-		network.computeAllPartials(reactionStartingIdx, reactionIndices,
-				reactionVals, xi + 1 - xs);
+		// Otherwise set the reaction ones row by row
+		if (!diagValues) {
+			auto& vals = getReactionVals(xi - xs);
+			if (!threadedPartials)
+				network.computeAllPartials(concs[xi], reactionStartingIdx,
+						reactionIndices, vals, xi + 1 - xs);
 
-		// Update the column in the Jacobian that represents each DOF
-		for (int i = 0; i < dof - 1; i++) {
-			// Set grid coordinate and component number for the row
-			rowId.i = xi;
-			rowId.c = i;
-
-			// Number of partial derivatives
-			pdColIdsVectorSize = reactionSize[i];
-			auto startingIdx = reactionStartingIdx[i];
-
-			// Loop over the list of column ids
-			for (int j = 0; j < pdColIdsVectorSize; j++) {
-				// Set grid coordinate and component number for a column in the list
-				colIds[j].i = xi;
-				colIds[j].c = reactionIndices[startingIdx + j];
-				// Get the partial derivative from the array of all of the partials
-				reactingPartialsForCluster[j] = reactionVals[startingIdx + j];
+			// Update the column in the Jacobian that represents each DOF
+			for (int i = 0; i < dof - 1; i++) {
+				// Set grid coordinate and component number for the row
+				rowId.i = xi;
+				rowId.c = i;
+
+				// Number of partial derivatives
+				pdColIdsVectorSize = reactionSize[i];
+				auto startingIdx = reactionStartingIdx[i];
+
+				// Loop over the list of column ids
+				for (int j = 0; j < pdColIdsVectorSize; j++) {
+					// Set grid coordinate and component number for a column in the list
+					colIds[j].i = xi;
+					colIds[j].c = reactionIndices[startingIdx + j];
+					// Get the partial derivative from the array of all of the partials
+					reactingPartialsForCluster[j] =
+							vals[startingIdx + j];
+				}
+				// Update the matrix
+				ierr = MatSetValuesStencil(J, 1, &rowId, pdColIdsVectorSize, colIds,
+						reactingPartialsForCluster.data(), ADD_VALUES);
+				checkPetscError(ierr,
+						"PetscSolver1DHandler::computeDiagonalJacobian: "
+								"MatSetValuesStencil (reactions) failed.");
 			}
-			// Update the matrix
-			ierr = MatSetValuesStencil(J, 1, &rowId, pdColIdsVectorSize, colIds,
-					reactingPartialsForCluster.data(), ADD_VALUES);
-			checkPetscError(ierr,
-					"PetscSolver1DHandler::computeDiagonalJacobian: "
-							"MatSetValuesStencil (reactions) failed.");
 		}
 
 		// ----- Take care of the modified trap-mutation for all the reactants -----
@@ -818,7 +913,7 @@ void PetscSolver1DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 
 		// Compute the partial derivative from modified trap-mutation at this grid point
 		int nMutating = mutationHandler->computePartialsForTrapMutation(network,
-				mutationVals, mutationIndices, xi, xs);
+				concs[xi], mutationVals, mutationIndices, xi, xs);
 
 		// Loop on the number of helium undergoing trap-mutation to set the values
 		// in the Jacobian
@@ -950,6 +1045,9 @@ void PetscSolver1DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 		}
 	}
 
+	// Give back the values of the Jacobian
+	restoreDiagonalValues(J, diagValues);
+
 	/*
 	 Restore vectors
 	 */
@@ -81,6 +81,7 @@ public:
 	 */
 	void setSurfacePosition(int pos, int j = -1, int k = -1) {
 		surfacePosition = pos;
+		surfaceMoves++;
 
 		return;
 	}
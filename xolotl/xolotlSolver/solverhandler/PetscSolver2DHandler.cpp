@@ -17,9 +17,16 @@ void PetscSolver2DHandler::createSolverContext(DM &da) {
 	 Create distributed array (DMDA) to manage parallel grid and vectors
 	 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
+	// Use the ownership ranges balancing the cost of a previous run if given
+	std::vector<std::vector<PetscInt> > ranges;
+	bool balanced = readOwnershipRanges( { nX, nY }, ranges);
+
 	ierr = DMDACreate2d(PETSC_COMM_WORLD, DM_BOUNDARY_MIRROR,
-			DM_BOUNDARY_PERIODIC, DMDA_STENCIL_STAR, nX, nY, PETSC_DECIDE,
-			PETSC_DECIDE, dof, 1, NULL, NULL, &da);
+			DM_BOUNDARY_PERIODIC, DMDA_STENCIL_STAR, nX, nY,
+			balanced ? (PetscInt) ranges[0].size() : PETSC_DECIDE,
+			balanced ? (PetscInt) ranges[1].size() : PETSC_DECIDE, dof, 1,
+			balanced ? ranges[0].data() : NULL,
+			balanced ? ranges[1].data() : NULL, &da);
 	checkPetscError(ierr, "PetscSolver2DHandler::createSolverContext: "
 			"DMDACreate2d failed.");
 	ierr = DMSetFromOptions(da);
@@ -29,6 +36,9 @@ void PetscSolver2DHandler::createSolverContext(DM &da) {
 	checkPetscError(ierr,
 			"PetscSolver2DHandler::createSolverContext: DMSetUp failed.");
 
+	// Measure the cost of the grid points if asked
+	initializeLoadBalance(da);
+
 	// Set the position of the surface
 	for (int j = 0; j < nY; j++) {
 		surfacePosition.push_back(0);
@@ -108,8 +118,11 @@ void PetscSolver2DHandler::createSolverContext(DM &da) {
 	// because it adds connectivity
 	resolutionHandler->initialize(network, electronicStoppingPower);
 
-	// Get the diagonal fill
-	network.getDiagonalFill(dfill);
+	// Get the diagonal fill of the reactions
+	initializeReactionFill(dfill);
+
+	// Check which parts of the Jacobian are kept between evaluations
+	initializeJacobianReuse();
 
 	// Load up the block fills
 	auto dfillsparse = ConvertToPetscSparseFillMap(dof, dfill);
@@ -127,7 +140,6 @@ void PetscSolver2DHandler::createSolverContext(DM &da) {
 	reactionIndices.resize(nPartials);
 	network.initPartialsIndices(reactionSize, reactionStartingIdx,
 			reactionIndices);
-	reactionVals.resize(nPartials);
 
 	return;
 }
@@ -153,6 +165,9 @@ void PetscSolver2DHandler::initializeConcentration(DM &da, Vec &C) {
 	}
 	network.addGridPoints(xm + 2);
 
+	// The processes owning the same rows share the concentration near the surface
+	initializeSurfaceComm(ys, ym);
+
 	// Get the last time step written in the HDF5 file
 	bool hasConcentrations = false;
 	std::unique_ptr<xolotlCore::XFile> xfile;
@@ -222,28 +237,31 @@ void PetscSolver2DHandler::initializeConcentration(DM &da, Vec &C) {
 		auto tsGroup = concGroup->getLastTimestepGroup();
 		assert(tsGroup);
 
-		// Loop on the full grid
-		for (PetscInt j = 0; j < nY; j++) {
-			for (PetscInt i = 0; i < nX; i++) {
-				// Read the concentrations from the HDF5 file
-				auto concVector = tsGroup->readGridPoint(i, j);
-
-				// Change the concentration only if we are on the locally owned part of the grid
-				if (i >= xs && i < xs + xm && j >= ys && j < ys + ym) {
-					concOffset = concentrations[j][i];
-					// Loop on the concVector size
-					for (unsigned int l = 0; l < concVector.size(); l++) {
-						concOffset[(int) concVector.at(l).at(0)] =
-								concVector.at(l).at(1);
-					}
-					// Set the temperature in the network
-					double temp = concVector.at(concVector.size() - 1).at(1);
-					network.setTemperature(temp, i - xs);
-					// Update the modified trap-mutation rate
-					// that depends on the network reaction rates
-					mutationHandler->updateTrapMutationRate(network);
-					lastTemperature[i - xs] = temp;
-				}
+		// Read the concentrations of the grid points we own
+		std::vector<std::array<int, 3> > positions;
+		for (PetscInt j = ys; j < ys + ym; j++) {
+			for (PetscInt i = xs; i < xs + xm; i++) {
+				positions.push_back( { { (int) i, (int) j, -1 } });
+			}
+		}
+		auto myConcs = tsGroup->readConcentrationDatasets(positions);
+
+		// Apply the concentrations we just read
+		for (auto n = 0; n < positions.size(); ++n) {
+			if (myConcs[n].empty())
+				continue;
+
+			const int i = positions[n][0], j = positions[n][1];
+			concOffset = concentrations[j][i];
+			for (auto const& currConcData : myConcs[n]) {
+				concOffset[currConcData.first] = currConcData.second;
+			}
+			// Set the temperature in the network, only once for
+			// each temperature because it changes with depth only
+			double temp = myConcs[n].back().second;
+			if (temp != lastTemperature[i - xs]) {
+				network.setTemperature(temp, i - xs);
+				lastTemperature[i - xs] = temp;
 			}
 		}
 	}
@@ -297,52 +315,28 @@ void PetscSolver2DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 	double sy = 1.0 / (hY * hY);
 
 	// Declarations for variables used in the loop
-	double **concVector = new double*[5];
 	xolotlCore::Point<3> gridPosition { 0.0, 0.0, 0.0 };
+	std::vector<PetscInt> points;
+	std::vector<bool> isComputed;
 	std::vector<double> incidentFluxVector;
-	double atomConc = 0.0, totalAtomConc = 0.0;
 
 	// Degrees of freedom is the total number of clusters in the network
 	const int dof = network.getDOF();
 
+	// Compute the total concentration of atoms contained in bubbles
+	// near the surface for each local row
+	computeTrappedAtomConc(concs, xs, xm, ys, ym);
+
 	// Loop over grid points
 	for (PetscInt yj = bottomOffset; yj < nY - topOffset; yj++) {
 
-		// Compute the total concentration of atoms contained in bubbles
-		atomConc = 0.0;
-
-		// Loop over grid points
-		for (int xi = surfacePosition[yj] + leftOffset; xi < nX - rightOffset;
-				xi++) {
-			// We are only interested in the helium near the surface
-			if (grid[xi + 1] - grid[surfacePosition[yj] + 1] > 2.0)
-				continue;
-
-			// Check if we are on the right processor
-			if (xi >= xs && xi < xs + xm && yj >= ys && yj < ys + ym) {
-				// Get the concentrations at this grid point
-				concOffset = concs[yj][xi];
-				// Copy data into the PSIClusterReactionNetwork
-				network.updateConcentrationsFromArray(concOffset);
-
-				// Sum the total atom concentration
-				atomConc += network.getTotalTrappedAtomConcentration()
-						* (grid[xi + 1] - grid[xi]);
-			}
-		}
-
-		// Share the concentration with all the processes
-		totalAtomConc = 0.0;
-		MPI_Allreduce(&atomConc, &totalAtomConc, 1, MPI_DOUBLE, MPI_SUM,
-				MPI_COMM_WORLD);
-
-		// Set the disappearing rate in the modified TM handler
-		mutationHandler->updateDisappearingRate(totalAtomConc);
-
 		// Skip if we are not on the right process
 		if (yj < ys || yj >= ys + ym)
 			continue;
 
+		// Set the disappearing rate in the modified TM handler
+		mutationHandler->updateDisappearingRate(totalAtomConc[yj - ys]);
+
 		// Set the grid position
 		gridPosition[1] = yj * hY;
 
@@ -353,20 +347,25 @@ void PetscSolver2DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 				grid[surfacePosition[yj] + 1] - grid[1]);
 		temperatureHandler->updateSurfacePosition(surfacePosition[yj]);
 
+		// What modifies the network or the handlers is done serially first,
+		// the temperature of each grid point is set once and only read after
+		points.clear();
+		isComputed.assign(xm + 2, false);
 		for (PetscInt xi = xs; xi < xs + xm; xi++) {
 			// Compute the old and new array offsets
 			concOffset = concs[yj][xi];
 			updatedConcOffset = updatedConcs[yj][xi];
 
-			// Fill the concVector with the pointer to the middle, left, right, bottom, and top grid points
-			concVector[0] = concOffset; // middle
-			concVector[1] = concs[yj][xi - 1]; // left
-			concVector[2] = concs[yj][xi + 1]; // right
-			concVector[3] = concs[yj - 1][xi]; // bottom
-			concVector[4] = concs[yj + 1][xi]; // top
-
 			// Heat condition
 			if (xi == surfacePosition[yj]) {
+				// Fill the concVector with the pointer to the middle, left, right, bottom, and top grid points
+				double *concVector[5];
+				concVector[0] = concOffset; // middle
+				concVector[1] = concs[yj][xi - 1]; // left
+				concVector[2] = concs[yj][xi + 1]; // right
+				concVector[3] = concs[yj - 1][xi]; // bottom
+				concVector[4] = concs[yj + 1][xi]; // top
+
 				temperatureHandler->computeTemperature(concVector,
 						updatedConcOffset, grid[xi + 1] - grid[xi],
 						grid[xi + 2] - grid[xi + 1], xi, sy, yj);
@@ -390,48 +389,55 @@ void PetscSolver2DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 			if (skip)
 				continue;
 
-			// Update the network if the temperature changed
-			// left
-			double temperature = concs[yj][xi - 1][dof - 1];
-			if (std::fabs(lastTemperature[xi - xs] - temperature) > 0.1) {
-				network.setTemperature(temperature, xi - xs);
-				lastTemperature[xi - xs] = temperature;
-			}
-			// right
-			temperature = concs[yj][xi + 1][dof - 1];
-			if (std::fabs(lastTemperature[xi + 2 - xs] - temperature) > 0.1) {
-				network.setTemperature(temperature, xi + 2 - xs);
-				lastTemperature[xi + 2 - xs] = temperature;
-			}
-
 			// Set the grid fraction
 			gridPosition[0] = (grid[xi + 1] - grid[surfacePosition[yj] + 1])
 					/ (grid[grid.size() - 1] - grid[surfacePosition[yj] + 1]);
 
-			// Get the temperature from the temperature handler
+			// Update the network if the temperature from the temperature
+			// handler changed
 			temperatureHandler->setTemperature(concOffset);
-			temperature = temperatureHandler->getTemperature(gridPosition,
-					ftime);
-			// middle
-			if (std::fabs(lastTemperature[xi + 1 - xs] - temperature) > 0.1) {
-				network.setTemperature(temperature, xi + 1 - xs);
-				// Update the modified trap-mutation rate
-				// that depends on the network reaction rates
-				mutationHandler->updateTrapMutationRate(network);
-				lastTemperature[xi + 1 - xs] = temperature;
-			}
-
-			// Copy data into the ReactionNetwork so that it can
-			// compute the fluxes properly. The network is only used to compute the
-			// fluxes and hold the state data from the last time step. I'm reusing
-			// it because it cuts down on memory significantly (about 400MB per
-			// grid point) at the expense of being a little tricky to comprehend.
-			network.updateConcentrationsFromArray(concOffset);
+			updateTemperature(
+					temperatureHandler->getTemperature(gridPosition, ftime),
+					xi + 1 - xs);
+			isComputed[xi + 1 - xs] = true;
 
 			// ----- Account for flux of incoming particles -----
 			fluxHandler->computeIncidentFlux(ftime, updatedConcOffset, xi,
 					surfacePosition[yj]);
 
+			// The rest is computed in parallel
+			points.push_back(xi);
+		}
+
+		// The neighbors that are not computed here take the temperature
+		// of the solution
+		for (auto xi : points) {
+			// left
+			if (!isComputed[xi - xs])
+				updateTemperature(concs[yj][xi - 1][dof - 1], xi - xs);
+			// right
+			if (!isComputed[xi + 2 - xs])
+				updateTemperature(concs[yj][xi + 1][dof - 1], xi + 2 - xs);
+		}
+
+		// Each thread only uses its own views of the concentrations
+		const int nPoints = points.size();
+#pragma omp parallel for if (getNumberOfThreads() > 1)
+		for (int p = 0; p < nPoints; p++) {
+			const PetscInt xi = points[p];
+			auto costStart = startPointCost();
+			PetscScalar *concOffset = concs[yj][xi];
+			PetscScalar *updatedConcOffset = updatedConcs[yj][xi];
+			xolotlCore::Point<3> threadPosition = gridPosition;
+
+			// Fill the concVector with the pointer to the middle, left, right, bottom, and top grid points
+			double *concVector[5];
+			concVector[0] = concOffset; // middle
+			concVector[1] = concs[yj][xi - 1]; // left
+			concVector[2] = concs[yj][xi + 1]; // right
+			concVector[3] = concs[yj - 1][xi]; // bottom
+			concVector[4] = concs[yj + 1][xi]; // top
+
 			// ---- Compute the temperature over the locally owned part of the grid -----
 			temperatureHandler->computeTemperature(concVector,
 					updatedConcOffset, grid[xi + 1] - grid[xi],
@@ -444,9 +450,9 @@ void PetscSolver2DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 
 			// ---- Compute advection over the locally owned part of the grid -----
 			// Set the grid position
-			gridPosition[0] = grid[xi + 1] - grid[1];
+			threadPosition[0] = grid[xi + 1] - grid[1];
 			for (int i = 0; i < advectionHandlers.size(); i++) {
-				advectionHandlers[i]->computeAdvection(network, gridPosition,
+				advectionHandlers[i]->computeAdvection(network, threadPosition,
 						concVector, updatedConcOffset, grid[xi + 1] - grid[xi],
 						grid[xi + 2] - grid[xi + 1], xi, xs, hY, yj);
 			}
@@ -460,7 +466,10 @@ void PetscSolver2DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 					updatedConcOffset, xi, xs, yj);
 
 			// ----- Compute the reaction fluxes over the locally owned part of the grid -----
-			network.computeAllFluxes(updatedConcOffset, xi + 1 - xs);
+			network.computeAllFluxes(concOffset, updatedConcOffset,
+					xi + 1 - xs);
+
+			addPointCost((yj - ys) * xm + xi - xs, costStart);
 		}
 	}
 
@@ -477,8 +486,39 @@ void PetscSolver2DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 	checkPetscError(ierr, "PetscSolver2DHandler::updateConcentration: "
 			"DMRestoreLocalVector failed.");
 
-	// Clear memory
-	delete[] concVector;
+	return;
+}
+
+void PetscSolver2DHandler::computeTrappedAtomConc(PetscScalar ***concs,
+		PetscInt xs, PetscInt xm, PetscInt ys, PetscInt ym) {
+	// Loop over the local rows
+	for (PetscInt yj = ys; yj < ys + ym; yj++) {
+		// Compute the total concentration of atoms contained in bubbles
+		double atomConc = 0.0;
+
+		// Loop over the local grid points, skipping the boundaries
+		PetscInt xStart = std::max(xs, (PetscInt) surfacePosition[yj] + leftOffset);
+		PetscInt xEnd = std::min(xs + xm, (PetscInt) nX - rightOffset);
+		if (yj < bottomOffset || yj >= nY - topOffset)
+			xEnd = xStart;
+		for (PetscInt xi = xStart; xi < xEnd; xi++) {
+			// We are only interested in the helium near the surface
+			if (grid[xi + 1] - grid[surfacePosition[yj] + 1] > 2.0)
+				continue;
+
+			// Copy data into the PSIClusterReactionNetwork
+			network.updateConcentrationsFromArray(concs[yj][xi]);
+
+			// Sum the total atom concentration
+			atomConc += network.getTotalTrappedAtomConcentration()
+					* (grid[xi + 1] - grid[xi]);
+		}
+
+		localAtomConc[yj - ys] = atomConc;
+	}
+
+	// Share the concentrations of all the rows at once
+	reduceTrappedAtomConc();
 
 	return;
 }
@@ -796,42 +836,21 @@ void PetscSolver2DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 	int pdColIdsVectorSize = 0;
 
 	// Declarations for variables used in the loop
-	double atomConc = 0.0, totalAtomConc = 0.0;
 	xolotlCore::Point<3> gridPosition { 0.0, 0.0, 0.0 };
+	std::vector<double> temperatures(xm * ym, 0.0);
+	std::vector<std::vector<PetscInt> > linePoints(ym);
 
-	// Loop over the grid points
-	for (PetscInt yj = bottomOffset; yj < nY - topOffset; yj++) {
+	// Make sure each thread has its partials array
+	threadReactionVals.resize(getNumberOfThreads(),
+			std::vector<PetscScalar>(reactionIndices.size(), 0.0));
 
-		// Compute the total concentration of atoms contained in bubbles
-		atomConc = 0.0;
-
-		// Loop over grid points
-		for (int xi = surfacePosition[yj] + leftOffset; xi < nX - rightOffset;
-				xi++) {
-			// We are only interested in the helium near the surface
-			if (grid[xi + 1] - grid[surfacePosition[yj] + 1] > 2.0)
-				continue;
-
-			// Check if we are on the right processor
-			if (xi >= xs && xi < xs + xm && yj >= ys && yj < ys + ym) {
-				// Get the concentrations at this grid point
-				concOffset = concs[yj][xi];
-				// Copy data into the PSIClusterReactionNetwork
-				network.updateConcentrationsFromArray(concOffset);
-
-				// Sum the total atom concentration
-				atomConc += network.getTotalTrappedAtomConcentration()
-						* (grid[xi + 1] - grid[xi]);
-			}
-		}
+	// Get the values of the Jacobian to add the reaction partials directly
+	PetscScalar *diagValues = getDiagonalValues(J);
+	reactionPoints.clear();
 
-		// Share the concentration with all the processes
-		totalAtomConc = 0.0;
-		MPI_Allreduce(&atomConc, &totalAtomConc, 1, MPI_DOUBLE, MPI_SUM,
-				MPI_COMM_WORLD);
-
-		// Set the disappearing rate in the modified TM handler
-		mutationHandler->updateDisappearingRate(totalAtomConc);
+	// Get the temperature of each grid point and the grid points of each row
+	// serially first
+	for (PetscInt yj = bottomOffset; yj < nY - topOffset; yj++) {
 
 		// Skip if we are not on the right process
 		if (yj < ys || yj >= ys + ym)
@@ -865,55 +884,105 @@ void PetscSolver2DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 			// Get the temperature from the temperature handler
 			concOffset = concs[yj][xi];
 			temperatureHandler->setTemperature(concOffset);
-			double temperature = temperatureHandler->getTemperature(
-					gridPosition, ftime);
+			temperatures[(yj - ys) * xm + xi - xs] =
+					temperatureHandler->getTemperature(gridPosition, ftime);
 
-			// Update the network if the temperature changed
-			if (std::fabs(lastTemperature[xi + 1 - xs] - temperature) > 0.1) {
-				network.setTemperature(temperature, xi + 1 - xs);
-				// Update the modified trap-mutation rate that depends on the
-				// network reaction rates
-				mutationHandler->updateTrapMutationRate(network);
-				lastTemperature[xi + 1 - xs] = temperature;
-			}
+			linePoints[yj - ys].push_back(xi);
+			reactionPoints.emplace_back((yj - ys) * xm + xi - xs, xi + 1 - xs);
+		}
+	}
 
-			// Copy data into the ReactionNetwork so that it can
-			// compute the new concentrations.
-			network.updateConcentrationsFromArray(concOffset);
+	// Use the reaction partials of the previous evaluations if they are
+	// lagged and the temperatures did not change
+	const bool lagged = lagReactionPartials(temperatures);
 
-			// ----- Take care of the reactions for all the reactants -----
+	// The partial derivatives for the reactions are computed in parallel
+	// when they are added directly in the Jacobian or kept, otherwise they
+	// are computed one grid point at a time
+	const bool threadedPartials = diagValues || reactionJacobianLag > 1;
 
-			// Compute all the partial derivatives for the reactions
-			network.computeAllPartials(reactionStartingIdx, reactionIndices,
-					reactionVals, xi + 1 - xs);
+	// Compute the total concentration of atoms contained in bubbles
+	// near the surface for each local row
+	computeTrappedAtomConc(concs, xs, xm, ys, ym);
 
-			// Update the column in the Jacobian that represents each DOF
-			for (int i = 0; i < dof - 1; i++) {
-				// Set grid coordinate and component number for the row
-				rowId.i = xi;
-				rowId.j = yj;
-				rowId.c = i;
-
-				// Number of partial derivatives
-				pdColIdsVectorSize = reactionSize[i];
-				auto startingIdx = reactionStartingIdx[i];
-
-				// Loop over the list of column ids
-				for (int j = 0; j < pdColIdsVectorSize; j++) {
-					// Set grid coordinate and component number for a column in the list
-					colIds[j].i = xi;
-					colIds[j].j = yj;
-					colIds[j].c = reactionIndices[startingIdx + j];
-					// Get the partial derivative from the array of all of the partials
-					reactingPartialsForCluster[j] =
-							reactionVals[startingIdx + j];
+	// Loop over the grid points
+	for (PetscInt yj = bottomOffset; yj < nY - topOffset; yj++) {
+
+		// Skip if we are not on the right process
+		if (yj < ys || yj >= ys + ym)
+			continue;
+
+		// Set the disappearing rate in the modified TM handler
+		mutationHandler->updateDisappearingRate(totalAtomConc[yj - ys]);
+
+		// Update the network if the temperature of a grid point of this row
+		// changed, serially before the threads read the rates
+		const auto& points = linePoints[yj - ys];
+		for (auto xi : points) {
+			updateTemperature(temperatures[(yj - ys) * xm + xi - xs],
+					xi + 1 - xs);
+		}
+
+		// ----- Take care of the reactions for all the reactants -----
+
+		// Compute all the partial derivatives for the reactions in parallel,
+		// and add them directly in the Jacobian if possible
+		const int nPoints = points.size();
+		if (threadedPartials) {
+#pragma omp parallel for if (getNumberOfThreads() > 1)
+			for (int p = 0; p < nPoints; p++) {
+				const PetscInt xi = points[p];
+				auto costStart = startPointCost();
+				auto& vals = getReactionVals((yj - ys) * xm + xi - xs);
+				if (!lagged)
+					network.computeAllPartials(concs[yj][xi], reactionStartingIdx,
+							reactionIndices, vals, xi + 1 - xs);
+				if (diagValues)
+					addReactionPartials(diagValues, (yj - ys) * xm + xi - xs, vals);
+
+				addPointCost((yj - ys) * xm + xi - xs, costStart);
+			}
+		}
+
+		// Set the other partial derivatives in the Jacobian, one grid point at a time
+		for (int p = 0; p < nPoints; p++) {
+			const PetscInt xi = points[p];
+
+			// Otherwise set the reaction ones row by row
+			if (!diagValues) {
+				auto& vals = getReactionVals((yj - ys) * xm + xi - xs);
+				if (!threadedPartials)
+					network.computeAllPartials(concs[yj][xi], reactionStartingIdx,
+							reactionIndices, vals, xi + 1 - xs);
+
+				// Update the column in the Jacobian that represents each DOF
+				for (int i = 0; i < dof - 1; i++) {
+					// Set grid coordinate and component number for the row
+					rowId.i = xi;
+					rowId.j = yj;
+					rowId.c = i;
+
+					// Number of partial derivatives
+					pdColIdsVectorSize = reactionSize[i];
+					auto startingIdx = reactionStartingIdx[i];
+
+					// Loop over the list of column ids
+					for (int j = 0; j < pdColIdsVectorSize; j++) {
+						// Set grid coordinate and component number for a column in the list
+						colIds[j].i = xi;
+						colIds[j].j = yj;
+						colIds[j].c = reactionIndices[startingIdx + j];
+						// Get the partial derivative from the array of all of the partials
+						reactingPartialsForCluster[j] =
+								vals[startingIdx + j];
+					}
+					// Update the matrix
+					ierr = MatSetValuesStencil(J, 1, &rowId, pdColIdsVectorSize,
+							colIds, reactingPartialsForCluster.data(), ADD_VALUES);
+					checkPetscError(ierr,
+							"PetscSolver2DHandler::computeDiagonalJacobian: "
+									"MatSetValuesStencil (reactions) failed.");
 				}
-				// Update the matrix
-				ierr = MatSetValuesStencil(J, 1, &rowId, pdColIdsVectorSize,
-						colIds, reactingPartialsForCluster.data(), ADD_VALUES);
-				checkPetscError(ierr,
-						"PetscSolver2DHandler::computeDiagonalJacobian: "
-								"MatSetValuesStencil (reactions) failed.");
 			}
 
 			// ----- Take care of the modified trap-mutation for all the reactants -----
@@ -929,7 +998,8 @@ void PetscSolver2DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 
 			// Compute the partial derivative from modified trap-mutation at this grid point
 			int nMutating = mutationHandler->computePartialsForTrapMutation(
-					network, mutationVals, mutationIndices, xi, xs, yj);
+					network, concs[yj][xi], mutationVals, mutationIndices, xi,
+					xs, yj);
 
 			// Loop on the number of helium undergoing trap-mutation to set the values
 			// in the Jacobian
@@ -1066,6 +1136,9 @@ void PetscSolver2DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 		}
 	}
 
+	// Give back the values of the Jacobian
+	restoreDiagonalValues(J, diagValues);
+
 	/*
 	 Restore vectors
 	 */
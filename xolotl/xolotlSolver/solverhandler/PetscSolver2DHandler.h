@@ -15,6 +15,19 @@ private:
 	//! The position of the surface
 	std::vector<int> surfacePosition;
 
+	/**
+	 * Compute the total concentration of atoms trapped in bubbles near the
+	 * surface for each local row, in totalAtomConc.
+	 *
+	 * @param concs The local concentrations
+	 * @param xs The first local grid point in the x direction
+	 * @param xm The number of local grid points in the x direction
+	 * @param ys The first local row
+	 * @param ym The number of local rows
+	 */
+	void computeTrappedAtomConc(PetscScalar ***concs, PetscInt xs, PetscInt xm,
+			PetscInt ys, PetscInt ym);
+
 public:
 
 	/**
@@ -81,6 +94,7 @@ public:
 	 */
 	void setSurfacePosition(int pos, int j = -1, int k = -1) {
 		surfacePosition[j] = pos;
+		surfaceMoves++;
 
 		return;
 	}
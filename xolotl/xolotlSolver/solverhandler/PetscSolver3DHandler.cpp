@@ -17,10 +17,18 @@ void PetscSolver3DHandler::createSolverContext(DM &da) {
 	 Create distributed array (DMDA) to manage parallel grid and vectors
 	 - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
+	// Use the ownership ranges balancing the cost of a previous run if given
+	std::vector<std::vector<PetscInt> > ranges;
+	bool balanced = readOwnershipRanges( { nX, nY, nZ }, ranges);
+
 	ierr = DMDACreate3d(PETSC_COMM_WORLD, DM_BOUNDARY_MIRROR,
 			DM_BOUNDARY_PERIODIC, DM_BOUNDARY_PERIODIC, DMDA_STENCIL_STAR, nX,
-			nY, nZ, PETSC_DECIDE, PETSC_DECIDE, PETSC_DECIDE, dof, 1, NULL,
-			NULL, NULL, &da);
+			nY, nZ, balanced ? (PetscInt) ranges[0].size() : PETSC_DECIDE,
+			balanced ? (PetscInt) ranges[1].size() : PETSC_DECIDE,
+			balanced ? (PetscInt) ranges[2].size() : PETSC_DECIDE, dof, 1,
+			balanced ? ranges[0].data() : NULL,
+			balanced ? ranges[1].data() : NULL,
+			balanced ? ranges[2].data() : NULL, &da);
 	checkPetscError(ierr, "PetscSolver3DHandler::createSolverContext: "
 			"DMDACreate3d failed.");
 	ierr = DMSetFromOptions(da);
@@ -30,6 +38,9 @@ void PetscSolver3DHandler::createSolverContext(DM &da) {
 	checkPetscError(ierr,
 			"PetscSolver3DHandler::createSolverContext: DMSetUp failed.");
 
+	// Measure the cost of the grid points if asked
+	initializeLoadBalance(da);
+
 	// Set the position of the surface
 	// Loop on Y
 	for (int j = 0; j < nY; j++) {
@@ -124,8 +135,11 @@ void PetscSolver3DHandler::createSolverContext(DM &da) {
 	// because it adds connectivity
 	resolutionHandler->initialize(network, electronicStoppingPower);
 
-	// Get the diagonal fill
-	network.getDiagonalFill(dfill);
+	// Get the diagonal fill of the reactions
+	initializeReactionFill(dfill);
+
+	// Check which parts of the Jacobian are kept between evaluations
+	initializeJacobianReuse();
 
 	// Load up the block fills
 	auto dfillsparse = ConvertToPetscSparseFillMap(dof, dfill);
@@ -143,7 +157,6 @@ void PetscSolver3DHandler::createSolverContext(DM &da) {
 	reactionIndices.resize(nPartials);
 	network.initPartialsIndices(reactionSize, reactionStartingIdx,
 			reactionIndices);
-	reactionVals.resize(nPartials);
 
 	return;
 }
@@ -169,6 +182,9 @@ void PetscSolver3DHandler::initializeConcentration(DM &da, Vec &C) {
 	}
 	network.addGridPoints(xm + 2);
 
+	// The processes owning the same columns share the concentration near the surface
+	initializeSurfaceComm(zs * nY + ys, ym * zm);
+
 	// Get the last time step written in the HDF5 file
 	bool hasConcentrations = false;
 	std::unique_ptr<xolotlCore::XFile> xfile;
@@ -243,35 +259,36 @@ void PetscSolver3DHandler::initializeConcentration(DM &da, Vec &C) {
 		auto tsGroup = concGroup->getLastTimestepGroup();
 		assert(tsGroup);
 
-		// Loop on the full grid
-		for (PetscInt k = 0; k < nZ; k++) {
-			for (PetscInt j = 0; j < nY; j++) {
-				for (PetscInt i = 0; i < nX; i++) {
-					// Read the concentrations from the HDF5 file
-					auto concVector = tsGroup->readGridPoint(i, j, k);
-
-					// Change the concentration only if we are on the locally
-					// owned part of the grid
-					if (i >= xs && i < xs + xm && j >= ys && j < ys + ym
-							&& k >= zs && k < zs + zm) {
-						concOffset = concentrations[k][j][i];
-						// Loop on the concVector size
-						for (unsigned int l = 0; l < concVector.size(); l++) {
-							concOffset[(int) concVector.at(l).at(0)] =
-									concVector.at(l).at(1);
-						}
-						// Set the temperature in the network
-						double temp = concVector.at(concVector.size() - 1).at(
-								1);
-						network.setTemperature(temp, i - xs);
-						// Update the modified trap-mutation rate
-						// that depends on the network reaction rates
-						mutationHandler->updateTrapMutationRate(network);
-						lastTemperature[i - xs] = temp;
-					}
+		// Read the concentrations of the grid points we own
+		std::vector<std::array<int, 3> > positions;
+		for (PetscInt k = zs; k < zs + zm; k++) {
+			for (PetscInt j = ys; j < ys + ym; j++) {
+				for (PetscInt i = xs; i < xs + xm; i++) {
+					positions.push_back( { { (int) i, (int) j, (int) k } });
 				}
 			}
 		}
+		auto myConcs = tsGroup->readConcentrationDatasets(positions);
+
+		// Apply the concentrations we just read
+		for (auto n = 0; n < positions.size(); ++n) {
+			if (myConcs[n].empty())
+				continue;
+
+			const int i = positions[n][0], j = positions[n][1], k =
+					positions[n][2];
+			concOffset = concentrations[k][j][i];
+			for (auto const& currConcData : myConcs[n]) {
+				concOffset[currConcData.first] = currConcData.second;
+			}
+			// Set the temperature in the network, only once for
+			// each temperature because it changes with depth only
+			double temp = myConcs[n].back().second;
+			if (temp != lastTemperature[i - xs]) {
+				network.setTemperature(temp, i - xs);
+				lastTemperature[i - xs] = temp;
+			}
+		}
 	}
 
 	/*
@@ -324,54 +341,30 @@ void PetscSolver3DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 	double sz = 1.0 / (hZ * hZ);
 
 	// Declarations for variables used in the loop
-	double **concVector = new double*[7];
 	xolotlCore::Point<3> gridPosition { 0.0, 0.0, 0.0 };
+	std::vector<PetscInt> points;
+	std::vector<bool> isComputed;
 	std::vector<double> incidentFluxVector;
-	double atomConc = 0.0, totalAtomConc = 0.0;
 
 	// Degrees of freedom is the total number of clusters in the network
 	const int dof = network.getDOF();
 
+	// Compute the total concentration of atoms contained in bubbles
+	// near the surface for each local column
+	computeTrappedAtomConc(concs, xs, xm, ys, ym, zs, zm);
+
 	// Loop over grid points
 	for (PetscInt zk = frontOffset; zk < nZ - backOffset; zk++) {
 		for (PetscInt yj = bottomOffset; yj < nY - topOffset; yj++) {
 
-			// Compute the total concentration of atoms contained in bubbles
-			atomConc = 0.0;
-
-			// Loop over grid points
-			for (int xi = surfacePosition[yj][zk] + leftOffset;
-					xi < nX - rightOffset; xi++) {
-				// We are only interested in the helium near the surface
-				if (grid[xi + 1] - grid[surfacePosition[yj][zk] + 1] > 2.0)
-					continue;
-
-				// Check if we are on the right processor
-				if (xi >= xs && xi < xs + xm && yj >= ys && yj < ys + ym
-						&& zk >= zs && zk < zs + zm) {
-					// Get the concentrations at this grid point
-					concOffset = concs[zk][yj][xi];
-					// Copy data into the PSIClusterReactionNetwork
-					network.updateConcentrationsFromArray(concOffset);
-
-					// Sum the total atom concentration
-					atomConc += network.getTotalTrappedAtomConcentration()
-							* (grid[xi + 1] - grid[xi]);
-				}
-			}
-
-			// Share the concentration with all the processes
-			totalAtomConc = 0.0;
-			MPI_Allreduce(&atomConc, &totalAtomConc, 1, MPI_DOUBLE, MPI_SUM,
-					MPI_COMM_WORLD);
-
-			// Set the disappearing rate in the modified TM handler
-			mutationHandler->updateDisappearingRate(totalAtomConc);
-
 			// Skip if we are not on the right process
 			if (yj < ys || yj >= ys + ym || zk < zs || zk >= zs + zm)
 				continue;
 
+			// Set the disappearing rate in the modified TM handler
+			mutationHandler->updateDisappearingRate(
+					totalAtomConc[(zk - zs) * ym + yj - ys]);
+
 			// Set the grid position
 			gridPosition[1] = yj * hY;
 			gridPosition[2] = zk * hZ;
@@ -384,23 +377,28 @@ void PetscSolver3DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 					grid[surfacePosition[yj][zk] + 1] - grid[1]);
 			temperatureHandler->updateSurfacePosition(surfacePosition[yj][zk]);
 
+			// What modifies the network or the handlers is done serially first,
+			// the temperature of each grid point is set once and only read after
+			points.clear();
+			isComputed.assign(xm + 2, false);
 			for (PetscInt xi = xs; xi < xs + xm; xi++) {
 				// Compute the old and new array offsets
 				concOffset = concs[zk][yj][xi];
 				updatedConcOffset = updatedConcs[zk][yj][xi];
 
-				// Fill the concVector with the pointer to the middle, left,
-				// right, bottom, top, front, and back grid points
-				concVector[0] = concOffset; // middle
-				concVector[1] = concs[zk][yj][xi - 1]; // left
-				concVector[2] = concs[zk][yj][xi + 1]; // right
-				concVector[3] = concs[zk][yj - 1][xi]; // bottom
-				concVector[4] = concs[zk][yj + 1][xi]; // top
-				concVector[5] = concs[zk - 1][yj][xi]; // front
-				concVector[6] = concs[zk + 1][yj][xi]; // back
-
 				// Heat condition
 				if (xi == surfacePosition[yj][zk]) {
+					// Fill the concVector with the pointer to the middle, left,
+					// right, bottom, top, front, and back grid points
+					double *concVector[7];
+					concVector[0] = concOffset; // middle
+					concVector[1] = concs[zk][yj][xi - 1]; // left
+					concVector[2] = concs[zk][yj][xi + 1]; // right
+					concVector[3] = concs[zk][yj - 1][xi]; // bottom
+					concVector[4] = concs[zk][yj + 1][xi]; // top
+					concVector[5] = concs[zk - 1][yj][xi]; // front
+					concVector[6] = concs[zk + 1][yj][xi]; // back
+
 					temperatureHandler->computeTemperature(concVector,
 							updatedConcOffset, grid[xi + 1] - grid[xi],
 							grid[xi + 2] - grid[xi + 1], xi, sy, yj, sz, zk);
@@ -426,52 +424,60 @@ void PetscSolver3DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 				if (skip)
 					continue;
 
-				// Update the network if the temperature changed
-				// left
-				double temperature = concs[zk][yj][xi - 1][dof - 1];
-				if (std::fabs(lastTemperature[xi - xs] - temperature) > 0.1) {
-					network.setTemperature(temperature, xi - xs);
-					lastTemperature[xi - xs] = temperature;
-				}
-				// right
-				temperature = concs[zk][yj][xi + 1][dof - 1];
-				if (std::fabs(lastTemperature[xi + 2 - xs] - temperature)
-						> 0.1) {
-					network.setTemperature(temperature, xi + 2 - xs);
-					lastTemperature[xi + 2 - xs] = temperature;
-				}
-
 				// Set the grid fraction
 				gridPosition[0] = (grid[xi + 1]
 						- grid[surfacePosition[yj][zk] + 1])
 						/ (grid[grid.size() - 1]
 								- grid[surfacePosition[yj][zk] + 1]);
 
-				// Get the temperature from the temperature handler
+				// Update the network if the temperature from the temperature
+				// handler changed
 				temperatureHandler->setTemperature(concOffset);
-				temperature = temperatureHandler->getTemperature(gridPosition,
-						ftime);
-				// middle
-				if (std::fabs(lastTemperature[xi + 1 - xs] - temperature)
-						> 0.1) {
-					network.setTemperature(temperature, xi + 1 - xs);
-					// Update the modified trap-mutation rate
-					// that depends on the network reaction rates
-					mutationHandler->updateTrapMutationRate(network);
-					lastTemperature[xi + 1 - xs] = temperature;
-				}
-
-				// Copy data into the ReactionNetwork so that it can
-				// compute the fluxes properly. The network is only used to compute the
-				// fluxes and hold the state data from the last time step. I'm reusing
-				// it because it cuts down on memory significantly (about 400MB per
-				// grid point) at the expense of being a little tricky to comprehend.
-				network.updateConcentrationsFromArray(concOffset);
+				updateTemperature(
+						temperatureHandler->getTemperature(gridPosition, ftime),
+						xi + 1 - xs);
+				isComputed[xi + 1 - xs] = true;
 
 				// ----- Account for flux of incoming particles -----
 				fluxHandler->computeIncidentFlux(ftime, updatedConcOffset, xi,
 						surfacePosition[yj][zk]);
 
+				// The rest is computed in parallel
+				points.push_back(xi);
+			}
+
+			// The neighbors that are not computed here take the temperature
+			// of the solution
+			for (auto xi : points) {
+				// left
+				if (!isComputed[xi - xs])
+					updateTemperature(concs[zk][yj][xi - 1][dof - 1], xi - xs);
+				// right
+				if (!isComputed[xi + 2 - xs])
+					updateTemperature(concs[zk][yj][xi + 1][dof - 1], xi + 2 - xs);
+			}
+
+			// Each thread only uses its own views of the concentrations
+			const int nPoints = points.size();
+#pragma omp parallel for if (getNumberOfThreads() > 1)
+			for (int p = 0; p < nPoints; p++) {
+				const PetscInt xi = points[p];
+				auto costStart = startPointCost();
+				PetscScalar *concOffset = concs[zk][yj][xi];
+				PetscScalar *updatedConcOffset = updatedConcs[zk][yj][xi];
+				xolotlCore::Point<3> threadPosition = gridPosition;
+
+				// Fill the concVector with the pointer to the middle, left,
+				// right, bottom, top, front, and back grid points
+				double *concVector[7];
+				concVector[0] = concOffset; // middle
+				concVector[1] = concs[zk][yj][xi - 1]; // left
+				concVector[2] = concs[zk][yj][xi + 1]; // right
+				concVector[3] = concs[zk][yj - 1][xi]; // bottom
+				concVector[4] = concs[zk][yj + 1][xi]; // top
+				concVector[5] = concs[zk - 1][yj][xi]; // front
+				concVector[6] = concs[zk + 1][yj][xi]; // back
+
 				// ---- Compute the temperature over the locally owned part of the grid -----
 				temperatureHandler->computeTemperature(concVector,
 						updatedConcOffset, grid[xi + 1] - grid[xi],
@@ -484,10 +490,10 @@ void PetscSolver3DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 
 				// ---- Compute advection over the locally owned part of the grid -----
 				// Set the grid position
-				gridPosition[0] = grid[xi + 1] - grid[1];
+				threadPosition[0] = grid[xi + 1] - grid[1];
 				for (int i = 0; i < advectionHandlers.size(); i++) {
 					advectionHandlers[i]->computeAdvection(network,
-							gridPosition, concVector, updatedConcOffset,
+							threadPosition, concVector, updatedConcOffset,
 							grid[xi + 1] - grid[xi],
 							grid[xi + 2] - grid[xi + 1], xi, xs, hY, yj, hZ,
 							zk);
@@ -502,7 +508,11 @@ void PetscSolver3DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 						updatedConcOffset, xi, xs, yj, zk);
 
 				// ----- Compute the reaction fluxes over the locally owned part of the grid -----
-				network.computeAllFluxes(updatedConcOffset, xi + 1 - xs);
+				network.computeAllFluxes(concOffset, updatedConcOffset,
+						xi + 1 - xs);
+
+				addPointCost(((zk - zs) * ym + yj - ys) * xm + xi - xs,
+						costStart);
 			}
 		}
 	}
@@ -520,8 +530,44 @@ void PetscSolver3DHandler::updateConcentration(TS &ts, Vec &localC, Vec &F,
 	checkPetscError(ierr, "PetscSolver3DHandler::updateConcentration: "
 			"DMRestoreLocalVector failed.");
 
-	// Clear memory
-	delete[] concVector;
+	return;
+}
+
+void PetscSolver3DHandler::computeTrappedAtomConc(PetscScalar ****concs,
+		PetscInt xs, PetscInt xm, PetscInt ys, PetscInt ym, PetscInt zs,
+		PetscInt zm) {
+	// Loop over the local columns
+	for (PetscInt zk = zs; zk < zs + zm; zk++) {
+		for (PetscInt yj = ys; yj < ys + ym; yj++) {
+			// Compute the total concentration of atoms contained in bubbles
+			double atomConc = 0.0;
+
+			// Loop over the local grid points, skipping the boundaries
+			PetscInt xStart = std::max(xs,
+					(PetscInt) surfacePosition[yj][zk] + leftOffset);
+			PetscInt xEnd = std::min(xs + xm, (PetscInt) nX - rightOffset);
+			if (yj < bottomOffset || yj >= nY - topOffset || zk < frontOffset
+					|| zk >= nZ - backOffset)
+				xEnd = xStart;
+			for (PetscInt xi = xStart; xi < xEnd; xi++) {
+				// We are only interested in the helium near the surface
+				if (grid[xi + 1] - grid[surfacePosition[yj][zk] + 1] > 2.0)
+					continue;
+
+				// Copy data into the PSIClusterReactionNetwork
+				network.updateConcentrationsFromArray(concs[zk][yj][xi]);
+
+				// Sum the total atom concentration
+				atomConc += network.getTotalTrappedAtomConcentration()
+						* (grid[xi + 1] - grid[xi]);
+			}
+
+			localAtomConc[(zk - zs) * ym + yj - ys] = atomConc;
+		}
+	}
+
+	// Share the concentrations of all the columns at once
+	reduceTrappedAtomConc();
 
 	return;
 }
@@ -900,44 +946,22 @@ void PetscSolver3DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 	int pdColIdsVectorSize = 0;
 
 	// Declarations for variables used in the loop
-	double atomConc = 0.0, totalAtomConc = 0.0;
 	xolotlCore::Point<3> gridPosition { 0.0, 0.0, 0.0 };
+	std::vector<double> temperatures(xm * ym * zm, 0.0);
+	std::vector<std::vector<PetscInt> > linePoints(ym * zm);
 
-	// Loop over the grid points
-	for (PetscInt zk = frontOffset; zk < nZ - backOffset; zk++) {
-		for (PetscInt yj = bottomOffset; yj < nY - topOffset; yj++) {
-
-			// Compute the total concentration of atoms contained in bubbles
-			atomConc = 0.0;
+	// Make sure each thread has its partials array
+	threadReactionVals.resize(getNumberOfThreads(),
+			std::vector<PetscScalar>(reactionIndices.size(), 0.0));
 
-			// Loop over grid points
-			for (int xi = surfacePosition[yj][zk] + leftOffset;
-					xi < nX - rightOffset; xi++) {
-				// We are only interested in the helium near the surface
-				if (grid[xi + 1] - grid[surfacePosition[yj][zk] + 1] > 2.0)
-					continue;
+	// Get the values of the Jacobian to add the reaction partials directly
+	PetscScalar *diagValues = getDiagonalValues(J);
+	reactionPoints.clear();
 
-				// Check if we are on the right processor
-				if (xi >= xs && xi < xs + xm && yj >= ys && yj < ys + ym
-						&& zk >= zs && zk < zs + zm) {
-					// Get the concentrations at this grid point
-					concOffset = concs[zk][yj][xi];
-					// Copy data into the PSIClusterReactionNetwork
-					network.updateConcentrationsFromArray(concOffset);
-
-					// Sum the total atom concentration
-					atomConc += network.getTotalTrappedAtomConcentration()
-							* (grid[xi + 1] - grid[xi]);
-				}
-			}
-
-			// Share the concentration with all the processes
-			totalAtomConc = 0.0;
-			MPI_Allreduce(&atomConc, &totalAtomConc, 1, MPI_DOUBLE, MPI_SUM,
-					MPI_COMM_WORLD);
-
-			// Set the disappearing rate in the modified TM handler
-			mutationHandler->updateDisappearingRate(totalAtomConc);
+	// Get the temperature of each grid point and the grid points of each
+	// column serially first
+	for (PetscInt zk = frontOffset; zk < nZ - backOffset; zk++) {
+		for (PetscInt yj = bottomOffset; yj < nY - topOffset; yj++) {
 
 			// Skip if we are not on the right process
 			if (yj < ys || yj >= ys + ym || zk < zs || zk >= zs + zm)
@@ -976,59 +1000,115 @@ void PetscSolver3DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 				// Get the temperature from the temperature handler
 				concOffset = concs[zk][yj][xi];
 				temperatureHandler->setTemperature(concOffset);
-				double temperature = temperatureHandler->getTemperature(
-						gridPosition, ftime);
+				temperatures[((zk - zs) * ym + yj - ys) * xm + xi - xs] =
+						temperatureHandler->getTemperature(gridPosition, ftime);
 
-				// Update the network if the temperature changed
-				if (std::fabs(lastTemperature[xi + 1 - xs] - temperature)
-						> 0.1) {
-					network.setTemperature(temperature, xi + 1 - xs);
-					// Update the modified trap-mutation rate that depends on the
-					// network reaction rates
-					mutationHandler->updateTrapMutationRate(network);
-					lastTemperature[xi + 1 - xs] = temperature;
-				}
+				linePoints[(zk - zs) * ym + yj - ys].push_back(xi);
+				reactionPoints.emplace_back(((zk - zs) * ym + yj - ys) * xm + xi - xs, xi + 1 - xs);
+			}
+		}
+	}
 
-				// Copy data into the ReactionNetwork so that it can
-				// compute the new concentrations.
-				network.updateConcentrationsFromArray(concOffset);
+	// Use the reaction partials of the previous evaluations if they are
+	// lagged and the temperatures did not change
+	const bool lagged = lagReactionPartials(temperatures);
 
-				// ----- Take care of the reactions for all the reactants -----
+	// The partial derivatives for the reactions are computed in parallel
+	// when they are added directly in the Jacobian or kept, otherwise they
+	// are computed one grid point at a time
+	const bool threadedPartials = diagValues || reactionJacobianLag > 1;
 
-				// Compute all the partial derivatives for the reactions
-				network.computeAllPartials(reactionStartingIdx, reactionIndices,
-						reactionVals, xi + 1 - xs);
+	// Compute the total concentration of atoms contained in bubbles
+	// near the surface for each local column
+	computeTrappedAtomConc(concs, xs, xm, ys, ym, zs, zm);
 
-				// Update the column in the Jacobian that represents each DOF
-				for (int i = 0; i < dof - 1; i++) {
-					// Set grid coordinate and component number for the row
-					rowId.i = xi;
-					rowId.j = yj;
-					rowId.k = zk;
-					rowId.c = i;
-
-					// Number of partial derivatives
-					pdColIdsVectorSize = reactionSize[i];
-					auto startingIdx = reactionStartingIdx[i];
-
-					// Loop over the list of column ids
-					for (int j = 0; j < pdColIdsVectorSize; j++) {
-						// Set grid coordinate and component number for a column in the list
-						colIds[j].i = xi;
-						colIds[j].j = yj;
-						colIds[j].k = zk;
-						colIds[j].c = reactionIndices[startingIdx + j];
-						// Get the partial derivative from the array of all of the partials
-						reactingPartialsForCluster[j] = reactionVals[startingIdx
-								+ j];
+	// Loop over the grid points
+	for (PetscInt zk = frontOffset; zk < nZ - backOffset; zk++) {
+		for (PetscInt yj = bottomOffset; yj < nY - topOffset; yj++) {
+
+			// Skip if we are not on the right process
+			if (yj < ys || yj >= ys + ym || zk < zs || zk >= zs + zm)
+				continue;
+
+			// Set the disappearing rate in the modified TM handler
+			mutationHandler->updateDisappearingRate(
+					totalAtomConc[(zk - zs) * ym + yj - ys]);
+
+			// Update the network if the temperature of a grid point of this
+			// column changed, serially before the threads read the rates
+			const auto& points = linePoints[(zk - zs) * ym + yj - ys];
+			for (auto xi : points) {
+				updateTemperature(
+						temperatures[((zk - zs) * ym + yj - ys) * xm + xi - xs],
+						xi + 1 - xs);
+			}
+
+			// ----- Take care of the reactions for all the reactants -----
+
+			// Compute all the partial derivatives for the reactions in parallel,
+			// and add them directly in the Jacobian if possible
+			const int nPoints = points.size();
+			if (threadedPartials) {
+#pragma omp parallel for if (getNumberOfThreads() > 1)
+				for (int p = 0; p < nPoints; p++) {
+					const PetscInt xi = points[p];
+					auto costStart = startPointCost();
+					auto& vals = getReactionVals(
+							((zk - zs) * ym + yj - ys) * xm + xi - xs);
+					if (!lagged)
+						network.computeAllPartials(concs[zk][yj][xi], reactionStartingIdx,
+								reactionIndices, vals, xi + 1 - xs);
+					if (diagValues)
+						addReactionPartials(diagValues,
+								((zk - zs) * ym + yj - ys) * xm + xi - xs, vals);
+
+					addPointCost(((zk - zs) * ym + yj - ys) * xm + xi - xs,
+							costStart);
+				}
+			}
+
+			// Set the other partial derivatives in the Jacobian, one grid point at a time
+			for (int p = 0; p < nPoints; p++) {
+				const PetscInt xi = points[p];
+
+				// Otherwise set the reaction ones row by row
+				if (!diagValues) {
+					auto& vals = getReactionVals(
+							((zk - zs) * ym + yj - ys) * xm + xi - xs);
+					if (!threadedPartials)
+						network.computeAllPartials(concs[zk][yj][xi], reactionStartingIdx,
+								reactionIndices, vals, xi + 1 - xs);
+
+					// Update the column in the Jacobian that represents each DOF
+					for (int i = 0; i < dof - 1; i++) {
+						// Set grid coordinate and component number for the row
+						rowId.i = xi;
+						rowId.j = yj;
+						rowId.k = zk;
+						rowId.c = i;
+
+						// Number of partial derivatives
+						pdColIdsVectorSize = reactionSize[i];
+						auto startingIdx = reactionStartingIdx[i];
+
+						// Loop over the list of column ids
+						for (int j = 0; j < pdColIdsVectorSize; j++) {
+							// Set grid coordinate and component number for a column in the list
+							colIds[j].i = xi;
+							colIds[j].j = yj;
+							colIds[j].k = zk;
+							colIds[j].c = reactionIndices[startingIdx + j];
+							// Get the partial derivative from the array of all of the partials
+							reactingPartialsForCluster[j] = vals[startingIdx + j];
+						}
+						// Update the matrix
+						ierr = MatSetValuesStencil(J, 1, &rowId, pdColIdsVectorSize,
+								colIds, reactingPartialsForCluster.data(),
+								ADD_VALUES);
+						checkPetscError(ierr,
+								"PetscSolver3DHandler::computeDiagonalJacobian: "
+										"MatSetValuesStencil (reactions) failed.");
 					}
-					// Update the matrix
-					ierr = MatSetValuesStencil(J, 1, &rowId, pdColIdsVectorSize,
-							colIds, reactingPartialsForCluster.data(),
-							ADD_VALUES);
-					checkPetscError(ierr,
-							"PetscSolver3DHandler::computeDiagonalJacobian: "
-									"MatSetValuesStencil (reactions) failed.");
 				}
 
 				// ----- Take care of the modified trap-mutation for all the reactants -----
@@ -1044,7 +1124,8 @@ void PetscSolver3DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 
 				// Compute the partial derivative from modified trap-mutation at this grid point
 				int nMutating = mutationHandler->computePartialsForTrapMutation(
-						network, mutationVals, mutationIndices, xi, xs, yj, zk);
+						network, concs[zk][yj][xi], mutationVals,
+						mutationIndices, xi, xs, yj, zk);
 
 				// Loop on the number of helium undergoing trap-mutation to set the values
 				// in the Jacobian
@@ -1188,6 +1269,9 @@ void PetscSolver3DHandler::computeDiagonalJacobian(TS &ts, Vec &localC, Mat &J,
 		}
 	}
 
+	// Give back the values of the Jacobian
+	restoreDiagonalValues(J, diagValues);
+
 	/*
 	 Restore vectors
 	 */
@@ -15,6 +15,21 @@ private:
 	//! The position of the surface
 	std::vector<std::vector<int> > surfacePosition;
 
+	/**
+	 * Compute the total concentration of atoms trapped in bubbles near the
+	 * surface for each local column along the depth, in totalAtomConc.
+	 *
+	 * @param concs The local concentrations
+	 * @param xs The first local grid point in the x direction
+	 * @param xm The number of local grid points in the x direction
+	 * @param ys The first local grid point in the y direction
+	 * @param ym The number of local grid points in the y direction
+	 * @param zs The first local grid point in the z direction
+	 * @param zm The number of local grid points in the z direction
+	 */
+	void computeTrappedAtomConc(PetscScalar ****concs, PetscInt xs,
+			PetscInt xm, PetscInt ys, PetscInt ym, PetscInt zs, PetscInt zm);
+
 public:
 
 	/**
@@ -81,6 +96,7 @@ public:
 	 */
 	void setSurfacePosition(int pos, int j = -1, int k = -1) {
 		surfacePosition[j][k] = pos;
+		surfaceMoves++;
 
 		return;
 	}
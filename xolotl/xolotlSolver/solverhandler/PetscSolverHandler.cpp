@@ -1,4 +1,8 @@
 #include "xolotlSolver/solverhandler/PetscSolverHandler.h"
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <sstream>
 
 namespace xolotlSolver {
 
@@ -39,4 +43,584 @@ std::vector<PetscInt> PetscSolverHandler::ConvertToPetscSparseFillMap(
 	return ret;
 }
 
+PetscScalar * PetscSolverHandler::getDiagonalValues(Mat &J) {
+	PetscErrorCode ierr;
+
+	// Get the local diagonal part of the matrix
+	Mat diagJ = nullptr;
+	PetscBool isType = PETSC_FALSE;
+	ierr = PetscObjectTypeCompare((PetscObject) J, MATSEQAIJ, &isType);
+	checkPetscError(ierr, "PetscSolverHandler::getDiagonalValues: "
+			"PetscObjectTypeCompare failed.");
+	if (isType)
+		diagJ = J;
+	else {
+		ierr = PetscObjectTypeCompare((PetscObject) J, MATMPIAIJ, &isType);
+		checkPetscError(ierr, "PetscSolverHandler::getDiagonalValues: "
+				"PetscObjectTypeCompare failed.");
+		if (!isType) {
+			// The reactions can only be matrix-free with an AIJ matrix
+			if (reactionMatrixFree)
+				throw std::string(
+						"\nPetscSolverHandler::getDiagonalValues: "
+								"-reaction_mf needs an AIJ matrix.");
+			return nullptr;
+		}
+		ierr = MatMPIAIJGetSeqAIJ(J, &diagJ, NULL, NULL);
+		checkPetscError(ierr, "PetscSolverHandler::getDiagonalValues: "
+				"MatMPIAIJGetSeqAIJ failed.");
+	}
+
+	// Compute the positions again if the structure changed
+	PetscObjectState state = 0;
+	ierr = MatGetNonzeroState(J, &state);
+	checkPetscError(ierr, "PetscSolverHandler::getDiagonalValues: "
+			"MatGetNonzeroState failed.");
+	if (J != positionsMatrix || state != positionsState) {
+		positionsMatrix = nullptr;
+
+		// Get the structure of the local diagonal part
+		PetscInt nRows = 0;
+		const PetscInt *ia = nullptr, *ja = nullptr;
+		PetscBool done = PETSC_FALSE;
+		ierr = MatGetRowIJ(diagJ, 0, PETSC_FALSE, PETSC_FALSE, &nRows, &ia, &ja,
+				&done);
+		checkPetscError(ierr, "PetscSolverHandler::getDiagonalValues: "
+				"MatGetRowIJ failed.");
+		if (!done)
+			return nullptr;
+
+		// The local rows are ordered by grid point, then by DOF, and the
+		// diagonal block of each grid point has the same structure
+		const int dof = reactionSize.size();
+		const PetscInt nPoints = nRows / dof;
+		diagonalBlockStarts.resize(nRows);
+		reactionPositions.resize(reactionIndices.size());
+		std::vector<PetscInt> blockSizes(dof, 0);
+		bool valid = true;
+		for (PetscInt p = 0; p < nPoints && valid; p++) {
+			for (int i = 0; i < dof && valid; i++) {
+				// Find the columns of the diagonal block in this row
+				PetscInt row = p * dof + i;
+				auto begin = std::lower_bound(ja + ia[row], ja + ia[row + 1],
+						p * dof);
+				auto end = std::lower_bound(begin, ja + ia[row + 1],
+						(p + 1) * dof);
+				diagonalBlockStarts[row] = begin - ja;
+
+				// Find the reaction partials in the first grid point
+				if (p == 0) {
+					blockSizes[i] = end - begin;
+					auto startingIdx = reactionStartingIdx[i];
+					for (int j = 0; j < reactionSize[i] && valid; j++) {
+						auto col = reactionIndices[startingIdx + j];
+						auto iter = std::lower_bound(begin, end, col);
+						bool found = (iter != end && *iter == col);
+						reactionPositions[startingIdx + j] =
+								found ? iter - begin : -1;
+						// Only the diagonal is in the matrix-free mode
+						valid = found || (reactionMatrixFree && col != i);
+					}
+				}
+				// Check that the other ones have the same block
+				else {
+					valid = (end - begin == blockSizes[i])
+							&& std::equal(begin, end,
+									ja + diagonalBlockStarts[i],
+									[p, dof](PetscInt col, PetscInt firstCol) {
+										return col - p * dof == firstCol;
+									});
+				}
+			}
+		}
+
+		ierr = MatRestoreRowIJ(diagJ, 0, PETSC_FALSE, PETSC_FALSE, &nRows, &ia,
+				&ja, &done);
+		checkPetscError(ierr, "PetscSolverHandler::getDiagonalValues: "
+				"MatRestoreRowIJ failed.");
+		// Keep using MatSetValuesStencil() if the structure is not the
+		// expected one
+		if (!valid) {
+			if (reactionMatrixFree)
+				throw std::string(
+						"\nPetscSolverHandler::getDiagonalValues: "
+								"unexpected Jacobian structure with -reaction_mf.");
+			return nullptr;
+		}
+
+		positionsMatrix = J;
+		positionsState = state;
+	}
+
+	// Get the values
+	PetscScalar *values = nullptr;
+	ierr = MatSeqAIJGetArray(diagJ, &values);
+	checkPetscError(ierr, "PetscSolverHandler::getDiagonalValues: "
+			"MatSeqAIJGetArray failed.");
+
+	return values;
+}
+
+void PetscSolverHandler::restoreDiagonalValues(Mat &J, PetscScalar *values) {
+	if (!values)
+		return;
+
+	PetscErrorCode ierr;
+
+	// Get the local diagonal part of the matrix again
+	Mat diagJ = J;
+	PetscBool isType = PETSC_FALSE;
+	ierr = PetscObjectTypeCompare((PetscObject) J, MATMPIAIJ, &isType);
+	checkPetscError(ierr, "PetscSolverHandler::restoreDiagonalValues: "
+			"PetscObjectTypeCompare failed.");
+	if (isType) {
+		ierr = MatMPIAIJGetSeqAIJ(J, &diagJ, NULL, NULL);
+		checkPetscError(ierr, "PetscSolverHandler::restoreDiagonalValues: "
+				"MatMPIAIJGetSeqAIJ failed.");
+	}
+
+	ierr = MatSeqAIJRestoreArray(diagJ, &values);
+	checkPetscError(ierr, "PetscSolverHandler::restoreDiagonalValues: "
+			"MatSeqAIJRestoreArray failed.");
+
+	return;
+}
+
+void PetscSolverHandler::initializeReactionFill(
+		xolotlCore::IReactionNetwork::SparseFillMap& dfill) {
+	PetscErrorCode ierr;
+
+	// Check the option for the matrix-free reactions
+	PetscBool flag = PETSC_FALSE;
+	ierr = PetscOptionsHasName(NULL, NULL, "-reaction_mf", &flag);
+	checkPetscError(ierr, "PetscSolverHandler::initializeReactionFill: "
+			"PetscOptionsHasName (-reaction_mf) failed.");
+	reactionMatrixFree = flag;
+
+	if (!reactionMatrixFree) {
+		// Get the diagonal fill
+		network.getDiagonalFill(dfill);
+	} else {
+		// The network still needs to know its fill to compute the partials
+		xolotlCore::IReactionNetwork::SparseFillMap reactionFill;
+		network.getDiagonalFill(reactionFill);
+
+		// Only keep the diagonal of the reactions
+		for (auto const& row : reactionFill) {
+			auto& dfillRow = dfill[row.first];
+			if (std::find(dfillRow.begin(), dfillRow.end(), row.first)
+					== dfillRow.end())
+				dfillRow.push_back(row.first);
+		}
+	}
+
+	// Check the option to share the reaction data between the processes
+	// of each node, it does not change after the diagonal fill
+	flag = PETSC_FALSE;
+	ierr = PetscOptionsHasName(NULL, NULL, "-reaction_table_shared", &flag);
+	checkPetscError(ierr, "PetscSolverHandler::initializeReactionFill: "
+			"PetscOptionsHasName (-reaction_table_shared) failed.");
+	if (flag) {
+		bool isShared = network.shareOnNode(PETSC_COMM_WORLD);
+		int procId;
+		MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+		if (procId == 0 && !isShared) {
+			std::cout << "\nPetscSolverHandler Warning: "
+					<< "The reaction data could not be shared on the nodes."
+					<< std::endl;
+		}
+	}
+
+	return;
+}
+
+void PetscSolverHandler::initializeJacobianReuse() {
+	PetscErrorCode ierr;
+
+	// Check the option to keep the off-diagonal part
+	PetscBool flag = PETSC_FALSE;
+	ierr = PetscOptionsHasName(NULL, NULL, "-offdiag_jacobian_reuse", &flag);
+	checkPetscError(ierr, "PetscSolverHandler::initializeJacobianReuse: "
+			"PetscOptionsHasName (-offdiag_jacobian_reuse) failed.");
+	offDiagonalReuse = flag;
+
+	// Get the lag of the reaction partial derivatives
+	PetscInt lag = 1;
+	ierr = PetscOptionsGetInt(NULL, NULL, "-reaction_jacobian_lag", &lag,
+			NULL);
+	checkPetscError(ierr, "PetscSolverHandler::initializeJacobianReuse: "
+			"PetscOptionsGetInt (-reaction_jacobian_lag) failed.");
+	if (lag < 1)
+		throw std::string(
+				"\nPetscSolverHandler::initializeJacobianReuse: "
+						"-reaction_jacobian_lag must be at least 1.");
+	reactionJacobianLag = lag;
+
+	return;
+}
+
+void PetscSolverHandler::initializeSurfaceComm(int color, int nRows) {
+	// Keep the order of the processes
+	int procId;
+	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+	MPI_Comm_split(PETSC_COMM_WORLD, color, procId, &surfaceComm);
+
+	localAtomConc.assign(nRows, 0.0);
+	totalAtomConc.assign(nRows, 0.0);
+
+	return;
+}
+
+void PetscSolverHandler::destroySolverContext() {
+	// Free the communicator of the rows created by initializeSurfaceComm
+	if (surfaceComm != MPI_COMM_NULL)
+		MPI_Comm_free(&surfaceComm);
+
+	// Free the reaction data shared on the node by initializeReactionFill
+	network.releaseShared();
+
+	// Remove the grid points added to the network for the local grid, and
+	// forget the Jacobian parts kept for the matrices, so that the context
+	// can be created again
+	network.addGridPoints(-(int) lastTemperature.size());
+	lastTemperature.clear();
+	offDiagonalMatrix = nullptr;
+	positionsMatrix = nullptr;
+	reactionJacobianAge = 0;
+	laggedReactionVals.clear();
+
+	return;
+}
+
+bool PetscSolverHandler::readOwnershipRanges(const std::vector<PetscInt>& dims,
+		std::vector<std::vector<PetscInt> >& ranges) const {
+	PetscErrorCode ierr;
+	ranges.clear();
+
+	// Check the option -load_balance_ranges
+	char fileName[PETSC_MAX_PATH_LEN];
+	PetscBool flag;
+	ierr = PetscOptionsGetString(NULL, NULL, "-load_balance_ranges", fileName,
+			PETSC_MAX_PATH_LEN, &flag);
+	checkPetscError(ierr, "PetscSolverHandler::readOwnershipRanges: "
+			"PetscOptionsGetString (-load_balance_ranges) failed.");
+	if (!flag)
+		return false;
+
+	// Each process reads the ranges, one line per direction
+	std::vector<std::vector<PetscInt> > fileRanges(dims.size());
+	std::ifstream rangesFile(fileName);
+	std::string line;
+	while (std::getline(rangesFile, line)) {
+		std::istringstream lineStream(line);
+		std::string direction;
+		lineStream >> direction;
+		auto d = std::string("xyz").find(direction);
+		if (direction.size() != 1 || d >= dims.size())
+			continue;
+		PetscInt range;
+		while (lineStream >> range)
+			fileRanges[d].push_back(range);
+	}
+
+	// They must cover the grid with all the processes
+	int nProcs;
+	MPI_Comm_size(PETSC_COMM_WORLD, &nProcs);
+	int nRanges = 1;
+	bool valid = true;
+	for (int d = 0; d < dims.size(); d++) {
+		PetscInt sum = 0;
+		for (auto range : fileRanges[d]) {
+			valid = valid && range > 0;
+			sum += range;
+		}
+		valid = valid && sum == dims[d];
+		nRanges *= fileRanges[d].size();
+	}
+	valid = valid && nRanges == nProcs;
+
+	if (!valid) {
+		int procId;
+		MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+		if (procId == 0)
+			std::cout << "The ownership ranges in " << fileName
+					<< " do not match the grid and the number of processes, "
+							"they are decided by PETSc." << std::endl;
+		return false;
+	}
+
+	ranges = fileRanges;
+
+	return true;
+}
+
+void PetscSolverHandler::initializeLoadBalance(DM &da) {
+	PetscErrorCode ierr;
+
+	// Check the option -load_balance
+	PetscBool flag;
+	ierr = PetscOptionsHasName(NULL, NULL, "-load_balance", &flag);
+	checkPetscError(ierr, "PetscSolverHandler::initializeLoadBalance: "
+			"PetscOptionsHasName (-load_balance) failed.");
+	measureLoad = flag;
+
+	// One cost for each local grid point
+	PetscInt xm, ym, zm;
+	ierr = DMDAGetCorners(da, NULL, NULL, NULL, &xm, &ym, &zm);
+	checkPetscError(ierr, "PetscSolverHandler::initializeLoadBalance: "
+			"DMDAGetCorners failed.");
+	pointCost.assign(measureLoad ? xm * ym * zm : 0, 0.0);
+
+	return;
+}
+
+std::vector<PetscInt> PetscSolverHandler::balanceRanges(
+		const std::vector<double>& cost, int nProcs) {
+	const int nPoints = cost.size();
+
+	// Give a small cost to every grid point so that the points where nothing
+	// was measured (the vacuum) are still split evenly
+	double total = 0.0;
+	for (auto pointCost : cost)
+		total += pointCost;
+	double minCost = (total > 0.0) ? 1.0e-3 * total / nPoints : 1.0;
+
+	// The cost before each grid point
+	std::vector<double> costBefore(nPoints + 1, 0.0);
+	for (int i = 0; i < nPoints; i++)
+		costBefore[i + 1] = costBefore[i] + cost[i] + minCost;
+
+	// Cut where the cost before reaches each share of the total
+	std::vector<PetscInt> ranges(nProcs, 0);
+	int start = 0;
+	for (int r = 0; r < nProcs - 1; r++) {
+		double target = costBefore[nPoints] * (r + 1) / nProcs;
+		// Leave at least one grid point for each of the next processes
+		int maxEnd = nPoints - (nProcs - r - 1);
+		int end = start + 1;
+		while (end < maxEnd && costBefore[end] < target)
+			end++;
+		// Cut on the closest side of the target
+		if (end - 1 > start
+				&& target - costBefore[end - 1] < costBefore[end] - target)
+			end--;
+		ranges[r] = end - start;
+		start = end;
+	}
+	ranges[nProcs - 1] = nPoints - start;
+
+	return ranges;
+}
+
+void PetscSolverHandler::reportLoadBalance(DM &da, PetscInt timestep) {
+	// Nothing was measured
+	if (!measureLoad)
+		return;
+
+	PetscErrorCode ierr;
+
+	// Get the size of the grid and of the process grid
+	PetscInt dim, Mx, My, Mz, m, n, p;
+	ierr = DMDAGetInfo(da, &dim, &Mx, &My, &Mz, &m, &n, &p, PETSC_IGNORE,
+	PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE, PETSC_IGNORE);
+	checkPetscError(ierr, "PetscSolverHandler::reportLoadBalance: "
+			"DMDAGetInfo failed.");
+	PetscInt xs, ys, zs, xm, ym, zm;
+	ierr = DMDAGetCorners(da, &xs, &ys, &zs, &xm, &ym, &zm);
+	checkPetscError(ierr, "PetscSolverHandler::reportLoadBalance: "
+			"DMDAGetCorners failed.");
+
+	// The cost of this process and its share of the cost of each grid
+	// point along x, then y, then z
+	double localCost = 0.0;
+	std::vector<double> localProfile(Mx + My + Mz, 0.0);
+	for (PetscInt k = 0; k < zm; k++)
+		for (PetscInt j = 0; j < ym; j++)
+			for (PetscInt i = 0; i < xm; i++) {
+				double cost = pointCost[(k * ym + j) * xm + i];
+				localCost += cost;
+				localProfile[xs + i] += cost;
+				localProfile[Mx + ys + j] += cost;
+				localProfile[Mx + My + zs + k] += cost;
+			}
+
+	// Gather them on the master process
+	int procId, nProcs;
+	MPI_Comm_rank(PETSC_COMM_WORLD, &procId);
+	MPI_Comm_size(PETSC_COMM_WORLD, &nProcs);
+	std::vector<double> costs(procId == 0 ? nProcs : 0);
+	MPI_Gather(&localCost, 1, MPI_DOUBLE, costs.data(), 1, MPI_DOUBLE, 0,
+			PETSC_COMM_WORLD);
+	std::vector<double> profile(procId == 0 ? localProfile.size() : 0);
+	MPI_Reduce(localProfile.data(), profile.data(), localProfile.size(),
+			MPI_DOUBLE, MPI_SUM, 0, PETSC_COMM_WORLD);
+
+	if (procId == 0) {
+		double maxCost = *std::max_element(costs.begin(), costs.end());
+		double minCost = *std::min_element(costs.begin(), costs.end());
+		double average = 0.0;
+		for (auto cost : costs)
+			average += cost / nProcs;
+		double idle = (maxCost > 0.0) ? 1.0 - average / maxCost : 0.0;
+
+		std::cout << "Load balance at time step " << timestep
+				<< ": the processes spent between " << minCost << " s and "
+				<< maxCost << " s on their grid points (average " << average
+				<< " s), they were idle " << 100.0 * idle
+				<< "% of the time." << std::endl;
+
+		// Write the cost of each process and the ranges balancing it along
+		// each direction
+		std::ofstream rangesFile("loadBalance.txt");
+		rangesFile << "# Cost of each process (s) until time step "
+				<< timestep << ":";
+		for (auto cost : costs)
+			rangesFile << " " << cost;
+		rangesFile << std::endl;
+		rangesFile << "# Ownership ranges balancing it, to use with "
+				"-load_balance_ranges:" << std::endl;
+
+		PetscInt sizes[3] = { Mx, My, Mz };
+		PetscInt nProcsDir[3] = { m, n, p };
+		std::size_t offset = 0;
+		for (int d = 0; d < dim; d++) {
+			std::vector<double> directionCost(profile.begin() + offset,
+					profile.begin() + offset + sizes[d]);
+			offset += sizes[d];
+			auto ranges = balanceRanges(directionCost, nProcsDir[d]);
+			rangesFile << "xyz"[d];
+			for (auto range : ranges)
+				rangesFile << " " << range;
+			rangesFile << std::endl;
+		}
+	}
+
+	// Start measuring again
+	std::fill(pointCost.begin(), pointCost.end(), 0.0);
+
+	return;
+}
+
+bool PetscSolverHandler::lagReactionPartials(
+		const std::vector<double>& temperatures) {
+	// Nothing is kept without lag
+	if (reactionJacobianLag <= 1)
+		return false;
+
+	// Use the kept partials again until the lag is reached, if no grid point
+	// changed its temperature more than the network does before setting it
+	const int nPoints = temperatures.size();
+	bool current = reactionJacobianAge > 0
+			&& reactionJacobianAge < reactionJacobianLag
+			&& laggedReactionVals.size() == nPoints
+			&& reactionState.temperature.size() == nPoints
+			&& reactionState.surfaceMoves == surfaceMoves;
+	for (int i = 0; current && i < nPoints; i++) {
+		current = std::fabs(reactionState.temperature[i] - temperatures[i])
+				<= 0.1;
+	}
+	if (current) {
+		reactionJacobianAge++;
+		return true;
+	}
+
+	// They are computed again at every grid point
+	laggedReactionVals.resize(nPoints,
+			std::vector<PetscScalar>(reactionIndices.size(), 0.0));
+	reactionState.temperature = temperatures;
+	reactionState.surfaceMoves = surfaceMoves;
+	reactionJacobianAge = 1;
+
+	return false;
+}
+
+bool PetscSolverHandler::isOffDiagonalJacobianCurrent(Mat &J) {
+	// Nothing is kept without reuse
+	if (!offDiagonalReuse || J != offDiagonalMatrix)
+		return false;
+
+	// The stored values are lost if the structure changed
+	PetscObjectState state = 0;
+	PetscErrorCode ierr = MatGetNonzeroState(J, &state);
+	checkPetscError(ierr, "PetscSolverHandler::isOffDiagonalJacobianCurrent: "
+			"MatGetNonzeroState failed.");
+	if (state != offDiagonalNonzeroState)
+		return false;
+
+	return isJacobianStateCurrent(offDiagonalState);
+}
+
+bool PetscSolverHandler::keepOffDiagonalJacobian(Mat &J) {
+	if (!offDiagonalReuse)
+		return false;
+
+	// Save the state in which it was computed
+	PetscErrorCode ierr = MatGetNonzeroState(J, &offDiagonalNonzeroState);
+	checkPetscError(ierr, "PetscSolverHandler::keepOffDiagonalJacobian: "
+			"MatGetNonzeroState failed.");
+	offDiagonalMatrix = J;
+	saveJacobianState(offDiagonalState);
+
+	return true;
+}
+
+void PetscSolverHandler::multiplyReactionJacobian(Vec &C, Vec &x, Vec &y) {
+	PetscErrorCode ierr;
+
+	// Get the arrays of the owned grid points
+	const PetscScalar *concs = nullptr, *xValues = nullptr;
+	PetscScalar *yValues = nullptr;
+	ierr = VecGetArrayRead(C, &concs);
+	checkPetscError(ierr, "PetscSolverHandler::multiplyReactionJacobian: "
+			"VecGetArrayRead (C) failed.");
+	ierr = VecGetArrayRead(x, &xValues);
+	checkPetscError(ierr, "PetscSolverHandler::multiplyReactionJacobian: "
+			"VecGetArrayRead (x) failed.");
+	ierr = VecGetArray(y, &yValues);
+	checkPetscError(ierr, "PetscSolverHandler::multiplyReactionJacobian: "
+			"VecGetArray (y) failed.");
+
+	// Degrees of freedom is the total number of clusters in the network
+	const int dof = reactionSize.size();
+
+	// Compute the partial derivatives again at each grid point and multiply
+	// them with the vector, without keeping them
+	const int nPoints = reactionPoints.size();
+#pragma omp parallel for if (getNumberOfThreads() > 1)
+	for (int n = 0; n < nPoints; n++) {
+		const PetscInt offset = reactionPoints[n].first * dof;
+		// The lagged partials are the ones of the assembled part
+		auto& vals = getReactionVals(reactionPoints[n].first);
+		if (reactionJacobianLag <= 1)
+			network.computeAllPartials(concs + offset, reactionStartingIdx,
+					reactionIndices, vals, reactionPoints[n].second);
+
+		// The last DOF is the temperature, it doesn't have reactions
+		for (int i = 0; i < dof - 1; i++) {
+			auto startingIdx = reactionStartingIdx[i];
+			double product = 0.0;
+			for (int j = 0; j < reactionSize[i]; j++) {
+				// Skip the partials that are in the assembled matrix
+				if (reactionPositions[startingIdx + j] < 0)
+					product += vals[startingIdx + j]
+							* xValues[offset + reactionIndices[startingIdx + j]];
+			}
+			yValues[offset + i] += product;
+		}
+	}
+
+	// Restore the arrays
+	ierr = VecRestoreArrayRead(C, &concs);
+	checkPetscError(ierr, "PetscSolverHandler::multiplyReactionJacobian: "
+			"VecRestoreArrayRead (C) failed.");
+	ierr = VecRestoreArrayRead(x, &xValues);
+	checkPetscError(ierr, "PetscSolverHandler::multiplyReactionJacobian: "
+			"VecRestoreArrayRead (x) failed.");
+	ierr = VecRestoreArray(y, &yValues);
+	checkPetscError(ierr, "PetscSolverHandler::multiplyReactionJacobian: "
+			"VecRestoreArray (y) failed.");
+
+	return;
+}
+
 } // nmaespace xolotlSolver
@@ -2,7 +2,12 @@
 #define PETSCSOLVERHANDLER_H
 
 // Includes
+#include <chrono>
+#include <cmath>
 #include "SolverHandler.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace xolotlSolver {
 
@@ -85,6 +90,364 @@ protected:
 	 */
 	std::vector<PetscScalar> reactionVals;
 
+	/**
+	 * Partial derivatives for all reactions at one grid point, one vector
+	 * for each thread when the grid point loops are threaded. They are sized
+	 * when the Jacobian is first computed.
+	 */
+	std::vector<std::vector<PetscScalar> > threadReactionVals;
+
+	/**
+	 * Is the reaction part of the Jacobian applied without being assembled?
+	 * It is set with the -reaction_mf PETSc option.
+	 */
+	bool reactionMatrixFree = false;
+
+	/**
+	 * The grid points where the reaction partial derivatives were last
+	 * computed: the index of the grid point among the local ones and its
+	 * index in the rate constants of the network.
+	 */
+	std::vector<std::pair<PetscInt, int> > reactionPoints;
+
+	/**
+	 * The state of the temperature and of the surface when a part of the
+	 * Jacobian was computed, to know if it can be kept.
+	 */
+	struct JacobianState {
+		//! The temperature at each grid point, of the network rows for the
+		//! off-diagonal part and of the local grid points for the reactions
+		std::vector<double> temperature;
+		//! The number of surface moves
+		int surfaceMoves = -1;
+	};
+
+	/**
+	 * Is the off-diagonal part of the Jacobian (temperature, diffusion and
+	 * advection) kept until the temperature or the surface changes? It is set
+	 * with the -offdiag_jacobian_reuse PETSc option.
+	 */
+	bool offDiagonalReuse = false;
+
+	/**
+	 * The Jacobian where the off-diagonal part was stored, the state of its
+	 * non-zero structure, and the state in which it was computed.
+	 */
+	Mat offDiagonalMatrix = nullptr;
+	PetscObjectState offDiagonalNonzeroState = 0;
+	JacobianState offDiagonalState;
+
+	/**
+	 * The number of Jacobian evaluations between two computations of the
+	 * reaction partial derivatives, set with the -reaction_jacobian_lag
+	 * PETSc option. They are computed at every evaluation when it is 1.
+	 */
+	int reactionJacobianLag = 1;
+
+	/**
+	 * The number of Jacobian evaluations since the reaction partial
+	 * derivatives were last computed, and the state in which they were.
+	 */
+	int reactionJacobianAge = 0;
+	JacobianState reactionState;
+
+	/**
+	 * The reaction partial derivatives at each local grid point, kept
+	 * between evaluations when they are lagged.
+	 */
+	std::vector<std::vector<PetscScalar> > laggedReactionVals;
+
+	/**
+	 * The number of times the surface moved, the parts of the Jacobian that
+	 * are kept are computed again when it changes.
+	 */
+	int surfaceMoves = 0;
+
+	/**
+	 * The communicator of the processes owning the same rows (2D) or
+	 * columns (3D) of the grid along the depth, the only ones sharing the
+	 * trapped atom concentration near the surface of these rows.
+	 */
+	MPI_Comm surfaceComm = MPI_COMM_NULL;
+
+	/**
+	 * The concentration of atoms trapped in bubbles near the surface for
+	 * each local row (or column) of the grid: the sum over the local grid
+	 * points and the total over the row.
+	 */
+	std::vector<double> localAtomConc;
+	std::vector<double> totalAtomConc;
+
+	/**
+	 * Create the communicator of the processes owning the same rows (or
+	 * columns) of the grid, collective call.
+	 *
+	 * @param color The same value for all the processes owning these rows
+	 * @param nRows The number of local rows
+	 */
+	void initializeSurfaceComm(int color, int nRows);
+
+	/**
+	 * Sum the local trapped atom concentrations of all the rows over the
+	 * processes owning them, with one collective call.
+	 */
+	void reduceTrappedAtomConc() {
+		MPI_Allreduce(localAtomConc.data(), totalAtomConc.data(),
+				localAtomConc.size(), MPI_DOUBLE, MPI_SUM, surfaceComm);
+
+		return;
+	}
+
+	/**
+	 * The position of each reaction partial derivative in the diagonal block
+	 * of its row in the Jacobian (the rank of its column among the non-zero
+	 * columns of this block), in the same order as reactionIndices. It is the
+	 * same at every grid point. It is -1 for the partials that are not in the
+	 * matrix in the matrix-free mode.
+	 */
+	std::vector<PetscInt> reactionPositions;
+
+	/**
+	 * For each local row of the Jacobian, the position in the value array of
+	 * the local diagonal part of the matrix of the first entry of the diagonal
+	 * block. The rows are ordered like the local grid points, then the DOF.
+	 */
+	std::vector<PetscInt> diagonalBlockStarts;
+
+	/**
+	 * The Jacobian and the state of its non-zero structure when the positions
+	 * were computed, they are computed again if any of them changes.
+	 */
+	Mat positionsMatrix = nullptr;
+	PetscObjectState positionsState = 0;
+
+	/**
+	 * Get the array of values of the local diagonal part of the Jacobian
+	 * where the reaction partial derivatives can be added directly with
+	 * addReactionPartials(), instead of going through MatSetValuesStencil()
+	 * row by row. The positions of the partials in this array are computed
+	 * the first time and whenever the non-zero structure changes.
+	 *
+	 * It is only possible for AIJ matrices, it returns nullptr otherwise.
+	 *
+	 * @param J The Jacobian, its non-zero structure must be final
+	 * @return The values, to be given back with restoreDiagonalValues()
+	 */
+	PetscScalar * getDiagonalValues(Mat &J);
+
+	/**
+	 * Give back the values of the local diagonal part of the Jacobian.
+	 *
+	 * @param J The Jacobian
+	 * @param values The values from getDiagonalValues(), can be nullptr
+	 */
+	void restoreDiagonalValues(Mat &J, PetscScalar *values);
+
+	/**
+	 * Add the reaction partial derivatives of one grid point at their
+	 * position in the values of the local diagonal part of the Jacobian.
+	 * Different grid points can be added concurrently.
+	 *
+	 * @param values The values from getDiagonalValues()
+	 * @param localPoint The index of the grid point among the local ones
+	 * @param vals The partial derivatives, in the same order as reactionIndices
+	 */
+	void addReactionPartials(PetscScalar *values, PetscInt localPoint,
+			const std::vector<PetscScalar>& vals) const {
+		const int dof = reactionSize.size();
+		auto rowStarts = diagonalBlockStarts.data() + localPoint * dof;
+		// The last DOF is the temperature, it doesn't have reactions
+		for (int i = 0; i < dof - 1; i++) {
+			PetscScalar *rowValues = values + rowStarts[i];
+			auto startingIdx = reactionStartingIdx[i];
+			for (int j = 0; j < reactionSize[i]; j++) {
+				auto position = reactionPositions[startingIdx + j];
+				if (position >= 0)
+					rowValues[position] += vals[startingIdx + j];
+			}
+		}
+
+		return;
+	}
+
+	/**
+	 * Get the diagonal fill of the reactions from the network, or only the
+	 * diagonal entries in the matrix-free mode. The partial derivatives
+	 * indices of the network are defined in both cases.
+	 *
+	 * @param dfill The diagonal fill where the reactions are added
+	 */
+	void initializeReactionFill(
+			xolotlCore::IReactionNetwork::SparseFillMap& dfill);
+
+	/**
+	 * Read the options that keep parts of the Jacobian between evaluations.
+	 */
+	void initializeJacobianReuse();
+
+	/**
+	 * Save the current temperature and surface.
+	 *
+	 * @param state The state to update
+	 */
+	void saveJacobianState(JacobianState& state) const {
+		state.temperature = lastTemperature;
+		state.surfaceMoves = surfaceMoves;
+
+		return;
+	}
+
+	/**
+	 * Are the temperature and surface the same as in the given state?
+	 * The network only changes its rates with lastTemperature.
+	 *
+	 * @param state The state to compare with
+	 * @return True if nothing changed
+	 */
+	bool isJacobianStateCurrent(const JacobianState& state) const {
+		return state.surfaceMoves == surfaceMoves
+				&& state.temperature == lastTemperature;
+	}
+
+	/**
+	 * Decide if the reaction partial derivatives kept at the previous
+	 * evaluations are used again for this Jacobian evaluation. They are
+	 * computed again every reactionJacobianLag evaluations, or if the
+	 * temperature of a grid point or the surface changed.
+	 *
+	 * @param temperatures The current temperature at each local grid point
+	 * @return True if the kept partials are used, false if they must be
+	 * computed with getReactionVals()
+	 */
+	bool lagReactionPartials(const std::vector<double>& temperatures);
+
+	/**
+	 * Is the cost of each local grid point measured to report the load
+	 * imbalance between the processes? It is set with the -load_balance
+	 * PETSc option.
+	 */
+	bool measureLoad = false;
+
+	/**
+	 * The time spent on each local grid point by the threaded parts of the
+	 * RHS and diagonal Jacobian evaluations since the last report, ordered
+	 * like the local grid points.
+	 */
+	std::vector<double> pointCost;
+
+	/**
+	 * The clock used to measure the cost of the grid points.
+	 */
+	using LoadClock = std::chrono::steady_clock;
+
+	/**
+	 * Read the -load_balance_ranges PETSc option and the ownership ranges
+	 * in the file it names, as written by reportLoadBalance(). The ranges are
+	 * only used if they cover the grid with as many processes as there are.
+	 *
+	 * @param dims The number of grid points in each direction, the size
+	 * gives the number of directions
+	 * @param ranges The number of grid points owned by the processes along
+	 * each direction, empty if they are decided by PETSc
+	 * @return True if the ranges can be given to DMDACreate
+	 */
+	bool readOwnershipRanges(const std::vector<PetscInt>& dims,
+			std::vector<std::vector<PetscInt> >& ranges) const;
+
+	/**
+	 * Read the -load_balance PETSc option and size the costs of the local
+	 * grid points.
+	 *
+	 * @param da The DMDA, set up
+	 */
+	void initializeLoadBalance(DM &da);
+
+	/**
+	 * Get the time at which the work on a grid point starts, if the cost of
+	 * the grid points is measured.
+	 *
+	 * @return The time
+	 */
+	LoadClock::time_point startPointCost() const {
+		return measureLoad ? LoadClock::now() : LoadClock::time_point();
+	}
+
+	/**
+	 * Add the time since start to the cost of a grid point, if the cost is
+	 * measured. Different grid points can be updated concurrently.
+	 *
+	 * @param localPoint The index of the grid point among the local ones
+	 * @param start The time from startPointCost()
+	 */
+	void addPointCost(PetscInt localPoint, LoadClock::time_point start) {
+		if (measureLoad)
+			pointCost[localPoint] += std::chrono::duration<double>(
+					LoadClock::now() - start).count();
+
+		return;
+	}
+
+	/**
+	 * Split the grid points along one direction into contiguous ranges of
+	 * nearly the same cost.
+	 *
+	 * @param cost The cost of each grid point along the direction
+	 * @param nProcs The number of processes along the direction
+	 * @return The number of grid points in each range, at least one
+	 */
+	static std::vector<PetscInt> balanceRanges(const std::vector<double>& cost,
+			int nProcs);
+
+	/**
+	 * Get the vector where the reaction partial derivatives of a grid point
+	 * are computed: the kept ones if they are lagged, the one of the calling
+	 * thread otherwise.
+	 *
+	 * @param localPoint The index of the grid point among the local ones
+	 * @return The partial derivatives
+	 */
+	std::vector<PetscScalar>& getReactionVals(PetscInt localPoint) {
+		if (reactionJacobianLag > 1)
+			return laggedReactionVals[localPoint];
+		int thread = 0;
+#ifdef _OPENMP
+		thread = omp_get_thread_num();
+#endif
+		return threadReactionVals[thread];
+	}
+
+	/**
+	 * Set the temperature of one grid point of the network if it changed.
+	 * The rates at a grid point only depend on its own temperature, so each
+	 * one is set once before the threads read them.
+	 *
+	 * @param temperature The new temperature
+	 * @param i The location on the grid in the depth direction, the local
+	 * grid point index plus one
+	 */
+	void updateTemperature(double temperature, int i) {
+		if (std::fabs(lastTemperature[i] - temperature) > 0.1) {
+			network.setTemperature(temperature, i);
+			lastTemperature[i] = temperature;
+		}
+	}
+
+	/**
+	 * Get the number of threads sharing the grid point loops of the RHS and
+	 * Jacobian evaluations. The loops are only threaded if the network can
+	 * compute its reactions concurrently.
+	 *
+	 * @return The number of OpenMP threads, 1 without OpenMP
+	 */
+	int getNumberOfThreads() const {
+		int nThreads = 1;
+#ifdef _OPENMP
+		if (network.isThreadSafe())
+			nThreads = omp_get_max_threads();
+#endif
+		return nThreads;
+	}
+
 	/**
 	 * Convert a C++ sparse fill map representation to the one that
 	 * PETSc's DMDASetBlockFillsSparse() expects.
@@ -113,6 +476,38 @@ public:
 			SolverHandler(_network) {
 	}
 
+	/**
+	 * \see ISolverHandler.h
+	 */
+	void destroySolverContext() override;
+
+	/**
+	 * \see ISolverHandler.h
+	 */
+	bool isReactionMatrixFree() const override {
+		return reactionMatrixFree;
+	}
+
+	/**
+	 * \see ISolverHandler.h
+	 */
+	void multiplyReactionJacobian(Vec &C, Vec &x, Vec &y) override;
+
+	/**
+	 * \see ISolverHandler.h
+	 */
+	bool isOffDiagonalJacobianCurrent(Mat &J) override;
+
+	/**
+	 * \see ISolverHandler.h
+	 */
+	bool keepOffDiagonalJacobian(Mat &J) override;
+
+	/**
+	 * \see ISolverHandler.h
+	 */
+	void reportLoadBalance(DM &da, PetscInt timestep) override;
+
 };
 //end class PetscSolverHandler
 
@@ -83,6 +83,9 @@ protected:
 	//! The portion of void at the beginning of the problem.
 	double portion;
 
+	//! The number of grid points left out before the active window.
+	int windowStart;
+
 	//! Which type of grid does the used want to use.
 	std::string useRegularGrid;
 
@@ -98,6 +101,9 @@ protected:
 	//! The depth parameter for the bubble bursting.
 	double tauBursting;
 
+	//! The format of the concentrations in the checkpoints.
+	xolotlCore::XFile::TimestepGroup::ConcsFormat concsFormat;
+
 	//! The value to use to seed the random number generator.
 	unsigned int rngSeed;
 
@@ -300,8 +306,9 @@ protected:
 					0.0), hZ(0.0), leftOffset(1), rightOffset(1), bottomOffset(
 					1), topOffset(1), frontOffset(1), backOffset(1), initialVConc(
 					0.0), electronicStoppingPower(0.0), dimension(-1), portion(
-					0.0), useRegularGrid(""), movingSurface(false), bubbleBursting(
-					false), sputteringYield(0.0), fluxHandler(nullptr), temperatureHandler(
+					0.0), windowStart(0), useRegularGrid(""), movingSurface(
+					false), bubbleBursting(false), sputteringYield(0.0), fluxHandler(
+					nullptr), temperatureHandler(
 					nullptr), diffusionHandler(nullptr), mutationHandler(
 					nullptr), resolutionHandler(nullptr), tauBursting(10.0), rngSeed(
 					0) {
@@ -414,6 +421,11 @@ public:
 		// Set the sputtering yield
 		tauBursting = options.getBurstingDepth();
 
+		// Set the format of the concentrations in the checkpoints
+		concsFormat.dense = options.useDenseConcentrations();
+		concsFormat.compressionLevel = options.getConcCompressionLevel();
+		concsFormat.mantissaBits = options.getConcMantissaBits();
+
 		// Look at if the user wants to use a regular grid in the x direction
 		if (options.useRegularXGrid())
 			useRegularGrid = "regular";
@@ -493,6 +505,14 @@ public:
 		return dimension;
 	}
 
+	/**
+	 * Get the number of grid points left out before the active window.
+	 * \see ISolverHandler.h
+	 */
+	int getWindowStart() const override {
+		return windowStart;
+	}
+
 	/**
 	 * Get the initial vacancy concentration.
 	 * \see ISolverHandler.h
@@ -517,6 +537,14 @@ public:
 		return tauBursting;
 	}
 
+	/**
+	 * Get the format of the concentrations in the checkpoints.
+	 * \see ISolverHandler.h
+	 */
+	xolotlCore::XFile::TimestepGroup::ConcsFormat getConcsFormat() const override {
+		return concsFormat;
+	}
+
 	/**
 	 * Get the grid left offset.
 	 * \see ISolverHandler.h
@@ -614,6 +642,14 @@ public:
 		return networkName;
 	}
 
+	/**
+	 * Set the network name.
+	 * \see ISolverHandler.h
+	 */
+	void setNetworkName(const std::string& name) override {
+		networkName = name;
+	}
+
 	/**
 	 * Access the random number generator
 	 * The generator will have already been seeded.